@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "fluid-client.h"
+#include "fluid-server.h"
+#include "../logical/slice-controller.h"
+#include "../uni5on-common.h"
+
+#undef NS_LOG_APPEND_CONTEXT
+#define NS_LOG_APPEND_CONTEXT \
+  std::clog << "[" << GetAppName ()                       \
+            << " client teid " << GetTeidHex () << "] ";
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FluidClient");
+NS_OBJECT_ENSURE_REGISTERED (FluidClient);
+
+TypeId
+FluidClient::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FluidClient")
+    .SetParent<Uni5onClient> ()
+    .AddConstructor<FluidClient> ()
+    .AddAttribute ("SliceCtrl", "The LTE logical slice controller pointer.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   PointerValue (),
+                   MakePointerAccessor (&FluidClient::m_controller),
+                   MakePointerChecker<SliceController> ())
+    .AddAttribute ("Interval",
+                   "The interval between subsequent bit rate updates.",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&FluidClient::m_interval),
+                   MakeTimeChecker (MilliSeconds (1)))
+
+    // These attributes can be configured for the desired traffic pattern.
+    .AddAttribute ("DlBitRate",
+                   "A random variable used to pick the downlink "
+                   "bit rate for each interval [bps].",
+                   StringValue ("ns3::UniformRandomVariable["
+                               "Min=500000|Max=2000000]"),
+                   MakePointerAccessor (&FluidClient::m_dlRateRng),
+                   MakePointerChecker <RandomVariableStream> ())
+    .AddAttribute ("UlBitRate",
+                   "A random variable used to pick the uplink "
+                   "bit rate for each interval [bps].",
+                   StringValue ("ns3::UniformRandomVariable["
+                               "Min=100000|Max=500000]"),
+                   MakePointerAccessor (&FluidClient::m_ulRateRng),
+                   MakePointerChecker <RandomVariableStream> ())
+  ;
+  return tid;
+}
+
+FluidClient::FluidClient ()
+  : m_controller (0),
+  m_sendEvent (EventId ()),
+  m_stopEvent (EventId ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FluidClient::~FluidClient ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FluidClient::Start ()
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT_MSG (m_controller, "Slice controller undefined.");
+
+  // Schedule the ForceStop method to stop traffic based on traffic length.
+  Time stop = GetTrafficLength ();
+  m_stopEvent = Simulator::Schedule (stop, &FluidClient::ForceStop, this);
+  NS_LOG_INFO ("Set traffic length to " << stop.GetSeconds () << "s.");
+
+  // Chain up to reset statistics, notify server, and fire start trace source.
+  Uni5onClient::Start ();
+
+  // Start traffic.
+  m_sendEvent.Cancel ();
+  m_sendEvent = Simulator::Schedule (m_interval, &FluidClient::SendFluid,
+                                     this);
+}
+
+void
+FluidClient::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_dlRateRng);
+  ReseedStream (m_ulRateRng);
+
+  // Chain up to reseed the server application streams.
+  Uni5onClient::ReseedStreams ();
+}
+
+void
+FluidClient::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_stopEvent.Cancel ();
+  m_sendEvent.Cancel ();
+  m_controller = 0;
+  Uni5onClient::DoDispose ();
+}
+
+void
+FluidClient::ForceStop ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // Cancel (possible) pending stop event and stop the traffic.
+  m_stopEvent.Cancel ();
+  m_sendEvent.Cancel ();
+
+  // Chain up to notify server.
+  Uni5onClient::ForceStop ();
+
+  // There are no packets in flight, so notify the stopped application now.
+  NotifyStop (false);
+}
+
+void
+FluidClient::SendFluid (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Convert the bit rates for this interval into transmitted bytes.
+  double seconds = m_interval.GetSeconds ();
+  uint32_t dlBytes = std::abs (m_dlRateRng->GetValue ()) * seconds / 8;
+  uint32_t ulBytes = std::abs (m_ulRateRng->GetValue ()) * seconds / 8;
+
+  // Account for the fluid traffic in the backhaul network. As there are no
+  // packets, the traffic is delivered to both ends at the end of interval.
+  m_controller->FluidTrafficTx (GetTeid (), Direction::DLINK, dlBytes);
+  m_controller->FluidTrafficTx (GetTeid (), Direction::ULINK, ulBytes);
+  DynamicCast<FluidServer> (m_serverApp)->NotifyFluidRx (ulBytes);
+  NotifyRx (dlBytes);
+  NS_LOG_DEBUG ("Client TX " << ulBytes << " and RX " << dlBytes <<
+                " bytes of fluid traffic.");
+
+  // Schedule next interval.
+  m_sendEvent = Simulator::Schedule (m_interval, &FluidClient::SendFluid,
+                                     this);
+}
+
+} // Namespace ns3
@@ -0,0 +1,78 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef FLUID_CLIENT_H
+#define FLUID_CLIENT_H
+
+#include "uni5on-client.h"
+
+namespace ns3 {
+
+class SliceController;
+
+/**
+ * \ingroup uni5onApps
+ * This is the client side of a fluid traffic generator. Instead of sending
+ * packets, this application follows downlink and uplink bit rate trajectories,
+ * picking new bit rates at fixed intervals and notifying the slice controller
+ * of the bytes transmitted over the EPS bearer in each interval. The slice
+ * controller injects these bytes directly into the backhaul link accounting,
+ * so fluid applications can be mixed with packet-level applications to
+ * simulate a large number of background UEs at low cost.
+ */
+class FluidClient : public Uni5onClient
+{
+public:
+  /**
+   * \brief Register this type.
+   * \return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  FluidClient ();             //!< Default constructor.
+  virtual ~FluidClient ();    //!< Dummy destructor, see DoDispose.
+
+  // Inherited from Uni5onClient.
+  void Start ();
+  void ReseedStreams ();
+
+protected:
+  // Inherited from Object.
+  virtual void DoDispose (void);
+
+  // Inherited from Uni5onClient.
+  void ForceStop ();
+
+private:
+  /**
+   * \brief Handle the fluid traffic transmission for the last interval, and
+   * schedule the next one.
+   */
+  void SendFluid (void);
+
+  Ptr<SliceController>        m_controller;   //!< Slice controller.
+  Ptr<RandomVariableStream>   m_dlRateRng;    //!< Downlink bit rate.
+  Ptr<RandomVariableStream>   m_ulRateRng;    //!< Uplink bit rate.
+  Time                        m_interval;     //!< Bit rate update interval.
+  EventId                     m_sendEvent;    //!< SendFluid event.
+  EventId                     m_stopEvent;    //!< Stop event.
+};
+
+} // namespace ns3
+#endif /* FLUID_CLIENT_H */
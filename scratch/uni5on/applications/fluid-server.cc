@@ -0,0 +1,61 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "fluid-server.h"
+
+#undef NS_LOG_APPEND_CONTEXT
+#define NS_LOG_APPEND_CONTEXT                             \
+  std::clog << "[" << GetAppName ()                       \
+            << " server teid " << GetTeidHex () << "] ";
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FluidServer");
+NS_OBJECT_ENSURE_REGISTERED (FluidServer);
+
+TypeId
+FluidServer::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FluidServer")
+    .SetParent<Uni5onServer> ()
+    .AddConstructor<FluidServer> ()
+  ;
+  return tid;
+}
+
+FluidServer::FluidServer ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FluidServer::~FluidServer ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FluidServer::NotifyFluidRx (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+
+  NotifyRx (bytes);
+  NS_LOG_DEBUG ("Server RX fluid traffic with " << bytes << " bytes.");
+}
+
+} // Namespace ns3
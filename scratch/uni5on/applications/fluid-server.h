@@ -0,0 +1,53 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef FLUID_SERVER_H
+#define FLUID_SERVER_H
+
+#include "uni5on-server.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onApps
+ * This is the server side of a fluid traffic generator. The fluid traffic is
+ * entirely driven by the client application, so this server only keeps the
+ * uplink traffic statistics.
+ */
+class FluidServer : public Uni5onServer
+{
+public:
+  /**
+   * \brief Register this type.
+   * \return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  FluidServer ();             //!< Default constructor.
+  virtual ~FluidServer ();    //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Notify this server of uplink fluid traffic received from the client.
+   * \param bytes The number of bytes received.
+   */
+  void NotifyFluidRx (uint32_t bytes);
+};
+
+} // namespace ns3
+#endif /* FLUID_SERVER_H */
@@ -21,6 +21,7 @@
  */
 
 #include "http-client.h"
+#include "../uni5on-common.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT \
@@ -95,6 +96,18 @@ HttpClient::Start ()
     MakeCallback (&HttpClient::NotifyConnectionFailed, this));
 }
 
+void
+HttpClient::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_readingTimeStream);
+  ReseedStream (m_readingTimeAdjustStream);
+
+  // Chain up to reseed the server application streams.
+  Uni5onClient::ReseedStreams ();
+}
+
 void
 HttpClient::DoDispose (void)
 {
@@ -57,6 +57,7 @@ public:
 
   // Inherited from Uni5onClient.
   void Start ();
+  void ReseedStreams ();
 
 protected:
   // Inherited from Object.
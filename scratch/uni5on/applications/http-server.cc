@@ -21,6 +21,7 @@
  */
 
 #include "http-server.h"
+#include "../uni5on-common.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                             \
@@ -67,6 +68,16 @@ HttpServer::~HttpServer ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+HttpServer::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_mainObjectSizeStream);
+  ReseedStream (m_numOfInlineObjStream);
+  ReseedStream (m_inlineObjSizeStream);
+}
+
 void
 HttpServer::DoDispose (void)
 {
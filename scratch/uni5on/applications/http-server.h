@@ -51,6 +51,9 @@ public:
   HttpServer ();          //!< Default constructor.
   virtual ~HttpServer (); //!< Dummy destructor, see DoDispose.
 
+  // Inherited from Uni5onServer.
+  void ReseedStreams ();
+
 protected:
   // Inherited from Object.
   virtual void DoDispose (void);
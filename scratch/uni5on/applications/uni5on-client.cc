@@ -235,6 +235,18 @@ Uni5onClient::Start ()
   m_appStartTrace (this);
 }
 
+void
+Uni5onClient::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_lengthRng);
+  if (m_serverApp)
+    {
+      m_serverApp->ReseedStreams ();
+    }
+}
+
 DataRate
 Uni5onClient::GetDlGoodput (void) const
 {
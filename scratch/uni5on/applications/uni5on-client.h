@@ -100,6 +100,12 @@ public:
    */
   virtual void Start ();
 
+  /**
+   * Reseed the random variable streams used by this application and by the
+   * server application with the current RngSeedManager run number.
+   */
+  virtual void ReseedStreams ();
+
   /**
    * Get the downlink goodput for this application.
    * \return The requested goodput.
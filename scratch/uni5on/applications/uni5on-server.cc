@@ -129,6 +129,12 @@ Uni5onServer::GetUlGoodput (void) const
     }
 }
 
+void
+Uni5onServer::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void
 Uni5onServer::DoDispose (void)
 {
@@ -76,6 +76,12 @@ public:
    */
   DataRate GetUlGoodput (void) const;
 
+  /**
+   * Reseed the random variable streams used by this application with the
+   * current RngSeedManager run number.
+   */
+  virtual void ReseedStreams ();
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose (void);
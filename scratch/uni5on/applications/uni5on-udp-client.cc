@@ -19,6 +19,7 @@
 
 #include <ns3/seq-ts-header.h>
 #include "uni5on-udp-client.h"
+#include "../uni5on-common.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT \
@@ -86,6 +87,18 @@ Uni5onUdpClient::Start ()
                                      this, newSize);
 }
 
+void
+Uni5onUdpClient::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_pktInterRng);
+  ReseedStream (m_pktSizeRng);
+
+  // Chain up to reseed the server application streams.
+  Uni5onClient::ReseedStreams ();
+}
+
 void
 Uni5onUdpClient::DoDispose (void)
 {
@@ -43,6 +43,7 @@ public:
 
   // Inherited from Uni5onClient.
   void Start ();
+  void ReseedStreams ();
 
 protected:
   // Inherited from Object.
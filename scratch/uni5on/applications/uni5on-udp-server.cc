@@ -19,6 +19,7 @@
 
 #include <ns3/seq-ts-header.h>
 #include "uni5on-udp-server.h"
+#include "../uni5on-common.h"
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                             \
@@ -64,6 +65,15 @@ Uni5onUdpServer::~Uni5onUdpServer ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+Uni5onUdpServer::ReseedStreams ()
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_pktInterRng);
+  ReseedStream (m_pktSizeRng);
+}
+
 void
 Uni5onUdpServer::DoDispose (void)
 {
@@ -41,6 +41,9 @@ public:
   Uni5onUdpServer ();             //!< Default constructor.
   virtual ~Uni5onUdpServer ();    //!< Dummy destructor, see DoDispose.
 
+  // Inherited from Uni5onServer.
+  void ReseedStreams ();
+
 protected:
   // Inherited from Object.
   virtual void DoDispose (void);
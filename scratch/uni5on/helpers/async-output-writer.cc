@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "async-output-writer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AsyncOutputWriter");
+
+const size_t AsyncOutputWriter::m_chunkSize = 256 * 1024;
+
+AsyncOutputWriter::AsyncOutputWriter ()
+  : m_stop (false),
+  m_shutdown (false)
+{
+  NS_LOG_FUNCTION (this);
+
+  StartThread ();
+}
+
+AsyncOutputWriter::~AsyncOutputWriter ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DoShutdown ();
+}
+
+Ptr<OutputStreamWrapper>
+AsyncOutputWriter::CreateStream (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  AsyncOutputWriter *writer = Get ();
+  NS_ABORT_MSG_IF (writer->m_shutdown, "Output writer already shut down.");
+
+  // The chunks are already large, so the file stream doesn't need its own
+  // buffer: each chunk turns into a single write to the file.
+  Output output;
+  output.file = new std::ofstream ();
+  output.file->rdbuf ()->pubsetbuf (0, 0);
+  output.file->open (filename.c_str (), std::ios::out);
+  NS_ABORT_MSG_UNLESS (output.file->is_open (),
+                       "Unable to open output file " << filename);
+  output.buffer = new ChunkStreamBuf (output.file);
+  output.stream = new std::ostream (output.buffer);
+  writer->m_outputs.push_back (output);
+
+  return Create<OutputStreamWrapper> (output.stream);
+}
+
+void
+AsyncOutputWriter::Shutdown (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Get ()->DoShutdown ();
+}
+
+void
+AsyncOutputWriter::Flush (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Get ()->StopThread ();
+}
+
+void
+AsyncOutputWriter::Restart (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  AsyncOutputWriter *writer = Get ();
+  NS_ABORT_MSG_IF (writer->m_shutdown, "Output writer already shut down.");
+  writer->StartThread ();
+}
+
+AsyncOutputWriter*
+AsyncOutputWriter::Get (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  static AsyncOutputWriter writer;
+  return &writer;
+}
+
+void
+AsyncOutputWriter::Enqueue (std::ofstream *file, const char *begin,
+                            const char *end)
+{
+  NS_LOG_FUNCTION (this << file << end - begin);
+
+  Chunk chunk;
+  chunk.file = file;
+  m_mutex.Lock ();
+  m_queue.push_back (chunk);
+  m_queue.back ().data.assign (begin, end);
+  m_mutex.Unlock ();
+  m_condition.SetCondition (true);
+  m_condition.Signal ();
+}
+
+void
+AsyncOutputWriter::DoShutdown (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_shutdown)
+    {
+      return;
+    }
+
+  // Write everything before closing the files. If the thread was stopped by
+  // a flush, start it again to write the output produced since then.
+  StartThread ();
+  StopThread ();
+  m_shutdown = true;
+
+  for (auto &output : m_outputs)
+    {
+      output.file->close ();
+      delete output.stream;
+      delete output.buffer;
+      delete output.file;
+    }
+  m_outputs.clear ();
+}
+
+void
+AsyncOutputWriter::StartThread (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_thread)
+    {
+      return;
+    }
+
+  m_stop = false;
+  m_thread = Create<SystemThread> (
+      MakeCallback (&AsyncOutputWriter::Run, this));
+  m_thread->Start ();
+}
+
+void
+AsyncOutputWriter::StopThread (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_thread)
+    {
+      return;
+    }
+
+  // Hand over the pending output and wait for the writer thread to write
+  // everything it has in the queue before stopping.
+  for (auto &output : m_outputs)
+    {
+      output.buffer->HandOver ();
+    }
+  m_mutex.Lock ();
+  m_stop = true;
+  m_mutex.Unlock ();
+  m_condition.SetCondition (true);
+  m_condition.Signal ();
+  m_thread->Join ();
+  m_thread = 0;
+}
+
+void
+AsyncOutputWriter::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  while (true)
+    {
+      std::list<Chunk> chunks;
+      m_mutex.Lock ();
+      chunks.swap (m_queue);
+      bool stop = m_stop;
+      m_mutex.Unlock ();
+
+      for (auto const &chunk : chunks)
+        {
+          chunk.file->write (chunk.data.data (), chunk.data.size ());
+        }
+
+      // Chunks queued before the stop flag was set were already written.
+      if (stop)
+        {
+          break;
+        }
+      if (chunks.empty ())
+        {
+          // The condition flag is set with each signal and only cleared here,
+          // so a chunk queued while we were writing wakes us up immediately.
+          // It is cleared before the queue is checked again, so no chunk is
+          // missed. The timeout is only a safety net.
+          m_condition.TimedWait (100000000);
+          m_condition.SetCondition (false);
+        }
+    }
+}
+
+AsyncOutputWriter::ChunkStreamBuf::ChunkStreamBuf (std::ofstream *file)
+  : m_file (file),
+  m_chunk (m_chunkSize)
+{
+  setp (m_chunk.data (), m_chunk.data () + m_chunk.size ());
+}
+
+void
+AsyncOutputWriter::ChunkStreamBuf::HandOver (void)
+{
+  if (pptr () != pbase ())
+    {
+      AsyncOutputWriter::Get ()->Enqueue (m_file, pbase (), pptr ());
+      setp (m_chunk.data (), m_chunk.data () + m_chunk.size ());
+    }
+}
+
+AsyncOutputWriter::ChunkStreamBuf::int_type
+AsyncOutputWriter::ChunkStreamBuf::overflow (int_type c)
+{
+  HandOver ();
+  if (!traits_type::eq_int_type (c, traits_type::eof ()))
+    {
+      *pptr () = traits_type::to_char_type (c);
+      pbump (1);
+    }
+  return traits_type::not_eof (c);
+}
+
+int
+AsyncOutputWriter::ChunkStreamBuf::sync (void)
+{
+  // Flushes are ignored to keep chunks large. The output is handed over
+  // when the chunk is full or when the writer is shut down.
+  return 0;
+}
+
+} // namespace ns3
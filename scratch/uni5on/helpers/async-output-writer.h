@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef ASYNC_OUTPUT_WRITER_H
+#define ASYNC_OUTPUT_WRITER_H
+
+#include <fstream>
+#include <list>
+#include <streambuf>
+#include <vector>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5on
+ * Background writer for output files. Streams created by this writer keep
+ * the output in large memory chunks on the simulation thread, ignoring the
+ * flushes from std::endl. Each full chunk is handed over to a writer thread
+ * that appends it to the file with a single sequential write, so the
+ * simulation event loop is not stalled by file I/O. Pending chunks are
+ * written and files are closed by the Shutdown method. Before forking the
+ * simulation process, the Flush method must be used to write all pending
+ * output and stop the writer thread, which is not inherited by the child
+ * processes. The Restart method starts it again after the fork.
+ *
+ * Output written to files lags behind the simulation by up to one chunk per
+ * file. If the process aborts or crashes before Shutdown is called, up to
+ * 256 KiB of the latest output of each file is lost.
+ */
+class AsyncOutputWriter
+{
+public:
+  /**
+   * Create an output stream for the given file.
+   * \param filename The output filename.
+   * \return The output stream wrapper.
+   */
+  static Ptr<OutputStreamWrapper> CreateStream (std::string filename);
+
+  /**
+   * Write all pending output, stop the writer thread and close the files.
+   * Streams previously created by this writer must not be used anymore.
+   */
+  static void Shutdown (void);
+
+  /**
+   * Write all pending output and stop the writer thread, keeping the files
+   * open. Streams can still be used, but nothing is written until the writer
+   * thread is started again by the Restart method.
+   */
+  static void Flush (void);
+
+  /** Start the writer thread again after a Flush. */
+  static void Restart (void);
+
+private:
+  /** Stream buffer that hands over full chunks to the writer thread. */
+  class ChunkStreamBuf : public std::streambuf
+  {
+  public:
+    /**
+     * Complete constructor.
+     * \param file The output file, written by the writer thread only.
+     */
+    ChunkStreamBuf (std::ofstream *file);
+
+    /** Hand over the chunk filled so far to the writer thread. */
+    void HandOver (void);
+
+  protected:
+    // Inherited from std::streambuf.
+    virtual int_type overflow (int_type c);
+    virtual int sync (void);
+
+  private:
+    std::ofstream    *m_file;           //!< Output file.
+    std::vector<char> m_chunk;          //!< Chunk being filled.
+  };
+
+  /** A chunk of output waiting to be written. */
+  struct Chunk
+  {
+    std::ofstream *file;                //!< Output file.
+    std::string    data;                //!< Output data.
+  };
+
+  /** An output file and its associated stream. */
+  struct Output
+  {
+    std::ofstream  *file;               //!< Output file.
+    ChunkStreamBuf *buffer;             //!< Stream buffer.
+    std::ostream   *stream;             //!< Output stream.
+  };
+
+  AsyncOutputWriter ();                 //!< Default constructor.
+  ~AsyncOutputWriter ();                //!< Default destructor.
+
+  /**
+   * Get the writer instance, starting the writer thread on first use.
+   * \return The writer instance.
+   */
+  static AsyncOutputWriter* Get (void);
+
+  /**
+   * Queue a chunk to be written by the writer thread.
+   * \param file The output file.
+   * \param begin The first output byte.
+   * \param end The past-the-end output byte.
+   */
+  void Enqueue (std::ofstream *file, const char *begin, const char *end);
+
+  /** Stop the writer thread and close the files. */
+  void DoShutdown (void);
+
+  /** Start the writer thread. */
+  void StartThread (void);
+
+  /**
+   * Hand over the pending output and stop the writer thread after all
+   * queued chunks are written.
+   */
+  void StopThread (void);
+
+  /** The writer thread loop. */
+  void Run (void);
+
+  Ptr<SystemThread>   m_thread;         //!< Writer thread.
+  SystemMutex         m_mutex;          //!< Queue mutex.
+  SystemCondition     m_condition;      //!< Queue condition.
+  std::list<Chunk>    m_queue;          //!< Chunks to be written.
+  bool                m_stop;           //!< Stop the writer thread.
+  bool                m_shutdown;       //!< Files closed.
+  std::vector<Output> m_outputs;        //!< Open output files.
+
+  static const size_t m_chunkSize;      //!< Chunk size in bytes.
+};
+
+} // namespace ns3
+#endif // ASYNC_OUTPUT_WRITER_H
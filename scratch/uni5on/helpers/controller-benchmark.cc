@@ -0,0 +1,618 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ns3/csma-module.h>
+#include <ns3/internet-module.h>
+#include <ns3/lte-module.h>
+#include <ns3/ofswitch13-module.h>
+#include "controller-benchmark.h"
+#include "../infrastructure/backhaul-controller.h"
+#include "../infrastructure/ring-network.h"
+#include "../logical/slice-controller.h"
+#include "../logical/slice-network.h"
+#include "../logical/uni5on-mme.h"
+#include "../metadata/enb-info.h"
+#include "../metadata/ue-info.h"
+
+using namespace std;
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ControllerBenchmark");
+NS_OBJECT_ENSURE_REGISTERED (ControllerBenchmark);
+
+ControllerBenchmark::ControllerBenchmark ()
+  : m_nAttached (0),
+  m_msgCount (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Clear operation metadata.
+  memset (m_ops, 0, sizeof (OperationMetadata) * N_OPERATIONS);
+
+  m_opRng = CreateObject<UniformRandomVariable> ();
+}
+
+ControllerBenchmark::~ControllerBenchmark ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+ControllerBenchmark::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ControllerBenchmark")
+    .SetParent<Object> ()
+    .AddConstructor<ControllerBenchmark> ()
+    .AddAttribute ("Operations",
+                   "The number of benchmark operations, after UE attaches.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&ControllerBenchmark::m_operations),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("StartTime",
+                   "The benchmark start time, after OpenFlow connections.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&ControllerBenchmark::m_startTime),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("PathSwitchProb",
+                   "The probability of a S1-AP path switch operation.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&ControllerBenchmark::m_switchProb),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("LoadBalProb",
+                   "The probability of a P-GW TFT load balancing operation.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&ControllerBenchmark::m_loadBalProb),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("BenchmarkFilename",
+                   "Filename for controller benchmark results.",
+                   StringValue ("controller-benchmark"),
+                   MakeStringAccessor (&ControllerBenchmark::m_filename),
+                   MakeStringChecker ())
+
+    // Synthetic network.
+    .AddAttribute ("NumSwitches",
+                   "The number of OpenFlow switches in the backhaul ring.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (5),
+                   MakeUintegerAccessor (&ControllerBenchmark::m_numSwitches),
+                   MakeUintegerChecker<uint16_t> (3))
+    .AddAttribute ("NumEnbs",
+                   "The number of eNBs attached to the backhaul.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (12),
+                   MakeUintegerAccessor (&ControllerBenchmark::m_numEnbs),
+                   MakeUintegerChecker<uint16_t> (1))
+    .AddAttribute ("NumUes",
+                   "The number of UEs for each slice.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&ControllerBenchmark::m_numUes),
+                   MakeUintegerChecker<uint32_t> (1, 4095))
+    .AddAttribute ("BearersPerUe",
+                   "The number of dedicated bearers for each UE.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&ControllerBenchmark::m_numBearers),
+                   MakeUintegerChecker<uint16_t> (1, 10))
+  ;
+  return tid;
+}
+
+void
+ControllerBenchmark::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_opRng = 0;
+  m_mme = 0;
+  m_backhaul = 0;
+  m_enbNodes = NodeContainer ();
+  m_ues.clear ();
+  m_idle.clear ();
+  m_active.clear ();
+  m_defaults.clear ();
+  for (int s = 0; s < N_SLICE_IDS; s++)
+    {
+      m_controllers [s] = 0;
+      m_networks [s] = 0;
+    }
+  Object::DoDispose ();
+}
+
+void
+ControllerBenchmark::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ABORT_MSG_IF (m_switchProb + m_loadBalProb > 1,
+                   "Invalid benchmark operation probabilities.");
+
+  StringValue stringValue;
+  GlobalValue::GetValueByName ("OutputPrefix", stringValue);
+  std::string prefix = stringValue.Get ();
+  SetAttribute ("BenchmarkFilename", StringValue (prefix + m_filename));
+
+  // Create the synthetic UNI5ON infrastructure, without the LTE radio.
+  m_mme = CreateObject<Uni5onMme> ();
+  m_backhaul = CreateObjectWithAttributes<RingNetwork> (
+      "NumRingSwitches", UintegerValue (m_numSwitches));
+
+  Ptr<BackhaulController> backhaulCtrl = m_backhaul->GetControllerApp ();
+  ApplicationContainer sliceControllers;
+
+  // Create the logical slice controllers and networks, splitting the
+  // backhaul bandwidth evenly among slices. The slice addressing follows the
+  // ScenarioHelper, but slice networks here have no UE nodes.
+  int quota = 100 / GetNSlices ();
+  for (SliceId slice : GetSliceIds ())
+    {
+      uint32_t netId = slice <= SliceId::MTC ? 2 - slice : slice + 1;
+      Ipv4Address ueAddr ((7U << 24) | (netId << 16));
+      Ipv4Address webAddr ((8U << 24) | (netId << 16));
+
+      m_controllers [slice] = CreateObjectWithAttributes<SliceController> (
+          "SliceId", EnumValue (slice),
+          "Mme", PointerValue (m_mme),
+          "BackhaulCtrl", PointerValue (backhaulCtrl),
+          "Quota", IntegerValue (quota));
+      sliceControllers.Add (m_controllers [slice]);
+
+      ObjectFactory networkFac;
+      networkFac.SetTypeId (SliceNetwork::GetTypeId ());
+      networkFac.Set ("SliceId", EnumValue (slice));
+      networkFac.Set ("SliceCtrl", PointerValue (m_controllers [slice]));
+      networkFac.Set ("BackhaulNet", PointerValue (m_backhaul));
+      networkFac.Set ("NumUes", UintegerValue (0));
+      networkFac.Set ("UeAddress", Ipv4AddressValue (ueAddr));
+      networkFac.Set ("UeMask", Ipv4MaskValue ("255.255.0.0"));
+      networkFac.Set ("WebAddress", Ipv4AddressValue (webAddr));
+      networkFac.Set ("WebMask", Ipv4MaskValue ("255.255.0.0"));
+      m_networks [slice] = networkFac.Create<SliceNetwork> ();
+    }
+
+  // Notify the backhaul controller of the slice controllers.
+  backhaulCtrl->NotifySlicesBuilt (sliceControllers);
+
+  CreateEnbs ();
+  CreateUes ();
+
+  // Count the OpenFlow messages sent by all controllers.
+  backhaulCtrl->TraceConnectWithoutContext (
+    "MsgTx", MakeCallback (&ControllerBenchmark::NotifyMsgTx, this));
+  for (SliceId slice : GetSliceIds ())
+    {
+      m_controllers [slice]->TraceConnectWithoutContext (
+        "MsgTx", MakeCallback (&ControllerBenchmark::NotifyMsgTx, this));
+    }
+
+  Simulator::Schedule (m_startTime, &ControllerBenchmark::Run, this);
+
+  Object::NotifyConstructionCompleted ();
+}
+
+std::string
+ControllerBenchmark::OperationStr (Operation op)
+{
+  switch (op)
+    {
+    case Operation::ATTACH:
+      return "Attach";
+    case Operation::REQUEST:
+      return "Request";
+    case Operation::RELEASE:
+      return "Release";
+    case Operation::PATHSWITCH:
+      return "PathSwitch";
+    case Operation::LOADBAL:
+      return "LoadBal";
+    default:
+      NS_LOG_ERROR ("Invalid benchmark operation.");
+      return std::string ();
+    }
+}
+
+void
+ControllerBenchmark::CreateEnbs (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The synthetic eNBs have only the S1-U interface attached to the backhaul
+  // network, and no eNB application. Cell IDs start at 1 in the LTE module.
+  m_enbNodes.Create (m_numEnbs);
+  InternetStackHelper internet;
+  internet.Install (m_enbNodes);
+  for (uint16_t cellId = 1; cellId <= m_numEnbs; cellId++)
+    {
+      Ptr<Node> enb = m_enbNodes.Get (cellId - 1);
+      Names::Add ("enb" + std::to_string (cellId), enb);
+
+      uint16_t infraSwIdx = m_backhaul->GetEnbSwIdx (cellId);
+      Ptr<CsmaNetDevice> enbS1uDev;
+      Ptr<OFSwitch13Port> infraSwPort;
+      std::tie (enbS1uDev, infraSwPort) = m_backhaul->AttachEpcNode (
+          enb, infraSwIdx, LteIface::S1);
+      Ipv4Address enbS1uAddr = Ipv4AddressHelper::GetAddress (enbS1uDev);
+      NS_LOG_DEBUG ("eNB cell ID " << cellId << " at switch index " <<
+                    infraSwIdx << " with IP " << enbS1uAddr);
+
+      // Saving eNB metadata.
+      CreateObject<EnbInfo> (
+        cellId, enbS1uAddr, infraSwIdx, infraSwPort->GetPortNo (), 0);
+    }
+}
+
+void
+ControllerBenchmark::CreateUes (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The synthetic UEs are only metadata, with a default bearer and some
+  // dedicated bearers using the same packet filters from the ScenarioHelper
+  // and TrafficHelper. IMSIs start at 1 in the LTE module.
+  uint64_t imsi = 0;
+  for (SliceId slice : GetSliceIds ())
+    {
+      Ptr<NetDevice> webDev = m_networks [slice]->GetWebNode ()->GetDevice (1);
+      Ipv4Address webAddr = Ipv4AddressHelper::GetAddress (webDev);
+      Ipv4Mask webMask = Ipv4AddressHelper::GetMask (webDev);
+      for (uint32_t u = 0; u < m_numUes; u++)
+        {
+          Ptr<UeInfo> ueInfo = CreateObject<UeInfo> (
+              ++imsi, m_networks [slice]->AllocateUeAddress (),
+              m_controllers [slice]);
+          m_ues.push_back (ueInfo);
+
+          // The default bearer with TCP and UDP filters for the UE address.
+          UeInfo::BearerInfo bearerInfo;
+          bearerInfo.bearer = EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT);
+          bearerInfo.tft = Create<EpcTft> ();
+
+          EpcTft::PacketFilter filterTcp;
+          filterTcp.protocol = TcpL4Protocol::PROT_NUMBER;
+          filterTcp.localAddress = ueInfo->GetAddr ();
+          bearerInfo.tft->Add (filterTcp);
+
+          EpcTft::PacketFilter filterUdp;
+          filterUdp.protocol = UdpL4Protocol::PROT_NUMBER;
+          filterUdp.localAddress = ueInfo->GetAddr ();
+          bearerInfo.tft->Add (filterUdp);
+          ueInfo->AddBearerInfo (bearerInfo);
+
+          // Dedicated bearers alternate between GBR and Non-GBR ones.
+          for (uint16_t b = 0; b < m_numBearers; b++)
+            {
+              if (b % 2 == 0)
+                {
+                  GbrQosInformation qos;
+                  qos.gbrDl = 45000;  // 45 Kbps
+                  qos.gbrUl = 45000;  // 45 Kbps
+                  bearerInfo.bearer = EpsBearer (EpsBearer::GBR_CONV_VOICE,
+                                                 qos);
+                }
+              else
+                {
+                  bearerInfo.bearer =
+                    EpsBearer (EpsBearer::NGBR_VIDEO_TCP_PREMIUM);
+                }
+
+              EpcTft::PacketFilter filter;
+              filter.direction = EpcTft::BIDIRECTIONAL;
+              filter.protocol = UdpL4Protocol::PROT_NUMBER;
+              filter.remoteAddress = webAddr;
+              filter.remoteMask = webMask;
+              filter.remotePortStart = 10000 + b;
+              filter.remotePortEnd = 10000 + b;
+              filter.localAddress = ueInfo->GetAddr ();
+              filter.localMask = Ipv4Mask ("255.255.255.255");
+              bearerInfo.tft = Create<EpcTft> ();
+              bearerInfo.tft->Add (filter);
+              ueInfo->AddBearerInfo (bearerInfo);
+            }
+        }
+    }
+  NS_LOG_INFO ("Created " << m_ues.size () << " synthetic UEs with " <<
+               m_numBearers << " dedicated bearers each.");
+}
+
+void
+ControllerBenchmark::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  int64_t rssBefore = GetResidentBytes ();
+  auto benchStart = std::chrono::steady_clock::now ();
+
+  // Attach all UEs, installing their default bearers.
+  while (m_nAttached < m_ues.size ())
+    {
+      RunOperation (Operation::ATTACH);
+    }
+
+  // Collect the bearers available for the benchmark.
+  RoutingInfoList_t bearerList;
+  RoutingInfo::GetList (bearerList);
+  for (auto const &rInfo : bearerList)
+    {
+      if (rInfo->IsDefault ())
+        {
+          if (rInfo->IsGwInstalled ())
+            {
+              m_defaults.push_back (rInfo);
+            }
+        }
+      else if (!rInfo->IsActive () && !rInfo->IsGwInstalled ())
+        {
+          m_idle.push_back (rInfo);
+        }
+    }
+  NS_ABORT_MSG_IF (m_idle.empty () || m_defaults.empty (),
+                   "No bearers available for the controller benchmark.");
+  NS_LOG_INFO ("Running controller benchmark with " << m_idle.size () <<
+               " dedicated bearers and " << m_defaults.size () << " UEs.");
+
+  for (uint32_t i = 0; i < m_operations; i++)
+    {
+      // Select the operation. Requests and releases share the remaining
+      // probability, respecting the available bearers.
+      double rand = m_opRng->GetValue ();
+      if (rand < m_switchProb)
+        {
+          RunOperation (Operation::PATHSWITCH);
+        }
+      else if (rand < m_switchProb + m_loadBalProb)
+        {
+          RunOperation (Operation::LOADBAL);
+        }
+      else if (m_active.empty ()
+               || (!m_idle.empty () && m_opRng->GetInteger (0, 1) == 0))
+        {
+          RunOperation (Operation::REQUEST);
+        }
+      else
+        {
+          RunOperation (Operation::RELEASE);
+        }
+    }
+  std::chrono::duration<double> benchSecs =
+    std::chrono::steady_clock::now () - benchStart;
+  int64_t rssAfter = GetResidentBytes ();
+
+  // Print the results in the output file and in the standard output.
+  std::ofstream file (m_filename + ".log");
+  PrintResults (file, benchSecs.count (), rssBefore, rssAfter);
+  PrintResults (std::cout, benchSecs.count (), rssBefore, rssAfter);
+
+  Simulator::Stop ();
+}
+
+void
+ControllerBenchmark::RunOperation (Operation op)
+{
+  NS_LOG_FUNCTION (this << op);
+
+  bool success = false;
+  uint64_t msgsBefore = m_msgCount;
+  auto opStart = std::chrono::steady_clock::now ();
+  switch (op)
+    {
+    case Operation::ATTACH:
+      success = DoAttach ();
+      break;
+    case Operation::REQUEST:
+      success = DoRequest ();
+      break;
+    case Operation::RELEASE:
+      success = DoRelease ();
+      break;
+    case Operation::PATHSWITCH:
+      success = DoPathSwitch ();
+      break;
+    case Operation::LOADBAL:
+      success = DoLoadBalancing ();
+      break;
+    }
+  std::chrono::duration<double> opSecs =
+    std::chrono::steady_clock::now () - opStart;
+
+  OperationMetadata &opData = m_ops [op];
+  opData.count++;
+  opData.failed += success ? 0 : 1;
+  opData.msgs += m_msgCount - msgsBefore;
+  opData.wallSecs += opSecs.count ();
+}
+
+bool
+ControllerBenchmark::DoAttach (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Each UE gets its own eNB UE S1-AP ID, with eNBs in a round-robin fashion.
+  Ptr<UeInfo> ueInfo = m_ues.at (m_nAttached++);
+  uint16_t cellId = 1 + (m_nAttached % m_numEnbs);
+  uint64_t imsi = ueInfo->GetImsi ();
+  m_mme->GetS1apSapMme ()->InitialUeMessage (
+    imsi, static_cast<uint16_t> (imsi), imsi, cellId);
+  return ueInfo->GetEnbCellId () == cellId;
+}
+
+bool
+ControllerBenchmark::DoRequest (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t idx = m_opRng->GetInteger (0, m_idle.size () - 1);
+  Ptr<RoutingInfo> rInfo = m_idle.at (idx);
+  Ptr<UeInfo> ueInfo = rInfo->GetUeInfo ();
+
+  bool success = ueInfo->GetSliceCtrl ()->DedicatedBearerRequest (
+      rInfo->GetEpsBearer (), ueInfo->GetImsi (), rInfo->GetTeid ());
+  if (success)
+    {
+      rInfo->SetActive (true);
+      m_idle [idx] = m_idle.back ();
+      m_idle.pop_back ();
+      m_active.push_back (rInfo);
+    }
+  return success;
+}
+
+bool
+ControllerBenchmark::DoRelease (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t idx = m_opRng->GetInteger (0, m_active.size () - 1);
+  Ptr<RoutingInfo> rInfo = m_active.at (idx);
+  Ptr<UeInfo> ueInfo = rInfo->GetUeInfo ();
+
+  rInfo->SetActive (false);
+  bool success = ueInfo->GetSliceCtrl ()->DedicatedBearerRelease (
+      rInfo->GetEpsBearer (), ueInfo->GetImsi (), rInfo->GetTeid ());
+  m_active [idx] = m_active.back ();
+  m_active.pop_back ();
+  m_idle.push_back (rInfo);
+  return success;
+}
+
+bool
+ControllerBenchmark::DoPathSwitch (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t idx = m_opRng->GetInteger (0, m_defaults.size () - 1);
+  Ptr<UeInfo> ueInfo = m_defaults.at (idx)->GetUeInfo ();
+
+  // Move the UE to the eNB with the next cell ID, wrapping around to the
+  // first one.
+  uint16_t dstCellId = 1 + (ueInfo->GetEnbCellId () % m_numEnbs);
+  if (dstCellId == ueInfo->GetEnbCellId ())
+    {
+      return false;
+    }
+
+  // The target eNB requests the path switch for all UE bearers, keeping the
+  // bearer TEIDs, as the Uni5onEnbApplication does after the X2 handover.
+  Ptr<EnbInfo> dstEnbInfo = EnbInfo::GetPointer (dstCellId);
+  std::list<EpcS1apSapMme::ErabSwitchedInDownlinkItem> erabList;
+  for (auto const &bit : ueInfo->GetBearerInfoList ())
+    {
+      EpcS1apSapMme::ErabSwitchedInDownlinkItem erab;
+      erab.erabId = bit.bearerId;
+      erab.enbTransportLayerAddress = dstEnbInfo->GetS1uAddr ();
+      erab.enbTeid = ueInfo->GetTeid (bit.bearerId);
+      erabList.push_back (erab);
+    }
+  m_mme->GetS1apSapMme ()->PathSwitchRequest (
+    ueInfo->GetEnbUeS1Id (), ueInfo->GetMmeUeS1Id (), dstCellId, erabList);
+  return ueInfo->GetEnbCellId () == dstCellId;
+}
+
+bool
+ControllerBenchmark::DoLoadBalancing (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Each call schedules another periodic load balancing check on this
+  // controller, but the simulation stops at the end of the benchmark.
+  uint32_t idx = m_opRng->GetInteger (0, m_defaults.size () - 1);
+  m_defaults.at (idx)->GetUeInfo ()->GetSliceCtrl ()->PgwTftLoadBalancing ();
+  return true;
+}
+
+void
+ControllerBenchmark::NotifyMsgTx (uint64_t dpId, std::string type,
+                                  uint32_t length, int64_t wallNs)
+{
+  NS_LOG_FUNCTION (this << dpId << type << length << wallNs);
+
+  m_msgCount++;
+}
+
+void
+ControllerBenchmark::PrintResults (std::ostream &os, double wallSecs,
+                                   int64_t rssBefore, int64_t rssAfter) const
+{
+  NS_LOG_FUNCTION (this);
+
+  // Only the messages sent by controllers within each operation are counted.
+  // Switch replies are processed asynchronously, after the benchmark.
+  os << "Controller benchmark results with " << m_numSwitches
+     << " backhaul switches, " << m_numEnbs << " eNBs, " << m_ues.size ()
+     << " UEs, and " << m_numBearers << " dedicated bearers per UE"
+     << std::endl;
+  os << right << fixed << setprecision (3)
+     << " " << setw (10) << "Operation"
+     << " " << setw (9)  << "Count"
+     << " " << setw (9)  << "Failed"
+     << " " << setw (11) << "WallMs"
+     << " " << setw (11) << "OpsPerSec"
+     << " " << setw (9)  << "UsPerOp"
+     << " " << setw (9)  << "MsgsTx"
+     << " " << setw (9)  << "MsgsPerOp"
+     << std::endl;
+
+  uint32_t total = 0;
+  uint64_t totalMsgs = 0;
+  for (int o = 0; o < N_OPERATIONS; o++)
+    {
+      const OperationMetadata &opData = m_ops [o];
+      total += opData.count;
+      totalMsgs += opData.msgs;
+      os << " " << setw (10) << OperationStr (static_cast<Operation> (o))
+         << " " << setw (9)  << opData.count
+         << " " << setw (9)  << opData.failed
+         << " " << setw (11) << opData.wallSecs * 1000
+         << " " << setw (11)
+         << (opData.wallSecs > 0 ? opData.count / opData.wallSecs : 0)
+         << " " << setw (9)
+         << (opData.count ? opData.wallSecs * 1e6 / opData.count : 0)
+         << " " << setw (9)  << opData.msgs
+         << " " << setw (9)
+         << (opData.count ? static_cast<double> (opData.msgs) / opData.count
+             : 0)
+         << std::endl;
+    }
+  os << " " << setw (10) << "Total"
+     << " " << setw (9)  << total
+     << " " << setw (9)  << "-"
+     << " " << setw (11) << wallSecs * 1000
+     << " " << setw (11) << (wallSecs > 0 ? total / wallSecs : 0)
+     << " " << setw (9)  << (total ? wallSecs * 1e6 / total : 0)
+     << " " << setw (9)  << totalMsgs
+     << " " << setw (9)
+     << (total ? static_cast<double> (totalMsgs) / total : 0)
+     << std::endl;
+
+  // The resident set size covers the whole process, not only the controllers.
+  os << "Resident memory: " << rssAfter / 1024 << " KiB ("
+     << (rssAfter - rssBefore) / 1024 << " KiB during benchmark)."
+     << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,198 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef CONTROLLER_BENCHMARK_H
+#define CONTROLLER_BENCHMARK_H
+
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include "../metadata/routing-info.h"
+#include "../uni5on-common.h"
+
+namespace ns3 {
+
+class BackhaulNetwork;
+class SliceController;
+class SliceNetwork;
+class Uni5onMme;
+
+/**
+ * \ingroup uni5on
+ * Micro-benchmark for the slice and backhaul controllers. This benchmark
+ * builds its own synthetic network, with an OpenFlow ring backhaul, the
+ * logical slices, and eNB nodes attached to the backhaul, but without any
+ * LTE radio. UEs exist only as metadata. At the start time, this benchmark
+ * attaches all UEs through the MME and then drives a configurable churn of
+ * dedicated bearer requests and releases, S1-AP path switches, and P-GW TFT
+ * load balancing operations, measuring the wall-clock time and the number of
+ * OpenFlow messages sent by controllers on each operation type.
+ *
+ * A path switch goes through the MME and the slice controller just like the
+ * last step of an X2 handover, so it measures the core network cost of the
+ * handover, but not the radio part of it.
+ */
+class ControllerBenchmark : public Object
+{
+public:
+  ControllerBenchmark ();          //!< Default constructor.
+  virtual ~ControllerBenchmark (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+  // Inherited from ObjectBase.
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  /** The benchmark operation types. */
+  enum Operation
+  {
+    ATTACH = 0,     //!< UE attach, with default and dedicated bearers.
+    REQUEST = 1,    //!< Dedicated bearer request.
+    RELEASE = 2,    //!< Dedicated bearer release.
+    PATHSWITCH = 3, //!< S1-AP path switch to another eNB.
+    LOADBAL = 4     //!< P-GW TFT load balancing.
+  };
+
+  // Total number of valid Operation items.
+  #define N_OPERATIONS (static_cast<int> (Operation::LOADBAL) + 1)
+
+  /** Metadata associated to a benchmark operation type. */
+  struct OperationMetadata
+  {
+    uint32_t count;     //!< Number of operations.
+    uint32_t failed;    //!< Number of failed (blocked) operations.
+    uint64_t msgs;      //!< Number of OpenFlow messages sent.
+    double   wallSecs;  //!< Wall-clock time spent on operations.
+  };
+
+  /**
+   * Get the string representing the given operation type.
+   * \param op The operation type.
+   * \return The operation type string.
+   */
+  static std::string OperationStr (Operation op);
+
+  /** Create the synthetic eNBs. */
+  void CreateEnbs (void);
+
+  /** Create the synthetic UEs with their bearers. */
+  void CreateUes (void);
+
+  /** Run the benchmark and stop the simulation. */
+  void Run (void);
+
+  /**
+   * Run a single operation, updating the operation metadata.
+   * \param op The operation type.
+   */
+  void RunOperation (Operation op);
+
+  /**
+   * Attach the next UE to an eNB, in a round-robin fashion.
+   * \return True if succeeded, false otherwise.
+   */
+  bool DoAttach (void);
+
+  /**
+   * Request a random inactive dedicated bearer.
+   * \return True if succeeded, false otherwise.
+   */
+  bool DoRequest (void);
+
+  /**
+   * Release a random dedicated bearer previously requested by this benchmark.
+   * \return True if succeeded, false otherwise.
+   */
+  bool DoRelease (void);
+
+  /**
+   * Switch the S1-U path of a random UE to the next eNB.
+   * \return True if succeeded, false otherwise.
+   */
+  bool DoPathSwitch (void);
+
+  /**
+   * Run the P-GW TFT load balancing on a random slice controller.
+   * \return True if succeeded, false otherwise.
+   */
+  bool DoLoadBalancing (void);
+
+  /**
+   * Count OpenFlow messages sent by controllers.
+   * \param dpId The datapath ID.
+   * \param type The message type.
+   * \param length The message length.
+   * \param wallNs The wall-clock processing time.
+   */
+  void NotifyMsgTx (uint64_t dpId, std::string type,
+                    uint32_t length, int64_t wallNs);
+
+  /**
+   * Print the benchmark results.
+   * \param os The output stream.
+   * \param wallSecs The total wall-clock time.
+   * \param rssBefore The resident set size before the benchmark.
+   * \param rssAfter The resident set size after the benchmark.
+   */
+  void PrintResults (std::ostream &os, double wallSecs,
+                     int64_t rssBefore, int64_t rssAfter) const;
+
+  uint32_t                    m_operations;   //!< Number of operations.
+  Time                        m_startTime;    //!< Benchmark start time.
+  double                      m_switchProb;   //!< Path switch probability.
+  double                      m_loadBalProb;  //!< Load balancing probability.
+  std::string                 m_filename;     //!< Output filename.
+  uint16_t                    m_numSwitches;  //!< Number of ring switches.
+  uint16_t                    m_numEnbs;      //!< Number of eNBs.
+  uint32_t                    m_numUes;       //!< Number of UEs per slice.
+  uint16_t                    m_numBearers;   //!< Dedicated bearers per UE.
+  Ptr<UniformRandomVariable>  m_opRng;        //!< Operation random stream.
+
+  Ptr<Uni5onMme>              m_mme;          //!< The MME entity.
+  Ptr<BackhaulNetwork>        m_backhaul;     //!< The backhaul network.
+  NodeContainer               m_enbNodes;     //!< The synthetic eNB nodes.
+  std::vector<Ptr<UeInfo> >   m_ues;          //!< The synthetic UEs.
+  uint32_t                    m_nAttached;    //!< Number of attached UEs.
+  uint64_t                    m_msgCount;     //!< OpenFlow messages sent.
+
+  RoutingInfoList_t           m_idle;         //!< Idle dedicated bearers.
+  RoutingInfoList_t           m_active;       //!< Active dedicated bearers.
+  RoutingInfoList_t           m_defaults;     //!< Installed default bearers.
+
+  /** The logical slice controllers. */
+  Ptr<SliceController>        m_controllers [N_SLICE_IDS];
+
+  /** The logical slice networks. */
+  Ptr<SliceNetwork>           m_networks [N_SLICE_IDS];
+
+  /** Metadata for each operation type. */
+  OperationMetadata           m_ops [N_OPERATIONS];
+};
+
+} // namespace ns3
+#endif // CONTROLLER_BENCHMARK_H
@@ -0,0 +1,247 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "progress-reporter.h"
+#include "../metadata/routing-info.h"
+
+using namespace std;
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ProgressReporter");
+NS_OBJECT_ENSURE_REGISTERED (ProgressReporter);
+
+ProgressReporter::ProgressReporter ()
+  : m_lastEvents (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ProgressReporter::~ProgressReporter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+ProgressReporter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ProgressReporter")
+    .SetParent<Object> ()
+    .AddConstructor<ProgressReporter> ()
+    .AddAttribute ("Interval",
+                   "The simulation time interval between reports. When the "
+                   "wall-clock interval is set, this is the interval between "
+                   "wall-clock checks.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&ProgressReporter::m_interval),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("WallInterval",
+                   "The wall-clock time interval between reports "
+                   "(zero to report on simulation time interval).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ProgressReporter::m_wallInterval),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("ProgressFilename",
+                   "Filename for simulation progress reports.",
+                   StringValue ("progress"),
+                   MakeStringAccessor (&ProgressReporter::m_filename),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+void
+ProgressReporter::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_wrapper = 0;
+  Object::DoDispose ();
+}
+
+void
+ProgressReporter::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  StringValue stringValue;
+  GlobalValue::GetValueByName ("OutputPrefix", stringValue);
+  std::string prefix = stringValue.Get ();
+  SetAttribute ("ProgressFilename", StringValue (prefix + m_filename));
+
+  TimeValue timeValue;
+  GlobalValue::GetValueByName ("SimTime", timeValue);
+  m_stopTime = timeValue.Get ();
+
+  // Create the output file for progress reports.
+  m_wrapper = Create<OutputStreamWrapper> (
+      m_filename + ".log", std::ios::out);
+
+  // Print the header in output file.
+  *m_wrapper->GetStream ()
+    << boolalpha << right << fixed << setprecision (3)
+    << " " << setw (8)  << "TimeSec"
+    << " " << setw (9)  << "WallSec"
+    << " " << setw (8)  << "SimRate"
+    << " " << setw (11) << "EvtRate"
+    << " " << setw (13) << "Events"
+    << " " << setw (9)  << "Queue"
+    << " " << setw (9)  << "RssMiB"
+    << " " << setw (8)  << "Bearers"
+    << " " << setw (9)  << "EtaSec"
+    << std::endl;
+
+  m_firstWall = m_lastWall = std::chrono::steady_clock::now ();
+  m_firstSim = m_lastSim = Simulator::Now ();
+  m_lastEvents = GetEventCount ();
+  Simulator::ScheduleNow (&ProgressReporter::Report, this);
+
+  Object::NotifyConstructionCompleted ();
+}
+
+void
+ProgressReporter::CheckProgress (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::chrono::duration<double> wallSecs =
+    std::chrono::steady_clock::now () - m_lastWall;
+  if (wallSecs.count () >= m_wallInterval.GetSeconds ())
+    {
+      Report ();
+      return;
+    }
+  Simulator::Schedule (m_interval, &ProgressReporter::CheckProgress, this);
+}
+
+void
+ProgressReporter::Report (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  WallTime_t nowWall = std::chrono::steady_clock::now ();
+  Time nowSim = Simulator::Now ();
+  uint64_t nowEvents = GetEventCount ();
+
+  // Rates since the last report.
+  double wallSecs =
+    std::chrono::duration<double> (nowWall - m_lastWall).count ();
+  double simRate = 0;
+  double evtRate = 0;
+  if (wallSecs > 0)
+    {
+      simRate = (nowSim - m_lastSim).GetSeconds () / wallSecs;
+      evtRate = (nowEvents - m_lastEvents) / wallSecs;
+    }
+
+  // The estimated time to complete uses the average simulation speed since
+  // the first report, which is more stable than the last interval speed.
+  double totalWall =
+    std::chrono::duration<double> (nowWall - m_firstWall).count ();
+  double totalSim = (nowSim - m_firstSim).GetSeconds ();
+  double etaSecs = 0;
+  if (totalSim > 0 && m_stopTime > nowSim)
+    {
+      etaSecs = (m_stopTime - nowSim).GetSeconds () * totalWall / totalSim;
+    }
+
+  uint32_t queue = GetPendingEventCount ();
+  double rssMiB = static_cast<double> (GetResidentBytes ()) / 1048576;
+  uint32_t bearers = GetActiveBearers ();
+
+  // Format the report in a local stream to keep the std::cout flags.
+  std::ostringstream report;
+  report << "Current simulation time: +" << fixed << setprecision (1)
+         << nowSim.GetSeconds () << "s"
+         << " speed " << setprecision (2) << simRate << "x"
+         << " events/s " << setprecision (0) << evtRate
+         << " queue " << queue
+         << " rss " << rssMiB << "MiB"
+         << " bearers " << bearers
+         << " eta " << etaSecs << "s";
+  std::cout << report.str () << std::endl;
+
+  *m_wrapper->GetStream ()
+    << " " << setw (8)  << nowSim.GetSeconds ()
+    << " " << setw (9)  << totalWall
+    << " " << setw (8)  << simRate
+    << " " << setw (11) << evtRate
+    << " " << setw (13) << nowEvents
+    << " " << setw (9)  << queue
+    << " " << setw (9)  << rssMiB
+    << " " << setw (8)  << bearers
+    << " " << setw (9)  << etaSecs
+    << std::endl;
+
+  m_lastWall = nowWall;
+  m_lastSim = nowSim;
+  m_lastEvents = nowEvents;
+
+  if (m_wallInterval.IsStrictlyPositive ())
+    {
+      Simulator::Schedule (m_interval, &ProgressReporter::CheckProgress, this);
+    }
+  else
+    {
+      Simulator::Schedule (m_interval, &ProgressReporter::Report, this);
+    }
+}
+
+uint64_t
+ProgressReporter::GetEventCount (void)
+{
+  // Only the default simulator implementation (and the profiling one, which
+  // extends it) keeps the event counters.
+  Ptr<DefaultSimulatorImpl> impl =
+    DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  return impl ? impl->GetEventCount () : 0;
+}
+
+uint32_t
+ProgressReporter::GetPendingEventCount (void)
+{
+  Ptr<DefaultSimulatorImpl> impl =
+    DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  return impl ? impl->GetPendingEventCount () : 0;
+}
+
+uint32_t
+ProgressReporter::GetActiveBearers (void)
+{
+  RoutingInfoList_t bearerList;
+  RoutingInfo::GetList (bearerList);
+
+  uint32_t active = 0;
+  for (auto const &rInfo : bearerList)
+    {
+      if (rInfo->IsActive ())
+        {
+          active++;
+        }
+    }
+  return active;
+}
+
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef PROGRESS_REPORTER_H
+#define PROGRESS_REPORTER_H
+
+#include <chrono>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include "../uni5on-common.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5on
+ * Periodic report of the simulation progress and performance. Each report
+ * includes the current simulation time, the simulation speed (simulated
+ * seconds per wall-clock second), the number of processed events per
+ * wall-clock second, the event queue size, the process resident set size,
+ * the number of active bearers and the estimated time to complete the
+ * simulation. Reports are printed to the standard output and saved into a
+ * machine-readable file.
+ */
+class ProgressReporter : public Object
+{
+public:
+  ProgressReporter ();          //!< Default constructor.
+  virtual ~ProgressReporter (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+  // Inherited from ObjectBase.
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  /** Check the wall-clock and report the progress when it's time to. */
+  void CheckProgress (void);
+
+  /** Print the progress report and update the last report metadata. */
+  void Report (void);
+
+  /**
+   * Get the number of events processed so far.
+   * \return The number of events, or zero when not available.
+   */
+  static uint64_t GetEventCount (void);
+
+  /**
+   * Get the number of events waiting in the event queue.
+   * \return The number of events, or zero when not available.
+   */
+  static uint32_t GetPendingEventCount (void);
+
+  /**
+   * Get the number of active bearers.
+   * \return The number of active bearers.
+   */
+  static uint32_t GetActiveBearers (void);
+
+  /** A wall-clock time point. */
+  typedef std::chrono::steady_clock::time_point WallTime_t;
+
+  Time                        m_interval;       //!< Simulation interval.
+  Time                        m_wallInterval;   //!< Wall-clock interval.
+  std::string                 m_filename;       //!< Output filename.
+  Ptr<OutputStreamWrapper>    m_wrapper;        //!< Output file wrapper.
+  Time                        m_stopTime;       //!< Simulation stop time.
+
+  // Metadata from the first and last reports.
+  WallTime_t                  m_firstWall;      //!< First report wall time.
+  Time                        m_firstSim;       //!< First report sim time.
+  WallTime_t                  m_lastWall;       //!< Last report wall time.
+  Time                        m_lastSim;        //!< Last report sim time.
+  uint64_t                    m_lastEvents;     //!< Last report event count.
+};
+
+} // namespace ns3
+#endif // PROGRESS_REPORTER_H
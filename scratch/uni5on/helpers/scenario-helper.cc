@@ -21,12 +21,16 @@
 #include <ns3/csma-module.h>
 #include "scenario-helper.h"
 #include "traffic-helper.h"
+#include "../infrastructure/abstract-enb-net-device.h"
+#include "../infrastructure/abstract-ue-net-device.h"
 #include "../infrastructure/backhaul-controller.h"
+#include "../infrastructure/backhaul-network.h"
 #include "../infrastructure/radio-network.h"
 #include "../infrastructure/ring-network.h"
 #include "../infrastructure/uni5on-enb-application.h"
 #include "../logical/slice-controller.h"
 #include "../logical/slice-network.h"
+#include "../logical/timer-wheel.h"
 #include "../logical/uni5on-mme.h"
 #include "../metadata/enb-info.h"
 #include "../metadata/ue-info.h"
@@ -36,22 +40,72 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("ScenarioHelper");
 NS_OBJECT_ENSURE_REGISTERED (ScenarioHelper);
 
+/**
+ * Attribute accessor for the object factory of a logical slice, stored in
+ * one of the ScenarioHelper arrays of factories indexed by slice ID.
+ */
+class ScenarioHelper::SliceFactoryAccessor : public AttributeAccessor
+{
+public:
+  /**
+   * Complete constructor.
+   * \param member The array of factories.
+   * \param slice The slice ID.
+   */
+  SliceFactoryAccessor (SliceFactories_t ScenarioHelper::*member,
+                        SliceId slice)
+    : m_member (member),
+    m_slice (slice)
+  {
+  }
+
+  // Inherited from AttributeAccessor.
+  bool Set (ObjectBase *object, const AttributeValue &value) const
+  {
+    ScenarioHelper *helper = dynamic_cast<ScenarioHelper*> (object);
+    const ObjectFactoryValue *factory =
+      dynamic_cast<const ObjectFactoryValue*> (&value);
+    if (!helper || !factory)
+      {
+        return false;
+      }
+    (helper->*m_member)[m_slice] = factory->Get ();
+    return true;
+  }
+  bool Get (const ObjectBase *object, AttributeValue &value) const
+  {
+    const ScenarioHelper *helper =
+      dynamic_cast<const ScenarioHelper*> (object);
+    ObjectFactoryValue *factory = dynamic_cast<ObjectFactoryValue*> (&value);
+    if (!helper || !factory)
+      {
+        return false;
+      }
+    factory->Set ((helper->*m_member)[m_slice]);
+    return true;
+  }
+  bool HasGetter (void) const
+  {
+    return true;
+  }
+  bool HasSetter (void) const
+  {
+    return true;
+  }
+
+private:
+  SliceFactories_t ScenarioHelper::*m_member; //!< The array of factories.
+  SliceId                           m_slice;  //!< The slice ID.
+};
+
 ScenarioHelper::ScenarioHelper ()
   : m_pcapConfig (0),
   m_backhaul (0),
   m_radio (0),
   m_mme (0),
-  m_htcController (0),
-  m_htcNetwork (0),
-  m_htcTraffic (0),
-  m_mtcController (0),
-  m_mtcNetwork (0),
-  m_mtcTraffic (0),
-  m_tmpController (0),
-  m_tmpNetwork (0),
-  m_tmpTraffic (0),
   m_admissionStats (0),
   m_backhaulStats (0),
+  m_controlStats (0),
   m_lteRrcStats (0),
   m_pgwTftStats (0),
   m_trafficStats (0)
@@ -67,54 +121,68 @@ ScenarioHelper::~ScenarioHelper ()
 TypeId
 ScenarioHelper::GetTypeId (void)
 {
-  static TypeId tid = TypeId ("ns3::ScenarioHelper")
+  static TypeId tid = AddSliceAttributes (TypeId ("ns3::ScenarioHelper")
     .SetParent<EpcHelper> ()
-    .AddAttribute ("HtcController", "The HTC slice controller configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_htcControllerFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("HtcSlice", "The HTC slice network configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_htcNetworkFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("HtcTraffic", "The HTC slice traffic configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_htcTrafficFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("MtcController", "The MTC slice controller configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_mtcControllerFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("MtcSlice", "The MTC slice network configuration.",
+    .AddAttribute ("Backhaul", "The backhaul network configuration "
+                   "(defaults to the ring backhaul network).",
                    ObjectFactoryValue (ObjectFactory ()),
                    MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_mtcNetworkFac),
+                     &ScenarioHelper::m_backhaulFac),
                    MakeObjectFactoryChecker ())
-    .AddAttribute ("MtcTraffic", "The MTC slice traffic configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_mtcTrafficFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("TmpController", "The TMP slice controller configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_tmpControllerFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("TmpSlice", "The TMP slice network configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_tmpNetworkFac),
-                   MakeObjectFactoryChecker ())
-    .AddAttribute ("TmpTraffic", "The TMP slice traffic configuration.",
-                   ObjectFactoryValue (ObjectFactory ()),
-                   MakeObjectFactoryAccessor (
-                     &ScenarioHelper::m_tmpTrafficFac),
-                   MakeObjectFactoryChecker ())
-  ;
+  );
+  return tid;
+}
+
+TypeId
+ScenarioHelper::AddSliceAttributes (TypeId tid)
+{
+  // Each slice gets its own factory attributes, named after the slice ID
+  // (like HtcController, HtcSlice, HtcTraffic, and Slice3Controller).
+  for (int s = 0; s < N_SLICE_IDS; s++)
+    {
+      SliceId slice = static_cast<SliceId> (s);
+      std::string name = SliceIdStr (slice);
+      std::string prefix = name;
+      prefix [0] = std::toupper (prefix [0]);
+
+      // Generic slices default to a copy of a named slice.
+      std::string ctrlDefault, netDefault, trafDefault;
+      if (slice <= SliceId::TMP)
+        {
+          for (char &c : name)
+            {
+              c = std::toupper (c);
+            }
+        }
+      else
+        {
+          ctrlDefault = " (defaults to a named slice copy, without quota)";
+          netDefault = " (defaults to a copy of a named slice)";
+          trafDefault = " (defaults to a copy of a named slice, with its "
+            "traffic profile)";
+        }
+      tid.AddAttribute (prefix + "Controller",
+                        "The " + name + " slice controller configuration" +
+                        ctrlDefault + ".",
+                        ObjectFactoryValue (ObjectFactory ()),
+                        Create<SliceFactoryAccessor> (
+                          &ScenarioHelper::m_controllerFacs, slice),
+                        MakeObjectFactoryChecker ());
+      tid.AddAttribute (prefix + "Slice",
+                        "The " + name + " slice network configuration" +
+                        netDefault + ".",
+                        ObjectFactoryValue (ObjectFactory ()),
+                        Create<SliceFactoryAccessor> (
+                          &ScenarioHelper::m_networkFacs, slice),
+                        MakeObjectFactoryChecker ());
+      tid.AddAttribute (prefix + "Traffic",
+                        "The " + name + " slice traffic configuration" +
+                        trafDefault + ".",
+                        ObjectFactoryValue (ObjectFactory ()),
+                        Create<SliceFactoryAccessor> (
+                          &ScenarioHelper::m_trafficFacs, slice),
+                        MakeObjectFactoryChecker ());
+    }
   return tid;
 }
 
@@ -136,17 +204,13 @@ ScenarioHelper::ConfigurePcap (std::string prefix, uint8_t config)
                           HasPcapFlag (ScenarioHelper::PCBACKSWT));
 
   // Enable PCAP on the logical network slices.
-  if (m_htcNetwork)
+  for (SliceId slice : GetSliceIds ())
     {
-      m_htcNetwork->EnablePcap (prefix, promisc, ofpFlag, sgiFlag, pgwFlag);
-    }
-  if (m_mtcNetwork)
-    {
-      m_mtcNetwork->EnablePcap (prefix, promisc, ofpFlag, sgiFlag, pgwFlag);
-    }
-  if (m_tmpNetwork)
-    {
-      m_tmpNetwork->EnablePcap (prefix, promisc, ofpFlag, sgiFlag, pgwFlag);
+      if (m_networks [slice])
+        {
+          m_networks [slice]->EnablePcap (
+            prefix, promisc, ofpFlag, sgiFlag, pgwFlag);
+        }
     }
 }
 
@@ -162,6 +226,20 @@ ScenarioHelper::PrintLteRem (bool enable)
     }
 }
 
+void
+ScenarioHelper::ReseedTraffic (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (SliceId slice : GetSliceIds ())
+    {
+      if (m_traffics [slice])
+        {
+          m_traffics [slice]->ReseedStreams ();
+        }
+    }
+}
+
 //
 // Implementing methods inherited from EpcHelper.
 //
@@ -199,8 +277,17 @@ ScenarioHelper::ActivateEpsBearer (Ptr<NetDevice> ueDevice, uint64_t imsi,
   NS_LOG_DEBUG ("Activating bearer id " << static_cast<uint16_t> (bearerId) <<
                 " for UE IMSI " << imsi);
   Ptr<LteUeNetDevice> ueLteDevice = ueDevice->GetObject<LteUeNetDevice> ();
-  NS_ASSERT_MSG (ueLteDevice, "LTE UE device not found.");
-  ueLteDevice->GetNas ()->ActivateEpsBearer (bearer, tft);
+  Ptr<AbstractUeNetDevice> ueAbsDevice =
+    ueDevice->GetObject<AbstractUeNetDevice> ();
+  NS_ASSERT_MSG (ueLteDevice || ueAbsDevice, "LTE UE device not found.");
+  if (ueLteDevice)
+    {
+      ueLteDevice->GetNas ()->ActivateEpsBearer (bearer, tft);
+    }
+  else
+    {
+      ueAbsDevice->ActivateEpsBearer (bearerId, tft);
+    }
 
   return bearerId;
 }
@@ -278,12 +365,15 @@ ScenarioHelper::AddX2Interface (Ptr<Node> enb1Node, Ptr<Node> enb2Node)
 {
   NS_LOG_FUNCTION (this << enb1Node << enb1Node);
 
-  // Get the eNB device pointer from eNB node poiter.
+  // Get the eNB device pointer from eNB node poiter. In the abstract radio
+  // mode there is no LTE eNB device, but the abstract one.
   Ptr<LteEnbNetDevice> enb1Dev = 0, enb2Dev = 0;
+  Ptr<AbstractEnbNetDevice> enb1AbsDev = 0, enb2AbsDev = 0;
   for (uint32_t i = 0; i < enb1Node->GetNDevices (); i++)
     {
       enb1Dev = enb1Node->GetDevice (i)->GetObject<LteEnbNetDevice> ();
-      if (enb1Dev)
+      enb1AbsDev = enb1Node->GetDevice (i)->GetObject<AbstractEnbNetDevice> ();
+      if (enb1Dev || enb1AbsDev)
         {
           break;
         }
@@ -291,17 +381,22 @@ ScenarioHelper::AddX2Interface (Ptr<Node> enb1Node, Ptr<Node> enb2Node)
   for (uint32_t i = 0; i < enb2Node->GetNDevices (); i++)
     {
       enb2Dev = enb2Node->GetDevice (i)->GetObject<LteEnbNetDevice> ();
-      if (enb2Dev)
+      enb2AbsDev = enb2Node->GetDevice (i)->GetObject<AbstractEnbNetDevice> ();
+      if (enb2Dev || enb2AbsDev)
         {
           break;
         }
     }
-  NS_ASSERT_MSG (enb1Dev, "Lte eNB device not found for node " << enb1Node);
-  NS_ASSERT_MSG (enb2Dev, "Lte eNB device not found for node " << enb2Node);
+  NS_ASSERT_MSG (enb1Dev || enb1AbsDev,
+                 "Lte eNB device not found for node " << enb1Node);
+  NS_ASSERT_MSG (enb2Dev || enb2AbsDev,
+                 "Lte eNB device not found for node " << enb2Node);
 
   // Attach both eNB nodes to the OpenFlow backhaul network over X2 interface.
-  uint16_t enb1CellId = enb1Dev->GetCellId ();
-  uint16_t enb2CellId = enb2Dev->GetCellId ();
+  uint16_t enb1CellId =
+    enb1Dev ? enb1Dev->GetCellId () : enb1AbsDev->GetCellId ();
+  uint16_t enb2CellId =
+    enb2Dev ? enb2Dev->GetCellId () : enb2AbsDev->GetCellId ();
   uint16_t enb1InfraSwIdx = m_backhaul->GetEnbSwIdx (enb1CellId);
   uint16_t enb2InfraSwIdx = m_backhaul->GetEnbSwIdx (enb2CellId);
   Ptr<CsmaNetDevice> enb1X2Dev, enb2X2Dev;
@@ -322,8 +417,11 @@ ScenarioHelper::AddX2Interface (Ptr<Node> enb1Node, Ptr<Node> enb2Node)
   Ptr<EpcX2> enb2X2 = enb2Node->GetObject<EpcX2> ();
   enb1X2->AddX2Interface (enb1CellId, enb1X2Addr, enb2CellId, enb2X2Addr);
   enb2X2->AddX2Interface (enb2CellId, enb2X2Addr, enb1CellId, enb1X2Addr);
-  enb1Dev->GetRrc ()->AddX2Neighbour (enb2CellId);
-  enb2Dev->GetRrc ()->AddX2Neighbour (enb1CellId);
+  if (enb1Dev && enb2Dev)
+    {
+      enb1Dev->GetRrc ()->AddX2Neighbour (enb2CellId);
+      enb2Dev->GetRrc ()->AddX2Neighbour (enb1CellId);
+    }
 }
 
 void
@@ -380,6 +478,7 @@ ScenarioHelper::DoDispose (void)
   // This will force output files to get closed.
   m_admissionStats->Dispose ();
   m_backhaulStats->Dispose ();
+  m_controlStats->Dispose ();
   m_pgwTftStats->Dispose ();
   m_trafficStats->Dispose ();
   m_lteRrcStats->Dispose ();
@@ -387,19 +486,18 @@ ScenarioHelper::DoDispose (void)
   m_mme = 0;
   m_backhaul = 0;
   m_radio = 0;
+  m_timerWheel = 0;
 
-  m_htcController = 0;
-  m_htcNetwork = 0;
-  m_htcTraffic = 0;
-  m_mtcController = 0;
-  m_mtcNetwork = 0;
-  m_mtcTraffic = 0;
-  m_tmpController = 0;
-  m_tmpNetwork = 0;
-  m_tmpTraffic = 0;
+  for (int s = 0; s < N_SLICE_IDS; s++)
+    {
+      m_controllers [s] = 0;
+      m_networks [s] = 0;
+      m_traffics [s] = 0;
+    }
 
   m_admissionStats = 0;
   m_backhaulStats = 0;
+  m_controlStats = 0;
   m_pgwTftStats = 0;
   m_trafficStats = 0;
   m_lteRrcStats = 0;
@@ -412,109 +510,81 @@ ScenarioHelper::NotifyConstructionCompleted (void)
 {
   NS_LOG_FUNCTION (this);
 
+  // This scenario must run within a single process. The MME, the slice and
+  // backhaul controllers, and the client/server application pairs interact
+  // through direct method calls that can't cross MPI ranks. Under MPI every
+  // rank would build and run its own full replica of the scenario, so let's
+  // fail early instead of silently producing inconsistent results.
+  StringValue simImplValue;
+  GlobalValue::GetValueByName ("SimulatorImplementationType", simImplValue);
+  NS_ABORT_MSG_IF (simImplValue.Get () == "ns3::DistributedSimulatorImpl"
+                   || simImplValue.Get () == "ns3::NullMessageSimulatorImpl",
+                   "Distributed execution is not supported by this scenario.");
+
   // Create the UNI5ON infrastructure.
   m_mme = CreateObject<Uni5onMme> ();
-  m_backhaul = CreateObject<RingNetwork> ();
-  m_radio = CreateObject<RadioNetwork> (Ptr<ScenarioHelper> (this));
-
-  Ptr<BackhaulController> backahulCtrl = m_backhaul->GetControllerApp ();
-  ApplicationContainer sliceControllers;
-  int sumQuota = 0;
-
-  // Create the HTC logical slice controller, network, and traffic helper.
-  if (AreFactoriesOk (m_htcControllerFac, m_htcNetworkFac, m_htcTrafficFac))
+  if (m_backhaulFac.GetTypeId () == TypeId ())
     {
-      m_htcControllerFac.Set ("SliceId", EnumValue (SliceId::HTC));
-      m_htcControllerFac.Set ("Mme", PointerValue (m_mme));
-      m_htcControllerFac.Set ("BackhaulCtrl", PointerValue (backahulCtrl));
-      m_htcController = m_htcControllerFac.Create<SliceController> ();
-
-      sliceControllers.Add (m_htcController);
-      sumQuota += m_htcController->GetQuota ();
-
-      m_htcNetworkFac.Set ("SliceId", EnumValue (SliceId::HTC));
-      m_htcNetworkFac.Set ("SliceCtrl", PointerValue (m_htcController));
-      m_htcNetworkFac.Set ("BackhaulNet", PointerValue (m_backhaul));
-      m_htcNetworkFac.Set ("RadioNet", PointerValue (m_radio));
-      m_htcNetworkFac.Set ("UeAddress", Ipv4AddressValue ("7.2.0.0"));
-      m_htcNetworkFac.Set ("UeMask", Ipv4MaskValue ("255.255.0.0"));
-      m_htcNetworkFac.Set ("WebAddress", Ipv4AddressValue ("8.2.0.0"));
-      m_htcNetworkFac.Set ("WebMask", Ipv4MaskValue ("255.255.0.0"));
-      m_htcNetwork = m_htcNetworkFac.Create<SliceNetwork> ();
-
-      m_htcTrafficFac.Set ("SliceId", EnumValue (SliceId::HTC));
-      m_htcTrafficFac.Set ("SliceCtrl", PointerValue (m_htcController));
-      m_htcTrafficFac.Set ("SliceNet", PointerValue (m_htcNetwork));
-      m_htcTrafficFac.Set ("RadioNet", PointerValue (m_radio));
-      m_htcTraffic = m_htcTrafficFac.Create<TrafficHelper> ();
+      m_backhaul = CreateObject<RingNetwork> ();
     }
   else
     {
-      NS_LOG_WARN ("HTC slice being ignored by now.");
+      NS_ABORT_MSG_IF (
+        !m_backhaulFac.GetTypeId ().IsChildOf (BackhaulNetwork::GetTypeId ()),
+        "Invalid backhaul network type.");
+      m_backhaul = m_backhaulFac.Create<BackhaulNetwork> ();
     }
+  m_radio = CreateObject<RadioNetwork> (Ptr<ScenarioHelper> (this));
 
-  // Create the MTC logical slice controller, network, and traffic helper.
-  if (AreFactoriesOk (m_mtcControllerFac, m_mtcNetworkFac, m_mtcTrafficFac))
-    {
-      m_mtcControllerFac.Set ("SliceId", EnumValue (SliceId::MTC));
-      m_mtcControllerFac.Set ("Mme", PointerValue (m_mme));
-      m_mtcControllerFac.Set ("BackhaulCtrl", PointerValue (backahulCtrl));
-      m_mtcController = m_mtcControllerFac.Create<SliceController> ();
-
-      sliceControllers.Add (m_mtcController);
-      sumQuota += m_mtcController->GetQuota ();
-
-      m_mtcNetworkFac.Set ("SliceId", EnumValue (SliceId::MTC));
-      m_mtcNetworkFac.Set ("SliceCtrl", PointerValue (m_mtcController));
-      m_mtcNetworkFac.Set ("BackhaulNet", PointerValue (m_backhaul));
-      m_mtcNetworkFac.Set ("RadioNet", PointerValue (m_radio));
-      m_mtcNetworkFac.Set ("UeAddress", Ipv4AddressValue ("7.1.0.0"));
-      m_mtcNetworkFac.Set ("UeMask", Ipv4MaskValue ("255.255.0.0"));
-      m_mtcNetworkFac.Set ("WebAddress", Ipv4AddressValue ("8.1.0.0"));
-      m_mtcNetworkFac.Set ("WebMask", Ipv4MaskValue ("255.255.0.0"));
-      m_mtcNetwork = m_mtcNetworkFac.Create<SliceNetwork> ();
-
-      m_mtcTrafficFac.Set ("SliceId", EnumValue (SliceId::MTC));
-      m_mtcTrafficFac.Set ("SliceCtrl", PointerValue (m_mtcController));
-      m_mtcTrafficFac.Set ("SliceNet", PointerValue (m_mtcNetwork));
-      m_mtcTrafficFac.Set ("RadioNet", PointerValue (m_radio));
-      m_mtcTraffic = m_mtcTrafficFac.Create<TrafficHelper> ();
-    }
-  else
-    {
-      NS_LOG_WARN ("MTC slice being ignored by now.");
-    }
+  // The timer wheel shared by traffic managers in all logical slices.
+  m_timerWheel = CreateObject<TimerWheel> ();
 
-  // Create the TMP logical slice controller, network, and traffic helper.
-  if (AreFactoriesOk (m_tmpControllerFac, m_tmpNetworkFac, m_tmpTrafficFac))
-    {
-      m_tmpControllerFac.Set ("SliceId", EnumValue (SliceId::TMP));
-      m_tmpControllerFac.Set ("Mme", PointerValue (m_mme));
-      m_tmpControllerFac.Set ("BackhaulCtrl", PointerValue (backahulCtrl));
-      m_tmpController = m_tmpControllerFac.Create<SliceController> ();
-
-      sliceControllers.Add (m_tmpController);
-      sumQuota += m_tmpController->GetQuota ();
-
-      m_tmpNetworkFac.Set ("SliceId", EnumValue (SliceId::TMP));
-      m_tmpNetworkFac.Set ("SliceCtrl", PointerValue (m_tmpController));
-      m_tmpNetworkFac.Set ("BackhaulNet", PointerValue (m_backhaul));
-      m_tmpNetworkFac.Set ("RadioNet", PointerValue (m_radio));
-      m_tmpNetworkFac.Set ("UeAddress", Ipv4AddressValue ("7.3.0.0"));
-      m_tmpNetworkFac.Set ("UeMask", Ipv4MaskValue ("255.255.0.0"));
-      m_tmpNetworkFac.Set ("WebAddress", Ipv4AddressValue ("8.3.0.0"));
-      m_tmpNetworkFac.Set ("WebMask", Ipv4MaskValue ("255.255.0.0"));
-      m_tmpNetwork = m_tmpNetworkFac.Create<SliceNetwork> ();
-
-      m_tmpTrafficFac.Set ("SliceId", EnumValue (SliceId::TMP));
-      m_tmpTrafficFac.Set ("SliceCtrl", PointerValue (m_tmpController));
-      m_tmpTrafficFac.Set ("SliceNet", PointerValue (m_tmpNetwork));
-      m_tmpTrafficFac.Set ("RadioNet", PointerValue (m_radio));
-      m_tmpTraffic = m_tmpTrafficFac.Create<TrafficHelper> ();
-    }
-  else
+  Ptr<BackhaulController> backahulCtrl = m_backhaul->GetControllerApp ();
+  ApplicationContainer sliceControllers;
+  int sumQuota = 0;
+
+  // Create the logical slice controllers, networks, and traffic helpers.
+  for (SliceId slice : GetSliceIds ())
     {
-      NS_LOG_WARN ("TMP slice being ignored by now.");
+      ObjectFactory controllerFac, networkFac, trafficFac;
+      GetSliceFactories (slice, controllerFac, networkFac, trafficFac);
+      if (!AreFactoriesOk (controllerFac, networkFac, trafficFac))
+        {
+          NS_LOG_WARN ("Slice " << SliceIdStr (slice) <<
+                       " being ignored by now.");
+          continue;
+        }
+
+      // The UE and Internet network addresses for this slice. For historical
+      // reasons, the HTC slice uses 7.2.0.0 and the MTC slice uses 7.1.0.0.
+      uint32_t netId = slice <= SliceId::MTC ? 2 - slice : slice + 1;
+      Ipv4Address ueAddr ((7U << 24) | (netId << 16));
+      Ipv4Address webAddr ((8U << 24) | (netId << 16));
+
+      controllerFac.Set ("SliceId", EnumValue (slice));
+      controllerFac.Set ("Mme", PointerValue (m_mme));
+      controllerFac.Set ("BackhaulCtrl", PointerValue (backahulCtrl));
+      m_controllers [slice] = controllerFac.Create<SliceController> ();
+
+      sliceControllers.Add (m_controllers [slice]);
+      sumQuota += m_controllers [slice]->GetQuota ();
+
+      networkFac.Set ("SliceId", EnumValue (slice));
+      networkFac.Set ("SliceCtrl", PointerValue (m_controllers [slice]));
+      networkFac.Set ("BackhaulNet", PointerValue (m_backhaul));
+      networkFac.Set ("RadioNet", PointerValue (m_radio));
+      networkFac.Set ("UeAddress", Ipv4AddressValue (ueAddr));
+      networkFac.Set ("UeMask", Ipv4MaskValue ("255.255.0.0"));
+      networkFac.Set ("WebAddress", Ipv4AddressValue (webAddr));
+      networkFac.Set ("WebMask", Ipv4MaskValue ("255.255.0.0"));
+      m_networks [slice] = networkFac.Create<SliceNetwork> ();
+
+      trafficFac.Set ("SliceId", EnumValue (slice));
+      trafficFac.Set ("SliceCtrl", PointerValue (m_controllers [slice]));
+      trafficFac.Set ("SliceNet", PointerValue (m_networks [slice]));
+      trafficFac.Set ("RadioNet", PointerValue (m_radio));
+      trafficFac.Set ("TimerWheel", PointerValue (m_timerWheel));
+      m_traffics [slice] = trafficFac.Create<TrafficHelper> ();
     }
 
   // Validate slice quotas.
@@ -526,6 +596,7 @@ ScenarioHelper::NotifyConstructionCompleted (void)
   // Creating the statistic calculators.
   m_admissionStats  = CreateObject<AdmissionStatsCalculator> ();
   m_backhaulStats   = CreateObject<BackhaulStatsCalculator> ();
+  m_controlStats    = CreateObject<ControlStatsCalculator> ();
   m_lteRrcStats     = CreateObject<LteRrcStatsCalculator> ();
   m_pgwTftStats     = CreateObject<PgwTftStatsCalculator> ();
   m_trafficStats    = CreateObject<TrafficStatsCalculator> ();
@@ -541,6 +612,46 @@ ScenarioHelper::HasPcapFlag (PcapConfig flag) const
   return (m_pcapConfig & (static_cast<uint8_t> (flag)));
 }
 
+void
+ScenarioHelper::GetSliceFactories (SliceId slice, ObjectFactory &controller,
+                                   ObjectFactory &network,
+                                   ObjectFactory &traffic) const
+{
+  NS_LOG_FUNCTION (this << slice);
+
+  NS_ASSERT_MSG (slice < N_SLICE_IDS, "Invalid slice ID.");
+  controller = m_controllerFacs [slice];
+  network = m_networkFacs [slice];
+  traffic = m_trafficFacs [slice];
+
+  // Named slices only use their own factories.
+  SliceId profile = static_cast<SliceId> (slice % (SliceId::TMP + 1));
+  if (slice == profile)
+    {
+      return;
+    }
+
+  // Generic slices replicate the named slice factories not configured.
+  if (controller.GetTypeId () == TypeId ()
+      && m_controllerFacs [profile].GetTypeId () != TypeId ())
+    {
+      NS_LOG_WARN ("Slice " << SliceIdStr (slice) << " replicating the " <<
+                   SliceIdStr (profile) << " controller without quota.");
+      controller = m_controllerFacs [profile];
+      controller.Set ("Quota", IntegerValue (0));
+    }
+  if (network.GetTypeId () == TypeId ())
+    {
+      network = m_networkFacs [profile];
+    }
+  if (traffic.GetTypeId () == TypeId ()
+      && m_trafficFacs [profile].GetTypeId () != TypeId ())
+    {
+      traffic = m_trafficFacs [profile];
+      traffic.Set ("Profile", EnumValue (profile));
+    }
+}
+
 bool
 ScenarioHelper::AreFactoriesOk (ObjectFactory &controller,
                                 ObjectFactory &network,
@@ -27,6 +27,7 @@
 #include <ns3/ofswitch13-module.h>
 #include "../statistics/admission-stats-calculator.h"
 #include "../statistics/backhaul-stats-calculator.h"
+#include "../statistics/control-stats-calculator.h"
 #include "../statistics/lte-rrc-stats-calculator.h"
 #include "../statistics/pgw-tft-stats-calculator.h"
 #include "../statistics/traffic-stats-calculator.h"
@@ -34,10 +35,11 @@
 
 namespace ns3 {
 
+class BackhaulNetwork;
 class RadioNetwork;
-class RingNetwork;
 class SliceController;
 class SliceNetwork;
+class TimerWheel;
 class Uni5onMme;
 class TrafficHelper;
 
@@ -100,6 +102,14 @@ public:
    */
   void PrintLteRem (bool enable);
 
+  /**
+   * Reseed the random variable streams that drive the traffic in all logical
+   * slices with the current RngSeedManager run number. This is used to
+   * continue a simulation that shares the same warm-up period with a
+   * different traffic realization.
+   */
+  void ReseedTraffic (void);
+
   // Inherited from EpcHelper.
   uint8_t ActivateEpsBearer (Ptr<NetDevice> ueLteDevice, uint64_t imsi,
                              Ptr<EpcTft> tft, EpsBearer bearer);
@@ -128,7 +138,34 @@ protected:
    */
   bool HasPcapFlag (PcapConfig flag) const;
 
+  /**
+   * Get the object factories for a logical slice. A slice uses its own
+   * factories when configured. Otherwise, it replicates the factories of the
+   * named slices in a round-robin fashion, without the controller quota and
+   * with the traffic profile of the replicated slice.
+   * \param slice The slice ID.
+   * \param controller The SliceController object factory.
+   * \param network The SliceNetwork object factory.
+   * \param traffic The TrafficHelper object factory.
+   */
+  void GetSliceFactories (SliceId slice, ObjectFactory &controller,
+                          ObjectFactory &network,
+                          ObjectFactory &traffic) const;
+
 private:
+  /** Attribute accessor for the factories of logical slices. */
+  class SliceFactoryAccessor;
+
+  /** Object factories indexed by slice ID. */
+  typedef ObjectFactory SliceFactories_t [N_SLICE_IDS];
+
+  /**
+   * Add the factory attributes for logical slices to this type.
+   * \param tid The ScenarioHelper TypeId.
+   * \return The ScenarioHelper TypeId.
+   */
+  static TypeId AddSliceAttributes (TypeId tid);
+
   /**
    * Check the object factories for proper types.
    * \param controller The SliceController object factory.
@@ -141,37 +178,26 @@ private:
 
   uint8_t                   m_pcapConfig;       //!< PCAP configuration bitmap.
 
-  Ptr<RingNetwork>          m_backhaul;         //!< The backhaul network.
+  ObjectFactory             m_backhaulFac;      //!< Backhaul factory.
+  Ptr<BackhaulNetwork>      m_backhaul;         //!< The backhaul network.
   Ptr<RadioNetwork>         m_radio;            //!< The LTE RAN network.
   Ptr<Uni5onMme>            m_mme;              //!< The MME entity.
+  Ptr<TimerWheel>           m_timerWheel;       //!< Traffic timer wheel.
+
+  // Logical network slice factories, indexed by slice ID.
+  SliceFactories_t          m_controllerFacs;   //!< Controller factories.
+  SliceFactories_t          m_networkFacs;      //!< Network factories.
+  SliceFactories_t          m_trafficFacs;      //!< Traffic factories.
 
-  // HTC network slice.
-  ObjectFactory             m_htcControllerFac; //!< HTC controller factory.
-  ObjectFactory             m_htcNetworkFac;    //!< HTC network factory.
-  ObjectFactory             m_htcTrafficFac;    //!< HTC traffic factory.
-  Ptr<SliceController>      m_htcController;    //!< HTC slice controller.
-  Ptr<SliceNetwork>         m_htcNetwork;       //!< HTC slice network.
-  Ptr<TrafficHelper>        m_htcTraffic;       //!< HTC slice traffic.
-
-  // MTC network slice.
-  ObjectFactory             m_mtcControllerFac; //!< MTC controller factory.
-  ObjectFactory             m_mtcNetworkFac;    //!< MTC network factory.
-  ObjectFactory             m_mtcTrafficFac;    //!< MTC traffic factory.
-  Ptr<SliceController>      m_mtcController;    //!< MTC slice controller.
-  Ptr<SliceNetwork>         m_mtcNetwork;       //!< MTC slice network.
-  Ptr<TrafficHelper>        m_mtcTraffic;       //!< MTC slice traffic.
-
-  // TMP network slice.
-  ObjectFactory             m_tmpControllerFac; //!< TMP controller factory.
-  ObjectFactory             m_tmpNetworkFac;    //!< TMP network factory.
-  ObjectFactory             m_tmpTrafficFac;    //!< TMP traffic factory.
-  Ptr<SliceController>      m_tmpController;    //!< TMP slice controller.
-  Ptr<SliceNetwork>         m_tmpNetwork;       //!< TMP slice network.
-  Ptr<TrafficHelper>        m_tmpTraffic;       //!< TMP slice traffic.
+  // Logical network slices, indexed by slice ID.
+  Ptr<SliceController>      m_controllers [N_SLICE_IDS]; //!< Controllers.
+  Ptr<SliceNetwork>         m_networks [N_SLICE_IDS];    //!< Networks.
+  Ptr<TrafficHelper>        m_traffics [N_SLICE_IDS];    //!< Traffics.
 
   // Statistic calculators.
   Ptr<AdmissionStatsCalculator>   m_admissionStats; //!< Admission stats.
   Ptr<BackhaulStatsCalculator>    m_backhaulStats;  //!< Backhaul stats.
+  Ptr<ControlStatsCalculator>     m_controlStats;   //!< Control stats.
   Ptr<LteRrcStatsCalculator>      m_lteRrcStats;    //!< LTE RRC stats.
   Ptr<PgwTftStatsCalculator>      m_pgwTftStats;    //!< P-GW TFT stats.
   Ptr<TrafficStatsCalculator>     m_trafficStats;   //!< Traffic stats.
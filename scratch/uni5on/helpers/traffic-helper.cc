@@ -21,6 +21,8 @@
 #include "traffic-helper.h"
 #include "../applications/buffered-video-client.h"
 #include "../applications/buffered-video-server.h"
+#include "../applications/fluid-client.h"
+#include "../applications/fluid-server.h"
 #include "../applications/http-client.h"
 #include "../applications/http-server.h"
 #include "../applications/live-video-client.h"
@@ -30,6 +32,7 @@
 #include "../infrastructure/radio-network.h"
 #include "../logical/slice-controller.h"
 #include "../logical/slice-network.h"
+#include "../logical/timer-wheel.h"
 #include "../logical/traffic-manager.h"
 #include "../metadata/ue-info.h"
 #include "../statistics/flow-stats-calculator.h"
@@ -69,6 +72,7 @@ const uint64_t TrafficHelper::m_mbrBitRate [] = {
 
 // ------------------------------------------------------------------------ //
 TrafficHelper::TrafficHelper ()
+  : m_profile (SliceId::UNKN)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,9 +94,17 @@ TrafficHelper::GetTypeId (void)
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    EnumValue (SliceId::UNKN),
                    MakeEnumAccessor (&TrafficHelper::m_sliceId),
+                   MakeSliceIdChecker ())
+    .AddAttribute ("Profile", "The traffic profile for this slice "
+                   "(defaults to the profile of the slice ID, which is only "
+                   "available for named slices).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   EnumValue (SliceId::UNKN),
+                   MakeEnumAccessor (&TrafficHelper::m_profile),
                    MakeEnumChecker (SliceId::HTC, SliceIdStr (SliceId::HTC),
                                     SliceId::MTC, SliceIdStr (SliceId::MTC),
-                                    SliceId::TMP, SliceIdStr (SliceId::TMP)))
+                                    SliceId::TMP, SliceIdStr (SliceId::TMP),
+                                    SliceId::UNKN, SliceIdStr (SliceId::UNKN)))
     .AddAttribute ("SliceCtrl", "The LTE logical slice controller pointer.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    PointerValue (),
@@ -110,6 +122,11 @@ TrafficHelper::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&TrafficHelper::m_radio),
                    MakePointerChecker<RadioNetwork> ())
+    .AddAttribute ("TimerWheel", "The timer wheel shared by traffic managers.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   PointerValue (),
+                   MakePointerAccessor (&TrafficHelper::m_timerWheel),
+                   MakePointerChecker<TimerWheel> ())
 
     // Traffic helper attributes.
     .AddAttribute ("UseOnlyDefaultBearer",
@@ -118,6 +135,13 @@ TrafficHelper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&TrafficHelper::m_useOnlyDefault),
                    MakeBooleanChecker ())
+    .AddAttribute ("FluidUeRatio",
+                   "The ratio of UEs running fluid background traffic "
+                   "instead of packet-level applications.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&TrafficHelper::m_fluidRatio),
+                   MakeDoubleChecker<double> (0.0, 1.0))
 
     // Traffic manager attributes.
     .AddAttribute ("InitialProb",
@@ -167,6 +191,26 @@ TrafficHelper::GetTypeId (void)
   return tid;
 }
 
+void
+TrafficHelper::ReseedStreams (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The inter-arrival stream is shared among all traffic managers.
+  ReseedStream (m_poissonRng);
+
+  NodeContainer ueNodes = m_slice->GetUeNodes ();
+  for (uint32_t u = 0; u < ueNodes.GetN (); u++)
+    {
+      Ptr<Node> ueNode = ueNodes.Get (u);
+      Ptr<TrafficManager> manager = ueNode->GetObject<TrafficManager> ();
+      if (manager)
+        {
+          manager->ReseedStreams ();
+        }
+    }
+}
+
 void
 TrafficHelper::DoDispose ()
 {
@@ -175,8 +219,8 @@ TrafficHelper::DoDispose ()
   m_radio = 0;
   m_slice = 0;
   m_controller = 0;
+  m_timerWheel = 0;
   m_poissonRng = 0;
-  m_lteHelper = 0;
   m_webNode = 0;
   t_ueManager = 0;
   t_ueDev = 0;
@@ -195,9 +239,16 @@ TrafficHelper::NotifyConstructionCompleted ()
   NS_ABORT_MSG_IF (!m_radio, "No radio network.");
   NS_ABORT_MSG_IF (!m_slice, "No slice network.");
   NS_ABORT_MSG_IF (!m_controller, "No slice controller.");
+  NS_ABORT_MSG_IF (!m_timerWheel, "No timer wheel.");
+
+  // Only the named slices have their own traffic profile.
+  if (m_profile == SliceId::UNKN)
+    {
+      NS_ABORT_MSG_IF (m_sliceId > SliceId::TMP, "Unknown traffic profile.");
+      m_profile = m_sliceId;
+    }
 
   // Saving pointers.
-  m_lteHelper = m_radio->GetLteHelper ();
   m_webNode = m_slice->GetWebNode ();
 
   // Saving server metadata.
@@ -213,6 +264,7 @@ TrafficHelper::NotifyConstructionCompleted ()
   m_managerFac.Set ("StartProb", DoubleValue (m_initialProb));
   m_managerFac.Set ("StartTime", TimeValue (m_startAppsAt));
   m_managerFac.Set ("StopTime", TimeValue (m_stopAppsAt));
+  m_managerFac.Set ("TimerWheel", PointerValue (m_timerWheel));
 
   // Configure random video selections.
   m_gbrVidRng = CreateObject<UniformRandomVariable> ();
@@ -478,6 +530,28 @@ TrafficHelper::ConfigureHelpers ()
   m_gpsTrackHelper.SetServerAttribute (
     "PktInterval",
     StringValue ("ns3::UniformRandomVariable[Min=1.0|Max=25.0]"));
+
+
+  // -------------------------------------------------------------------------
+  // Configuring fluid application helper.
+
+  //
+  // The fluid background traffic doesn't send packets. Instead, it injects
+  // bit rate trajectories directly into backhaul link accounting through the
+  // slice controller. The bit rates can be adjusted through the FluidClient
+  // DlBitRate and UlBitRate attributes.
+  //
+  m_fluidBgHelper = ApplicationHelper (FluidClient::GetTypeId (),
+                                       FluidServer::GetTypeId ());
+  m_fluidBgHelper.SetClientAttribute ("AppName", StringValue ("FluidBg"));
+  m_fluidBgHelper.SetClientAttribute (
+    "SliceCtrl", PointerValue (m_controller));
+
+  // Traffic length: we are using a arbitrary normally-distributed long traffic
+  // length of 120 sec with 20 sec stdev.
+  m_fluidBgHelper.SetClientAttribute (
+    "TrafficLength",
+    StringValue ("ns3::NormalRandomVariable[Mean=120.0|Variance=400.0]"));
 }
 
 uint16_t
@@ -519,7 +593,9 @@ TrafficHelper::InstallApplications ()
       t_ueNode = ueNodes.Get (u);
       t_ueDev = ueDevices.Get (u);
       NS_ASSERT (t_ueDev->GetNode () == t_ueNode);
-      t_ueImsi = DynamicCast<LteUeNetDevice> (t_ueDev)->GetImsi ();
+      UintegerValue imsiValue;
+      t_ueDev->GetAttribute ("Imsi", imsiValue);
+      t_ueImsi = imsiValue.Get ();
 
       Ptr<Ipv4> clientIpv4 = t_ueNode->GetObject<Ipv4> ();
       t_ueAddr = clientIpv4->GetAddress (1, 0).GetLocal ();
@@ -553,8 +629,16 @@ TrafficHelper::InstallApplications ()
         "/NodeList/*/ApplicationList/*/$ns3::SliceController/SessionCreated",
         MakeCallback (&TrafficManager::NotifySessionCreated, t_ueManager));
 
-      // Install applications into this UE according to network slice.
-      if (m_sliceId == SliceId::HTC)
+      // Install fluid background traffic over default Non-GBR EPS bearer
+      // into the first UEs of this slice, according to the fluid ratio.
+      if (u < ueNodes.GetN () * m_fluidRatio)
+        {
+          InstallAppDefault (m_fluidBgHelper);
+          continue;
+        }
+
+      // Install applications into this UE according to the traffic profile.
+      if (m_profile == SliceId::HTC)
         {
           {
             // VoIP call over dedicated GBR EPS bearer.
@@ -672,7 +756,7 @@ TrafficHelper::InstallApplications ()
           continue;
         }
 
-      if (m_sliceId == SliceId::MTC)
+      if (m_profile == SliceId::MTC)
         {
           {
             // Auto-pilot traffic over dedicated GBR EPS bearer.
@@ -738,7 +822,7 @@ TrafficHelper::InstallApplications ()
           continue;
         }
 
-      if (m_sliceId == SliceId::TMP)
+      if (m_profile == SliceId::TMP)
         {
           {
             // VoIP call over dedicated GBR EPS bearer.
@@ -834,7 +918,7 @@ TrafficHelper::InstallAppDedicated (
   tft->Add (filter);
 
   // Create the dedicated bearer for this traffic.
-  uint8_t bid = m_lteHelper->ActivateDedicatedEpsBearer (t_ueDev, bearer, tft);
+  uint8_t bid = m_radio->ActivateDedicatedEpsBearer (t_ueDev, bearer, tft);
   clientApp->SetEpsBearer (bearer);
   clientApp->SetEpsBearerId (bid);
 }
@@ -33,6 +33,7 @@ namespace ns3 {
 class RadioNetwork;
 class SliceController;
 class SliceNetwork;
+class TimerWheel;
 class TrafficManager;
 
 /**
@@ -53,6 +54,14 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Reseed the random variable streams used by the traffic managers and
+   * applications installed by this helper with the current RngSeedManager
+   * run number. Streams only used while installing applications are left
+   * untouched.
+   */
+  void ReseedStreams (void);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -129,11 +138,14 @@ private:
 
   // Traffic helper.
   SliceId                     m_sliceId;          //!< Logical slice ID.
+  SliceId                     m_profile;          //!< Traffic profile.
   Ptr<RadioNetwork>           m_radio;            //!< LTE radio network.
   Ptr<SliceNetwork>           m_slice;            //!< LTE slice network.
   Ptr<SliceController>        m_controller;       //!< LTE slice controller.
+  Ptr<TimerWheel>             m_timerWheel;       //!< Shared timer wheel.
   static uint16_t             m_port;             //!< Port numbers for apps.
   bool                        m_useOnlyDefault;   //!< Use only default bearer.
+  double                      m_fluidRatio;       //!< Ratio of fluid UEs.
 
   // Traffic manager.
   Time                        m_fullProbAt;       //!< Time to 100% requests.
@@ -150,6 +162,7 @@ private:
   ApplicationHelper           m_autPilotHelper;   //!< Auto-pilot helper.
   ApplicationHelper           m_bikeRaceHelper;   //!< Bicycle race helper.
   ApplicationHelper           m_bufVideoHelper;   //!< Buffered video helper.
+  ApplicationHelper           m_fluidBgHelper;    //!< Fluid background helper.
   ApplicationHelper           m_gameOpenHelper;   //!< Open Arena helper.
   ApplicationHelper           m_gameTeamHelper;   //!< Team Fortress helper.
   ApplicationHelper           m_gpsTrackHelper;   //!< GPS tracking helper.
@@ -158,7 +171,6 @@ private:
   ApplicationHelper           m_voipCallHelper;   //!< VoIP call helper.
 
   // Temporary variables used only when installing applications.
-  Ptr<LteHelper>              m_lteHelper;        //!< LTE helper.
   Ptr<Node>                   m_webNode;          //!< Server node.
   Ipv4Address                 m_webAddr;          //!< Server address.
   Ipv4Mask                    m_webMask;          //!< Server address mask.
@@ -0,0 +1,575 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <algorithm>
+#include "abstract-enb-net-device.h"
+#include "abstract-ue-net-device.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AbstractEnbNetDevice");
+NS_OBJECT_ENSURE_REGISTERED (AbstractEnbNetDevice);
+
+// Number of CQI indexes in the SINR-to-throughput table (CQI 0 to 15).
+#define N_CQIS 16
+
+// SINR thresholds (dB) for CQI indexes 1 to 15 at 10% BLER.
+static const double g_cqiSinrThresholds [N_CQIS - 1] = {
+  -6.7, -4.7, -2.3, 0.2, 2.4, 4.3, 5.9, 8.1,
+  10.3, 11.7, 14.1, 16.3, 18.7, 21.0, 22.7
+};
+
+// Spectral efficiency (bps/Hz) for CQI indexes 1 to 15 (3GPP TS 36.213
+// Table 7.2.3-1).
+static const double g_cqiEfficiency [N_CQIS - 1] = {
+  0.1523, 0.2344, 0.3770, 0.6016, 0.8770, 1.1758, 1.4766, 1.9141,
+  2.4063, 2.7305, 3.3223, 3.9023, 4.5234, 5.1152, 5.5547
+};
+
+// Bandwidth of a single resource block (Hz).
+static const double g_rbBandwidth = 180000;
+
+AbstractEnbNetDevice::AbstractEnbNetDevice ()
+  : m_antenna (0),
+  m_rntiCounter (0),
+  m_s1SapProvider (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  SetAddress (Mac64Address::Allocate ());
+  m_s1SapUser = new MemberEpcEnbS1SapUser<AbstractEnbNetDevice> (this);
+  for (int d = 0; d < N_DIRECTIONS; d++)
+    {
+      m_virtualTime [d] = 0;
+    }
+}
+
+AbstractEnbNetDevice::~AbstractEnbNetDevice ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+AbstractEnbNetDevice::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AbstractEnbNetDevice")
+    .SetParent<LteNetDevice> ()
+    .AddConstructor<AbstractEnbNetDevice> ()
+    .AddAttribute ("CellId", "The eNB cell ID.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AbstractEnbNetDevice::m_cellId),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("DlBandwidth", "The downlink bandwidth (RBs).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&AbstractEnbNetDevice::m_dlBandwidth),
+                   MakeUintegerChecker<uint16_t> (6, 100))
+    .AddAttribute ("UlBandwidth", "The uplink bandwidth (RBs).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&AbstractEnbNetDevice::m_ulBandwidth),
+                   MakeUintegerChecker<uint16_t> (6, 100))
+    .AddAttribute ("TxPower", "The eNB TX power (dBm).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (46.0),
+                   MakeDoubleAccessor (&AbstractEnbNetDevice::m_txPower),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("NoiseFigure", "The eNB noise figure (dB).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (5.0),
+                   MakeDoubleAccessor (&AbstractEnbNetDevice::m_noiseFigure),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Overhead", "The fraction of radio resources used by "
+                   "control channels and reference signals.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (0.25),
+                   MakeDoubleAccessor (&AbstractEnbNetDevice::m_overhead),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("MaxQueueBytes", "The maximum number of bytes queued "
+                   "for each UE in each direction.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (102400),
+                   MakeUintegerAccessor (
+                     &AbstractEnbNetDevice::m_maxQueueBytes),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Antenna", "The eNB antenna model.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   PointerValue (),
+                   MakePointerAccessor (&AbstractEnbNetDevice::m_antenna),
+                   MakePointerChecker<AntennaModel> ())
+
+    .AddTraceSource ("Drop", "Packet dropped at the radio queues.",
+                     MakeTraceSourceAccessor (
+                       &AbstractEnbNetDevice::m_dropTrace),
+                     "ns3::Packet::TracedCallback")
+  ;
+  return tid;
+}
+
+Ptr<AntennaModel>
+AbstractEnbNetDevice::GetAntenna (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_antenna;
+}
+
+uint16_t
+AbstractEnbNetDevice::GetCellId (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_cellId;
+}
+
+uint16_t
+AbstractEnbNetDevice::GetDlBandwidth (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_dlBandwidth;
+}
+
+double
+AbstractEnbNetDevice::GetNoiseFigure (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_noiseFigure;
+}
+
+double
+AbstractEnbNetDevice::GetTxPower (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_txPower;
+}
+
+uint16_t
+AbstractEnbNetDevice::GetUlBandwidth (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_ulBandwidth;
+}
+
+DataRate
+AbstractEnbNetDevice::GetAchievableRate (double sinrDb, Direction dir) const
+{
+  NS_LOG_FUNCTION (this << sinrDb << dir);
+
+  // Find the highest CQI index supported by this SINR.
+  int cqi = 0;
+  while (cqi < N_CQIS - 1 && sinrDb >= g_cqiSinrThresholds [cqi])
+    {
+      cqi++;
+    }
+  return m_rateTable [dir][cqi];
+}
+
+void
+AbstractEnbNetDevice::Attach (Ptr<AbstractUeNetDevice> ueDev)
+{
+  NS_LOG_FUNCTION (this << ueDev);
+
+  NS_ASSERT_MSG (!ueDev->GetEnb (), "UE already attached.");
+  uint16_t rnti = AddUe (ueDev);
+  NS_LOG_INFO ("UE IMSI " << ueDev->GetImsi () << " attached to cell " <<
+               m_cellId << " with RNTI " << rnti);
+
+  m_s1SapProvider->InitialUeMessage (ueDev->GetImsi (), rnti);
+}
+
+void
+AbstractEnbNetDevice::HandoverIn (Ptr<AbstractUeNetDevice> ueDev)
+{
+  NS_LOG_FUNCTION (this << ueDev);
+
+  Ptr<AbstractEnbNetDevice> source = ueDev->GetEnb ();
+  uint16_t sourceRnti = ueDev->GetRnti ();
+  NS_ASSERT_MSG (source && source != this, "Invalid source eNB.");
+
+  // Create the UE context at this eNB and move the queued packets from the
+  // source eNB, which will forward further downlink packets to this eNB.
+  uint16_t rnti = AddUe (ueDev);
+  UeContext &ctx = m_ueContexts [rnti];
+  ctx.teidByBid = source->HandoverOut (sourceRnti, this, rnti);
+  m_handoverFrom [rnti] = EnbRnti_t (source, sourceRnti);
+  NS_LOG_INFO ("UE IMSI " << ueDev->GetImsi () << " handover from cell " <<
+               source->GetCellId () << " to cell " << m_cellId <<
+               " with RNTI " << rnti);
+
+  // Request the S1-U path switch.
+  EpcEnbS1SapProvider::PathSwitchRequestParameters params;
+  params.rnti = rnti;
+  params.cellId = m_cellId;
+  params.mmeUeS1Id = ueDev->GetImsi ();
+  for (auto const &it : ctx.teidByBid)
+    {
+      EpcEnbS1SapProvider::BearerToBeSwitched bearer;
+      bearer.epsBearerId = it.first;
+      bearer.teid = it.second;
+      params.bearersToBeSwitched.push_back (bearer);
+    }
+  m_s1SapProvider->PathSwitchRequest (params);
+}
+
+void
+AbstractEnbNetDevice::EnqueueUplink (uint16_t rnti, uint8_t bearerId,
+                                     Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << rnti << static_cast<uint16_t> (bearerId) <<
+                   packet);
+
+  // The EpcEnbApplication uses this tag to identify the S1-U bearer.
+  EpsBearerTag tag (rnti, bearerId);
+  packet->AddPacketTag (tag);
+  Enqueue (Direction::ULINK, rnti, packet);
+}
+
+EpcEnbS1SapUser*
+AbstractEnbNetDevice::GetS1SapUser (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_s1SapUser;
+}
+
+void
+AbstractEnbNetDevice::SetS1SapProvider (EpcEnbS1SapProvider *s)
+{
+  NS_LOG_FUNCTION (this << s);
+
+  m_s1SapProvider = s;
+}
+
+bool
+AbstractEnbNetDevice::Send (Ptr<Packet> packet, const Address& dest,
+                            uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (this << packet << dest << protocolNumber);
+
+  NS_ASSERT_MSG (protocolNumber == Ipv4L3Protocol::PROT_NUMBER,
+                 "Unsupported protocol number.");
+
+  // Downlink packets from the EpcEnbApplication carry the bearer tag.
+  EpsBearerTag tag;
+  bool found = packet->RemovePacketTag (tag);
+  NS_ASSERT_MSG (found, "EpsBearerTag not found.");
+  uint16_t rnti = tag.GetRnti ();
+
+  // Forward packets for UEs that were handed over to the target eNB until the
+  // path switch completes, mimicking the X2-U data forwarding.
+  auto it = m_forwardTo.find (rnti);
+  if (it != m_forwardTo.end ())
+    {
+      it->second.first->Enqueue (Direction::DLINK, it->second.second, packet);
+      return true;
+    }
+
+  Enqueue (Direction::DLINK, rnti, packet);
+  return true;
+}
+
+void
+AbstractEnbNetDevice::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  delete m_s1SapUser;
+  m_s1SapProvider = 0;
+  m_antenna = 0;
+  m_ueContexts.clear ();
+  m_forwardTo.clear ();
+  m_handoverFrom.clear ();
+  for (int d = 0; d < N_DIRECTIONS; d++)
+    {
+      m_txEvent [d].Cancel ();
+      m_txing [d].clear ();
+    }
+  LteNetDevice::DoDispose ();
+}
+
+void
+AbstractEnbNetDevice::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_antenna)
+    {
+      m_antenna = CreateObject<IsotropicAntennaModel> ();
+    }
+
+  // Precompute the achievable rate for each CQI index in both directions,
+  // discounting the control overhead.
+  uint16_t nRbs [N_DIRECTIONS];
+  nRbs [Direction::DLINK] = m_dlBandwidth;
+  nRbs [Direction::ULINK] = m_ulBandwidth;
+  for (int d = 0; d < N_DIRECTIONS; d++)
+    {
+      double bandwidth = nRbs [d] * g_rbBandwidth * (1.0 - m_overhead);
+      m_rateTable [d].clear ();
+      m_rateTable [d].push_back (DataRate (0));
+      for (int c = 0; c < N_CQIS - 1; c++)
+        {
+          uint64_t bps = static_cast<uint64_t> (
+              g_cqiEfficiency [c] * bandwidth);
+          m_rateTable [d].push_back (DataRate (bps));
+        }
+    }
+
+  LteNetDevice::NotifyConstructionCompleted ();
+}
+
+void
+AbstractEnbNetDevice::DoDataRadioBearerSetupRequest (
+  EpcEnbS1SapUser::DataRadioBearerSetupRequestParameters params)
+{
+  NS_LOG_FUNCTION (this << params.rnti);
+
+  auto it = m_ueContexts.find (params.rnti);
+  NS_ASSERT_MSG (it != m_ueContexts.end (), "UE context not found.");
+  it->second.teidByBid [params.bearerId] = params.gtpTeid;
+}
+
+void
+AbstractEnbNetDevice::DoPathSwitchRequestAcknowledge (
+  EpcEnbS1SapUser::PathSwitchRequestAcknowledgeParameters params)
+{
+  NS_LOG_FUNCTION (this << params.rnti);
+
+  // Release the UE context at the source eNB.
+  auto it = m_handoverFrom.find (params.rnti);
+  NS_ASSERT_MSG (it != m_handoverFrom.end (), "No pending handover.");
+  it->second.first->ReleaseUe (it->second.second);
+  m_handoverFrom.erase (it);
+}
+
+uint16_t
+AbstractEnbNetDevice::AddUe (Ptr<AbstractUeNetDevice> ueDev)
+{
+  NS_LOG_FUNCTION (this << ueDev);
+
+  // Find the next free RNTI, skipping the reserved value 0.
+  do
+    {
+      m_rntiCounter++;
+    }
+  while (m_rntiCounter == 0 || m_ueContexts.count (m_rntiCounter)
+         || m_forwardTo.count (m_rntiCounter));
+
+  UeContext ctx;
+  ctx.ueDev = ueDev;
+  for (int d = 0; d < N_DIRECTIONS; d++)
+    {
+      ctx.bytes [d] = 0;
+      ctx.finish [d] = 0;
+    }
+  m_ueContexts [m_rntiCounter] = ctx;
+  ueDev->SetEnb (this, m_rntiCounter);
+  return m_rntiCounter;
+}
+
+std::map<uint8_t, uint32_t>
+AbstractEnbNetDevice::HandoverOut (
+  uint16_t rnti, Ptr<AbstractEnbNetDevice> target, uint16_t targetRnti)
+{
+  NS_LOG_FUNCTION (this << rnti << target << targetRnti);
+
+  auto it = m_ueContexts.find (rnti);
+  NS_ASSERT_MSG (it != m_ueContexts.end (), "UE context not found.");
+  UeContext &ctx = it->second;
+
+  // Abort the packets in transmission, which are resent by the target eNB
+  // from the beginning.
+  for (int d = 0; d < N_DIRECTIONS; d++)
+    {
+      Direction dir = static_cast<Direction> (d);
+      if (ctx.txPkt [dir])
+        {
+          UpdateVirtualTime (dir);
+          m_txing [dir].erase (std::make_pair (ctx.finish [dir], rnti));
+          ctx.queue [dir].push_front (ctx.txPkt [dir]);
+          ctx.txPkt [dir] = 0;
+          ScheduleTxComplete (dir);
+        }
+    }
+
+  // Move queued packets to the target eNB, updating the uplink bearer tags
+  // with the RNTI at the target eNB.
+  for (auto const &packet : ctx.queue [Direction::DLINK])
+    {
+      target->Enqueue (Direction::DLINK, targetRnti, packet);
+    }
+  for (auto const &packet : ctx.queue [Direction::ULINK])
+    {
+      EpsBearerTag tag;
+      packet->RemovePacketTag (tag);
+      tag.SetRnti (targetRnti);
+      packet->AddPacketTag (tag);
+      target->Enqueue (Direction::ULINK, targetRnti, packet);
+    }
+
+  std::map<uint8_t, uint32_t> teidByBid = ctx.teidByBid;
+  m_forwardTo [rnti] = EnbRnti_t (target, targetRnti);
+  m_ueContexts.erase (it);
+  return teidByBid;
+}
+
+void
+AbstractEnbNetDevice::ReleaseUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  m_forwardTo.erase (rnti);
+  m_s1SapProvider->UeContextRelease (rnti);
+}
+
+void
+AbstractEnbNetDevice::Enqueue (Direction dir, uint16_t rnti,
+                               Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << dir << rnti << packet);
+
+  auto it = m_ueContexts.find (rnti);
+  if (it == m_ueContexts.end ())
+    {
+      NS_LOG_WARN ("UE context not found, discarding packet.");
+      m_dropTrace (packet);
+      return;
+    }
+
+  UeContext &ctx = it->second;
+  if (ctx.bytes [dir] + packet->GetSize () > m_maxQueueBytes)
+    {
+      NS_LOG_DEBUG ("Queue full for RNTI " << rnti << ", dropping packet.");
+      m_dropTrace (packet);
+      return;
+    }
+
+  ctx.queue [dir].push_back (packet);
+  ctx.bytes [dir] += packet->GetSize ();
+
+  // Start the transmission if this UE has no packet in transmission yet.
+  if (!ctx.txPkt [dir])
+    {
+      UpdateVirtualTime (dir);
+      StartTx (dir, rnti);
+      ScheduleTxComplete (dir);
+    }
+}
+
+void
+AbstractEnbNetDevice::StartTx (Direction dir, uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << dir << rnti);
+
+  UeContext &ctx = m_ueContexts [rnti];
+  NS_ASSERT (!ctx.txPkt [dir]);
+  while (!ctx.queue [dir].empty ())
+    {
+      Ptr<Packet> packet = ctx.queue [dir].front ();
+      ctx.queue [dir].pop_front ();
+      ctx.bytes [dir] -= packet->GetSize ();
+
+      // Drop the packet when the UE is out of coverage.
+      DataRate rate = (dir == Direction::DLINK) ?
+        ctx.ueDev->GetDlRate () : ctx.ueDev->GetUlRate ();
+      if (rate.GetBitRate () == 0)
+        {
+          NS_LOG_DEBUG ("No achievable rate for RNTI " << rnti <<
+                        ", dropping packet.");
+          m_dropTrace (packet);
+          continue;
+        }
+
+      // The packet finishes after its transmission time at the full rate for
+      // this UE, in virtual time.
+      ctx.txPkt [dir] = packet;
+      ctx.finish [dir] = m_virtualTime [dir] +
+        rate.CalculateBytesTxTime (packet->GetSize ()).GetSeconds ();
+      m_txing [dir].insert (std::make_pair (ctx.finish [dir], rnti));
+      return;
+    }
+}
+
+void
+AbstractEnbNetDevice::UpdateVirtualTime (Direction dir)
+{
+  NS_LOG_FUNCTION (this << dir);
+
+  if (!m_txing [dir].empty ())
+    {
+      Time elapsed = Simulator::Now () - m_virtualUpdate [dir];
+      m_virtualTime [dir] += elapsed.GetSeconds () / m_txing [dir].size ();
+    }
+  m_virtualUpdate [dir] = Simulator::Now ();
+}
+
+void
+AbstractEnbNetDevice::ScheduleTxComplete (Direction dir)
+{
+  NS_LOG_FUNCTION (this << dir);
+
+  m_txEvent [dir].Cancel ();
+  if (!m_txing [dir].empty ())
+    {
+      // With N packets in transmission, the virtual time advances at 1/N of
+      // the real time.
+      double left = m_txing [dir].begin ()->first - m_virtualTime [dir];
+      Time delay = Seconds (std::max (left, 0.0) * m_txing [dir].size ());
+      m_txEvent [dir] = Simulator::Schedule (
+          delay, &AbstractEnbNetDevice::TxComplete, this, dir);
+    }
+}
+
+void
+AbstractEnbNetDevice::TxComplete (Direction dir)
+{
+  NS_LOG_FUNCTION (this << dir);
+
+  UpdateVirtualTime (dir);
+  uint16_t rnti = m_txing [dir].begin ()->second;
+  m_txing [dir].erase (m_txing [dir].begin ());
+
+  UeContext &ctx = m_ueContexts [rnti];
+  Ptr<AbstractUeNetDevice> ueDev = ctx.ueDev;
+  Ptr<Packet> packet = ctx.txPkt [dir];
+  ctx.txPkt [dir] = 0;
+
+  // Update the transmissions before delivering the packet, as it may trigger
+  // new packets to this eNB.
+  StartTx (dir, rnti);
+  ScheduleTxComplete (dir);
+
+  if (dir == Direction::DLINK)
+    {
+      ueDev->Receive (packet);
+    }
+  else
+    {
+      // Deliver to the EpcEnbApplication over the LTE packet socket.
+      LteNetDevice::Receive (packet);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,247 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef ABSTRACT_ENB_NET_DEVICE_H
+#define ABSTRACT_ENB_NET_DEVICE_H
+
+#include <deque>
+#include <set>
+#include <ns3/antenna-module.h>
+#include <ns3/core-module.h>
+#include <ns3/lte-module.h>
+#include <ns3/network-module.h>
+#include "../uni5on-common.h"
+
+namespace ns3 {
+
+class AbstractUeNetDevice;
+
+/**
+ * \ingroup uni5onInfra
+ * eNB network device for the abstract radio access mode. This device replaces
+ * the LTE protocol stack at the eNB, including the RRC entity that interacts
+ * with the EpcEnbApplication over the S1 SAP. Packets are queued per UE and
+ * direction, and the radio resources of each direction are equally shared
+ * among UEs with queued packets (processor sharing): with N active UEs, each
+ * one transmits its head-of-line packet at 1/N of its achievable rate, which
+ * is taken from a precomputed SINR-to-throughput table. Transmissions are
+ * tracked in virtual time, so the simulation cost depends on the number of
+ * packets (with logarithmic cost on the number of active UEs), not on the
+ * number of subframes.
+ */
+class AbstractEnbNetDevice : public LteNetDevice
+{
+  friend class MemberEpcEnbS1SapUser<AbstractEnbNetDevice>;
+
+public:
+  AbstractEnbNetDevice ();          //!< Default constructor.
+  virtual ~AbstractEnbNetDevice (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \name Private member accessors.
+   * \return The requested value.
+   */
+  //\{
+  Ptr<AntennaModel> GetAntenna        (void) const;
+  uint16_t          GetCellId         (void) const;
+  uint16_t          GetDlBandwidth    (void) const;
+  double            GetNoiseFigure    (void) const;
+  double            GetTxPower        (void) const;
+  uint16_t          GetUlBandwidth    (void) const;
+  //\}
+
+  /**
+   * Get the achievable rate for the given SINR, using the precomputed
+   * SINR-to-throughput table for this eNB.
+   * \param sinrDb The SINR (dB).
+   * \param dir The link direction.
+   * \return The achievable rate.
+   */
+  DataRate GetAchievableRate (double sinrDb, Direction dir) const;
+
+  /**
+   * Attach the UE to this eNB, notifying the EpcEnbApplication.
+   * \param ueDev The UE device.
+   */
+  void Attach (Ptr<AbstractUeNetDevice> ueDev);
+
+  /**
+   * Handover the UE from its current serving eNB to this eNB. Packets queued
+   * at the source eNB are forwarded to this eNB, and the EpcEnbApplication is
+   * notified to switch the S1-U path.
+   * \param ueDev The UE device.
+   */
+  void HandoverIn (Ptr<AbstractUeNetDevice> ueDev);
+
+  /**
+   * Enqueue an uplink packet received from the UE.
+   * \param rnti The UE RNTI.
+   * \param bearerId The EPS bearer ID.
+   * \param packet The packet.
+   */
+  void EnqueueUplink (uint16_t rnti, uint8_t bearerId, Ptr<Packet> packet);
+
+  /**
+   * \name S1 SAP accessors.
+   */
+  //\{
+  EpcEnbS1SapUser* GetS1SapUser (void);
+  void SetS1SapProvider (EpcEnbS1SapProvider *s);
+  //\}
+
+  // Inherited from NetDevice.
+  bool Send (Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+  // Inherited from ObjectBase.
+  void NotifyConstructionCompleted (void);
+
+private:
+  /** Radio context for a UE served by this eNB. */
+  struct UeContext
+  {
+    Ptr<AbstractUeNetDevice>    ueDev;                //!< UE device.
+    std::map<uint8_t, uint32_t> teidByBid;            //!< TEID by bearer ID.
+    std::deque<Ptr<Packet> >    queue [N_DIRECTIONS]; //!< Packet queues.
+    uint32_t                    bytes [N_DIRECTIONS]; //!< Queued bytes.
+    Ptr<Packet>                 txPkt [N_DIRECTIONS]; //!< Packets in TX.
+    double                      finish [N_DIRECTIONS]; //!< Virtual finish.
+  };
+
+  /**
+   * \name Methods for the S1 SAP user.
+   * \param params The message parameters.
+   */
+  //\{
+  void DoDataRadioBearerSetupRequest (
+    EpcEnbS1SapUser::DataRadioBearerSetupRequestParameters params);
+  void DoPathSwitchRequestAcknowledge (
+    EpcEnbS1SapUser::PathSwitchRequestAcknowledgeParameters params);
+  //\}
+
+  /**
+   * Create a new UE context at this eNB.
+   * \param ueDev The UE device.
+   * \return The RNTI assigned to this UE.
+   */
+  uint16_t AddUe (Ptr<AbstractUeNetDevice> ueDev);
+
+  /**
+   * Remove the UE context after a handover to the target eNB, moving queued
+   * packets to the target and forwarding further downlink packets to it
+   * until the UE context is released.
+   * \param rnti The UE RNTI at this eNB.
+   * \param target The target eNB device.
+   * \param targetRnti The UE RNTI at the target eNB.
+   * \return The S1-U TEID by bearer ID for this UE.
+   */
+  std::map<uint8_t, uint32_t> HandoverOut (
+    uint16_t rnti, Ptr<AbstractEnbNetDevice> target, uint16_t targetRnti);
+
+  /**
+   * Release the UE context at the EpcEnbApplication after a handover.
+   * \param rnti The UE RNTI at this eNB.
+   */
+  void ReleaseUe (uint16_t rnti);
+
+  /**
+   * Enqueue the packet for transmission.
+   * \param dir The link direction.
+   * \param rnti The UE RNTI.
+   * \param packet The packet.
+   */
+  void Enqueue (Direction dir, uint16_t rnti, Ptr<Packet> packet);
+
+  /**
+   * Start the transmission of the next queued packet for the UE in the given
+   * direction, dropping packets while the UE is out of coverage. The virtual
+   * time must be up to date.
+   * \param dir The link direction.
+   * \param rnti The UE RNTI.
+   */
+  void StartTx (Direction dir, uint16_t rnti);
+
+  /**
+   * Advance the virtual time in the given direction up to now. The virtual
+   * time advances at 1/N of the real time with N packets in transmission, so
+   * it must be updated before any change in the number of transmissions.
+   * \param dir The link direction.
+   */
+  void UpdateVirtualTime (Direction dir);
+
+  /**
+   * Schedule the completion of the packet with the earliest virtual finish
+   * time in the given direction, replacing any previous schedule.
+   * \param dir The link direction.
+   */
+  void ScheduleTxComplete (Direction dir);
+
+  /**
+   * Finish the transmission of the packet with the earliest virtual finish
+   * time, delivering it to the UE (downlink) or to the EpcEnbApplication
+   * (uplink).
+   * \param dir The link direction.
+   */
+  void TxComplete (Direction dir);
+
+  /** A pair of eNB device and RNTI used during handovers. */
+  typedef std::pair<Ptr<AbstractEnbNetDevice>, uint16_t> EnbRnti_t;
+
+  uint16_t                      m_cellId;         //!< Cell ID.
+  uint16_t                      m_dlBandwidth;    //!< DL bandwidth (RBs).
+  uint16_t                      m_ulBandwidth;    //!< UL bandwidth (RBs).
+  double                        m_txPower;        //!< TX power (dBm).
+  double                        m_noiseFigure;    //!< Noise figure (dB).
+  double                        m_overhead;       //!< Control overhead.
+  uint32_t                      m_maxQueueBytes;  //!< Queue size per UE.
+  Ptr<AntennaModel>             m_antenna;        //!< Antenna model.
+  uint16_t                      m_rntiCounter;    //!< RNTI counter.
+  std::map<uint16_t, UeContext> m_ueContexts;     //!< UE contexts by RNTI.
+  std::map<uint16_t, EnbRnti_t> m_forwardTo;      //!< Forward to target.
+  std::map<uint16_t, EnbRnti_t> m_handoverFrom;   //!< Pending handovers.
+  EpcEnbS1SapProvider          *m_s1SapProvider;  //!< S1 SAP provider.
+  EpcEnbS1SapUser              *m_s1SapUser;      //!< S1 SAP user.
+
+  /** Virtual finish time and RNTI of packets in TX per direction. */
+  std::set<std::pair<double, uint16_t> > m_txing [N_DIRECTIONS];
+  /** Virtual time (s) per direction. */
+  double                        m_virtualTime [N_DIRECTIONS];
+  /** Real time of the last virtual time update per direction. */
+  Time                          m_virtualUpdate [N_DIRECTIONS];
+  /** Next TX completion event per direction. */
+  EventId                       m_txEvent [N_DIRECTIONS];
+  /** Precomputed achievable rates by CQI index per direction. */
+  std::vector<DataRate>         m_rateTable [N_DIRECTIONS];
+
+  /** Trace source fired when a packet is dropped at the radio queues. */
+  TracedCallback<Ptr<const Packet> > m_dropTrace;
+};
+
+} // namespace ns3
+#endif // ABSTRACT_ENB_NET_DEVICE_H
@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "abstract-ue-net-device.h"
+#include "abstract-enb-net-device.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AbstractUeNetDevice");
+NS_OBJECT_ENSURE_REGISTERED (AbstractUeNetDevice);
+
+AbstractUeNetDevice::AbstractUeNetDevice ()
+  : m_enbDev (0),
+  m_rnti (0),
+  m_dlRate (0),
+  m_ulRate (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  SetAddress (Mac64Address::Allocate ());
+}
+
+AbstractUeNetDevice::~AbstractUeNetDevice ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+AbstractUeNetDevice::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AbstractUeNetDevice")
+    .SetParent<LteNetDevice> ()
+    .AddConstructor<AbstractUeNetDevice> ()
+    .AddAttribute ("Imsi", "The UE IMSI.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&AbstractUeNetDevice::m_imsi),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("TxPower", "The UE TX power (dBm).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (23.0),
+                   MakeDoubleAccessor (&AbstractUeNetDevice::m_txPower),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("NoiseFigure", "The UE noise figure (dB).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (9.0),
+                   MakeDoubleAccessor (&AbstractUeNetDevice::m_noiseFigure),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+DataRate
+AbstractUeNetDevice::GetDlRate (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_dlRate;
+}
+
+Ptr<AbstractEnbNetDevice>
+AbstractUeNetDevice::GetEnb (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_enbDev;
+}
+
+uint64_t
+AbstractUeNetDevice::GetImsi (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_imsi;
+}
+
+double
+AbstractUeNetDevice::GetNoiseFigure (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_noiseFigure;
+}
+
+uint16_t
+AbstractUeNetDevice::GetRnti (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_rnti;
+}
+
+double
+AbstractUeNetDevice::GetTxPower (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_txPower;
+}
+
+DataRate
+AbstractUeNetDevice::GetUlRate (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_ulRate;
+}
+
+void
+AbstractUeNetDevice::SetRates (DataRate dlRate, DataRate ulRate)
+{
+  NS_LOG_FUNCTION (this << dlRate << ulRate);
+
+  m_dlRate = dlRate;
+  m_ulRate = ulRate;
+}
+
+void
+AbstractUeNetDevice::ActivateEpsBearer (uint8_t bearerId, Ptr<EpcTft> tft)
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (bearerId) << tft);
+
+  m_tftClassifier.Add (tft, bearerId);
+}
+
+bool
+AbstractUeNetDevice::Send (Ptr<Packet> packet, const Address& dest,
+                           uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION (this << packet << dest << protocolNumber);
+
+  NS_ASSERT_MSG (protocolNumber == Ipv4L3Protocol::PROT_NUMBER,
+                 "Unsupported protocol number.");
+
+  if (!m_enbDev)
+    {
+      NS_LOG_WARN ("UE not attached, discarding packet.");
+      return false;
+    }
+
+  uint32_t id = m_tftClassifier.Classify (packet, EpcTft::UPLINK);
+  NS_ASSERT ((id & 0xFFFFFF00) == 0);
+  uint8_t bearerId = static_cast<uint8_t> (id & 0x000000FF);
+  if (bearerId == 0)
+    {
+      NS_LOG_WARN ("No matching bearer, discarding packet.");
+      return false;
+    }
+
+  m_enbDev->EnqueueUplink (m_rnti, bearerId, packet);
+  return true;
+}
+
+void
+AbstractUeNetDevice::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_enbDev = 0;
+  LteNetDevice::DoDispose ();
+}
+
+void
+AbstractUeNetDevice::SetEnb (Ptr<AbstractEnbNetDevice> enbDev, uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << enbDev << rnti);
+
+  m_enbDev = enbDev;
+  m_rnti = rnti;
+}
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef ABSTRACT_UE_NET_DEVICE_H
+#define ABSTRACT_UE_NET_DEVICE_H
+
+#include <ns3/core-module.h>
+#include <ns3/lte-module.h>
+#include <ns3/network-module.h>
+
+namespace ns3 {
+
+class AbstractEnbNetDevice;
+
+/**
+ * \ingroup uni5onInfra
+ * UE network device for the abstract radio access mode. This device replaces
+ * the LTE protocol stack (NAS, RRC, PDCP, RLC, MAC, and PHY) at the UE. It
+ * classifies uplink packets into EPS bearers using the TFTs of active bearers
+ * and hands them to the serving AbstractEnbNetDevice, which shapes the traffic
+ * at the achievable rates for this UE.
+ */
+class AbstractUeNetDevice : public LteNetDevice
+{
+  friend class AbstractEnbNetDevice;
+
+public:
+  AbstractUeNetDevice ();           //!< Default constructor.
+  virtual ~AbstractUeNetDevice ();  //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \name Private member accessors.
+   * \return The requested value.
+   */
+  //\{
+  DataRate                  GetDlRate       (void) const;
+  Ptr<AbstractEnbNetDevice> GetEnb          (void) const;
+  uint64_t                  GetImsi         (void) const;
+  double                    GetNoiseFigure  (void) const;
+  uint16_t                  GetRnti         (void) const;
+  double                    GetTxPower      (void) const;
+  DataRate                  GetUlRate       (void) const;
+  //\}
+
+  /**
+   * Set the achievable downlink and uplink rates for this UE, considering the
+   * current radio conditions with the serving eNB.
+   * \param dlRate The downlink rate.
+   * \param ulRate The uplink rate.
+   */
+  void SetRates (DataRate dlRate, DataRate ulRate);
+
+  /**
+   * Activate the EPS bearer, so uplink packets matching its TFT are sent over
+   * this bearer. This replaces the EpcUeNas::ActivateEpsBearer method.
+   * \param bearerId The EPS bearer ID.
+   * \param tft The bearer traffic flow template.
+   */
+  void ActivateEpsBearer (uint8_t bearerId, Ptr<EpcTft> tft);
+
+  // Inherited from NetDevice.
+  bool Send (Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * Set the serving eNB for this UE.
+   * \param enbDev The serving eNB device.
+   * \param rnti The RNTI assigned by the serving eNB.
+   */
+  void SetEnb (Ptr<AbstractEnbNetDevice> enbDev, uint16_t rnti);
+
+  uint64_t                  m_imsi;           //!< UE IMSI.
+  double                    m_txPower;        //!< UE TX power (dBm).
+  double                    m_noiseFigure;    //!< UE noise figure (dB).
+  Ptr<AbstractEnbNetDevice> m_enbDev;         //!< Serving eNB device.
+  uint16_t                  m_rnti;           //!< RNTI at the serving eNB.
+  DataRate                  m_dlRate;         //!< Achievable downlink rate.
+  DataRate                  m_ulRate;         //!< Achievable uplink rate.
+  EpcTftClassifier          m_tftClassifier;  //!< Uplink TFT classifier.
+};
+
+} // namespace ns3
+#endif // ABSTRACT_UE_NET_DEVICE_H
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include "backhaul-controller.h"
+#include "../metadata/enb-info.h"
 #include "../metadata/link-info.h"
 #include "backhaul-network.h"
 
@@ -29,6 +30,7 @@ NS_LOG_COMPONENT_DEFINE ("BackhaulController");
 NS_OBJECT_ENSURE_REGISTERED (BackhaulController);
 
 BackhaulController::BackhaulController ()
+  : m_nSlices (GetNSlices ())
 {
   NS_LOG_FUNCTION (this);
 }
@@ -74,7 +76,8 @@ BackhaulController::GetTypeId (void)
                    MakeEnumChecker (OpMode::OFF, OpModeStr (OpMode::OFF),
                                     OpMode::ON,  OpModeStr (OpMode::ON)))
     .AddAttribute ("SliceMode",
-                   "Inter-slice operation mode.",
+                   "Inter-slice operation mode. The mesh backhaul controller "
+                   "supports only the none mode.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    EnumValue (SliceMode::NONE),
                    MakeEnumAccessor (&BackhaulController::m_sliceMode),
@@ -109,6 +112,15 @@ BackhaulController::GetTypeId (void)
                    DoubleValue (0.9),
                    MakeDoubleAccessor (&BackhaulController::m_swBlockThs),
                    MakeDoubleChecker<double> (0.8, 1.0))
+
+    .AddTraceSource ("MsgTx", "OpenFlow messages sent to switches.",
+                     MakeTraceSourceAccessor (
+                       &BackhaulController::m_msgTxTrace),
+                     "ns3::BackhaulController::CtrlMsgTracedCallback")
+    .AddTraceSource ("MsgRx", "OpenFlow messages received from switches.",
+                     MakeTraceSourceAccessor (
+                       &BackhaulController::m_msgRxTrace),
+                     "ns3::BackhaulController::CtrlMsgTracedCallback")
   ;
   return tid;
 }
@@ -183,6 +195,8 @@ BackhaulController::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_pathCache.clear ();
+  m_invPathCache.clear ();
   m_sliceCtrlById.clear ();
   OFSwitch13Controller::DoDispose ();
 }
@@ -203,6 +217,222 @@ BackhaulController::NotifyConstructionCompleted (void)
   OFSwitch13Controller::NotifyConstructionCompleted ();
 }
 
+bool
+BackhaulController::BearerRequest (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  // Reset the shortest path for the S1-U interface (the handover procedure may
+  // have changed the eNB switch index.)
+  SetShortestPath (rInfo, LteIface::S1);
+
+  // Part 1: Check for the available resources on the S5 interface.
+  bool s5Ok = HasAvailableResources (rInfo, LteIface::S5);
+  if (!s5Ok)
+    {
+      NS_ASSERT_MSG (rInfo->IsBlocked (), "This bearer should be blocked.");
+      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
+                   " because there are no resources for the S5 interface.");
+    }
+
+  // Part 2: Check for the available resources on the S1-U interface.
+  // To avoid errors when reserving bit rates, check for overlapping links.
+  LinkInfoSet_t s5Links;
+  GetLinkSet (rInfo, LteIface::S5, &s5Links);
+  bool s1Ok = HasAvailableResources (rInfo, LteIface::S1, &s5Links);
+  if (!s1Ok)
+    {
+      NS_ASSERT_MSG (rInfo->IsBlocked (), "This bearer should be blocked.");
+      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
+                   " because there are no resources for the S1-U interface.");
+    }
+
+  return (s5Ok && s1Ok);
+}
+
+bool
+BackhaulController::BearerReserve (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo);
+
+  NS_ASSERT_MSG (!rInfo->IsBlocked (), "Bearer should not be blocked.");
+  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
+
+  bool success = true;
+  success &= BitRateReserve (rInfo, LteIface::S5);
+  success &= BitRateReserve (rInfo, LteIface::S1);
+  return success;
+}
+
+bool
+BackhaulController::BearerRelease (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo);
+
+  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
+
+  bool success = true;
+  success &= BitRateRelease (rInfo, LteIface::S5);
+  success &= BitRateRelease (rInfo, LteIface::S1);
+  return success;
+}
+
+bool
+BackhaulController::BearerInstall (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  NS_ASSERT_MSG (rInfo->IsGwInstalled (), "Gateway rules not installed.");
+  NS_LOG_INFO ("Installing backhaul rules for teid " << rInfo->GetTeidHex ());
+
+  bool success = true;
+  success &= RulesInstall (rInfo, LteIface::S5);
+  success &= RulesInstall (rInfo, LteIface::S1);
+  return success;
+}
+
+bool
+BackhaulController::BearerRemove (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  NS_ASSERT_MSG (!rInfo->IsGwInstalled (), "Gateway rules installed.");
+  NS_LOG_INFO ("Removing backhaul rules for teid " << rInfo->GetTeidHex ());
+
+  bool success = true;
+  success &= RulesRemove (rInfo, LteIface::S5);
+  success &= RulesRemove (rInfo, LteIface::S1);
+  return success;
+}
+
+bool
+BackhaulController::BearerUpdate (Ptr<RoutingInfo> rInfo,
+                                  Ptr<EnbInfo> dstEnbInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  NS_ASSERT_MSG (rInfo->IsGwInstalled (), "Gateway rules not installed.");
+  NS_ASSERT_MSG (rInfo->GetEnbCellId () != dstEnbInfo->GetCellId (),
+                 "Don't update UE's eNB info before BearerUpdate.");
+  NS_LOG_INFO ("Updating backhaul rules for teid " << rInfo->GetTeidHex ());
+
+  // Each slice has a single P-GW and S-GW, so handover only changes the eNB.
+  // Thus, we only need to modify the S1-U backhaul rules.
+  bool success = true;
+  success &= RulesUpdate (rInfo, LteIface::S1, dstEnbInfo);
+  return success;
+}
+
+void
+BackhaulController::BearerFluidTx (Ptr<RoutingInfo> rInfo, Direction dir,
+                                   uint64_t bytes)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex () << dir << bytes);
+
+  // Walk through the downlink paths, updating the TX bytes in the link
+  // direction used by the traffic.
+  for (LteIface iface : {LteIface::S5, LteIface::S1})
+    {
+      for (auto const &hop : GetDlPath (rInfo, iface))
+        {
+          hop.lInfo->NotifyTxBytes (
+            dir == Direction::DLINK ? hop.fwdDir : hop.bwdDir,
+            rInfo->GetSliceId (), rInfo->GetQosType (), bytes);
+        }
+    }
+}
+
+void
+BackhaulController::CreatePathCache (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Paths are computed for each ordered pair of switches, so each direction
+  // follows its own preference order. The path from a switch to itself is
+  // the empty path used for local routing.
+  uint16_t numSw = GetNSwitches ();
+  m_pathCache.assign (numSw * numSw, std::vector<RoutingPath_t> ());
+  m_invPathCache.assign (numSw * numSw, std::vector<RoutingPath_t> ());
+  for (uint16_t src = 0; src < numSw; src++)
+    {
+      for (uint16_t dst = 0; dst < numSw; dst++)
+        {
+          std::vector<RoutingPath_t> &fwdList = m_pathCache [src * numSw + dst];
+          std::vector<RoutingPath_t> &invList = m_invPathCache [src * numSw + dst];
+          if (src == dst)
+            {
+              fwdList.push_back (RoutingPath_t ());
+              invList.push_back (RoutingPath_t ());
+              continue;
+            }
+
+          for (auto const &swList : FindPaths (src, dst))
+            {
+              NS_ASSERT_MSG (swList.front () == src && swList.back () == dst,
+                             "Invalid routing path.");
+              RoutingPath_t fwdPath;
+              for (size_t i = 0; i + 1 < swList.size (); i++)
+                {
+                  PathHop hop;
+                  hop.srcIdx = swList [i];
+                  hop.dstIdx = swList [i + 1];
+                  std::tie (hop.lInfo, hop.fwdDir, hop.bwdDir) =
+                    GetLinkInfo (hop.srcIdx, hop.dstIdx);
+                  fwdPath.push_back (hop);
+                }
+
+              RoutingPath_t invPath;
+              for (auto it = fwdPath.rbegin (); it != fwdPath.rend (); ++it)
+                {
+                  PathHop hop = *it;
+                  std::swap (hop.srcIdx, hop.dstIdx);
+                  std::swap (hop.fwdDir, hop.bwdDir);
+                  invPath.push_back (hop);
+                }
+
+              fwdList.push_back (fwdPath);
+              invList.push_back (invPath);
+            }
+          NS_ABORT_MSG_IF (fwdList.empty (), "No path from switch " <<
+                           src << " to " << dst << ".");
+          NS_LOG_DEBUG ("Cached " << fwdList.size () << " paths from " <<
+                        "switch " << src << " to " << dst);
+        }
+    }
+}
+
+uint16_t
+BackhaulController::GetNumPaths (uint16_t srcIdx, uint16_t dstIdx) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx);
+
+  NS_ASSERT (std::max (srcIdx, dstIdx) < GetNSwitches ());
+  NS_ASSERT_MSG (!m_pathCache.empty (), "Routing path cache not created.");
+  return m_pathCache [srcIdx * GetNSwitches () + dstIdx].size ();
+}
+
+const BackhaulController::RoutingPath_t&
+BackhaulController::GetPath (uint16_t srcIdx, uint16_t dstIdx,
+                             uint16_t index) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx << index);
+
+  NS_ASSERT_MSG (index < GetNumPaths (srcIdx, dstIdx),
+                 "Invalid routing path index.");
+  return m_pathCache [srcIdx * GetNSwitches () + dstIdx][index];
+}
+
+const BackhaulController::RoutingPath_t&
+BackhaulController::GetInvPath (uint16_t srcIdx, uint16_t dstIdx,
+                                uint16_t index) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx << index);
+
+  NS_ASSERT_MSG (index < GetNumPaths (srcIdx, dstIdx),
+                 "Invalid routing path index.");
+  return m_invPathCache [srcIdx * GetNSwitches () + dstIdx][index];
+}
+
 void
 BackhaulController::DpctlSchedule (Time delay, uint64_t dpId,
                                    const std::string textCmd)
@@ -213,6 +443,17 @@ BackhaulController::DpctlSchedule (Time delay, uint64_t dpId,
                        this, dpId, textCmd);
 }
 
+int
+BackhaulController::DpctlExecute (uint64_t dpId, const std::string textCmd)
+{
+  NS_LOG_FUNCTION (this << dpId << textCmd);
+
+  CtrlMsgTrace::WallTime_t start = m_msgTxTrace.Start ();
+  int error = OFSwitch13Controller::DpctlExecute (dpId, textCmd);
+  m_msgTxTrace.NotifyDpctl (dpId, textCmd, start);
+  return error;
+}
+
 double
 BackhaulController::GetFlowTableUse (uint16_t idx, uint8_t tableId) const
 {
@@ -276,10 +517,30 @@ BackhaulController::GetSliceTable (SliceId slice) const
   return static_cast<int> (slice) + 2;
 }
 
+uint16_t
+BackhaulController::GetBandwTable (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_nSlices + 2;
+}
+
+uint16_t
+BackhaulController::GetOutputTable (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_nSlices + 3;
+}
+
 void
 BackhaulController::NotifyBearerCreated (Ptr<RoutingInfo> rInfo)
 {
   NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  // Set the downlink shortest path for both S1-U and S5 interfaces.
+  SetShortestPath (rInfo, LteIface::S5);
+  SetShortestPath (rInfo, LteIface::S1);
 }
 
 void
@@ -302,7 +563,7 @@ BackhaulController::NotifyEpcAttach (
         << " eth_type="     << IPV4_PROT_NUM
         << ",ip_dst="       << Ipv4AddressHelper::GetAddress (epcDev)
         << " write:output=" << portNo
-        << " goto:"         << OUTPT_TAB;
+        << " goto:"         << GetOutputTable ();
     DpctlExecute (swDev->GetDatapathId (), cmd.str ());
   }
   //
@@ -430,10 +691,11 @@ BackhaulController::HandleError (
 {
   NS_LOG_FUNCTION (this << swtch << xid);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
+  uint32_t bytes = sizeof (struct ofp_error_msg) + msg->data_length;
+
   // Print the message.
-  char *cStr = ofl_msg_to_string ((struct ofl_msg_header*)msg, 0);
-  std::string msgStr (cStr);
-  free (cStr);
+  std::string msgStr = OflMsgToString ((struct ofl_msg_header*)msg);
 
   // All handlers must free the message when everything is ok.
   ofl_msg_free ((struct ofl_msg_header*)msg, 0);
@@ -445,6 +707,8 @@ BackhaulController::HandleError (
             << " from switch id " << swtch->GetDpId ()
             << " with error message: " << msgStr
             << std::endl;
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "error", bytes, start);
   return 0;
 }
 
@@ -455,18 +719,13 @@ BackhaulController::HandleFlowRemoved (
 {
   NS_LOG_FUNCTION (this << swtch << xid << msg->stats->cookie);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
   uint32_t teid = CookieGetTeid (msg->stats->cookie);
   uint16_t prio = msg->stats->priority;
 
-  // Print the message.
-  char *cStr = ofl_msg_to_string ((struct ofl_msg_header*)msg, 0);
-  std::string msgStr (cStr);
-  free (cStr);
-
-  // All handlers must free the message when everything is ok.
-  ofl_msg_free_flow_removed (msg, true, 0);
-
-  NS_LOG_DEBUG ("Flow removed: " << msgStr);
+  // The message text is rendered only when it's actually printed.
+  NS_LOG_DEBUG ("Flow removed: " <<
+                OflMsgToString ((struct ofl_msg_header*)msg));
 
   // Check for existing routing information for this bearer.
   Ptr<RoutingInfo> rInfo = RoutingInfo::GetPointer (teid);
@@ -478,26 +737,34 @@ BackhaulController::HandleFlowRemoved (
     {
       NS_LOG_INFO ("Rule removed from switch dp " << swtch->GetDpId () <<
                    " for inactive bearer teid " << rInfo->GetTeidHex ());
-      return 0;
     }
 
   // 2) The application is running and the bearer is active, but the bearer
   // priority was increased and this removed flow rule is an old one.
-  if (rInfo->GetPriority () > prio)
+  else if (rInfo->GetPriority () > prio)
     {
       NS_LOG_INFO ("Rule removed from switch dp " << swtch->GetDpId () <<
                    " for bearer teid " << rInfo->GetTeidHex () <<
                    " with old priority " << prio);
-      return 0;
     }
 
   // 3) The application is running, the bearer is active, and the bearer
   // priority is the same of the removed rule. This is a critical situation!
   // For some reason, the flow rule was removed so we are going to abort the
   // program to avoid wrong results.
-  NS_ASSERT_MSG (rInfo->GetPriority () == prio, "Invalid flow priority.");
-  NS_ABORT_MSG ("Rule removed for active bearer. " <<
-                "OpenFlow flow removed message: " << msgStr);
+  else
+    {
+      NS_ASSERT_MSG (rInfo->GetPriority () == prio, "Invalid flow priority.");
+      NS_ABORT_MSG ("Rule removed for active bearer. " <<
+                    "OpenFlow flow removed message: " <<
+                    OflMsgToString ((struct ofl_msg_header*)msg));
+    }
+
+  // All handlers must free the message when everything is ok.
+  ofl_msg_free_flow_removed (msg, true, 0);
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "flow-removed",
+                       sizeof (struct ofp_flow_removed), start);
   return 0;
 }
 
@@ -508,6 +775,9 @@ BackhaulController::HandlePacketIn (
 {
   NS_LOG_FUNCTION (this << swtch << xid);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
+  uint32_t bytes = sizeof (struct ofp_packet_in) + msg->data_length;
+
   // Print the message.
   char *cStr = ofl_structs_match_to_string (msg->match, 0);
   std::string msgStr (cStr);
@@ -523,6 +793,8 @@ BackhaulController::HandlePacketIn (
             << " from switch id " << swtch->GetDpId ()
             << " with packet-in message: " << msgStr
             << std::endl;
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "packet-in", bytes, start);
   return 0;
 }
 
@@ -557,9 +829,8 @@ BackhaulController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
   // Classify GTP-U packets on the corresponding logical slice using
   // the GTP-U TEID masked value.
   // Send the packet to the corresponding slice table.
-  for (int s = 0; s < N_SLICE_IDS; s++)
+  for (SliceId slice : GetSliceIds ())
     {
-      SliceId slice = static_cast<SliceId> (s);
       uint32_t sliceTeid = TeidCreate (slice, 0, 0);
 
       std::ostringstream cmd;
@@ -593,9 +864,9 @@ BackhaulController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
   {
     std::ostringstream cmd;
     cmd << "flow-mod cmd=add,prio=0"
-        << ",table="  << BANDW_TAB
+        << ",table="  << GetBandwTable ()
         << ",flags="  << FLAGS_REMOVED_OVERLAP_RESET
-        << " goto:"   << OUTPT_TAB;
+        << " goto:"   << GetOutputTable ();
     DpctlExecute (swDpId, cmd.str ());
   }
 
@@ -612,7 +883,7 @@ BackhaulController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
         {
           std::ostringstream cmd;
           cmd << "flow-mod cmd=add,prio=32"
-              << ",table="        << OUTPT_TAB
+              << ",table="        << GetOutputTable ()
               << ",flags="        << FLAGS_REMOVED_OVERLAP_RESET
               << " eth_type="     << IPV4_PROT_NUM
               << ",ip_dscp="      << static_cast<uint16_t> (it.first)
@@ -626,7 +897,7 @@ BackhaulController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
   {
     std::ostringstream cmd;
     cmd << "flow-mod cmd=add,prio=0"
-        << ",table=" << OUTPT_TAB
+        << ",table=" << GetOutputTable ()
         << ",flags=" << FLAGS_REMOVED_OVERLAP_RESET;
     DpctlExecute (swDpId, cmd.str ());
   }
@@ -958,4 +1229,707 @@ BackhaulController::SlicingMeterInstall (Ptr<LinkInfo> lInfo, SliceId slice)
     }
 }
 
+bool
+BackhaulController::BitRateRequest (
+  Ptr<RoutingInfo> rInfo, LteIface iface, LinkInfoSet_t *overlap) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface << overlap);
+
+  // Ignoring this check for Non-GBR bearers, aggregated bearers,
+  // and local-routing bearers.
+  const RoutingPath_t &path = GetDlPath (rInfo, iface);
+  if (rInfo->IsNonGbr () || path.empty ()
+      || (rInfo->IsAggregated () && GetAggBitRateCheck () == OpMode::OFF))
+    {
+      return true;
+    }
+
+  return BitRateRequest (
+    path,
+    rInfo->GetGbrDlBitRate (),
+    rInfo->GetGbrUlBitRate (),
+    rInfo->GetSliceId (),
+    GetSliceController (rInfo->GetSliceId ())->GetGbrBlockThs (),
+    overlap);
+}
+
+bool
+BackhaulController::BitRateRequest (
+  const RoutingPath_t &path, int64_t fwdBitRate, int64_t bwdBitRate,
+  SliceId slice, double blockThs, LinkInfoSet_t *overlap) const
+{
+  NS_LOG_FUNCTION (this << fwdBitRate << bwdBitRate <<
+                   slice << blockThs << overlap);
+
+  // Walk through links in the given routing path, requesting for the bit rate.
+  bool ok = true;
+  for (auto it = path.begin (); ok && it != path.end (); ++it)
+    {
+      if (overlap && overlap->find (it->lInfo) != overlap->end ())
+        {
+          // Ensure that overlapping links have the requested bandwidth for
+          // both directions, otherwise the BitRateReserve method will fail.
+          int64_t sumBitRate = fwdBitRate + bwdBitRate;
+          ok &= it->lInfo->HasBitRate (it->fwdDir, slice, sumBitRate, blockThs);
+          ok &= it->lInfo->HasBitRate (it->bwdDir, slice, sumBitRate, blockThs);
+        }
+      else
+        {
+          ok &= it->lInfo->HasBitRate (it->fwdDir, slice, fwdBitRate, blockThs);
+          ok &= it->lInfo->HasBitRate (it->bwdDir, slice, bwdBitRate, blockThs);
+        }
+    }
+  return ok;
+}
+
+bool
+BackhaulController::BitRateReserve (Ptr<RoutingInfo> rInfo, LteIface iface)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  NS_ASSERT_MSG (!rInfo->IsBlocked (), "Bearer should not be blocked.");
+  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
+  NS_ASSERT_MSG (!rInfo->IsGbrReserved (iface), "Bit rate already reserved.");
+
+  NS_LOG_INFO ("Reserving resources for teid " << rInfo->GetTeidHex () <<
+               " on interface " << LteIfaceStr (iface));
+
+  // Ignoring bearers without guaranteed bit rate or local-routing bearers.
+  const RoutingPath_t &path = GetDlPath (rInfo, iface);
+  if (!rInfo->HasGbrBitRate () || path.empty ())
+    {
+      return true;
+    }
+  NS_ASSERT_MSG (rInfo->IsGbr (), "Non-GBR bearers should not get here.");
+
+  bool success = BitRateReserve (
+      path,
+      rInfo->GetGbrDlBitRate (),
+      rInfo->GetGbrUlBitRate (),
+      rInfo->GetSliceId ());
+  rInfo->SetGbrReserved (iface, success);
+  return success;
+}
+
+bool
+BackhaulController::BitRateReserve (
+  const RoutingPath_t &path, int64_t fwdBitRate, int64_t bwdBitRate,
+  SliceId slice)
+{
+  NS_LOG_FUNCTION (this << fwdBitRate << bwdBitRate << slice);
+
+  // Walk through links in the given routing path, reserving the bit rate.
+  bool ok = true;
+  for (auto it = path.begin (); ok && it != path.end (); ++it)
+    {
+      ok &= it->lInfo->UpdateResBitRate (it->fwdDir, slice, fwdBitRate);
+      ok &= it->lInfo->UpdateResBitRate (it->bwdDir, slice, bwdBitRate);
+      SlicingMeterAdjust (it->lInfo, slice);
+    }
+
+  NS_ASSERT_MSG (ok, "Error when reserving bit rate.");
+  return ok;
+}
+
+bool
+BackhaulController::BitRateRelease (Ptr<RoutingInfo> rInfo, LteIface iface)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  NS_LOG_INFO ("Releasing resources for teid " << rInfo->GetTeidHex () <<
+               " on interface " << LteIfaceStr (iface));
+
+  // Ignoring when there is no bit rate to release.
+  if (!rInfo->IsGbrReserved (iface))
+    {
+      return true;
+    }
+
+  bool success = BitRateRelease (
+      GetDlPath (rInfo, iface),
+      rInfo->GetGbrDlBitRate (),
+      rInfo->GetGbrUlBitRate (),
+      rInfo->GetSliceId ());
+  rInfo->SetGbrReserved (iface, !success);
+  return success;
+}
+
+bool
+BackhaulController::BitRateRelease (
+  const RoutingPath_t &path, int64_t fwdBitRate, int64_t bwdBitRate,
+  SliceId slice)
+{
+  NS_LOG_FUNCTION (this << fwdBitRate << bwdBitRate << slice);
+
+  // Walk through links in the given routing path, releasing the bit rate.
+  bool ok = true;
+  for (auto it = path.begin (); ok && it != path.end (); ++it)
+    {
+      ok &= it->lInfo->UpdateResBitRate (it->fwdDir, slice, -fwdBitRate);
+      ok &= it->lInfo->UpdateResBitRate (it->bwdDir, slice, -bwdBitRate);
+      SlicingMeterAdjust (it->lInfo, slice);
+    }
+
+  NS_ASSERT_MSG (ok, "Error when releasing bit rate.");
+  return ok;
+}
+
+const BackhaulController::RoutingPath_t&
+BackhaulController::GetDlPath (Ptr<RoutingInfo> rInfo, LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  return GetPath (rInfo->GetSrcDlInfraSwIdx (iface),
+                  rInfo->GetDstDlInfraSwIdx (iface),
+                  GetPathIndex (rInfo, iface));
+}
+
+void
+BackhaulController::GetLinkSet (
+  Ptr<RoutingInfo> rInfo, LteIface iface, LinkInfoSet_t *links) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  NS_ASSERT_MSG (links && links->empty (), "Set of links should be empty.");
+
+  // Walk through the downlink path.
+  for (auto const &hop : GetDlPath (rInfo, iface))
+    {
+      auto ret = links->insert (hop.lInfo);
+      NS_ABORT_MSG_IF (ret.second == false, "Error saving link info.");
+    }
+}
+
+bool
+BackhaulController::HasAvailableResources (
+  Ptr<RoutingInfo> rInfo, LteIface iface, LinkInfoSet_t *overlap)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  // Check for the available resources on the current path.
+  bool bwdOk = BitRateRequest (rInfo, iface, overlap);
+  bool cpuOk = SwitchCpuRequest (rInfo, iface);
+  bool tabOk = SwitchTableRequest (rInfo, iface);
+  if (bwdOk == false || cpuOk == false || tabOk == false)
+    {
+      // We don't have the resources in the current path. Let's check the
+      // alternative cached paths, in decreasing order of preference. When no
+      // path has the resources, the bearer keeps the last checked path and
+      // the block reasons refer to it. For the ring SPF strategy, this is the
+      // inverted path.
+      uint16_t srcIdx = rInfo->GetSrcDlInfraSwIdx (iface);
+      uint16_t dstIdx = rInfo->GetDstDlInfraSwIdx (iface);
+      uint16_t current = GetPathIndex (rInfo, iface);
+      uint16_t numPaths = GetNumPaths (srcIdx, dstIdx);
+      for (uint16_t index = 0; index < numPaths; index++)
+        {
+          if (index == current)
+            {
+              continue;
+            }
+          SetPathIndex (rInfo, iface, index, GetPath (srcIdx, dstIdx, index));
+          bwdOk = BitRateRequest (rInfo, iface, overlap);
+          cpuOk = SwitchCpuRequest (rInfo, iface);
+          tabOk = SwitchTableRequest (rInfo, iface);
+          if (bwdOk && cpuOk && tabOk)
+            {
+              break;
+            }
+        }
+    }
+
+  // Set the blocked flagged when necessary.
+  if (!bwdOk)
+    {
+      rInfo->SetBlocked (RoutingInfo::BACKBAND);
+      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
+                   " because at least one backhaul link is overloaded.");
+    }
+  if (!cpuOk)
+    {
+      rInfo->SetBlocked (RoutingInfo::BACKLOAD);
+      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
+                   " because at least one backhaul switch is overloaded.");
+    }
+  if (!tabOk)
+    {
+      rInfo->SetBlocked (RoutingInfo::BACKTABLE);
+      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
+                   " because at least one backhaul switch table is full.");
+    }
+
+  return (bwdOk && cpuOk && tabOk);
+}
+
+bool
+BackhaulController::RulesInstall (Ptr<RoutingInfo> rInfo, LteIface iface)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  NS_ASSERT_MSG (!rInfo->IsIfInstalled (iface), "Backhaul rules installed.");
+  bool success = true;
+
+  // No rules to install for local-routing bearers.
+  const RoutingPath_t &dlPath = GetDlPath (rInfo, iface);
+  if (dlPath.empty ())
+    {
+      return true;
+    }
+
+  // -------------------------------------------------------------------------
+  // Slice table -- [from higher to lower priority]
+  //
+  // Cookie and MBR meter ID for new rules.
+  uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
+  uint64_t cookie = CookieCreate (
+      iface, rInfo->GetPriority (), rInfo->GetTeid ());
+
+  // Building the dpctl command.
+  std::ostringstream cmd;
+  cmd << "flow-mod cmd=add"
+      << ",table="  << GetSliceTable (rInfo->GetSliceId ())
+      << ",flags="  << FLAGS_REMOVED_OVERLAP_RESET
+      << ",cookie=" << GetUint64Hex (cookie)
+      << ",prio="   << rInfo->GetPriority ()
+      << ",idle="   << rInfo->GetTimeout ();
+  std::string cmdStr = cmd.str ();
+
+  // Configuring downlink routing.
+  if (rInfo->HasDlTraffic ())
+    {
+      if (rInfo->HasMbrDl ())
+        {
+          NS_ASSERT_MSG (!rInfo->IsMbrDlInstalled (iface), "Meter installed.");
+
+          // Install downlink MBR meter entry on the input switch.
+          std::ostringstream met;
+          met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
+              << " drop:rate=" << rInfo->GetMbrDlBitRate () / 1000;
+          std::string metStr = met.str ();
+
+          DpctlExecute (GetDpId (rInfo->GetSrcDlInfraSwIdx (iface)), metStr);
+          rInfo->SetMbrDlInstalled (iface, true);
+        }
+
+      success &= RulesInstall (
+          dlPath,
+          rInfo->GetTeid (),
+          rInfo->GetDstDlAddr (iface),
+          rInfo->GetDscpValue (),
+          rInfo->IsMbrDlInstalled (iface) ? mbrMeterId : 0,
+          cmdStr);
+    }
+
+  // Configuring uplink routing (the inverted downlink path).
+  if (rInfo->HasUlTraffic ())
+    {
+      if (rInfo->HasMbrUl ())
+        {
+          NS_ASSERT_MSG (!rInfo->IsMbrUlInstalled (iface), "Meter installed.");
+
+          // Install uplink MBR meter entry on the input switch.
+          std::ostringstream met;
+          met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
+              << " drop:rate=" << rInfo->GetMbrUlBitRate () / 1000;
+          std::string metStr = met.str ();
+
+          DpctlExecute (GetDpId (rInfo->GetSrcUlInfraSwIdx (iface)), metStr);
+          rInfo->SetMbrUlInstalled (iface, true);
+        }
+
+      success &= RulesInstall (
+          GetInvPath (rInfo->GetSrcDlInfraSwIdx (iface),
+                      rInfo->GetDstDlInfraSwIdx (iface),
+                      GetPathIndex (rInfo, iface)),
+          rInfo->GetTeid (),
+          rInfo->GetDstUlAddr (iface),
+          rInfo->GetDscpValue (),
+          rInfo->IsMbrUlInstalled (iface) ? mbrMeterId : 0,
+          cmdStr);
+    }
+
+  // Update the installed flag for this interface.
+  rInfo->SetIfInstalled (iface, success);
+  return success;
+}
+
+bool
+BackhaulController::RulesInstall (
+  const RoutingPath_t &path, uint32_t teid, Ipv4Address dstAddr, uint16_t dscp,
+  uint32_t meter, std::string cmdStr)
+{
+  NS_LOG_FUNCTION (this << teid << dstAddr << dscp << meter << cmdStr);
+
+  NS_ASSERT_MSG (!path.empty (), "Can't install rules for local routing.");
+
+  // Building the match string (using GTP TEID to identify the bearer and
+  // the IP destination address to identify the logical interface).
+  std::ostringstream mat;
+  mat << " eth_type="   << IPV4_PROT_NUM
+      << ",ip_proto="   << UDP_PROT_NUM
+      << ",ip_dst="     << dstAddr
+      << ",gtpu_teid="  << GetUint32Hex (teid);
+  std::string matStr = mat.str ();
+
+  // Building the instructions string for the first switch.
+  std::ostringstream ins1;
+  if (meter)
+    {
+      ins1 << " meter:" << meter;
+    }
+  if (dscp)
+    {
+      ins1 << " apply:set_field=ip_dscp:" << dscp;
+    }
+  std::string ins1Str = ins1.str ();
+
+  // Installing OpenFlow routing rules, writing the topology actions that
+  // forward packets towards the next switch into action set.
+  for (auto it = path.begin (); it != path.end (); ++it)
+    {
+      std::ostringstream ins;
+      ins << GetHopActions (*it)
+          << " goto:" << GetBandwTable ();
+
+      DpctlExecute (GetDpId (it->srcIdx), cmdStr + matStr +
+                    (it == path.begin () ? ins1Str : std::string ()) +
+                    ins.str ());
+    }
+  return true;
+}
+
+bool
+BackhaulController::RulesRemove (Ptr<RoutingInfo> rInfo, LteIface iface)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  // No rules installed for this interface.
+  if (!rInfo->IsIfInstalled (iface))
+    {
+      return true;
+    }
+
+  // Building the dpctl command. Matching cookie for interface and TEID.
+  uint64_t cookie = CookieCreate (iface, 0, rInfo->GetTeid ());
+  std::ostringstream cmd;
+  cmd << "flow-mod cmd=del"
+      << ",table="        << GetSliceTable (rInfo->GetSliceId ())
+      << ",cookie="       << GetUint64Hex (cookie)
+      << ",cookie_mask="  << GetUint64Hex (COOKIE_IFACE_TEID_MASK);
+  std::string cmdStr = cmd.str ();
+
+  // Walking through the downlink path, including the last switch.
+  DpctlExecute (GetDpId (rInfo->GetSrcDlInfraSwIdx (iface)), cmdStr);
+  for (auto const &hop : GetDlPath (rInfo, iface))
+    {
+      DpctlExecute (GetDpId (hop.dstIdx), cmdStr);
+    }
+
+  // Remove installed MBR meter entries.
+  if (rInfo->HasMbr ())
+    {
+      uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
+
+      std::ostringstream met;
+      met << "meter-mod cmd=del,meter=" << mbrMeterId;
+      std::string metStr = met.str ();
+
+      if (rInfo->IsMbrDlInstalled (iface))
+        {
+          DpctlExecute (GetDpId (rInfo->GetSrcDlInfraSwIdx (iface)), metStr);
+          rInfo->SetMbrDlInstalled (iface, false);
+        }
+      if (rInfo->IsMbrUlInstalled (iface))
+        {
+          DpctlExecute (GetDpId (rInfo->GetSrcUlInfraSwIdx (iface)), metStr);
+          rInfo->SetMbrUlInstalled (iface, false);
+        }
+    }
+
+  // Update the installed flag for this interface.
+  rInfo->SetIfInstalled (iface, false);
+  return true;
+}
+
+bool
+BackhaulController::RulesUpdate (
+  Ptr<RoutingInfo> rInfo, LteIface iface, Ptr<EnbInfo> dstEnbInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface << dstEnbInfo);
+
+  NS_ASSERT_MSG (iface == LteIface::S1, "Only S1-U interface supported.");
+
+  // During this procedure, the eNB was not updated in the rInfo yet.
+  // So, the following methods will return information for the old eNB.
+  // rInfo->GetEnbCellId ()                   // eNB cell ID
+  // rInfo->GetEnbInfraSwIdx ()               // eNB switch index
+  // rInfo->GetDstDlInfraSwIdx (LteIface::S1) // eNB switch index
+  // rInfo->GetSrcUlInfraSwIdx (LteIface::S1) // eNB switch index
+  // rInfo->GetEnbS1uAddr ()                  // eNB S1-U address
+  // rInfo->GetDstDlAddr (LteIface::S1)       // eNB S1-U address
+  // rInfo->GetSrcUlAddr (LteIface::S1)       // eNB S1-U address
+  //
+  // We can't just modify the OpenFlow rules in the backhaul switches because
+  // we need to change the match fields. So, we will schedule the removal of
+  // old low-priority rules from the old routing path and install new rules in
+  // the new routing path (may be the same), using a higher priority and the
+  // dstEnbInfo metadata.
+
+  uint16_t sgwIdx = rInfo->GetSgwInfraSwIdx ();
+  uint16_t oldIdx = rInfo->GetEnbInfraSwIdx ();
+  uint16_t newIdx = dstEnbInfo->GetInfraSwIdx ();
+
+  // MBR meter ID for this bearer (won't change on update).
+  uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
+  bool success = true;
+
+  // Schedule the removal of old low-priority OpenFlow rules.
+  if (rInfo->IsIfInstalled (iface))
+    {
+      // Cookie for old rules. Using old low-priority.
+      uint64_t oldCookie = CookieCreate (
+          iface, rInfo->GetPriority (), rInfo->GetTeid ());
+
+      // Building the dpctl command. Strict matching cookie.
+      std::ostringstream del;
+      del << "flow-mod cmd=del"
+          << ",table="        << GetSliceTable (rInfo->GetSliceId ())
+          << ",cookie="       << GetUint64Hex (oldCookie)
+          << ",cookie_mask="  << GetUint64Hex (COOKIE_STRICT_MASK);
+      std::string delStr = del.str ();
+
+      // Walking through the old S1-U downlink path.
+      DpctlSchedule (MilliSeconds (250), GetDpId (sgwIdx), delStr);
+      for (auto const &hop : GetDlPath (rInfo, iface))
+        {
+          DpctlSchedule (MilliSeconds (250), GetDpId (hop.dstIdx), delStr);
+        }
+
+      // Update the installation flag.
+      rInfo->SetIfInstalled (iface, false);
+    }
+
+  // When changing the switch index, we must release any possible reserved bit
+  // rate from the old path, update the routing path to the new (shortest)
+  // one, and reserve the bit rate on the new path. For bearers with MBR meter,
+  // also remove it from the old switch and install it into the new switch.
+  if (oldIdx != newIdx)
+    {
+      // Release the bit rate from the old path.
+      if (rInfo->IsGbrReserved (iface))
+        {
+          bool ok = BitRateRelease (
+              GetDlPath (rInfo, iface),
+              rInfo->GetGbrDlBitRate (),
+              rInfo->GetGbrUlBitRate (),
+              rInfo->GetSliceId ());
+          rInfo->SetGbrReserved (iface, !ok);
+        }
+
+      // Update the new shortest path from the S-GW to the target eNB.
+      const RoutingPath_t &newPath = GetPath (sgwIdx, newIdx, 0);
+      SetPathIndex (rInfo, iface, 0, newPath);
+
+      // Try to reserve the bit rate on the new path.
+      if (rInfo->HasGbrBitRate () && !newPath.empty ())
+        {
+          // Check for the available bit rate in the new path and reserve it.
+          // There's no need to check for overlapping paths as the bit rate for
+          // the S5 interface is already reserved.
+          bool hasBitRate = BitRateRequest (
+              newPath,
+              rInfo->GetGbrDlBitRate (),
+              rInfo->GetGbrUlBitRate (),
+              rInfo->GetSliceId (),
+              GetSliceController (rInfo->GetSliceId ())->GetGbrBlockThs ());
+          if (hasBitRate)
+            {
+              bool ok = BitRateReserve (
+                  newPath,
+                  rInfo->GetGbrDlBitRate (),
+                  rInfo->GetGbrUlBitRate (),
+                  rInfo->GetSliceId ());
+              rInfo->SetGbrReserved (iface, ok);
+            }
+        }
+
+      // Remove the MBR meters from the old switches.
+      if (rInfo->HasMbr ())
+        {
+          std::ostringstream del;
+          del << "meter-mod cmd=del,meter=" << mbrMeterId;
+          std::string delStr = del.str ();
+
+          // In the uplink, the eNB switch will change for sure (we've already
+          // tested it!). So, schedule the removal of MBR meters from the old
+          // eNB switch.
+          if (rInfo->IsMbrUlInstalled (iface))
+            {
+              DpctlSchedule (MilliSeconds (300), GetDpId (oldIdx), delStr);
+              rInfo->SetMbrUlInstalled (iface, false);
+            }
+
+          // In the downlink, the S-GW switch won't change. But, there's the
+          // special case when the new routing path becomes a local one and we
+          // must remove the meter.
+          if (rInfo->IsMbrDlInstalled (iface) && newPath.empty ())
+            {
+              DpctlSchedule (MilliSeconds (300), GetDpId (sgwIdx), delStr);
+              rInfo->SetMbrDlInstalled (iface, false);
+            }
+        }
+    }
+
+  // Install new high-priority OpenFlow rules for non-local routing paths.
+  uint16_t newIndex = GetPathIndex (rInfo, iface);
+  const RoutingPath_t &newDlPath = GetPath (sgwIdx, newIdx, newIndex);
+  if (!newDlPath.empty ())
+    {
+      // Cookie for new rules. Using new high-priority.
+      uint64_t newCookie = CookieCreate (
+          iface, rInfo->GetPriority () + 1, rInfo->GetTeid ());
+
+      // Building the dpctl command.
+      std::ostringstream cmd;
+      cmd << "flow-mod cmd=add"
+          << ",table="  << GetSliceTable (rInfo->GetSliceId ())
+          << ",flags="  << FLAGS_REMOVED_OVERLAP_RESET
+          << ",cookie=" << GetUint64Hex (newCookie)
+          << ",prio="   << rInfo->GetPriority () + 1
+          << ",idle="   << rInfo->GetTimeout ();
+      std::string cmdStr = cmd.str ();
+
+      // Configuring downlink routing.
+      if (rInfo->HasDlTraffic ())
+        {
+          if (rInfo->HasMbrDl () && !rInfo->IsMbrDlInstalled (iface))
+            {
+              // Install downlink MBR meter entry on the input switch.
+              std::ostringstream met;
+              met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
+                  << " drop:rate=" << rInfo->GetMbrDlBitRate () / 1000;
+              std::string metStr = met.str ();
+
+              DpctlExecute (GetDpId (sgwIdx), metStr);
+              rInfo->SetMbrDlInstalled (iface, true);
+            }
+
+          success &= RulesInstall (
+              newDlPath,
+              rInfo->GetTeid (),
+              dstEnbInfo->GetS1uAddr (),            // Target eNB address.
+              rInfo->GetDscpValue (),
+              rInfo->IsMbrDlInstalled (iface) ? mbrMeterId : 0,
+              cmdStr);
+        }
+
+      // Configuring uplink routing.
+      if (rInfo->HasUlTraffic ())
+        {
+          if (rInfo->HasMbrUl () && !rInfo->IsMbrUlInstalled (iface))
+            {
+              // Install uplink MBR meter entry on the input switch.
+              std::ostringstream met;
+              met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
+                  << " drop:rate=" << rInfo->GetMbrUlBitRate () / 1000;
+              std::string metStr = met.str ();
+
+              DpctlExecute (GetDpId (newIdx), metStr);
+              rInfo->SetMbrUlInstalled (iface, true);
+            }
+
+          success &= RulesInstall (
+              GetInvPath (sgwIdx, newIdx, newIndex),
+              rInfo->GetTeid (),
+              rInfo->GetSgwS1uAddr (),
+              rInfo->GetDscpValue (),
+              rInfo->IsMbrUlInstalled (iface) ? mbrMeterId : 0,
+              cmdStr);
+        }
+
+      // Update the installed flag for this interface.
+      rInfo->SetIfInstalled (iface, success);
+    }
+
+  return success;
+}
+
+void
+BackhaulController::SetShortestPath (Ptr<RoutingInfo> rInfo, LteIface iface)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  SetPathIndex (rInfo, iface, 0,
+                GetPath (rInfo->GetSrcDlInfraSwIdx (iface),
+                         rInfo->GetDstDlInfraSwIdx (iface), 0));
+}
+
+bool
+BackhaulController::SwitchCpuRequest (Ptr<RoutingInfo> rInfo,
+                                      LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  // Ignoring this check when the BlockPolicy mode is OFF.
+  if (GetSwBlockPolicy () == OpMode::OFF)
+    {
+      return true;
+    }
+
+  return SwitchCpuRequest (
+    rInfo->GetSrcDlInfraSwIdx (iface),
+    GetDlPath (rInfo, iface),
+    GetSwBlockThreshold ());
+}
+
+bool
+BackhaulController::SwitchCpuRequest (
+  uint16_t srcIdx, const RoutingPath_t &path, double blockThs) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << blockThs);
+
+  // Walk through switches in the given routing path, requesting for CPU.
+  bool ok = (GetEwmaCpuUse (srcIdx) < blockThs);
+  for (auto it = path.begin (); ok && it != path.end (); ++it)
+    {
+      ok &= (GetEwmaCpuUse (it->dstIdx) < blockThs);
+    }
+  return ok;
+}
+
+bool
+BackhaulController::SwitchTableRequest (Ptr<RoutingInfo> rInfo,
+                                        LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  // Ignoring this check for aggregated bearers.
+  if (rInfo->IsAggregated ())
+    {
+      return true;
+    }
+
+  return SwitchTableRequest (
+    rInfo->GetSrcDlInfraSwIdx (iface),
+    GetDlPath (rInfo, iface),
+    GetSwBlockThreshold (),
+    GetSliceTable (rInfo->GetSliceId ()));
+}
+
+bool
+BackhaulController::SwitchTableRequest (
+  uint16_t srcIdx, const RoutingPath_t &path, double blockThs,
+  uint16_t table) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << blockThs << table);
+
+  // Walk through switches in the given routing path, requesting for table.
+  bool ok = (GetFlowTableUse (srcIdx, table) < blockThs);
+  for (auto it = path.begin (); ok && it != path.end (); ++it)
+    {
+      ok &= (GetFlowTableUse (it->dstIdx, table) < blockThs);
+    }
+  return ok;
+}
+
 } // namespace ns3
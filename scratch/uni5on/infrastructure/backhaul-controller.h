@@ -24,8 +24,6 @@
 // Pipeline tables at OpenFlow backhaul switches.
 #define INPUT_TAB 0
 #define CLASS_TAB 1
-#define BANDW_TAB (static_cast<int> (SliceId::ALL) + 2)
-#define OUTPT_TAB (static_cast<int> (SliceId::ALL) + 3)
 
 #include <ns3/core-module.h>
 #include <ns3/internet-module.h>
@@ -47,11 +45,15 @@ class LinkInfo;
  * This is the abstract base class for the OpenFlow backhaul controller, which
  * should be extended in accordance to the desired backhaul network topology.
  * This controller implements the logic for traffic routing and engineering
- * within the OpenFlow backhaul network.
+ * within the OpenFlow backhaul network. The topology controllers supply the
+ * routing paths between backhaul switches, while this class handles the
+ * bearer admission, bit rate reservation, and OpenFlow rules over them.
  */
 class BackhaulController : public OFSwitch13Controller
 {
   friend class BackhaulNetwork;
+  friend class BackhaulPathsTestCase;
+  friend class ControllerBenchmark;
   friend class SliceController;
   friend class ScenarioHelper;
 
@@ -91,6 +93,16 @@ public:
   OpMode    GetSpareUseMode       (void) const;
   //\}
 
+  /**
+   * TracedCallback signature for OpenFlow messages exchanged with switches.
+   * \param dpId The OpenFlow datapath ID.
+   * \param type The message type.
+   * \param length The message length (see CtrlMsgTrace).
+   * \param wallNs The wall-clock time spent handling the message (ns).
+   */
+  typedef void (*CtrlMsgTracedCallback)(
+    uint64_t dpId, std::string type, uint32_t length, int64_t wallNs);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -98,27 +110,43 @@ protected:
   // Inherited from ObjectBase.
   virtual void NotifyConstructionCompleted (void);
 
+  /** A single hop between two adjacent switches in a routing path. */
+  struct PathHop
+  {
+    uint16_t          srcIdx;   //!< Source switch index.
+    uint16_t          dstIdx;   //!< Destination switch index.
+    Ptr<LinkInfo>     lInfo;    //!< Link between these switches.
+    LinkInfo::LinkDir fwdDir;   //!< Link direction from src to dst.
+    LinkInfo::LinkDir bwdDir;   //!< Link direction from dst to src.
+  };
+
+  /** A routing path as a list of hops from the source switch. */
+  typedef std::vector<PathHop> RoutingPath_t;
+
+  /** A routing path as a list of switch indexes from the source switch. */
+  typedef std::vector<uint16_t> SwitchList_t;
+
   /**
    * Process the bearer request, deciding for the best routing path and
    * checking for the available resources in the backhaul network.
    * \param rInfo The routing information to process.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerRequest (Ptr<RoutingInfo> rInfo) = 0;
+  virtual bool BearerRequest (Ptr<RoutingInfo> rInfo);
 
   /**
    * Reserve the resources for this bearer.
-   * \param rInfo The ring routing information.
+   * \param rInfo The routing information to process.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerReserve (Ptr<RoutingInfo> rInfo) = 0;
+  virtual bool BearerReserve (Ptr<RoutingInfo> rInfo);
 
   /**
    * Release the resources for this bearer.
    * \param rInfo The routing information to process.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerRelease (Ptr<RoutingInfo> rInfo) = 0;
+  virtual bool BearerRelease (Ptr<RoutingInfo> rInfo);
 
   /**
    * Install TEID routing OpenFlow match rules into backhaul switches.
@@ -127,14 +155,14 @@ protected:
    * \param rInfo The routing information to process.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerInstall (Ptr<RoutingInfo> rInfo) = 0;
+  virtual bool BearerInstall (Ptr<RoutingInfo> rInfo);
 
   /**
    * Remove TEID routing OpenFlow match rules from backhaul switches.
    * \param rInfo The routing information to process.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerRemove (Ptr<RoutingInfo> rInfo) = 0;
+  virtual bool BearerRemove (Ptr<RoutingInfo> rInfo);
 
   /**
    * Update TEID routing OpenFlow match rules from backhaul switches after a
@@ -145,8 +173,97 @@ protected:
    * \param dstEnbInfo The destination eNB after the handover procedure.
    * \return True if succeeded, false otherwise.
    */
-  virtual bool BearerUpdate (Ptr<RoutingInfo> rInfo,
-                             Ptr<EnbInfo> dstEnbInfo) = 0;
+  virtual bool BearerUpdate (Ptr<RoutingInfo> rInfo, Ptr<EnbInfo> dstEnbInfo);
+
+  /**
+   * Account for fluid traffic sent over this bearer without packets, updating
+   * the transmitted bytes on all backhaul links in the bearer routing path.
+   * \param rInfo The routing information to process.
+   * \param dir The traffic direction.
+   * \param bytes The number of transmitted bytes.
+   */
+  virtual void BearerFluidTx (Ptr<RoutingInfo> rInfo, Direction dir,
+                              uint64_t bytes);
+
+  /**
+   * Build the routing path cache for every ordered pair of backhaul switches,
+   * using the paths found by the topology controller. The inverted paths are
+   * cached too, so the uplink traffic always follows the same links of the
+   * downlink traffic. Call this method once the topology is built and the
+   * FindPaths method is ready to be used.
+   */
+  void CreatePathCache (void);
+
+  /**
+   * Get the number of cached routing paths between two switches.
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \return The number of cached paths.
+   */
+  uint16_t GetNumPaths (uint16_t srcIdx, uint16_t dstIdx) const;
+
+  /**
+   * Get the cached routing path between two switches. The routing path
+   * between a switch and itself is an empty path (local routing).
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \param index The routing path index.
+   * \return The routing path.
+   */
+  const RoutingPath_t& GetPath (uint16_t srcIdx, uint16_t dstIdx,
+                                uint16_t index) const;
+
+  /**
+   * Get the cached routing path from the destination back to the source
+   * switch that follows the links of the given routing path in the opposite
+   * direction. This is the uplink path for a downlink routing path.
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \param index The routing path index.
+   * \return The inverted routing path.
+   */
+  const RoutingPath_t& GetInvPath (uint16_t srcIdx, uint16_t dstIdx,
+                                   uint16_t index) const;
+
+  /**
+   * Find the routing paths from the source to the destination switch, in
+   * decreasing order of preference. The first one is the default path used
+   * by new bearers, while the others are alternatives checked when the
+   * default path has not enough resources.
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \return The list of routing paths.
+   */
+  virtual std::vector<SwitchList_t> FindPaths (uint16_t srcIdx,
+                                               uint16_t dstIdx) const = 0;
+
+  /**
+   * Get the OpenFlow instructions that forward packets over the given hop.
+   * \param hop The routing path hop.
+   * \return The dpctl instructions string.
+   */
+  virtual std::string GetHopActions (const PathHop &hop) const = 0;
+
+  /**
+   * Get the index of the downlink routing path in use by this bearer for the
+   * given LTE logical interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return The routing path index.
+   */
+  virtual uint16_t GetPathIndex (Ptr<RoutingInfo> rInfo,
+                                 LteIface iface) const = 0;
+
+  /**
+   * Save the downlink routing path in use by this bearer for the given LTE
+   * logical interface into the topology routing metadata.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \param index The routing path index.
+   * \param path The routing path.
+   */
+  virtual void SetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface,
+                             uint16_t index, const RoutingPath_t &path) = 0;
 
   /**
    * Schedule a dpctl command to be executed after a delay.
@@ -156,6 +273,18 @@ protected:
    */
   void DpctlSchedule (Time delay, uint64_t dpId, const std::string textCmd);
 
+  /**
+   * Execute a dpctl command, firing the MsgTx trace source. This hides the
+   * non-virtual OFSwitch13Controller method, so only the commands issued by
+   * uni5on controllers through this method are accounted for. Messages sent
+   * by the OFSwitch13Controller itself (handshake, echo, barrier and commands
+   * queued by its own DpctlSchedule) are not.
+   * \param dpId The OpenFlow datapath ID.
+   * \param textCmd The dpctl command to be executed.
+   * \return 0 if everything's ok, otherwise an error number.
+   */
+  int DpctlExecute (uint64_t dpId, const std::string textCmd);
+
   /**
    * Get the pipeline flow table usage for the given backhaul switch index
    * and pipeline flow table ID.
@@ -209,7 +338,23 @@ protected:
   uint16_t GetSliceTable (SliceId slice) const;
 
   /**
-   * Notify this controller of a new bearer context created.
+   * Get the number of the OpenFlow pipeline table used for slice bandwidth
+   * metering, right after the slice tables in use.
+   * \return The bandwidth pipeline table.
+   */
+  uint16_t GetBandwTable (void) const;
+
+  /**
+   * Get the number of the OpenFlow pipeline table used for output queue
+   * classification. This is the last table in the pipeline.
+   * \return The output pipeline table.
+   */
+  uint16_t GetOutputTable (void) const;
+
+  /**
+   * Notify this controller of a new bearer context created. This sets the
+   * shortest routing paths for the bearer, so the topology controller must
+   * create its routing metadata before chaining up.
    * \param rInfo The routing information to process.
    */
   virtual void NotifyBearerCreated (Ptr<RoutingInfo> rInfo);
@@ -281,8 +426,203 @@ protected:
   void SlicingMeterInstall (Ptr<LinkInfo> lInfo, SliceId slice);
 
 private:
+  /**
+   * Check the available bit rate for this bearer for given LTE interface. This
+   * method checks for "doubled" resources on overlapping links.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \param overlap The optional overlapping links.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateRequest (Ptr<RoutingInfo> rInfo, LteIface iface,
+                       LinkInfoSet_t *overlap = 0) const;
+
+  /**
+   * Check the forward and backward available bit rate on links following the
+   * given routing path. This method checks for "doubled" resources on
+   * overlapping links, respecting the block threshold.
+   * \param path The routing path.
+   * \param fwdBitRate The forwarding bit rate.
+   * \param bwdBitRate The backward bit rate.
+   * \param slice The network slice.
+   * \param blockThs The block threshold.
+   * \param overlap The optional overlapping links.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateRequest (const RoutingPath_t &path,
+                       int64_t fwdBitRate, int64_t bwdBitRate,
+                       SliceId slice, double blockThs,
+                       LinkInfoSet_t *overlap = 0) const;
+
+  /**
+   * Reserve the bit rate for this bearer for the given LTE logical interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateReserve (Ptr<RoutingInfo> rInfo, LteIface iface);
+
+  /**
+   * Reserve the forward and backward bit rate on links following the given
+   * routing path.
+   * \param path The routing path.
+   * \param fwdBitRate The forwarding bit rate.
+   * \param bwdBitRate The backward bit rate.
+   * \param slice The network slice.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateReserve (const RoutingPath_t &path,
+                       int64_t fwdBitRate, int64_t bwdBitRate,
+                       SliceId slice);
+
+  /**
+   * Release the bit rate for this bearer for the given LTE logical interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateRelease (Ptr<RoutingInfo> rInfo, LteIface iface);
+
+  /**
+   * Release the forward and backward bit rate on links following the given
+   * routing path.
+   * \param path The routing path.
+   * \param fwdBitRate The forwarding bit rate.
+   * \param bwdBitRate The backward bit rate.
+   * \param slice The network slice.
+   * \return True if succeeded, false otherwise.
+   */
+  bool BitRateRelease (const RoutingPath_t &path,
+                       int64_t fwdBitRate, int64_t bwdBitRate,
+                       SliceId slice);
+
+  /**
+   * Get the downlink routing path in use by this bearer for the given LTE
+   * logical interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return The routing path.
+   */
+  const RoutingPath_t& GetDlPath (Ptr<RoutingInfo> rInfo,
+                                  LteIface iface) const;
+
+  /**
+   * Get the backhaul lInfo pointers for the given LTE interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \param links The set of links to populate.
+   */
+  void GetLinkSet (Ptr<RoutingInfo> rInfo, LteIface iface,
+                   LinkInfoSet_t *links) const;
+
+  /**
+   * Check for the available resources on the backhaul infrastructure for the
+   * given LTE interface, checking the alternative routing paths when the
+   * current one has not enough resources. When no path has all the requested
+   * resources, the bearer keeps the last checked path and this method must set
+   * the routing information with the block reason.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \param overlap The optional overlapping links.
+   * \return True if succeeded, false otherwise.
+   */
+  bool HasAvailableResources (Ptr<RoutingInfo> rInfo, LteIface iface,
+                              LinkInfoSet_t *overlap = 0);
+
+  /**
+   * Install forwarding rules on switches for the given LTE interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool RulesInstall (Ptr<RoutingInfo> rInfo, LteIface iface);
+
+  /**
+   * Install forwarding rules on switches following the given routing path.
+   * \param path The routing path.
+   * \param teid The TEID value.
+   * \param dstAddr The IP destination address.
+   * \param dscp The DSCP value for this bearer.
+   * \param meter The MBR meter ID for this bearer.
+   * \param cmdStr The OpenFlow dpctl flow mod command.
+   * \return True if succeeded, false otherwise.
+   */
+  bool RulesInstall (const RoutingPath_t &path, uint32_t teid,
+                     Ipv4Address dstAddr, uint16_t dscp, uint32_t meter,
+                     std::string cmdStr);
+
+  /**
+   * Remove forwarding rules from switches for the given LTE interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool RulesRemove (Ptr<RoutingInfo> rInfo, LteIface iface);
+
+  /**
+   * Update forwarding rules on switches for the given LTE interface after a
+   * successful handover procedure.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \param dstEnbInfo The destination eNB after the handover procedure.
+   * \return True if succeeded, false otherwise.
+   */
+  bool RulesUpdate (Ptr<RoutingInfo> rInfo, LteIface iface,
+                    Ptr<EnbInfo> dstEnbInfo);
+
+  /**
+   * Set the downlink routing path to the shortest one.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   */
+  void SetShortestPath (Ptr<RoutingInfo> rInfo, LteIface iface);
+
+  /**
+   * Check for the CPU usage on switches for the given LTE interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool SwitchCpuRequest (Ptr<RoutingInfo> rInfo, LteIface iface) const;
+
+  /**
+   * Check for the CPU usage on switches following the given routing path.
+   * \param srcIdx Source switch index.
+   * \param path The routing path.
+   * \param blockThs The block threshold.
+   * \return True if succeeded, false otherwise.
+   */
+  bool SwitchCpuRequest (uint16_t srcIdx, const RoutingPath_t &path,
+                         double blockThs) const;
+
+  /**
+   * Check for the flow table usage on switches for the given LTE interface.
+   * \param rInfo The routing information.
+   * \param iface The LTE logical interface.
+   * \return True if succeeded, false otherwise.
+   */
+  bool SwitchTableRequest (Ptr<RoutingInfo> rInfo, LteIface iface) const;
+
+  /**
+   * Check for the flow table usage on switches following the given routing
+   * path.
+   * \param srcIdx Source switch index.
+   * \param path The routing path.
+   * \param blockThs The block threshold.
+   * \param table The slice table.
+   * \return True if succeeded, false otherwise.
+   */
+  bool SwitchTableRequest (uint16_t srcIdx, const RoutingPath_t &path,
+                           double blockThs, uint16_t table) const;
+
   OFSwitch13DeviceContainer m_switchDevices;  //!< OpenFlow switch devices.
 
+  /** Routing paths cache indexed by (srcIdx * NSwitches + dstIdx). */
+  std::vector<std::vector<RoutingPath_t> > m_pathCache;
+
+  /** Inverted routing paths cache, with the same indexes of m_pathCache. */
+  std::vector<std::vector<RoutingPath_t> > m_invPathCache;
+
   // Internal mechanisms metadata.
   OpMode                m_aggCheck;       //!< Check bit rate for agg bearers.
   DataRate              m_extraStep;      //!< Extra adjustment step.
@@ -294,6 +634,7 @@ private:
   OpMode                m_spareUse;       //!< Spare bit rate sharing mode.
   OpMode                m_swBlockPolicy;  //!< Switch overload block policy.
   double                m_swBlockThs;     //!< Switch block threshold.
+  int                   m_nSlices;        //!< Number of slices in use.
 
   /** Slice controllers sorted by increasing priority. */
   SliceControllerList_t m_sliceCtrlsAll;
@@ -304,6 +645,12 @@ private:
   /** Map saving Slice ID / Slice controller application. */
   typedef std::map<SliceId, Ptr<SliceController> > SliceIdCtrlAppMap_t;
   SliceIdCtrlAppMap_t   m_sliceCtrlById;  //!< Slice controller mapped values.
+
+  /** The OpenFlow message TX trace source, fired at DpctlExecute. */
+  CtrlMsgTrace m_msgTxTrace;
+
+  /** The OpenFlow message RX trace source, fired at message handlers. */
+  CtrlMsgTrace m_msgRxTrace;
 };
 
 } // namespace ns3
@@ -235,7 +235,7 @@ BackhaulNetwork::NotifyConstructionCompleted (void)
   m_switchHelper->SetDeviceAttribute (
     "MeterTableSize", UintegerValue (m_meterTableSize));
   m_switchHelper->SetDeviceAttribute (
-    "PipelineTables", UintegerValue (4 + static_cast<int> (SliceId::ALL)));
+    "PipelineTables", UintegerValue (4 + GetNSlices ()));
 
   // Create the OpenFlow backhaul network.
   CreateTopology ();
@@ -47,6 +47,7 @@ class BackhaulController;
 class BackhaulNetwork : public Object
 {
   friend class BackhaulController;
+  friend class MeshController;
   friend class RingController;
 
 public:
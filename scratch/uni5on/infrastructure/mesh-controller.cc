@@ -0,0 +1,422 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <algorithm>
+#include <queue>
+#include <string>
+#include "mesh-controller.h"
+#include "../logical/slice-controller.h"
+#include "../metadata/enb-info.h"
+#include "../metadata/routing-info.h"
+#include "backhaul-network.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MeshController");
+NS_OBJECT_ENSURE_REGISTERED (MeshController);
+
+MeshController::MeshController ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MeshController::~MeshController ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+MeshController::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MeshController")
+    .SetParent<BackhaulController> ()
+    .AddConstructor<MeshController> ()
+    .AddAttribute ("NumPaths",
+                   "The number of shortest paths cached per switch pair.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   UintegerValue (3),
+                   MakeUintegerAccessor (&MeshController::m_numPaths),
+                   MakeUintegerChecker<uint16_t> (1))
+    .AddAttribute ("Routing", "The mesh routing strategy.",
+                   EnumValue (MeshController::KSP),
+                   MakeEnumAccessor (&MeshController::m_strategy),
+                   MakeEnumChecker (MeshController::SPO,
+                                    RoutingStrategyStr (MeshController::SPO),
+                                    MeshController::KSP,
+                                    RoutingStrategyStr (MeshController::KSP)))
+  ;
+  return tid;
+}
+
+MeshController::RoutingStrategy
+MeshController::GetRoutingStrategy (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_strategy;
+}
+
+std::string
+MeshController::RoutingStrategyStr (RoutingStrategy strategy)
+{
+  switch (strategy)
+    {
+    case MeshController::SPO:
+      return "spo";
+    case MeshController::KSP:
+      return "ksp";
+    default:
+      return "-";
+    }
+}
+
+void
+MeshController::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_adjacency.clear ();
+  BackhaulController::DoDispose ();
+}
+
+void
+MeshController::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // The infrastructure inter-slicing meters are identified by the link
+  // direction within each switch, which is only unique in the ring topology.
+  NS_ABORT_MSG_IF (GetInterSliceMode () != SliceMode::NONE,
+                   "Inter-slicing is not supported by the mesh controller.");
+
+  BackhaulController::NotifyConstructionCompleted ();
+}
+
+void
+MeshController::NotifyBearerCreated (Ptr<RoutingInfo> rInfo)
+{
+  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
+
+  // Let's create its mesh routing metadata.
+  CreateObject<MeshInfo> (rInfo);
+
+  BackhaulController::NotifyBearerCreated (rInfo);
+}
+
+void
+MeshController::NotifyEpcAttach (
+  Ptr<OFSwitch13Device> swDev, uint32_t portNo, Ptr<NetDevice> epcDev)
+{
+  NS_LOG_FUNCTION (this << swDev << portNo << epcDev);
+
+  BackhaulController::NotifyEpcAttach (swDev, portNo, epcDev);
+
+  // Only X2 packets are routed without per-bearer rules.
+  Ipv4Address epcAddr = Ipv4AddressHelper::GetAddress (epcDev);
+  if (!BackhaulNetwork::m_x2Mask.IsMatch (epcAddr, BackhaulNetwork::m_x2Addr))
+    {
+      return;
+    }
+
+  // -------------------------------------------------------------------------
+  // Classification table -- [from higher to lower priority]
+  //
+  // Skip slice classification for X2-C packets addressed to this eNB.
+  // Route them over the shortest path towards the eNB switch.
+  // Write the output port into action set.
+  // Send the packet directly to the output table.
+  auto it = m_swIdxByDpId.find (swDev->GetDatapathId ());
+  NS_ASSERT_MSG (it != m_swIdxByDpId.end (), "Unknown backhaul switch.");
+  uint16_t epcIdx = it->second;
+  for (uint16_t idx = 0; idx < GetNSwitches (); idx++)
+    {
+      if (idx == epcIdx)
+        {
+          continue;
+        }
+
+      const PathHop &hop = GetPath (idx, epcIdx, 0).front ();
+      std::ostringstream cmd;
+      cmd << "flow-mod cmd=add,prio=128"
+          << ",table="        << CLASS_TAB
+          << ",flags="        << FLAGS_REMOVED_OVERLAP_RESET
+          << " eth_type="     << IPV4_PROT_NUM
+          << ",ip_proto="     << UDP_PROT_NUM
+          << ",ip_dst="       << epcAddr
+          << " write:output=" << hop.lInfo->GetPortNo (hop.fwdDir)
+          << " goto:"         << GetOutputTable ();
+      DpctlExecute (GetDpId (idx), cmd.str ());
+    }
+}
+
+void
+MeshController::NotifyTopologyBuilt (OFSwitch13DeviceContainer &devices)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Chain up first, as we need to save the switch devices.
+  BackhaulController::NotifyTopologyBuilt (devices);
+
+  // Build the adjacency lists from the links in the topology.
+  m_swIdxByDpId.clear ();
+  for (uint16_t idx = 0; idx < GetNSwitches (); idx++)
+    {
+      m_swIdxByDpId [GetDpId (idx)] = idx;
+    }
+  m_adjacency.assign (GetNSwitches (), SwitchList_t ());
+  for (auto const &lInfo : LinkInfo::GetList ())
+    {
+      uint16_t idx0 = m_swIdxByDpId.at (lInfo->GetSwDpId (0));
+      uint16_t idx1 = m_swIdxByDpId.at (lInfo->GetSwDpId (1));
+      m_adjacency [idx0].push_back (idx1);
+      m_adjacency [idx1].push_back (idx0);
+    }
+  for (auto &neighbors : m_adjacency)
+    {
+      std::sort (neighbors.begin (), neighbors.end ());
+    }
+
+  // Precompute the routing paths and create the spanning tree.
+  CreatePathCache ();
+  CreateSpanningTree ();
+}
+
+void
+MeshController::CreateSpanningTree (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Find the spanning tree with a breadth-first search from the first switch.
+  uint16_t numSw = GetNSwitches ();
+  std::vector<bool> visited (numSw, false);
+  EdgeSet_t treeEdges;
+  std::queue<uint16_t> queue;
+  visited [0] = true;
+  queue.push (0);
+  while (!queue.empty ())
+    {
+      uint16_t curr = queue.front ();
+      queue.pop ();
+      for (uint16_t next : m_adjacency [curr])
+        {
+          if (!visited [next])
+            {
+              visited [next] = true;
+              treeEdges.insert (std::make_pair (curr, next));
+              treeEdges.insert (std::make_pair (next, curr));
+              queue.push (next);
+            }
+        }
+    }
+
+  // Let's configure the links out of the spanning tree to drop packets when
+  // flooding over ports (OFPP_FLOOD) with OFPPC_NO_FWD config (0x20).
+  for (auto const &lInfo : LinkInfo::GetList ())
+    {
+      uint16_t idx0 = m_swIdxByDpId.at (lInfo->GetSwDpId (0));
+      uint16_t idx1 = m_swIdxByDpId.at (lInfo->GetSwDpId (1));
+      if (treeEdges.find (std::make_pair (idx0, idx1)) != treeEdges.end ())
+        {
+          continue;
+        }
+
+      NS_LOG_DEBUG ("Disabling link from " << idx0 << " to " <<
+                    idx1 << " for broadcast messages.");
+      for (int i = 0; i < 2; i++)
+        {
+          std::ostringstream cmd;
+          cmd << "port-mod"
+              << " port=" << lInfo->GetPortNo (i)
+              << ",addr=" << lInfo->GetPortAddr (i)
+              << ",conf=0x00000020,mask=0x00000020";
+          DpctlExecute (lInfo->GetSwDpId (i), cmd.str ());
+        }
+    }
+}
+
+std::vector<BackhaulController::SwitchList_t>
+MeshController::FindKShortestPaths (
+  uint16_t srcIdx, uint16_t dstIdx, uint16_t k) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx << k);
+
+  std::vector<SwitchList_t> paths;
+  std::vector<bool> skipNodes (GetNSwitches (), false);
+  EdgeSet_t skipEdges;
+
+  SwitchList_t shortest = FindShortestPath (
+      srcIdx, dstIdx, skipNodes, skipEdges);
+  if (shortest.empty ())
+    {
+      return paths;
+    }
+  paths.push_back (shortest);
+
+  // Candidate paths sorted by the number of switches (ties are broken by the
+  // switch indexes, so the results are deterministic).
+  std::set<std::pair<size_t, SwitchList_t> > candidates;
+  while (paths.size () < k)
+    {
+      SwitchList_t last = paths.back ();
+      for (size_t i = 0; i + 1 < last.size (); i++)
+        {
+          // The root path goes from the source up to the spur switch.
+          SwitchList_t root (last.begin (), last.begin () + i + 1);
+
+          // Ignore the edges leaving the spur switch that are used by known
+          // paths sharing the same root, and the root switches before the
+          // spur one, so the new path will be loopless and unique.
+          skipEdges.clear ();
+          for (auto const &path : paths)
+            {
+              if (path.size () > i + 1
+                  && std::equal (root.begin (), root.end (), path.begin ()))
+                {
+                  skipEdges.insert (std::make_pair (path [i], path [i + 1]));
+                }
+            }
+          std::fill (skipNodes.begin (), skipNodes.end (), false);
+          for (size_t j = 0; j < i; j++)
+            {
+              skipNodes [root [j]] = true;
+            }
+
+          SwitchList_t spur = FindShortestPath (
+              last [i], dstIdx, skipNodes, skipEdges);
+          if (!spur.empty ())
+            {
+              SwitchList_t total (root.begin (), root.end () - 1);
+              total.insert (total.end (), spur.begin (), spur.end ());
+              candidates.insert (std::make_pair (total.size (), total));
+            }
+        }
+
+      if (candidates.empty ())
+        {
+          break;
+        }
+      paths.push_back (candidates.begin ()->second);
+      candidates.erase (candidates.begin ());
+    }
+  return paths;
+}
+
+std::vector<BackhaulController::SwitchList_t>
+MeshController::FindPaths (uint16_t srcIdx, uint16_t dstIdx) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx);
+
+  // When using the shortest path only strategy, there are no alternatives.
+  uint16_t numPaths = 1;
+  if (GetRoutingStrategy () == MeshController::KSP)
+    {
+      numPaths = m_numPaths;
+    }
+  return FindKShortestPaths (srcIdx, dstIdx, numPaths);
+}
+
+BackhaulController::SwitchList_t
+MeshController::FindShortestPath (
+  uint16_t srcIdx, uint16_t dstIdx, const std::vector<bool> &skipNodes,
+  const EdgeSet_t &skipEdges) const
+{
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx);
+
+  NS_ASSERT_MSG (srcIdx != dstIdx, "Invalid switch indexes.");
+
+  // All backhaul links have the same cost, so a breadth-first search is
+  // enough. Adjacency lists are sorted, so ties are always broken the same
+  // way.
+  std::vector<int> parent (GetNSwitches (), -1);
+  std::queue<uint16_t> queue;
+  parent [srcIdx] = srcIdx;
+  queue.push (srcIdx);
+  while (!queue.empty () && parent [dstIdx] < 0)
+    {
+      uint16_t curr = queue.front ();
+      queue.pop ();
+      for (uint16_t next : m_adjacency [curr])
+        {
+          if (parent [next] >= 0 || skipNodes [next]
+              || skipEdges.find (std::make_pair (curr, next))
+              != skipEdges.end ())
+            {
+              continue;
+            }
+          parent [next] = curr;
+          queue.push (next);
+        }
+    }
+
+  SwitchList_t path;
+  if (parent [dstIdx] >= 0)
+    {
+      for (uint16_t idx = dstIdx; idx != srcIdx; idx = parent [idx])
+        {
+          path.push_back (idx);
+        }
+      path.push_back (srcIdx);
+      std::reverse (path.begin (), path.end ());
+    }
+  return path;
+}
+
+std::string
+MeshController::GetHopActions (const PathHop &hop) const
+{
+  NS_LOG_FUNCTION (this << hop.srcIdx << hop.dstIdx);
+
+  // Write the output port towards the next switch into action set.
+  std::ostringstream ins;
+  ins << " write:output=" << hop.lInfo->GetPortNo (hop.fwdDir);
+  return ins.str ();
+}
+
+uint16_t
+MeshController::GetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << rInfo << iface);
+
+  Ptr<MeshInfo> meshInfo = rInfo->GetObject<MeshInfo> ();
+  NS_ASSERT_MSG (meshInfo, "No meshInfo for this bearer.");
+  NS_ASSERT_MSG (!meshInfo->IsUndefPath (iface), "Undefined routing path.");
+
+  // The local routing uses the single (empty) path in the cache.
+  return meshInfo->IsLocalPath (iface) ? 0 : meshInfo->GetDlPath (iface);
+}
+
+void
+MeshController::SetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface,
+                              uint16_t index, const RoutingPath_t &path)
+{
+  NS_LOG_FUNCTION (this << rInfo << iface << index);
+
+  Ptr<MeshInfo> meshInfo = rInfo->GetObject<MeshInfo> ();
+  NS_ASSERT_MSG (meshInfo, "No meshInfo for this bearer.");
+
+  int dlPath = path.empty () ? MeshInfo::LOCAL : index;
+  meshInfo->SetDlPath (iface, dlPath);
+
+  NS_LOG_DEBUG ("Bearer teid " << rInfo->GetTeidHex () <<
+                " interface "  << LteIfaceStr (iface) <<
+                " path "       << MeshInfo::MeshPathStr (dlPath));
+}
+
+} // namespace ns3
@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef MESH_CONTROLLER_H
+#define MESH_CONTROLLER_H
+
+#include "backhaul-controller.h"
+#include "../metadata/mesh-info.h"
+#include "../uni5on-common.h"
+
+namespace ns3 {
+
+class EnbInfo;
+
+/**
+ * \ingroup uni5onInfra
+ * OpenFlow backhaul controller for arbitrary (mesh or partial-mesh)
+ * topologies. When the topology is built, this controller precomputes the
+ * k-shortest paths (in number of hops) between every pair of backhaul
+ * switches, including all eNB and gateway switch pairs. Bearer requests are
+ * admitted over these cached paths by the BackhaulController.
+ * Inter-slicing is not supported, so the SliceMode attribute must be none.
+ */
+class MeshController : public BackhaulController
+{
+  friend class MeshNetwork;
+  friend class BackhaulPathsTestCase;
+
+public:
+  /** Routing strategy to find the paths in the mesh. */
+  enum RoutingStrategy
+  {
+    SPO = 0,  //!< Shortest path only (path with lowest number of hops).
+    KSP = 1   //!< First of the k-shortest paths with available resources.
+  };
+
+  MeshController ();            //!< Default constructor.
+  virtual ~MeshController ();   //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Get the routing strategy attribute.
+   * \return The routing strategy.
+   */
+  RoutingStrategy GetRoutingStrategy (void) const;
+
+  /**
+   * Get the string representing the given routing strategy.
+   * \param strategy The routing strategy.
+   * \return The routing strategy string.
+   */
+  static std::string RoutingStrategyStr (RoutingStrategy strategy);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+  // Inherited from ObjectBase.
+  virtual void NotifyConstructionCompleted (void);
+
+  // Inherited from BackhaulController.
+  void NotifyBearerCreated (Ptr<RoutingInfo> rInfo);
+  void NotifyEpcAttach (Ptr<OFSwitch13Device> swDev, uint32_t portNo,
+                        Ptr<NetDevice> epcDev);
+  void NotifyTopologyBuilt (OFSwitch13DeviceContainer &devices);
+  std::vector<SwitchList_t> FindPaths (uint16_t srcIdx,
+                                       uint16_t dstIdx) const;
+  std::string GetHopActions (const PathHop &hop) const;
+  uint16_t GetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface) const;
+  void SetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface, uint16_t index,
+                     const RoutingPath_t &path);
+  // Inherited from BackhaulController.
+
+private:
+  /** A set of directed edges (switch index pairs). */
+  typedef std::set<std::pair<uint16_t, uint16_t> > EdgeSet_t;
+
+  /**
+   * To avoid flooding problems when broadcasting packets (like in ARP
+   * protocol), let's find a Spanning Tree and drop packets at selected ports
+   * when flooding (OFPP_FLOOD). This is accomplished by configuring the port
+   * with OFPPC_NO_FWD flag (0x20).
+   */
+  void CreateSpanningTree (void);
+
+  /**
+   * Find the k-shortest loopless paths from the source to the destination
+   * switch, using the Yen's algorithm.
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \param k The maximum number of paths.
+   * \return The list of paths sorted by increasing number of hops.
+   */
+  std::vector<SwitchList_t> FindKShortestPaths (uint16_t srcIdx,
+                                                uint16_t dstIdx,
+                                                uint16_t k) const;
+
+  /**
+   * Find the shortest path from the source to the destination switch,
+   * ignoring the given switches and edges.
+   * \param srcIdx Source switch index.
+   * \param dstIdx Destination switch index.
+   * \param skipNodes The switches to ignore, indexed by switch index.
+   * \param skipEdges The directed edges to ignore.
+   * \return The shortest path, or an empty list if there is no path.
+   */
+  SwitchList_t FindShortestPath (uint16_t srcIdx, uint16_t dstIdx,
+                                 const std::vector<bool> &skipNodes,
+                                 const EdgeSet_t &skipEdges) const;
+
+  RoutingStrategy           m_strategy;       //!< Routing strategy in use.
+  uint16_t                  m_numPaths;       //!< Max paths per switch pair.
+
+  /** Adjacency lists (sorted by switch index) indexed by switch index. */
+  std::vector<SwitchList_t>             m_adjacency;
+
+  /** Map saving OpenFlow datapath ID / switch index. */
+  typedef std::map<uint64_t, uint16_t> DpIdSwIdxMap_t;
+  DpIdSwIdxMap_t            m_swIdxByDpId;    //!< Switch index by DP ID.
+};
+
+} // namespace ns3
+#endif // MESH_CONTROLLER_H
@@ -0,0 +1,215 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <ns3/topology-read-module.h>
+#include "mesh-network.h"
+#include "../metadata/link-info.h"
+#include "mesh-controller.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MeshNetwork");
+NS_OBJECT_ENSURE_REGISTERED (MeshNetwork);
+
+MeshNetwork::MeshNetwork ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MeshNetwork::~MeshNetwork ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+MeshNetwork::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MeshNetwork")
+    .SetParent<BackhaulNetwork> ()
+    .AddConstructor<MeshNetwork> ()
+    .AddAttribute ("MeshLinkDataRate",
+                   "The data rate for the links between OpenFlow switches.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DataRateValue (DataRate ("100Mbps")),
+                   MakeDataRateAccessor (&MeshNetwork::m_linkRate),
+                   MakeDataRateChecker ())
+    .AddAttribute ("MeshLinkDelay",
+                   "The delay for the links between OpenFlow switches.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   // The default value is for 40km fiber cable latency.
+                   TimeValue (MicroSeconds (200)),
+                   MakeTimeAccessor (&MeshNetwork::m_linkDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("SkipFirstSwitch",
+                   "Skip the first mesh switch when attaching eNBs.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MeshNetwork::m_skipFirst),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TopologyFilename",
+                   "The filename with the switch graph.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   StringValue (""),
+                   MakeStringAccessor (&MeshNetwork::m_topoFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("TopologyFormat",
+                   "The topology file format (Orbis, Inet, or Rocketfuel).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   StringValue ("Orbis"),
+                   MakeStringAccessor (&MeshNetwork::m_topoFormat),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+uint16_t
+MeshNetwork::GetEnbSwIdx (uint16_t cellId) const
+{
+  NS_LOG_FUNCTION (this << cellId);
+
+  NS_ASSERT_MSG (cellId > 0, "Invalid cell ID.");
+
+  // Connect the eNBs to switches in increasing index order. The three eNBs
+  // from the same cell site are always connected to the same switch.
+  uint16_t numNodes = m_switchNodes.GetN ();
+  uint16_t siteId = (cellId - 1) / 3;
+  if (m_skipFirst)
+    {
+      // Skip the first switch (index 0), which is exclusive for the P-GW.
+      return 1 + (siteId % (numNodes - 1));
+    }
+  else
+    {
+      return siteId % numNodes;
+    }
+}
+
+void
+MeshNetwork::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  BackhaulNetwork::DoDispose ();
+}
+
+void
+MeshNetwork::NotifyConstructionCompleted ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // Configuring CSMA helper for connection between switches.
+  m_csmaHelper.SetDeviceAttribute ("Mtu", UintegerValue (m_linkMtu));
+  m_csmaHelper.SetChannelAttribute ("DataRate", DataRateValue (m_linkRate));
+  m_csmaHelper.SetChannelAttribute ("Delay", TimeValue (m_linkDelay));
+
+  // The topology creation will be triggered by base class.
+  BackhaulNetwork::NotifyConstructionCompleted ();
+}
+
+void
+MeshNetwork::CreateTopology (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ABORT_MSG_IF (m_topoFilename.empty (), "Empty topology filename.");
+
+  // Install the mesh controller application for this topology.
+  Ptr<MeshController> meshController = CreateObject<MeshController> ();
+  m_controllerNode = CreateObject<Node> ();
+  Names::Add ("mesh_ctrl", m_controllerNode);
+  m_switchHelper->InstallController (m_controllerNode, meshController);
+  m_controllerApp = meshController;
+
+  // Read the switch graph, creating the switch nodes.
+  TopologyReaderHelper topoHelper;
+  topoHelper.SetFileName (m_topoFilename);
+  topoHelper.SetFileType (m_topoFormat);
+  Ptr<TopologyReader> topoReader = topoHelper.GetTopologyReader ();
+  NS_ABORT_MSG_IF (!topoReader, "Invalid topology file format.");
+  m_switchNodes = topoReader->Read ();
+
+  uint16_t numNodes = m_switchNodes.GetN ();
+  NS_LOG_INFO ("Creating mesh backhaul network with " << numNodes <<
+               " switches and " << topoReader->LinksSize () << " links.");
+  NS_ABORT_MSG_IF (numNodes < 2 || (m_skipFirst && numNodes < 3),
+                   "Invalid number of nodes for the mesh.");
+
+  // Install the OpenFlow switch devices.
+  m_switchDevices = m_switchHelper->InstallSwitch (m_switchNodes);
+
+  // Set the name for each switch node.
+  std::map<uint32_t, uint16_t> nodeIdx;
+  for (uint16_t i = 0; i < numNodes; i++)
+    {
+      std::ostringstream swName;
+      swName << "sw" << m_switchDevices.Get (i)->GetDatapathId ();
+      Names::Add (swName.str (), m_switchNodes.Get (i));
+      nodeIdx [m_switchNodes.Get (i)->GetId ()] = i;
+    }
+
+  // Connecting switches following the links in the topology file. Some file
+  // formats may list the same link in both directions, so let's ignore any
+  // duplicated links (the LinkInfo is unique for each pair of switches).
+  std::set<std::pair<uint16_t, uint16_t> > created;
+  TopologyReader::ConstLinksIterator it;
+  for (it = topoReader->LinksBegin (); it != topoReader->LinksEnd (); ++it)
+    {
+      uint16_t currIndex = nodeIdx.at (it->GetFromNode ()->GetId ());
+      uint16_t nextIndex = nodeIdx.at (it->GetToNode ()->GetId ());
+      auto key = std::make_pair (std::min (currIndex, nextIndex),
+                                 std::max (currIndex, nextIndex));
+      if (currIndex == nextIndex || !created.insert (key).second)
+        {
+          NS_LOG_WARN ("Ignoring link from " << currIndex <<
+                       " to " << nextIndex);
+          continue;
+        }
+
+      // Creating a link between current and next node.
+      Ptr<Node> currNode = m_switchNodes.Get (currIndex);
+      Ptr<Node> nextNode = m_switchNodes.Get (nextIndex);
+      NetDeviceContainer devs = m_csmaHelper.Install (currNode, nextNode);
+
+      // Set device names for pcap files.
+      SetDeviceNames (devs.Get (0), devs.Get (1), "~");
+
+      // Adding newly created csma devices as OpenFlow switch ports.
+      Ptr<OFSwitch13Device> currDev, nextDev;
+      Ptr<OFSwitch13Port> currPort, nextPort;
+      Ptr<CsmaNetDevice> currPortDev, nextPortDev;
+
+      currDev = m_switchDevices.Get (currIndex);
+      currPortDev = DynamicCast<CsmaNetDevice> (devs.Get (0));
+      currPort = currDev->AddSwitchPort (currPortDev);
+
+      nextDev = m_switchDevices.Get (nextIndex);
+      nextPortDev = DynamicCast<CsmaNetDevice> (devs.Get (1));
+      nextPort = nextDev->AddSwitchPort (nextPortDev);
+
+      Ptr<CsmaChannel> channel =
+        DynamicCast<CsmaChannel> (currPortDev->GetChannel ());
+      CreateObject<LinkInfo> (currPort, nextPort, channel);
+    }
+
+  // Fire trace source notifying that the topology was successfully built.
+  meshController->NotifyTopologyBuilt (m_switchDevices);
+}
+
+} // namespace ns3
@@ -0,0 +1,73 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef MESH_NETWORK_H
+#define MESH_NETWORK_H
+
+#include <ns3/csma-module.h>
+#include "backhaul-network.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onInfra
+ * OpenFlow backhaul network for arbitrary (mesh or partial-mesh) topologies.
+ * The switch graph is loaded from a topology file in any of the formats
+ * supported by the topology-read module (Orbis, Inet, or Rocketfuel). Each
+ * node in the file is an OpenFlow switch, and all links between switches
+ * have the same data rate and delay.
+ */
+class MeshNetwork : public BackhaulNetwork
+{
+public:
+  MeshNetwork ();           //!< Default constructor.
+  virtual ~MeshNetwork ();  //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  // Inherited from BackhaulNetwork.
+  uint16_t GetEnbSwIdx (uint16_t cellId) const;
+
+protected:
+  /** Destructor implementation. */
+  void DoDispose ();
+
+  // Inherited from ObjectBase.
+  void NotifyConstructionCompleted (void);
+
+  // Inherited from BackhaulNetwork.
+  void CreateTopology (void);
+
+private:
+  std::string                   m_topoFilename;   //!< Topology filename.
+  std::string                   m_topoFormat;     //!< Topology file format.
+  CsmaHelper                    m_csmaHelper;     //!< Connection helper.
+  DataRate                      m_linkRate;       //!< Backhaul link data rate.
+  Time                          m_linkDelay;      //!< Backhaul link delay.
+  bool                          m_skipFirst;      //!< Skip the first switch.
+
+}; // class MeshNetwork
+
+} // namespace ns3
+#endif // MESH_NETWORK_H
@@ -25,8 +25,51 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("RadioNetwork");
 NS_OBJECT_ENSURE_REGISTERED (RadioNetwork);
 
+/**
+ * Get the initial value for an attribute of the LTE module, so the abstract
+ * radio mode follows the configuration of the full mode.
+ * \param tidName The TypeId name.
+ * \param attrName The attribute name.
+ * \return The attribute initial value.
+ */
+static Ptr<const AttributeValue>
+GetLteDefault (std::string tidName, std::string attrName)
+{
+  TypeId::AttributeInformation info;
+  bool found = TypeId::LookupByName (tidName).LookupAttributeByName (
+      attrName, &info);
+  NS_ASSERT_MSG (found, "Attribute " << tidName << "::" << attrName <<
+                 " not found.");
+  return info.initialValue;
+}
+
+/**
+ * Convert a power value from dBm to mW.
+ * \param dbm The power (dBm).
+ * \return The power (mW).
+ */
+static inline double
+DbmToMw (double dbm)
+{
+  return std::pow (10.0, dbm / 10.0);
+}
+
+/**
+ * Get the thermal noise power over the given number of resource blocks.
+ * \param nRbs The number of resource blocks.
+ * \param noiseFigure The receiver noise figure (dB).
+ * \return The noise power (dBm).
+ */
+static inline double
+GetNoisePower (uint16_t nRbs, double noiseFigure)
+{
+  return -174.0 + 10.0 * std::log10 (nRbs * 180000.0) + noiseFigure;
+}
+
 RadioNetwork::RadioNetwork (Ptr<EpcHelper> helper)
-  : m_topoHelper (0),
+  : m_imsiCounter (0),
+  m_lossModel (0),
+  m_topoHelper (0),
   m_remHelper (0),
   m_lteHelper (0),
   m_epcHelper (helper)
@@ -91,6 +134,16 @@ RadioNetwork::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&RadioNetwork::m_handover),
                    MakeBooleanChecker ())
+    .AddAttribute ("HandoverHysteresis", "The A3 handover hysteresis (dB).",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&RadioNetwork::m_hoHysteresis),
+                   MakeDoubleChecker<double> (0.0, 15.0))
+    .AddAttribute ("HandoverTimeToTrigger", "The A3 handover time to trigger.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (MilliSeconds (512)),
+                   MakeTimeAccessor (&RadioNetwork::m_hoTimeToTrigger),
+                   MakeTimeChecker ())
     .AddAttribute ("EnbMargin", "How much the eNB coverage area extends, "
                    "expressed as fraction of the inter-site distance.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
@@ -107,16 +160,62 @@ RadioNetwork::GetTypeId (void)
                    StringValue ("radio-map"),
                    MakeStringAccessor (&RadioNetwork::m_remFilename),
                    MakeStringChecker ())
+    .AddAttribute ("RadioMode", "The radio access simulation mode.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   EnumValue (RadioMode::FULL),
+                   MakeEnumAccessor (&RadioNetwork::m_radioMode),
+                   MakeEnumChecker (RadioMode::FULL,     "full",
+                                    RadioMode::ABSTRACT, "abstract"))
+    .AddAttribute ("AbstractInterval", "The interval between radio "
+                   "conditions updates in the abstract radio mode.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&RadioNetwork::m_absInterval),
+                   MakeTimeChecker (MilliSeconds (1)))
   ;
   return tid;
 }
 
+uint8_t
+RadioNetwork::ActivateDedicatedEpsBearer (Ptr<NetDevice> ueDevice,
+                                          EpsBearer bearer, Ptr<EpcTft> tft)
+{
+  NS_LOG_FUNCTION (this << ueDevice);
+
+  // Both UE device types expose the IMSI attribute.
+  UintegerValue imsiValue;
+  ueDevice->GetAttribute ("Imsi", imsiValue);
+  return m_epcHelper->ActivateEpsBearer (ueDevice, imsiValue.Get (),
+                                         tft, bearer);
+}
+
 void
 RadioNetwork::AttachUeDevices (NetDeviceContainer ueDevices)
 {
   NS_LOG_FUNCTION (this);
 
-  m_lteHelper->Attach (ueDevices);
+  if (m_radioMode == RadioMode::FULL)
+    {
+      m_lteHelper->Attach (ueDevices);
+      return;
+    }
+
+  // Activate the default EPS bearer just like the LteHelper::Attach () does.
+  // UEs are attached to the best cell on the next radio conditions update.
+  for (NetDeviceContainer::Iterator it = ueDevices.Begin ();
+       it != ueDevices.End (); it++)
+    {
+      Ptr<AbstractUeNetDevice> ueDev = DynamicCast<AbstractUeNetDevice> (*it);
+      NS_ASSERT_MSG (ueDev, "Invalid UE device for the abstract radio mode.");
+      m_epcHelper->ActivateEpsBearer (
+        ueDev, ueDev->GetImsi (), EpcTft::Default (),
+        EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+  if (!m_absEvent.IsRunning ())
+    {
+      m_absEvent = Simulator::ScheduleNow (
+          &RadioNetwork::UpdateAbstractRadio, this);
+    }
 }
 
 NetDeviceContainer
@@ -130,7 +229,25 @@ RadioNetwork::InstallUeDevices (NodeContainer ueNodes,
   BuildingsHelper::Install (ueNodes);
 
   // Install LTE protocol stack into UE nodes.
-  NetDeviceContainer ueDevices = m_lteHelper->InstallUeDevice (ueNodes);
+  NetDeviceContainer ueDevices;
+  if (m_radioMode == RadioMode::FULL)
+    {
+      ueDevices = m_lteHelper->InstallUeDevice (ueNodes);
+    }
+  else
+    {
+      for (NodeContainer::Iterator it = ueNodes.Begin ();
+           it != ueNodes.End (); it++)
+        {
+          uint64_t imsi = ++m_imsiCounter;
+          m_absUeFactory.Set ("Imsi", UintegerValue (imsi));
+          Ptr<AbstractUeNetDevice> ueDev =
+            m_absUeFactory.Create<AbstractUeNetDevice> ();
+          (*it)->AddDevice (ueDev);
+          m_epcHelper->AddUe (ueDev, imsi);
+          ueDevices.Add (ueDev);
+        }
+    }
 
   // Saving nodes and devices only for REM.
   m_ueNodes.Add (ueNodes);
@@ -201,11 +318,21 @@ RadioNetwork::GetRandomPositionAllocator (uint16_t cellSiteId) const
   return boxPosAllocator;
 }
 
+RadioNetwork::RadioMode
+RadioNetwork::GetRadioMode (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_radioMode;
+}
+
 void
 RadioNetwork::PrintRadioEnvironmentMap (void)
 {
   NS_LOG_FUNCTION (this);
 
+  NS_ABORT_MSG_IF (m_radioMode == RadioMode::ABSTRACT,
+                   "Radio map not available in the abstract radio mode.");
   NS_LOG_INFO ("Printing LTE radio environment map...");
 
   // Force UE initialization so we don't have to wait for nodes to start before
@@ -346,6 +473,13 @@ RadioNetwork::DoDispose ()
   m_remHelper = 0;
   m_lteHelper = 0;
   m_epcHelper = 0;
+  m_lossModel = 0;
+  m_absEvent.Cancel ();
+  for (auto &it : m_hoEvents)
+    {
+      it.second.timer.Cancel ();
+    }
+  m_hoEvents.clear ();
   Object::DoDispose ();
 }
 
@@ -356,46 +490,57 @@ RadioNetwork::NotifyConstructionCompleted ()
   NS_LOG_INFO ("Creating LTE radio network with " << m_nSites <<
                " three-sector cell sites (" << 3 * m_nSites << " eNBs).");
 
-  // Create the LTE helper for the radio network.
-  m_lteHelper = CreateObject<LteHelper> ();
-  m_lteHelper->SetEpcHelper (m_epcHelper);
-
-  // Use the hybrid path loss model obtained through a combination of several
-  // well known path loss models in order to mimic different environmental
-  // scenarios, considering the phenomenon of indoor/outdoor propagation in the
-  // presence of buildings. Always use the LoS path loss model.
-  m_lteHelper->SetAttribute (
-    "PathlossModel", StringValue ("ns3::HybridBuildingsPropagationLossModel"));
-  m_lteHelper->SetPathlossModelAttribute (
-    "ShadowSigmaExtWalls", DoubleValue (0));
-  m_lteHelper->SetPathlossModelAttribute (
-    "ShadowSigmaOutdoor", DoubleValue (1.5));
-  m_lteHelper->SetPathlossModelAttribute (
-    "ShadowSigmaIndoor", DoubleValue (1.5));
-  m_lteHelper->SetPathlossModelAttribute (
-    "Los2NlosThr", DoubleValue (1e6));
-
-  // Configure the antennas for the hexagonal grid topology.
-  m_lteHelper->SetEnbAntennaModelType ("ns3::ParabolicAntennaModel");
-  m_lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (70));
-  m_lteHelper->SetEnbAntennaModelAttribute (
-    "MaxAttenuation", DoubleValue (20.0));
-
-  // Configure the handover algorithm.
-  if (m_handover)
+  NS_LOG_INFO ("Radio access simulation mode: " <<
+               (m_radioMode == RadioMode::FULL ? "full" : "abstract"));
+
+  if (m_radioMode == RadioMode::FULL)
     {
-      m_lteHelper->SetHandoverAlgorithmType (
-        "ns3::A3RsrpHandoverAlgorithm");
-      m_lteHelper->SetHandoverAlgorithmAttribute (
-        "Hysteresis", DoubleValue (3.0));
-      m_lteHelper->SetHandoverAlgorithmAttribute (
-        "TimeToTrigger", TimeValue (MilliSeconds (512)));
+      // Create the LTE helper for the radio network.
+      m_lteHelper = CreateObject<LteHelper> ();
+      m_lteHelper->SetEpcHelper (m_epcHelper);
+
+      // Use the hybrid path loss model obtained through a combination of
+      // several well known path loss models in order to mimic different
+      // environmental scenarios, considering the phenomenon of indoor/outdoor
+      // propagation in the presence of buildings. Always use the LoS path loss
+      // model.
+      m_lteHelper->SetAttribute (
+        "PathlossModel",
+        StringValue ("ns3::HybridBuildingsPropagationLossModel"));
+      m_lteHelper->SetPathlossModelAttribute (
+        "ShadowSigmaExtWalls", DoubleValue (0));
+      m_lteHelper->SetPathlossModelAttribute (
+        "ShadowSigmaOutdoor", DoubleValue (1.5));
+      m_lteHelper->SetPathlossModelAttribute (
+        "ShadowSigmaIndoor", DoubleValue (1.5));
+      m_lteHelper->SetPathlossModelAttribute (
+        "Los2NlosThr", DoubleValue (1e6));
+
+      // Configure the antennas for the hexagonal grid topology.
+      m_lteHelper->SetEnbAntennaModelType ("ns3::ParabolicAntennaModel");
+      m_lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (70));
+      m_lteHelper->SetEnbAntennaModelAttribute (
+        "MaxAttenuation", DoubleValue (20.0));
+
+      // Configure the handover algorithm.
+      if (m_handover)
+        {
+          m_lteHelper->SetHandoverAlgorithmType (
+            "ns3::A3RsrpHandoverAlgorithm");
+          m_lteHelper->SetHandoverAlgorithmAttribute (
+            "Hysteresis", DoubleValue (m_hoHysteresis));
+          m_lteHelper->SetHandoverAlgorithmAttribute (
+            "TimeToTrigger", TimeValue (m_hoTimeToTrigger));
+        }
     }
 
   // Create the topology helper used to group eNBs in three-sector sites layed
   // out on an hexagonal grid.
   m_topoHelper = CreateObject<LteHexGridEnbTopologyHelper> ();
-  m_topoHelper->SetLteHelper (m_lteHelper);
+  if (m_radioMode == RadioMode::FULL)
+    {
+      m_topoHelper->SetLteHelper (m_lteHelper);
+    }
 
   // Create the eNBs nodes and set their names.
   m_enbNodes.Create (3 * m_nSites);
@@ -413,15 +558,23 @@ RadioNetwork::NotifyConstructionCompleted ()
   mobilityHelper.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
   mobilityHelper.Install (m_enbNodes);
 
-  // Set eNB nodes positions on the hex grid and install the corresponding eNB
-  // devices with antenna bore sight properly configured. This topology helper
-  // will call the EpcHelper::AddEnb () method, which will configure and
-  // connect the eNB to the OpenFlow backhaul network.
-  m_enbDevices = m_topoHelper->SetPositionAndInstallEnbDevice (m_enbNodes);
-  BuildingsHelper::Install (m_enbNodes);
-
-  // Create an X2 interface between all the eNBs in a given set.
-  m_lteHelper->AddX2Interface (m_enbNodes);
+  if (m_radioMode == RadioMode::FULL)
+    {
+      // Set eNB nodes positions on the hex grid and install the corresponding
+      // eNB devices with antenna bore sight properly configured. This
+      // topology helper will call the EpcHelper::AddEnb () method, which will
+      // configure and connect the eNB to the OpenFlow backhaul network.
+      m_enbDevices = m_topoHelper->SetPositionAndInstallEnbDevice (m_enbNodes);
+      BuildingsHelper::Install (m_enbNodes);
+
+      // Create an X2 interface between all the eNBs in a given set.
+      m_lteHelper->AddX2Interface (m_enbNodes);
+    }
+  else
+    {
+      InstallAbstractEnbDevices ();
+      BuildingsHelper::Install (m_enbNodes);
+    }
 
   // Identify the LTE radio coverage area based on eNB nodes positions.
   std::vector<double> xPos, yPos;
@@ -453,10 +606,256 @@ RadioNetwork::NotifyConstructionCompleted ()
   // If enable, print the LTE ASCII trace files.
   if (m_lteTrace)
     {
+      NS_ABORT_MSG_IF (m_radioMode == RadioMode::ABSTRACT,
+                       "LTE traces not available in the abstract radio mode.");
       m_lteHelper->EnableTraces ();
     }
 
   Object::NotifyConstructionCompleted ();
 }
 
+void
+RadioNetwork::InstallAbstractEnbDevices (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Configure the abstract devices with the LTE attribute values, so both
+  // radio modes share the same configuration.
+  ObjectFactory enbFactory;
+  enbFactory.SetTypeId (AbstractEnbNetDevice::GetTypeId ());
+  enbFactory.Set ("DlBandwidth",
+                  *GetLteDefault ("ns3::LteEnbNetDevice", "DlBandwidth"));
+  enbFactory.Set ("UlBandwidth",
+                  *GetLteDefault ("ns3::LteEnbNetDevice", "UlBandwidth"));
+  enbFactory.Set ("TxPower",
+                  *GetLteDefault ("ns3::LteEnbPhy", "TxPower"));
+  enbFactory.Set ("NoiseFigure",
+                  *GetLteDefault ("ns3::LteEnbPhy", "NoiseFigure"));
+
+  m_absUeFactory.SetTypeId (AbstractUeNetDevice::GetTypeId ());
+  m_absUeFactory.Set ("TxPower",
+                      *GetLteDefault ("ns3::LteUePhy", "TxPower"));
+  m_absUeFactory.Set ("NoiseFigure",
+                      *GetLteDefault ("ns3::LteUePhy", "NoiseFigure"));
+
+  // Use the same path loss model of the full mode at the downlink frequency.
+  Ptr<const UintegerValue> earfcnValue = DynamicCast<const UintegerValue> (
+      GetLteDefault ("ns3::LteEnbNetDevice", "DlEarfcn"));
+  double frequency =
+    LteSpectrumValueHelper::GetCarrierFrequency (earfcnValue->Get ());
+  m_lossModel =
+    CreateObjectWithAttributes<HybridBuildingsPropagationLossModel> (
+      "ShadowSigmaExtWalls", DoubleValue (0),
+      "ShadowSigmaOutdoor", DoubleValue (1.5),
+      "ShadowSigmaIndoor", DoubleValue (1.5),
+      "Los2NlosThr", DoubleValue (1e6),
+      "Frequency", DoubleValue (frequency));
+
+  // Set eNB nodes positions on the hex grid from the topology helper and
+  // install the abstract eNB devices with the antenna bore sight properly
+  // configured.
+  for (uint32_t n = 0; n < m_enbNodes.GetN (); n++)
+    {
+      double orientation;
+      Vector position = m_topoHelper->GetEnbPosition (n, orientation);
+      Ptr<Node> node = m_enbNodes.Get (n);
+      node->GetObject<MobilityModel> ()->SetPosition (position);
+
+      Ptr<AntennaModel> antenna =
+        CreateObjectWithAttributes<ParabolicAntennaModel> (
+          "Beamwidth", DoubleValue (70),
+          "MaxAttenuation", DoubleValue (20.0),
+          "Orientation", DoubleValue (orientation));
+      enbFactory.Set ("CellId", UintegerValue (n + 1));
+      enbFactory.Set ("Antenna", PointerValue (antenna));
+      Ptr<AbstractEnbNetDevice> enbDev =
+        enbFactory.Create<AbstractEnbNetDevice> ();
+      node->AddDevice (enbDev);
+      m_enbDevices.Add (enbDev);
+
+      // This will configure and connect the eNB to the OpenFlow backhaul
+      // network. Then, connect the eNB device to the eNB application over the
+      // S1 SAP, just like the LteEnbRrc does.
+      m_epcHelper->AddEnb (node, enbDev, enbDev->GetCellId ());
+      Ptr<EpcEnbApplication> enbApp =
+        node->GetApplication (0)->GetObject<EpcEnbApplication> ();
+      NS_ASSERT_MSG (enbApp, "EPC eNB application not found.");
+      enbDev->SetS1SapProvider (enbApp->GetS1SapProvider ());
+      enbApp->SetS1SapUser (enbDev->GetS1SapUser ());
+    }
+
+  // Create an X2 interface between all the eNBs in a given set.
+  for (uint32_t i = 0; i < m_enbNodes.GetN (); i++)
+    {
+      for (uint32_t j = i + 1; j < m_enbNodes.GetN (); j++)
+        {
+          m_epcHelper->AddX2Interface (m_enbNodes.Get (i), m_enbNodes.Get (j));
+        }
+    }
+}
+
+void
+RadioNetwork::UpdateAbstractRadio (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t nEnbs = m_enbDevices.GetN ();
+  uint32_t nUes = m_ueDevices.GetN ();
+  std::vector<Ptr<AbstractEnbNetDevice> > enbDevs (nEnbs);
+  for (uint32_t e = 0; e < nEnbs; e++)
+    {
+      enbDevs [e] = DynamicCast<AbstractEnbNetDevice> (m_enbDevices.Get (e));
+    }
+
+  // First, get the channel gain (path loss and antenna gain) between each UE
+  // and each eNB, handling cell selection and handovers.
+  std::vector<std::vector<double> > gainDb (nUes, std::vector<double> (nEnbs));
+  std::vector<uint32_t> serving (nUes, nEnbs);
+  for (uint32_t u = 0; u < nUes; u++)
+    {
+      Ptr<AbstractUeNetDevice> ueDev =
+        DynamicCast<AbstractUeNetDevice> (m_ueDevices.Get (u));
+      Ptr<MobilityModel> ueMob =
+        ueDev->GetNode ()->GetObject<MobilityModel> ();
+
+      // Identify the serving and the best eNBs by the DL received power.
+      uint32_t best = 0;
+      std::vector<double> rxPower (nEnbs);
+      for (uint32_t e = 0; e < nEnbs; e++)
+        {
+          Ptr<MobilityModel> enbMob =
+            enbDevs [e]->GetNode ()->GetObject<MobilityModel> ();
+          double antennaGain = enbDevs [e]->GetAntenna ()->GetGainDb (
+              Angles (ueMob->GetPosition (), enbMob->GetPosition ()));
+          gainDb [u][e] =
+            m_lossModel->CalcRxPower (antennaGain, enbMob, ueMob);
+          rxPower [e] = enbDevs [e]->GetTxPower () + gainDb [u][e];
+          if (rxPower [e] > rxPower [best])
+            {
+              best = e;
+            }
+          if (enbDevs [e] == ueDev->GetEnb ())
+            {
+              serving [u] = e;
+            }
+        }
+
+      if (serving [u] == nEnbs)
+        {
+          // Initial cell selection.
+          enbDevs [best]->Attach (ueDev);
+          serving [u] = best;
+        }
+      else if (m_handover
+               && rxPower [best] > rxPower [serving [u]] + m_hoHysteresis)
+        {
+          // A3 event: start the time to trigger for a new target.
+          HandoverEvent &event = m_hoEvents [ueDev->GetImsi ()];
+          if (event.target != enbDevs [best])
+            {
+              event.timer.Cancel ();
+              event.ueDev = ueDev;
+              event.target = enbDevs [best];
+              event.timer = Simulator::Schedule (
+                  m_hoTimeToTrigger, &RadioNetwork::TriggerAbstractHandover,
+                  this, ueDev->GetImsi ());
+            }
+        }
+      else
+        {
+          // A3 event left: stop the time to trigger.
+          auto evIt = m_hoEvents.find (ueDev->GetImsi ());
+          if (evIt != m_hoEvents.end ())
+            {
+              evIt->second.timer.Cancel ();
+              m_hoEvents.erase (evIt);
+            }
+        }
+    }
+
+  // The uplink interference at each eNB comes from the UEs transmitting in
+  // the other cells. Considering fully loaded cells where a single UE at a
+  // time uses the whole uplink band, each cell contributes with the average
+  // power received from its own UEs.
+  std::vector<double> cellUlPower (nEnbs * nEnbs, 0.0);
+  std::vector<uint32_t> cellUes (nEnbs, 0);
+  for (uint32_t u = 0; u < nUes; u++)
+    {
+      Ptr<AbstractUeNetDevice> ueDev =
+        DynamicCast<AbstractUeNetDevice> (m_ueDevices.Get (u));
+      cellUes [serving [u]]++;
+      for (uint32_t e = 0; e < nEnbs; e++)
+        {
+          cellUlPower [serving [u] * nEnbs + e] +=
+            DbmToMw (ueDev->GetTxPower () + gainDb [u][e]);
+        }
+    }
+  std::vector<double> ulCellInterference (nEnbs, 0.0);
+  for (uint32_t e = 0; e < nEnbs; e++)
+    {
+      for (uint32_t c = 0; c < nEnbs; c++)
+        {
+          if (c != e && cellUes [c] > 0)
+            {
+              ulCellInterference [e] +=
+                cellUlPower [c * nEnbs + e] / cellUes [c];
+            }
+        }
+    }
+
+  // Then, update the achievable rates for each UE.
+  for (uint32_t u = 0; u < nUes; u++)
+    {
+      Ptr<AbstractUeNetDevice> ueDev =
+        DynamicCast<AbstractUeNetDevice> (m_ueDevices.Get (u));
+      Ptr<AbstractEnbNetDevice> enbDev = enbDevs [serving [u]];
+
+      // Downlink SINR considering fully loaded interfering cells.
+      double dlInterference = DbmToMw (
+          GetNoisePower (enbDev->GetDlBandwidth (), ueDev->GetNoiseFigure ()));
+      for (uint32_t e = 0; e < nEnbs; e++)
+        {
+          if (e != serving [u])
+            {
+              dlInterference += DbmToMw (
+                  enbDevs [e]->GetTxPower () + gainDb [u][e]);
+            }
+        }
+      double dlSinr = 10.0 * std::log10 (
+          DbmToMw (enbDev->GetTxPower () + gainDb [u][serving [u]]) /
+          dlInterference);
+
+      // Uplink SINR considering the interference from other cells.
+      double ulInterference = ulCellInterference [serving [u]] +
+        DbmToMw (GetNoisePower (enbDev->GetUlBandwidth (),
+                                enbDev->GetNoiseFigure ()));
+      double ulSinr = 10.0 * std::log10 (
+          DbmToMw (ueDev->GetTxPower () + gainDb [u][serving [u]]) /
+          ulInterference);
+
+      ueDev->SetRates (enbDev->GetAchievableRate (dlSinr, Direction::DLINK),
+                       enbDev->GetAchievableRate (ulSinr, Direction::ULINK));
+      NS_LOG_DEBUG ("UE IMSI " << ueDev->GetImsi () <<
+                    " cell " << enbDev->GetCellId () <<
+                    " DL SINR " << dlSinr << " UL SINR " << ulSinr);
+    }
+
+  m_absEvent = Simulator::Schedule (
+      m_absInterval, &RadioNetwork::UpdateAbstractRadio, this);
+}
+
+void
+RadioNetwork::TriggerAbstractHandover (uint64_t imsi)
+{
+  NS_LOG_FUNCTION (this << imsi);
+
+  auto evIt = m_hoEvents.find (imsi);
+  NS_ASSERT_MSG (evIt != m_hoEvents.end (), "No handover event for this UE.");
+
+  NS_LOG_INFO ("UE IMSI " << imsi << " handover to cell " <<
+               evIt->second.target->GetCellId ());
+  evIt->second.target->HandoverIn (evIt->second.ueDev);
+  m_hoEvents.erase (evIt);
+}
+
 } // namespace ns3
@@ -27,6 +27,8 @@
 #include <ns3/lte-module.h>
 #include <ns3/mobility-module.h>
 #include <ns3/network-module.h>
+#include "abstract-enb-net-device.h"
+#include "abstract-ue-net-device.h"
 
 namespace ns3 {
 
@@ -35,10 +37,29 @@ namespace ns3 {
  * LTE radio access network with eNBs grouped in three-sector sites layed out
  * on an hexagonal grid. UEs are randomly distributed around the sites and
  * attach to the network automatically using idle mode cell selection.
+ *
+ * In the abstract radio mode, the LTE protocol stack is replaced by the
+ * AbstractEnbNetDevice and AbstractUeNetDevice, which keep the S1-U and X2
+ * interfaces but shape the traffic of each UE at the achievable rate for its
+ * radio conditions. The radio conditions are periodically evaluated from the
+ * same path loss and antenna models used by the full mode: both downlink and
+ * uplink SINR consider fully loaded interfering cells (in the uplink, each
+ * cell interferes with the average power received from its own UEs), and
+ * handovers follow the A3 RSRP event with the full mode parameters. LTE stats
+ * calculators, LTE ASCII traces and the radio environment map are not
+ * available in this mode. The accuracy and speedup of this mode against the
+ * full mode have not been evaluated yet.
  */
 class RadioNetwork : public Object
 {
 public:
+  /** The radio access simulation mode. */
+  enum RadioMode
+  {
+    FULL     = 0, //!< Full LTE protocol stack with spectrum PHY.
+    ABSTRACT = 1  //!< Rate-shaped links from SINR-to-throughput tables.
+  };
+
   /**
    * Complete constructor.
    * \param helper The scenario helper (EpcHelper).
@@ -52,6 +73,16 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Activate a dedicated EPS bearer for the given UE device.
+   * \param ueDevice The UE device.
+   * \param bearer The bearer characteristics.
+   * \param tft The bearer traffic flow template.
+   * \return The bearer ID.
+   */
+  uint8_t ActivateDedicatedEpsBearer (Ptr<NetDevice> ueDevice,
+                                      EpsBearer bearer, Ptr<EpcTft> tft);
+
   /**
    * Enables automatic attachment of a set of UE devices to a suitable cell
    * using idle mode initial cell selection procedure.
@@ -79,7 +110,7 @@ public:
 
   /**
    * Get the LTE helper used to configure this radio network.
-   * \return The LTE helper.
+   * \return The LTE helper, or null in the abstract radio mode.
    */
   Ptr<LteHelper> GetLteHelper (void) const;
 
@@ -94,6 +125,12 @@ public:
   Ptr<PositionAllocator> GetRandomPositionAllocator (
     uint16_t cellSiteId = 0) const;
 
+  /**
+   * Get the radio access simulation mode.
+   * \return The radio mode.
+   */
+  RadioMode GetRadioMode (void) const;
+
   /**
    * Print LTE radio environment map.
    */
@@ -107,10 +144,40 @@ protected:
   void NotifyConstructionCompleted (void);
 
 private:
+  /**
+   * Create the abstract eNB devices, placing the eNB nodes on the hexagonal
+   * grid with the same layout used by the LteHexGridEnbTopologyHelper.
+   */
+  void InstallAbstractEnbDevices (void);
+
+  /**
+   * Periodically evaluate the radio conditions of UEs in the abstract radio
+   * mode, attaching new UEs, triggering handovers, and updating the
+   * achievable rates for each UE.
+   */
+  void UpdateAbstractRadio (void);
+
+  /**
+   * Handover the UE to the target eNB of its pending A3 event once the time
+   * to trigger expires (abstract radio mode).
+   * \param imsi The UE IMSI.
+   */
+  void TriggerAbstractHandover (uint64_t imsi);
+
+  /** Pending A3 handover event for a UE in the abstract radio mode. */
+  struct HandoverEvent
+  {
+    Ptr<AbstractUeNetDevice>  ueDev;    //!< UE device.
+    Ptr<AbstractEnbNetDevice> target;   //!< Target eNB device.
+    EventId                   timer;    //!< Time to trigger timer.
+  };
+
   uint32_t            m_nSites;         //!< Number of cell sites.
   double              m_enbMargin;      //!< eNB coverage margin.
   double              m_ueHeight;       //!< UE height.
   bool                m_handover;       //!< Enable UE handover.
+  double              m_hoHysteresis;   //!< A3 handover hysteresis.
+  Time                m_hoTimeToTrigger; //!< A3 handover time to trigger.
   bool                m_lteTrace;       //!< Enable LTE ASCII traces.
   std::string         m_remFilename;    //!< LTE REM filename.
   NodeContainer       m_enbNodes;       //!< eNB nodes.
@@ -118,6 +185,16 @@ private:
   NodeContainer       m_ueNodes;        //!< UE nodes.
   NetDeviceContainer  m_ueDevices;      //!< UE devices.
   Rectangle           m_ranCoverArea;   //!< LTE radio coverage area.
+  RadioMode           m_radioMode;      //!< Radio access simulation mode.
+  Time                m_absInterval;    //!< Abstract radio update interval.
+  uint64_t            m_imsiCounter;    //!< Abstract UE IMSI counter.
+  EventId             m_absEvent;       //!< Abstract radio update event.
+  ObjectFactory       m_absUeFactory;   //!< Abstract UE device factory.
+
+  /** Pending A3 handover events by UE IMSI (abstract radio mode). */
+  std::map<uint64_t, HandoverEvent> m_hoEvents;
+
+  Ptr<PropagationLossModel>        m_lossModel;     //!< Abstract path loss.
 
   Ptr<LteHexGridEnbTopologyHelper> m_topoHelper;    //!< Grid topology helper.
   Ptr<RadioEnvironmentMapHelper>   m_remHelper;     //!< Radio map helper.
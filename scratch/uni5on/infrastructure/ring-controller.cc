@@ -95,140 +95,13 @@ RingController::NotifyConstructionCompleted (void)
   BackhaulController::NotifyConstructionCompleted ();
 }
 
-bool
-RingController::BearerRequest (Ptr<RoutingInfo> rInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  // Reset the shortest path for the S1-U interface (the handover procedure may
-  // have changed the eNB switch index.)
-  SetShortestPath (ringInfo, LteIface::S1);
-
-  // Part 1: Check for the available resources on the S5 interface.
-  bool s5Ok = HasAvailableResources (ringInfo, LteIface::S5);
-  if (!s5Ok)
-    {
-      NS_ASSERT_MSG (rInfo->IsBlocked (), "This bearer should be blocked.");
-      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
-                   " because there are no resources for the S5 interface.");
-    }
-
-  // Part 2: Check for the available resources on the S1-U interface.
-  // To avoid errors when reserving bit rates, check for overlapping links.
-  LinkInfoSet_t s5Links;
-  GetLinkSet (ringInfo, LteIface::S5, &s5Links);
-  bool s1Ok = HasAvailableResources (ringInfo, LteIface::S1, &s5Links);
-  if (!s1Ok)
-    {
-      NS_ASSERT_MSG (rInfo->IsBlocked (), "This bearer should be blocked.");
-      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
-                   " because there are no resources for the S1-U interface.");
-    }
-
-  return (s5Ok && s1Ok);
-}
-
-bool
-RingController::BearerReserve (Ptr<RoutingInfo> rInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo);
-
-  NS_ASSERT_MSG (!rInfo->IsBlocked (), "Bearer should not be blocked.");
-  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  bool success = true;
-  success &= BitRateReserve (ringInfo, LteIface::S5);
-  success &= BitRateReserve (ringInfo, LteIface::S1);
-  return success;
-}
-
-bool
-RingController::BearerRelease (Ptr<RoutingInfo> rInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo);
-
-  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  bool success = true;
-  success &= BitRateRelease (ringInfo, LteIface::S5);
-  success &= BitRateRelease (ringInfo, LteIface::S1);
-  return success;
-}
-
-bool
-RingController::BearerInstall (Ptr<RoutingInfo> rInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
-
-  NS_ASSERT_MSG (rInfo->IsGwInstalled (), "Gateway rules not installed.");
-  NS_LOG_INFO ("Installing ring rules for teid " << rInfo->GetTeidHex ());
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  bool success = true;
-  success &= RulesInstall (ringInfo, LteIface::S5);
-  success &= RulesInstall (ringInfo, LteIface::S1);
-  return success;
-}
-
-bool
-RingController::BearerRemove (Ptr<RoutingInfo> rInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
-
-  NS_ASSERT_MSG (!rInfo->IsGwInstalled (), "Gateway rules installed.");
-  NS_LOG_INFO ("Removing ring rules for teid " << rInfo->GetTeidHex ());
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  bool success = true;
-  success &= RulesRemove (ringInfo, LteIface::S5);
-  success &= RulesRemove (ringInfo, LteIface::S1);
-  return success;
-}
-
-bool
-RingController::BearerUpdate (Ptr<RoutingInfo> rInfo, Ptr<EnbInfo> dstEnbInfo)
-{
-  NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
-
-  NS_ASSERT_MSG (rInfo->IsGwInstalled (), "Gateway rules not installed.");
-  NS_ASSERT_MSG (rInfo->GetEnbCellId () != dstEnbInfo->GetCellId (),
-                 "Don't update UE's eNB info before BearerUpdate.");
-  NS_LOG_INFO ("Updating ring rules for teid " << rInfo->GetTeidHex ());
-
-  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
-
-  // Each slice has a single P-GW and S-GW, so handover only changes the eNB.
-  // Thus, we only need to modify the S1-U backhaul rules.
-  bool success = true;
-  success &= RulesUpdate (ringInfo, LteIface::S1, dstEnbInfo);
-  return success;
-}
-
 void
 RingController::NotifyBearerCreated (Ptr<RoutingInfo> rInfo)
 {
   NS_LOG_FUNCTION (this << rInfo->GetTeidHex ());
 
   // Let's create its ring routing metadata.
-  Ptr<RingInfo> ringInfo = CreateObject<RingInfo> (rInfo);
-
-  // Set the downlink shortest path for both S1-U and S5 interfaces.
-  SetShortestPath (ringInfo, LteIface::S5);
-  SetShortestPath (ringInfo, LteIface::S1);
+  CreateObject<RingInfo> (rInfo);
 
   BackhaulController::NotifyBearerCreated (rInfo);
 }
@@ -244,6 +117,9 @@ RingController::NotifyTopologyBuilt (OFSwitch13DeviceContainer &devices)
   // Create the spanning tree for this topology.
   CreateSpanningTree ();
 
+  // Build the routing paths in both ring directions.
+  CreatePathCache ();
+
   // Iterate over links configuring the ring routing groups.
   // The following commands works as LINKS ARE CREATED IN CLOCKWISE DIRECTION.
   // Groups must be created first to avoid OpenFlow BAD_OUT_GROUP error code.
@@ -295,7 +171,7 @@ RingController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
         << ",ip_dst="         << BackhaulNetwork::m_x2Addr
         << "/"                << BackhaulNetwork::m_x2Mask.GetPrefixLength ()
         << " write:group="    << RingInfo::CLOCK
-        << " goto:"           << OUTPT_TAB;
+        << " goto:"           << GetOutputTable ();
     DpctlExecute (swDpId, cmd.str ());
   }
 
@@ -341,178 +217,6 @@ RingController::HandshakeSuccessful (Ptr<const RemoteSwitch> swtch)
   BackhaulController::HandshakeSuccessful (swtch);
 }
 
-bool
-RingController::BitRateRequest (
-  Ptr<RingInfo> ringInfo, LteIface iface, LinkInfoSet_t *overlap) const
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface << overlap);
-
-  // Ignoring this check for Non-GBR bearers, aggregated bearers,
-  // and local-routing bearers.
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  if (rInfo->IsNonGbr () || ringInfo->IsLocalPath (iface)
-      || (rInfo->IsAggregated () && GetAggBitRateCheck () == OpMode::OFF))
-    {
-      return true;
-    }
-
-  return BitRateRequest (
-    rInfo->GetSrcDlInfraSwIdx (iface),
-    rInfo->GetDstDlInfraSwIdx (iface),
-    rInfo->GetGbrDlBitRate (),
-    rInfo->GetGbrUlBitRate (),
-    ringInfo->GetDlPath (iface),
-    rInfo->GetSliceId (),
-    GetSliceController (rInfo->GetSliceId ())->GetGbrBlockThs (),
-    overlap);
-}
-
-bool
-RingController::BitRateRequest (
-  uint16_t srcIdx, uint16_t dstIdx, int64_t fwdBitRate, int64_t bwdBitRate,
-  RingInfo::RingPath path, SliceId slice, double blockThs,
-  LinkInfoSet_t *overlap) const
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << fwdBitRate <<
-                   bwdBitRate << path << slice << blockThs << overlap);
-
-  // Walk through links in the given routing path, requesting for the bit rate.
-  LinkInfo::LinkDir fwdDir, bwdDir;
-  Ptr<LinkInfo> lInfo;
-  bool ok = true;
-  while (ok && srcIdx != dstIdx)
-    {
-      uint16_t next = GetNextSwIdx (srcIdx, path);
-      std::tie (lInfo, fwdDir, bwdDir) = GetLinkInfo (srcIdx, next);
-      if (overlap && overlap->find (lInfo) != overlap->end ())
-        {
-          // Ensure that overlapping links have the requested bandwidth for
-          // both directions, otherwise the BitRateReserve method will fail.
-          int64_t sumBitRate = fwdBitRate + bwdBitRate;
-          ok &= lInfo->HasBitRate (fwdDir, slice, sumBitRate, blockThs);
-          ok &= lInfo->HasBitRate (bwdDir, slice, sumBitRate, blockThs);
-        }
-      else
-        {
-          ok &= lInfo->HasBitRate (fwdDir, slice, fwdBitRate, blockThs);
-          ok &= lInfo->HasBitRate (bwdDir, slice, bwdBitRate, blockThs);
-        }
-      srcIdx = next;
-    }
-  return ok;
-}
-
-bool
-RingController::BitRateReserve (
-  Ptr<RingInfo> ringInfo, LteIface iface)
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  NS_ASSERT_MSG (!rInfo->IsBlocked (), "Bearer should not be blocked.");
-  NS_ASSERT_MSG (!rInfo->IsAggregated (), "Bearer should not be aggregated.");
-  NS_ASSERT_MSG (!rInfo->IsGbrReserved (iface), "Bit rate already reserved.");
-
-  NS_LOG_INFO ("Reserving resources for teid " << rInfo->GetTeidHex () <<
-               " on interface " << LteIfaceStr (iface));
-
-  // Ignoring bearers without guaranteed bit rate or local-routing bearers.
-  if (!rInfo->HasGbrBitRate () || ringInfo->IsLocalPath (iface))
-    {
-      return true;
-    }
-  NS_ASSERT_MSG (rInfo->IsGbr (), "Non-GBR bearers should not get here.");
-
-  bool success = BitRateReserve (
-      rInfo->GetSrcDlInfraSwIdx (iface),
-      rInfo->GetDstDlInfraSwIdx (iface),
-      rInfo->GetGbrDlBitRate (),
-      rInfo->GetGbrUlBitRate (),
-      ringInfo->GetDlPath (iface),
-      rInfo->GetSliceId ());
-  rInfo->SetGbrReserved (iface, success);
-  return success;
-}
-
-bool
-RingController::BitRateReserve (
-  uint16_t srcIdx, uint16_t dstIdx, int64_t fwdBitRate, int64_t bwdBitRate,
-  RingInfo::RingPath path, SliceId slice)
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << fwdBitRate <<
-                   bwdBitRate << path << slice);
-
-  // Walk through links in the given routing path, reserving the bit rate.
-  LinkInfo::LinkDir fwdDir, bwdDir;
-  Ptr<LinkInfo> lInfo;
-  bool ok = true;
-  while (ok && srcIdx != dstIdx)
-    {
-      uint16_t next = GetNextSwIdx (srcIdx, path);
-      std::tie (lInfo, fwdDir, bwdDir) = GetLinkInfo (srcIdx, next);
-      ok &= lInfo->UpdateResBitRate (fwdDir, slice, fwdBitRate);
-      ok &= lInfo->UpdateResBitRate (bwdDir, slice, bwdBitRate);
-      SlicingMeterAdjust (lInfo, slice);
-      srcIdx = next;
-    }
-
-  NS_ASSERT_MSG (ok, "Error when reserving bit rate.");
-  return ok;
-}
-
-bool
-RingController::BitRateRelease (
-  Ptr<RingInfo> ringInfo, LteIface iface)
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  NS_LOG_INFO ("Releasing resources for teid " << rInfo->GetTeidHex () <<
-               " on interface " << LteIfaceStr (iface));
-
-  // Ignoring when there is no bit rate to release.
-  if (!rInfo->IsGbrReserved (iface))
-    {
-      return true;
-    }
-
-  bool success = BitRateRelease (
-      rInfo->GetSrcDlInfraSwIdx (iface),
-      rInfo->GetDstDlInfraSwIdx (iface),
-      rInfo->GetGbrDlBitRate (),
-      rInfo->GetGbrUlBitRate (),
-      ringInfo->GetDlPath (iface),
-      rInfo->GetSliceId ());
-  rInfo->SetGbrReserved (iface, !success);
-  return success;
-}
-
-bool
-RingController::BitRateRelease (
-  uint16_t srcIdx, uint16_t dstIdx, int64_t fwdBitRate, int64_t bwdBitRate,
-  RingInfo::RingPath path, SliceId slice)
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << fwdBitRate <<
-                   bwdBitRate << path << slice);
-
-  // Walk through links in the given routing path, releasing the bit rate.
-  LinkInfo::LinkDir fwdDir, bwdDir;
-  Ptr<LinkInfo> lInfo;
-  bool ok = true;
-  while (ok && srcIdx != dstIdx)
-    {
-      uint16_t next = GetNextSwIdx (srcIdx, path);
-      std::tie (lInfo, fwdDir, bwdDir) = GetLinkInfo (srcIdx, next);
-      ok &= lInfo->UpdateResBitRate (fwdDir, slice, -fwdBitRate);
-      ok &= lInfo->UpdateResBitRate (bwdDir, slice, -bwdBitRate);
-      SlicingMeterAdjust (lInfo, slice);
-      srcIdx = next;
-    }
-
-  NS_ASSERT_MSG (ok, "Error when releasing bit rate.");
-  return ok;
-}
-
 void
 RingController::CreateSpanningTree (void)
 {
@@ -543,30 +247,46 @@ RingController::CreateSpanningTree (void)
   }
 }
 
-void
-RingController::GetLinkSet (
-  Ptr<RingInfo> ringInfo, LteIface iface, LinkInfoSet_t *links) const
+std::vector<BackhaulController::SwitchList_t>
+RingController::FindPaths (uint16_t srcIdx, uint16_t dstIdx) const
 {
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  NS_ASSERT_MSG (links && links->empty (), "Set of links should be empty.");
+  NS_LOG_FUNCTION (this << srcIdx << dstIdx);
 
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  uint16_t curr = rInfo->GetSrcDlInfraSwIdx (iface);
-  uint16_t last = rInfo->GetDstDlInfraSwIdx (iface);
-  RingInfo::RingPath path = ringInfo->GetDlPath (iface);
+  // The shortest path comes first. When using the shortest path first
+  // strategy, the path in the opposite direction is the alternative one.
+  std::vector<SwitchList_t> paths;
+  RingInfo::RingPath shortPath = GetShortPath (srcIdx, dstIdx);
+  std::vector<RingInfo::RingPath> ringPaths (1, shortPath);
+  if (GetRoutingStrategy () == RingController::SPF)
+    {
+      ringPaths.push_back (RingInfo::InvertPath (shortPath));
+    }
 
-  // Walk through the downlink path.
-  LinkInfo::LinkDir dlDir, ulDir;
-  Ptr<LinkInfo> lInfo;
-  while (curr != last)
+  // Walk through the ring following each routing direction.
+  for (RingInfo::RingPath ringPath : ringPaths)
     {
-      uint16_t next = GetNextSwIdx (curr, path);
-      std::tie (lInfo, dlDir, ulDir) = GetLinkInfo (curr, next);
-      auto ret = links->insert (lInfo);
-      NS_ABORT_MSG_IF (ret.second == false, "Error saving link info.");
-      curr = next;
+      SwitchList_t path (1, srcIdx);
+      while (path.back () != dstIdx)
+        {
+          path.push_back (GetNextSwIdx (path.back (), ringPath));
+        }
+      paths.push_back (path);
     }
+  return paths;
+}
+
+std::string
+RingController::GetHopActions (const PathHop &hop) const
+{
+  NS_LOG_FUNCTION (this << hop.srcIdx << hop.dstIdx);
+
+  // Write the output group for this ring direction into action set, and
+  // save it in the metadata for the inter-slicing meters.
+  RingInfo::RingPath path = RingInfo::LinkDirToRingPath (hop.fwdDir);
+  std::ostringstream ins;
+  ins << " write:group=" << path
+      << " meta:"        << path;
+  return ins.str ();
 }
 
 uint16_t
@@ -585,33 +305,15 @@ RingController::GetNextSwIdx (
 }
 
 uint16_t
-RingController::GetNumHops (
-  uint16_t srcIdx, uint16_t dstIdx, RingInfo::RingPath path) const
+RingController::GetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface) const
 {
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx);
+  NS_LOG_FUNCTION (this << rInfo << iface);
 
-  NS_ASSERT_MSG (path != RingInfo::UNDEF, "Invalid ring routing path.");
-  NS_ASSERT (std::max (srcIdx, dstIdx) < GetNSwitches ());
-
-  // Check for local routing.
-  if (path == RingInfo::LOCAL)
-    {
-      NS_ASSERT (srcIdx == dstIdx);
-      return 0;
-    }
+  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
+  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
 
-  // Count the number of hops from src to dst switch index.
-  NS_ASSERT (srcIdx != dstIdx);
-  int distance = dstIdx - srcIdx;
-  if (path == RingInfo::COUNT)
-    {
-      distance = srcIdx - dstIdx;
-    }
-  if (distance < 0)
-    {
-      distance += GetNSwitches ();
-    }
-  return distance;
+  // The short path is the first one in the cache.
+  return ringInfo->IsShortPath (iface) ? 0 : 1;
 }
 
 RingInfo::RingPath
@@ -640,486 +342,26 @@ RingController::GetShortPath (
          RingInfo::COUNT;
 }
 
-bool
-RingController::HasAvailableResources (
-  Ptr<RingInfo> ringInfo, LteIface iface, LinkInfoSet_t *overlap) const
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  // Check for the available resources on the default path.
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  bool bwdOk = BitRateRequest (ringInfo, iface, overlap);
-  bool cpuOk = SwitchCpuRequest (ringInfo, iface);
-  bool tabOk = SwitchTableRequest (ringInfo, iface);
-  if ((bwdOk == false || cpuOk == false || tabOk == false)
-      && GetRoutingStrategy () == RingController::SPF)
-    {
-      // We don't have the resources in the default path.
-      // Let's invert the routing path and check again.
-      ringInfo->InvertPath (iface);
-      bwdOk = BitRateRequest (ringInfo, iface, overlap);
-      cpuOk = SwitchCpuRequest (ringInfo, iface);
-      tabOk = SwitchTableRequest (ringInfo, iface);
-    }
-
-  // Set the blocked flagged when necessary.
-  if (!bwdOk)
-    {
-      rInfo->SetBlocked (RoutingInfo::BACKBAND);
-      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
-                   " because at least one backhaul link is overloaded.");
-    }
-  if (!cpuOk)
-    {
-      rInfo->SetBlocked (RoutingInfo::BACKLOAD);
-      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
-                   " because at least one backhaul switch is overloaded.");
-    }
-  if (!tabOk)
-    {
-      rInfo->SetBlocked (RoutingInfo::BACKTABLE);
-      NS_LOG_WARN ("Blocking bearer teid " << rInfo->GetTeidHex () <<
-                   " because at least one backhaul switch table is full.");
-    }
-
-  return (bwdOk && cpuOk && tabOk);
-}
-
-bool
-RingController::RulesInstall (
-  Ptr<RingInfo> ringInfo, LteIface iface)
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  NS_ASSERT_MSG (!rInfo->IsIfInstalled (iface), "Ring rules installed.");
-  bool success = true;
-
-  // No rules to install for local-routing bearers.
-  if (ringInfo->IsLocalPath (iface))
-    {
-      return true;
-    }
-
-  // -------------------------------------------------------------------------
-  // Slice table -- [from higher to lower priority]
-  //
-  // Cookie and MBR meter ID for new rules.
-  uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
-  uint64_t cookie = CookieCreate (
-      iface, rInfo->GetPriority (), rInfo->GetTeid ());
-
-  // Building the dpctl command.
-  std::ostringstream cmd;
-  cmd << "flow-mod cmd=add"
-      << ",table="  << GetSliceTable (rInfo->GetSliceId ())
-      << ",flags="  << FLAGS_REMOVED_OVERLAP_RESET
-      << ",cookie=" << GetUint64Hex (cookie)
-      << ",prio="   << rInfo->GetPriority ()
-      << ",idle="   << rInfo->GetTimeout ();
-  std::string cmdStr = cmd.str ();
-
-  // Configuring downlink routing.
-  if (rInfo->HasDlTraffic ())
-    {
-      if (rInfo->HasMbrDl ())
-        {
-          NS_ASSERT_MSG (!rInfo->IsMbrDlInstalled (iface), "Meter installed.");
-
-          // Install downlink MBR meter entry on the input switch.
-          std::ostringstream met;
-          met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
-              << " drop:rate=" << rInfo->GetMbrDlBitRate () / 1000;
-          std::string metStr = met.str ();
-
-          DpctlExecute (GetDpId (rInfo->GetSrcDlInfraSwIdx (iface)), metStr);
-          rInfo->SetMbrDlInstalled (iface, true);
-        }
-
-      success &= RulesInstall (
-          rInfo->GetSrcDlInfraSwIdx (iface),
-          rInfo->GetDstDlInfraSwIdx (iface),
-          ringInfo->GetDlPath (iface),
-          rInfo->GetTeid (),
-          rInfo->GetDstDlAddr (iface),
-          rInfo->GetDscpValue (),
-          rInfo->IsMbrDlInstalled (iface) ? mbrMeterId : 0,
-          cmdStr);
-    }
-
-  // Configuring uplink routing.
-  if (rInfo->HasUlTraffic ())
-    {
-      if (rInfo->HasMbrUl ())
-        {
-          NS_ASSERT_MSG (!rInfo->IsMbrUlInstalled (iface), "Meter installed.");
-
-          // Install uplink MBR meter entry on the input switch.
-          std::ostringstream met;
-          met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
-              << " drop:rate=" << rInfo->GetMbrUlBitRate () / 1000;
-          std::string metStr = met.str ();
-
-          DpctlExecute (GetDpId (rInfo->GetSrcUlInfraSwIdx (iface)), metStr);
-          rInfo->SetMbrUlInstalled (iface, true);
-        }
-
-      success &= RulesInstall (
-          rInfo->GetSrcUlInfraSwIdx (iface),
-          rInfo->GetDstUlInfraSwIdx (iface),
-          ringInfo->GetUlPath (iface),
-          rInfo->GetTeid (),
-          rInfo->GetDstUlAddr (iface),
-          rInfo->GetDscpValue (),
-          rInfo->IsMbrUlInstalled (iface) ? mbrMeterId : 0,
-          cmdStr);
-    }
-
-  // Update the installed flag for this interface.
-  rInfo->SetIfInstalled (iface, success);
-  return success;
-}
-
-bool
-RingController::RulesInstall (
-  uint16_t srcIdx, uint16_t dstIdx, RingInfo::RingPath path, uint32_t teid,
-  Ipv4Address dstAddr, uint16_t dscp, uint32_t meter, std::string cmdStr)
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << path << teid <<
-                   dstAddr << dscp << meter << cmdStr);
-
-  NS_ASSERT_MSG (srcIdx != dstIdx, "Can't install rules for local routing.");
-
-  // Building the match string (using GTP TEID to identify the bearer and
-  // the IP destination address to identify the logical interface).
-  std::ostringstream mat;
-  mat << " eth_type="   << IPV4_PROT_NUM
-      << ",ip_proto="   << UDP_PROT_NUM
-      << ",ip_dst="     << dstAddr
-      << ",gtpu_teid="  << GetUint32Hex (teid);
-  std::string matStr = mat.str ();
-
-  // Building the instructions string for the first switch.
-  std::ostringstream ins1;
-  if (meter)
-    {
-      ins1 << " meter:" << meter;
-    }
-  if (dscp)
-    {
-      ins1 << " apply:set_field=ip_dscp:" << dscp;
-    }
-  std::string ins1Str = ins1.str ();
-
-  // Building the instructions string for all switches.
-  std::ostringstream ins;
-  ins << " write:group=" << path
-      << " meta:"        << path
-      << " goto:"        << BANDW_TAB;
-  std::string insStr = ins.str ();
-
-  // Installing OpenFlow routing rules.
-  DpctlExecute (GetDpId (srcIdx), cmdStr + matStr + ins1Str + insStr);
-  srcIdx = GetNextSwIdx (srcIdx, path);
-  while (srcIdx != dstIdx)
-    {
-      DpctlExecute (GetDpId (srcIdx), cmdStr + matStr + insStr);
-      srcIdx = GetNextSwIdx (srcIdx, path);
-    }
-  return true;
-}
-
-bool
-RingController::RulesRemove (
-  Ptr<RingInfo> ringInfo, LteIface iface)
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  // No rules installed for this interface.
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  if (!rInfo->IsIfInstalled (iface))
-    {
-      return true;
-    }
-
-  // Building the dpctl command. Matching cookie for interface and TEID.
-  uint64_t cookie = CookieCreate (iface, 0, rInfo->GetTeid ());
-  std::ostringstream cmd;
-  cmd << "flow-mod cmd=del"
-      << ",table="        << GetSliceTable (rInfo->GetSliceId ())
-      << ",cookie="       << GetUint64Hex (cookie)
-      << ",cookie_mask="  << GetUint64Hex (COOKIE_IFACE_TEID_MASK);
-  std::string cmdStr = cmd.str ();
-
-  RingInfo::RingPath dlPath = ringInfo->GetDlPath (iface);
-  uint16_t curr = rInfo->GetSrcDlInfraSwIdx (iface);
-  uint16_t last = rInfo->GetDstDlInfraSwIdx (iface);
-  while (curr != last)
-    {
-      DpctlExecute (GetDpId (curr), cmdStr);
-      curr = GetNextSwIdx (curr, dlPath);
-    }
-  DpctlExecute (GetDpId (curr), cmdStr);
-
-  // Remove installed MBR meter entries.
-  if (rInfo->HasMbr ())
-    {
-      uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
-
-      std::ostringstream met;
-      met << "meter-mod cmd=del,meter=" << mbrMeterId;
-      std::string metStr = met.str ();
-
-      if (rInfo->IsMbrDlInstalled (iface))
-        {
-          DpctlExecute (GetDpId (rInfo->GetSrcDlInfraSwIdx (iface)), metStr);
-          rInfo->SetMbrDlInstalled (iface, false);
-        }
-      if (rInfo->IsMbrUlInstalled (iface))
-        {
-          DpctlExecute (GetDpId (rInfo->GetSrcUlInfraSwIdx (iface)), metStr);
-          rInfo->SetMbrUlInstalled (iface, false);
-        }
-    }
-
-  // Update the installed flag for this interface.
-  rInfo->SetIfInstalled (iface, false);
-  return true;
-}
-
-bool
-RingController::RulesUpdate (
-  Ptr<RingInfo> ringInfo, LteIface iface, Ptr<EnbInfo> dstEnbInfo)
+void
+RingController::SetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface,
+                              uint16_t index, const RoutingPath_t &path)
 {
-  NS_LOG_FUNCTION (this << ringInfo << iface << dstEnbInfo);
-
-  NS_ASSERT_MSG (iface == LteIface::S1, "Only S1-U interface supported.");
-
-  // During this procedure, the eNB was not updated in the rInfo yet.
-  // So, the following methods will return information for the old eNB.
-  // rInfo->GetEnbCellId ()                   // eNB cell ID
-  // rInfo->GetEnbInfraSwIdx ()               // eNB switch index
-  // rInfo->GetDstDlInfraSwIdx (LteIface::S1) // eNB switch index
-  // rInfo->GetSrcUlInfraSwIdx (LteIface::S1) // eNB switch index
-  // rInfo->GetEnbS1uAddr ()                  // eNB S1-U address
-  // rInfo->GetDstDlAddr (LteIface::S1)       // eNB S1-U address
-  // rInfo->GetSrcUlAddr (LteIface::S1)       // eNB S1-U address
-  //
-  // We can't just modify the OpenFlow rules in the backhaul switches because
-  // we need to change the match fields. So, we will schedule the removal of
-  // old low-priority rules from the old routing path and install new rules in
-  // the new routing path (may be the same), using a higher priority and the
-  // dstEnbInfo metadata.
-
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-
-  // MBR meter ID for this bearer (won't change on update).
-  uint32_t mbrMeterId = MeterIdMbrCreate (iface, rInfo->GetTeid ());
-  bool success = true;
-
-  // Schedule the removal of old low-priority OpenFlow rules.
-  if (rInfo->IsIfInstalled (iface))
-    {
-      // Cookie for old rules. Using old low-priority.
-      uint64_t oldCookie = CookieCreate (
-          iface, rInfo->GetPriority (), rInfo->GetTeid ());
-
-      // Building the dpctl command. Strict matching cookie.
-      std::ostringstream del;
-      del << "flow-mod cmd=del"
-          << ",table="        << GetSliceTable (rInfo->GetSliceId ())
-          << ",cookie="       << GetUint64Hex (oldCookie)
-          << ",cookie_mask="  << GetUint64Hex (COOKIE_STRICT_MASK);
-      std::string delStr = del.str ();
+  NS_LOG_FUNCTION (this << rInfo << iface << index);
 
-      // Walking through the old S1-U downlink path.
-      RingInfo::RingPath dlPath = ringInfo->GetDlPath (iface);
-      uint16_t curr = rInfo->GetSgwInfraSwIdx ();
-      uint16_t last = rInfo->GetEnbInfraSwIdx ();
-      while (curr != last)
-        {
-          DpctlSchedule (MilliSeconds (250), GetDpId (curr), delStr);
-          curr = GetNextSwIdx (curr, dlPath);
-        }
-      DpctlSchedule (MilliSeconds (250), GetDpId (curr), delStr);
-
-      // Update the installation flag.
-      rInfo->SetIfInstalled (iface, false);
-    }
-
-  // When changing the switch index, we must release any possible reserved bit
-  // rate from the old path, update the ring routing path to the new (shortest)
-  // one, and reserve the bit rate on the new path. For bearers with MBR meter,
-  // also remove it from the old switch and install it into the new switch.
-  if (rInfo->GetEnbInfraSwIdx () != dstEnbInfo->GetInfraSwIdx ())
-    {
-      // Release the bit rate from the old path.
-      if (rInfo->IsGbrReserved (iface))
-        {
-          bool ok = BitRateRelease (
-              rInfo->GetSgwInfraSwIdx (),
-              rInfo->GetEnbInfraSwIdx (),
-              rInfo->GetGbrDlBitRate (),
-              rInfo->GetGbrUlBitRate (),
-              ringInfo->GetDlPath (iface),
-              rInfo->GetSliceId ());
-          rInfo->SetGbrReserved (iface, !ok);
-        }
-
-      // Update the new shortest path from the S-GW to the target eNB.
-      RingInfo::RingPath newDlPath = GetShortPath (
-          rInfo->GetSgwInfraSwIdx (),
-          dstEnbInfo->GetInfraSwIdx ());
-      ringInfo->SetShortDlPath (iface, newDlPath);
-
-      // Try to reserve the bit rate on the new path.
-      if (rInfo->HasGbrBitRate ())
-        {
-          // Check for the available bit rate in the new path and reserve it.
-          // There's no need to check for overlapping paths as the bit rate for
-          // the S5 interface is already reserved.
-          bool hasBitRate = BitRateRequest (
-              rInfo->GetSgwInfraSwIdx (),
-              dstEnbInfo->GetInfraSwIdx (),         // Target eNB switch idx.
-              rInfo->GetGbrDlBitRate (),
-              rInfo->GetGbrUlBitRate (),
-              ringInfo->GetDlPath (iface),          // New downlink path.
-              rInfo->GetSliceId (),
-              GetSliceController (rInfo->GetSliceId ())->GetGbrBlockThs ());
-          if (hasBitRate)
-            {
-              bool ok = BitRateReserve (
-                  rInfo->GetSgwInfraSwIdx (),
-                  dstEnbInfo->GetInfraSwIdx (),     // Target eNB switch idx.
-                  rInfo->GetGbrDlBitRate (),
-                  rInfo->GetGbrUlBitRate (),
-                  ringInfo->GetDlPath (iface),      // New downlink path.
-                  rInfo->GetSliceId ());
-              rInfo->SetGbrReserved (iface, ok);
-            }
-        }
-
-      // Remove the MBR meters from the old switches.
-      if (rInfo->HasMbr ())
-        {
-          std::ostringstream del;
-          del << "meter-mod cmd=del,meter=" << mbrMeterId;
-          std::string delStr = del.str ();
-
-          // In the uplink, the eNB switch will change for sure (we've already
-          // tested it!). So, schedule the removal of MBR meters from the old
-          // eNB switch.
-          if (rInfo->IsMbrUlInstalled (iface))
-            {
-              DpctlSchedule (MilliSeconds (300),
-                             GetDpId (rInfo->GetEnbInfraSwIdx ()), delStr);
-              rInfo->SetMbrUlInstalled (iface, false);
-            }
-
-          // In the downlink, the S-GW switch won't change. But, there's the
-          // speciall case when the new routing path becomes a local one and we
-          // must remove the meter. This must be checked here, after updating
-          // the new shortest path from the S-GW to the target eNB.
-          if (rInfo->IsMbrDlInstalled (iface) && ringInfo->IsLocalPath (iface))
-            {
-              DpctlSchedule (MilliSeconds (300),
-                             GetDpId (rInfo->GetSgwInfraSwIdx ()), delStr);
-              rInfo->SetMbrDlInstalled (iface, false);
-            }
-        }
-    }
+  Ptr<RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
+  NS_ASSERT_MSG (ringInfo, "No ringInfo for this bearer.");
 
-  // Install new high-priority OpenFlow rules for non-local routing paths.
-  if (!ringInfo->IsLocalPath (iface))
+  // The routing direction comes from the link direction of the first hop.
+  RingInfo::RingPath dlPath = RingInfo::LOCAL;
+  if (!path.empty ())
     {
-      // Cookie for new rules. Using new high-priority.
-      uint64_t newCookie = CookieCreate (
-          iface, rInfo->GetPriority () + 1, rInfo->GetTeid ());
-
-      // Building the dpctl command.
-      std::ostringstream cmd;
-      cmd << "flow-mod cmd=add"
-          << ",table="  << GetSliceTable (rInfo->GetSliceId ())
-          << ",flags="  << FLAGS_REMOVED_OVERLAP_RESET
-          << ",cookie=" << GetUint64Hex (newCookie)
-          << ",prio="   << rInfo->GetPriority () + 1
-          << ",idle="   << rInfo->GetTimeout ();
-      std::string cmdStr = cmd.str ();
-
-      // Configuring downlink routing.
-      if (rInfo->HasDlTraffic ())
-        {
-          if (rInfo->HasMbrDl () && !rInfo->IsMbrDlInstalled (iface))
-            {
-              // Install downlink MBR meter entry on the input switch.
-              std::ostringstream met;
-              met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
-                  << " drop:rate=" << rInfo->GetMbrDlBitRate () / 1000;
-              std::string metStr = met.str ();
-
-              DpctlExecute (GetDpId (rInfo->GetSgwInfraSwIdx ()), metStr);
-              rInfo->SetMbrDlInstalled (iface, true);
-            }
-
-          success &= RulesInstall (
-              rInfo->GetSgwInfraSwIdx (),
-              dstEnbInfo->GetInfraSwIdx (),         // Target eNB switch idx.
-              ringInfo->GetDlPath (iface),          // New downlink path.
-              rInfo->GetTeid (),
-              dstEnbInfo->GetS1uAddr (),            // Target eNB address.
-              rInfo->GetDscpValue (),
-              rInfo->IsMbrDlInstalled (iface) ? mbrMeterId : 0,
-              cmdStr);
-        }
-
-      // Configuring uplink routing.
-      if (rInfo->HasUlTraffic ())
-        {
-          if (rInfo->HasMbrUl () && !rInfo->IsMbrUlInstalled (iface))
-            {
-              // Install uplink MBR meter entry on the input switch.
-              std::ostringstream met;
-              met << "meter-mod cmd=add,flags=1,meter=" << mbrMeterId
-                  << " drop:rate=" << rInfo->GetMbrUlBitRate () / 1000;
-              std::string metStr = met.str ();
-
-              DpctlExecute (GetDpId (dstEnbInfo->GetInfraSwIdx ()), metStr);
-              rInfo->SetMbrUlInstalled (iface, true);
-            }
-
-          success &= RulesInstall (
-              dstEnbInfo->GetInfraSwIdx (),         // Target eNB switch idx.
-              rInfo->GetSgwInfraSwIdx (),
-              ringInfo->GetUlPath (iface),          // New uplink path.
-              rInfo->GetTeid (),
-              rInfo->GetSgwS1uAddr (),
-              rInfo->GetDscpValue (),
-              rInfo->IsMbrUlInstalled (iface) ? mbrMeterId : 0,
-              cmdStr);
-        }
-
-      // Update the installed flag for this interface.
-      rInfo->SetIfInstalled (iface, success);
+      dlPath = RingInfo::LinkDirToRingPath (path.front ().fwdDir);
     }
-
-  return success;
-}
-
-void
-RingController::SetShortestPath (
-  Ptr<RingInfo> ringInfo, LteIface iface) const
-{
-  NS_LOG_FUNCTION (this << ringInfo);
-
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  RingInfo::RingPath dlPath = GetShortPath (
-      rInfo->GetSrcDlInfraSwIdx (iface),
-      rInfo->GetDstDlInfraSwIdx (iface));
-  ringInfo->SetShortDlPath (iface, dlPath);
+  ringInfo->SetDlPath (iface, dlPath, index == 0);
 
   NS_LOG_DEBUG ("Bearer teid " << rInfo->GetTeidHex () <<
                 " interface "  << LteIfaceStr (iface) <<
-                " short path " << RingInfo::RingPathStr (dlPath));
+                " path "       << RingInfo::RingPathStr (dlPath));
 }
 
 void
@@ -1139,7 +381,7 @@ RingController::SlicingMeterApply (
   std::ostringstream cmd;
   cmd << "flow-mod cmd=add"
       << ",prio="       << (slice == SliceId::ALL ? 32 : 64)
-      << ",table="      << BANDW_TAB
+      << ",table="      << GetBandwTable ()
       << ",flags="      << FLAGS_REMOVED_OVERLAP_RESET;
 
   // Install rules on each port direction (FWD and BWD).
@@ -1171,88 +413,11 @@ RingController::SlicingMeterApply (
           // Build the instructions string.
           std::ostringstream act;
           act << " meter:"      << meterId
-              << " goto:"       << OUTPT_TAB;
+              << " goto:"       << GetOutputTable ();
 
           DpctlExecute (swDpId, cmd.str () + mtc.str () + act.str ());
         }
     }
 }
 
-bool
-RingController::SwitchCpuRequest (
-  Ptr<RingInfo> ringInfo, LteIface iface) const
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  // Ignoring this check when the BlockPolicy mode is OFF.
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  if (GetSwBlockPolicy () == OpMode::OFF)
-    {
-      return true;
-    }
-
-  return SwitchCpuRequest (
-    rInfo->GetSrcDlInfraSwIdx (iface),
-    rInfo->GetDstDlInfraSwIdx (iface),
-    ringInfo->GetDlPath (iface),
-    GetSwBlockThreshold ());
-}
-
-bool
-RingController::SwitchCpuRequest (
-  uint16_t srcIdx, uint16_t dstIdx, RingInfo::RingPath path,
-  double blockThs) const
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << path << blockThs);
-
-  // Walk through switches in the given routing path, requesting for CPU.
-  bool ok = true;
-  while (ok && srcIdx != dstIdx)
-    {
-      ok &= (GetEwmaCpuUse (srcIdx) < blockThs);
-      srcIdx = GetNextSwIdx (srcIdx, path);
-    }
-  ok &= (GetEwmaCpuUse (srcIdx) < blockThs);
-  return ok;
-}
-
-bool
-RingController::SwitchTableRequest (
-  Ptr<RingInfo> ringInfo, LteIface iface) const
-{
-  NS_LOG_FUNCTION (this << ringInfo << iface);
-
-  // Ignoring this check for aggregated bearers.
-  Ptr<RoutingInfo> rInfo = ringInfo->GetRoutingInfo ();
-  if (rInfo->IsAggregated ())
-    {
-      return true;
-    }
-
-  return SwitchTableRequest (
-    rInfo->GetSrcDlInfraSwIdx (iface),
-    rInfo->GetDstDlInfraSwIdx (iface),
-    ringInfo->GetDlPath (iface),
-    GetSwBlockThreshold (),
-    GetSliceTable (rInfo->GetSliceId ()));
-}
-
-bool
-RingController::SwitchTableRequest (
-  uint16_t srcIdx, uint16_t dstIdx, RingInfo::RingPath path,
-  double blockThs, uint16_t table) const
-{
-  NS_LOG_FUNCTION (this << srcIdx << dstIdx << path << blockThs << table);
-
-  // Walk through switches in the given routing path, requesting for table.
-  bool ok = true;
-  while (ok && srcIdx != dstIdx)
-    {
-      ok &= (GetFlowTableUse (srcIdx, table) < blockThs);
-      srcIdx = GetNextSwIdx (srcIdx, path);
-    }
-  ok &= (GetFlowTableUse (srcIdx, table) < blockThs);
-  return ok;
-}
-
 } // namespace ns3
@@ -75,97 +75,20 @@ protected:
   virtual void NotifyConstructionCompleted (void);
 
   // Inherited from BackhaulController.
-  bool BearerRequest (Ptr<RoutingInfo> rInfo);
-  bool BearerReserve (Ptr<RoutingInfo> rInfo);
-  bool BearerRelease (Ptr<RoutingInfo> rInfo);
-  bool BearerInstall (Ptr<RoutingInfo> rInfo);
-  bool BearerRemove  (Ptr<RoutingInfo> rInfo);
-  bool BearerUpdate  (Ptr<RoutingInfo> rInfo, Ptr<EnbInfo> dstEnbInfo);
   void NotifyBearerCreated (Ptr<RoutingInfo> rInfo);
   void NotifyTopologyBuilt (OFSwitch13DeviceContainer &devices);
+  std::vector<SwitchList_t> FindPaths (uint16_t srcIdx,
+                                       uint16_t dstIdx) const;
+  std::string GetHopActions (const PathHop &hop) const;
+  uint16_t GetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface) const;
+  void SetPathIndex (Ptr<RoutingInfo> rInfo, LteIface iface, uint16_t index,
+                     const RoutingPath_t &path);
   // Inherited from BackhaulController.
 
   // Inherited from OFSwitch13Controller.
   void HandshakeSuccessful (Ptr<const RemoteSwitch> swtch);
 
 private:
-  /**
-   * Check the available bit rate for this bearer for given LTE interface. This
-   * method checks for "doubled" resources on overlapping links.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \param overlap The optional overlapping links.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateRequest (Ptr<RingInfo> ringInfo, LteIface iface,
-                       LinkInfoSet_t *overlap = 0) const;
-
-  /**
-   * Check the forward and backward available bit rate on links from the source
-   * to the destination switch following the given routing path. This method
-   * checks for "doubled" resources on overlapping links, respecting the block
-   * threshold.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param fwdBitRate The forwarding bit rate.
-   * \param bwdBitRate The backward bit rate.
-   * \param path The routing path.
-   * \param slice The network slice.
-   * \param blockThs The block threshold.
-   * \param overlap The optional overlapping links.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateRequest (uint16_t srcIdx, uint16_t dstIdx,
-                       int64_t fwdBitRate, int64_t bwdBitRate,
-                       RingInfo::RingPath path, SliceId slice,
-                       double blockThs, LinkInfoSet_t *overlap = 0) const;
-
-  /**
-   * Reserve the bit rate for this bearer for the given LTE logical interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateReserve (Ptr<RingInfo> ringInfo, LteIface iface);
-
-  /**
-   * Reserve the forward and backward bit rate on links from the source to the
-   * destination switch following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param fwdBitRate The forwarding bit rate.
-   * \param bwdBitRate The backward bit rate.
-   * \param path The routing path.
-   * \param slice The network slice.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateReserve (uint16_t srcIdx, uint16_t dstIdx,
-                       int64_t fwdBitRate, int64_t bwdBitRate,
-                       RingInfo::RingPath path, SliceId slice);
-
-  /**
-   * Release the bit rate for this bearer for the given LTE logical interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateRelease (Ptr<RingInfo> ringInfo, LteIface iface);
-
-  /**
-   * Release the forward and backward bit rate on links from the source to the
-   * destination switch following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param fwdBitRate The forwarding bit rate.
-   * \param bwdBitRate The backward bit rate.
-   * \param path The routing path.
-   * \param slice The network slice.
-   * \return True if succeeded, false otherwise.
-   */
-  bool BitRateRelease (uint16_t srcIdx, uint16_t dstIdx,
-                       int64_t fwdBitRate, int64_t bwdBitRate,
-                       RingInfo::RingPath path, SliceId slice);
-
   /**
    * To avoid flooding problems when broadcasting packets (like in ARP
    * protocol), let's find a Spanning Tree and drop packets at selected ports
@@ -174,15 +97,6 @@ private:
    */
   void CreateSpanningTree (void);
 
-  /**
-   * Get the backhaul lInfo pointers for the given LTE interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \param links The set of links to populate.
-   */
-  void GetLinkSet (Ptr<RingInfo> ringInfo, LteIface iface,
-                   LinkInfoSet_t *links) const;
-
   /**
    * Get the next switch index following the given routing path.
    * \param srcIdx The source switch index.
@@ -191,17 +105,6 @@ private:
    */
   uint16_t GetNextSwIdx (uint16_t srcIdx, RingInfo::RingPath path) const;
 
-  /**
-   * Get the number of hops between source and destination switch indexes
-   * following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param path The routing path.
-   * \return The number of hops in routing path.
-   */
-  uint16_t GetNumHops (uint16_t srcIdx, uint16_t dstIdx,
-                       RingInfo::RingPath path) const;
-
   /**
    * Get the routing path from source to destination switch index with the
    * lowest number of hops.
@@ -211,69 +114,6 @@ private:
    */
   RingInfo::RingPath GetShortPath (uint16_t srcIdx, uint16_t dstIdx) const;
 
-  /**
-   * Check for the available resources on the backhaul infrastructure for the
-   * given LTE interface. When any of the requested resources is not available,
-   * this method must set the routing information with the block reason.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \param overlap The optional overlapping links.
-   * \return True if succeeded, false otherwise.
-   */
-  bool HasAvailableResources (Ptr<RingInfo> ringInfo, LteIface iface,
-                              LinkInfoSet_t *overlap = 0) const;
-
-  /**
-   * Install forwarding rules on switches for the given LTE interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool RulesInstall (Ptr<RingInfo> ringInfo, LteIface iface);
-
-  /**
-   * Install forwarding rules on switches from the source to the destination
-   * following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param path The routing path.
-   * \param teid The TEID value.
-   * \param dstAddr The IP destination address.
-   * \param dscp The DSCP value for this bearer.
-   * \param meter The MBR meter ID for this bearer.
-   * \param cmdStr The OpenFlow dpctl flow mod command.
-   * \return True if succeeded, false otherwise.
-   */
-  bool RulesInstall (uint16_t srcIdx, uint16_t dstIdx, RingInfo::RingPath path,
-                     uint32_t teid, Ipv4Address dstAddr, uint16_t dscp,
-                     uint32_t meter, std::string cmdStr);
-
-  /**
-   * Remove forwarding rules from switches for the given LTE interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool RulesRemove (Ptr<RingInfo> ringInfo, LteIface iface);
-
-  /**
-   * Update forwarding rules on switches for the given LTE interface after a
-   * successful handover procedure.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \param dstEnbInfo The destination eNB after the handover procedure.
-   * \return True if succeeded, false otherwise.
-   */
-  bool RulesUpdate (Ptr<RingInfo> ringInfo, LteIface iface,
-                    Ptr<EnbInfo> dstEnbInfo);
-
-  /**
-   * Set the default ring routing paths to the shortest ones.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   */
-  void SetShortestPath (Ptr<RingInfo> ringInfo, LteIface iface) const;
-
   /**
    * Apply the infrastructure inter-slicing OpenFlow meters.
    * \param swtch The switch information.
@@ -281,50 +121,6 @@ private:
    */
   void SlicingMeterApply (Ptr<const RemoteSwitch> swtch, SliceId slice);
 
-  /**
-   * Check for the CPU usage on switches for the given LTE interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool SwitchCpuRequest (Ptr<RingInfo> ringInfo, LteIface iface) const;
-
-  /**
-   * Check for the CPU usage on switches from the source to the destination
-   * following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param path The routing path.
-   * \param slice The network slice.
-   * \param blockThs The block threshold.
-   * \return True if succeeded, false otherwise.
-   */
-  bool SwitchCpuRequest (uint16_t srcIdx, uint16_t dstIdx,
-                         RingInfo::RingPath path, double blockThs) const;
-
-  /**
-   * Check for the flow table usage on switches for the given LTE interface.
-   * \param ringInfo The ring routing information.
-   * \param iface The LTE logical interface.
-   * \return True if succeeded, false otherwise.
-   */
-  bool SwitchTableRequest (Ptr<RingInfo> ringInfo, LteIface iface) const;
-
-  /**
-   * Check for the flow table usage on switches from the source to the
-   * destination following the given routing path.
-   * \param srcIdx Source switch index.
-   * \param dstIdx Destination switch index.
-   * \param path The routing path.
-   * \param slice The network slice.
-   * \param blockThs The block threshold.
-   * \param table The slice table.
-   * \return True if succeeded, false otherwise.
-   */
-  bool SwitchTableRequest (uint16_t srcIdx, uint16_t dstIdx,
-                           RingInfo::RingPath path, double blockThs,
-                           uint16_t table) const;
-
   RoutingStrategy           m_strategy;       //!< Routing strategy in use.
 };
 
@@ -78,7 +78,10 @@ Uni5onEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
-  m_rxS1uSocketPktTrace (packet->Copy ());
+  if (!m_rxS1uSocketPktTrace.IsEmpty ())
+    {
+      m_rxS1uSocketPktTrace (packet->Copy ());
+    }
 
   // Check for UE context information.
   auto it = m_teidRbidMap.find (teid);
@@ -31,7 +31,10 @@ NS_OBJECT_ENSURE_REGISTERED (PgwTunnelApp);
 
 PgwTunnelApp::PgwTunnelApp (Ptr<VirtualNetDevice> logicalPort,
                             Ptr<CsmaNetDevice> physicalDev)
-  : GtpTunnelApp (logicalPort, physicalDev)
+  : GtpTunnelApp (logicalPort, physicalDev),
+  m_flowCacheVersion (0),
+  m_flowCacheHits (0),
+  m_flowCacheMisses (0)
 {
   NS_LOG_FUNCTION (this << logicalPort << physicalDev);
 
@@ -50,6 +53,12 @@ PgwTunnelApp::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::PgwTunnelApp")
     .SetParent<GtpTunnelApp> ()
+    .AddAttribute ("FlowCacheSize",
+                   "The maximum number of microflow cache entries "
+                   "(0 disables the cache).",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&PgwTunnelApp::m_flowCacheSize),
+                   MakeUintegerChecker<uint32_t> ())
     .AddTraceSource ("S5Rx",
                      "Trace source for packets received from S5 interface.",
                      MakeTraceSourceAccessor (&PgwTunnelApp::m_rxS5Trace),
@@ -62,11 +71,30 @@ PgwTunnelApp::GetTypeId (void)
   return tid;
 }
 
+double
+PgwTunnelApp::GetFlowCacheHitRatio (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  uint64_t total = m_flowCacheHits + m_flowCacheMisses;
+  return total ? static_cast<double> (m_flowCacheHits) / total : 0.0;
+}
+
+void
+PgwTunnelApp::ResetFlowCacheStats (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_flowCacheHits = 0;
+  m_flowCacheMisses = 0;
+}
+
 void
 PgwTunnelApp::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  m_flowCache.clear ();
   GtpTunnelApp::DoDispose ();
 }
 
@@ -78,17 +106,40 @@ PgwTunnelApp::AttachEpcGtpuTag (Ptr<Packet> packet, uint32_t teid)
   // Ignoring TEID parameter and classify the packet again. This is useful when
   // aggregating different bearers withing the same tunnel. Using this
   // independent classifier ensures that the EPC packet tags can continue to
-  // differentiate the bearers withing the EPC.
-  Ptr<Packet> packetCopy = packet->Copy ();
-
-  GtpuHeader gtpuHeader;
-  Ipv4Header ipv4Header;
-  packetCopy->RemoveHeader (gtpuHeader);
-  packetCopy->PeekHeader (ipv4Header);
-
-  Ptr<UeInfo> ueInfo = UeInfo::GetPointer (ipv4Header.GetDestination ());
-  NS_ASSERT_MSG (ueInfo, "No UE info for this IP address.");
-  teid = ueInfo->Classify (packetCopy);
+  // differentiate the bearers withing the EPC. Packets of recently seen
+  // microflows skip the classifier. The cache is flushed when any TFT
+  // changes or when it gets full.
+  FlowKey_t key;
+  if (m_flowCacheSize && GetFlowKey (packet, key))
+    {
+      if (m_flowCacheVersion != UeInfo::GetClassifierVersion ())
+        {
+          m_flowCache.clear ();
+          m_flowCacheVersion = UeInfo::GetClassifierVersion ();
+        }
+
+      auto it = m_flowCache.find (key);
+      if (it != m_flowCache.end ())
+        {
+          teid = it->second;
+          m_flowCacheHits++;
+        }
+      else
+        {
+          teid = Classify (packet);
+          m_flowCacheMisses++;
+          if (m_flowCache.size () >= m_flowCacheSize)
+            {
+              m_flowCache.clear ();
+            }
+          m_flowCache [key] = teid;
+        }
+    }
+  else
+    {
+      teid = Classify (packet);
+      m_flowCacheMisses++;
+    }
 
   // Packet entering the EPC. Attach the tag and fire the S5 TX trace source.
   Ptr<RoutingInfo> rInfo = RoutingInfo::GetPointer (teid);
@@ -110,4 +161,69 @@ PgwTunnelApp::RemoveEpcGtpuTag (Ptr<Packet> packet, uint32_t teid)
   packet->RemovePacketTag (teidTag);
 }
 
+uint32_t
+PgwTunnelApp::Classify (Ptr<const Packet> packet) const
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  Ptr<Packet> packetCopy = packet->Copy ();
+
+  GtpuHeader gtpuHeader;
+  Ipv4Header ipv4Header;
+  packetCopy->RemoveHeader (gtpuHeader);
+  packetCopy->PeekHeader (ipv4Header);
+
+  Ptr<UeInfo> ueInfo = UeInfo::GetPointer (ipv4Header.GetDestination ());
+  NS_ASSERT_MSG (ueInfo, "No UE info for this IP address.");
+  return ueInfo->Classify (packetCopy);
+}
+
+bool
+PgwTunnelApp::GetFlowKey (Ptr<const Packet> packet, FlowKey_t &key)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  // Copy only the GTP-U header, the IPv4 header with options, and the L4
+  // ports into a local buffer, without copying the packet.
+  const uint32_t ip = 12;
+  uint8_t buf [ip + 64];
+  uint32_t size = packet->CopyData (buf, sizeof (buf));
+  if (size < ip + 20 || (buf [ip] >> 4) != 4)
+    {
+      return false;
+    }
+
+  uint32_t l4 = ip + (buf [ip] & 0x0F) * 4;
+  uint8_t protocol = buf [ip + 9];
+  bool fragment = (buf [ip + 6] & 0x3F) || buf [ip + 7];
+  if (fragment || size < l4 + 4
+      || (protocol != TcpL4Protocol::PROT_NUMBER
+          && protocol != UdpL4Protocol::PROT_NUMBER))
+    {
+      return false;
+    }
+
+  uint64_t addrs = 0;
+  for (uint32_t i = ip + 12; i < ip + 20; i++)
+    {
+      addrs = (addrs << 8) | buf [i];
+    }
+  uint64_t ports = 0;
+  for (uint32_t i = l4; i < l4 + 4; i++)
+    {
+      ports = (ports << 8) | buf [i];
+    }
+  key.first = addrs;
+  key.second = (static_cast<uint64_t> (protocol) << 40)
+    | (static_cast<uint64_t> (buf [ip + 1]) << 32) | ports;
+  return true;
+}
+
+size_t
+PgwTunnelApp::FlowKeyHash::operator () (const FlowKey_t &key) const
+{
+  return std::hash<uint64_t> () (
+    key.first ^ (key.second * 0x9E3779B97F4A7C15ULL));
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 #ifndef PGW_APP_H
 #define PGW_APP_H
 
+#include <unordered_map>
 #include "gtp-tunnel-app.h"
 
 namespace ns3 {
@@ -30,6 +31,8 @@ namespace ns3 {
  * This is the GTP tunneling application for the P-GW. It extends the GTP
  * tunnel application for attach and remove the EpcGtpuTag tag on packets
  * entering/leaving the OpenFlow EPC backhaul network over S5 interface.
+ * Downlink packets are classified by the UE TFT classifier, with a microflow
+ * cache mapping the exact IPv4 5-tuple and ToS to the bearer TEID.
  */
 class PgwTunnelApp : public GtpTunnelApp
 {
@@ -49,11 +52,40 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Get the microflow cache hit ratio for downlink packets classified by
+   * this application since the last statistics reset.
+   * \return The cache hit ratio in the range [0, 1].
+   */
+  double GetFlowCacheHitRatio (void) const;
+
+  /**
+   * Reset the microflow cache hit and miss counters.
+   */
+  void ResetFlowCacheStats (void);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
 
 private:
+  /** The microflow key: IPv4 addresses, and protocol, ToS, and ports. */
+  typedef std::pair<uint64_t, uint64_t> FlowKey_t;
+
+  /** Hash function for the microflow key. */
+  struct FlowKeyHash
+  {
+    /**
+     * Hash the microflow key.
+     * \param key The microflow key.
+     * \return The hash value.
+     */
+    size_t operator () (const FlowKey_t &key) const;
+  };
+
+  /** Hash map saving microflow key / GTP TEID. */
+  typedef std::unordered_map<FlowKey_t, uint32_t, FlowKeyHash> FlowTeidMap_t;
+
   /**
    * Attach the EpcGtpuTag tag into packet and fire the S5Tx trace source.
    * \param packet The packet.
@@ -68,6 +100,22 @@ private:
    */
   void RemoveEpcGtpuTag (Ptr<Packet> packet, uint32_t teid);
 
+  /**
+   * Classify the downlink packet using the TFT classifier of the UE.
+   * \param packet The packet with the GTP-U header.
+   * \return The GTP TEID for this packet.
+   */
+  uint32_t Classify (Ptr<const Packet> packet) const;
+
+  /**
+   * Get the microflow key for this packet. Only unfragmented TCP and UDP
+   * packets over IPv4 can be cached.
+   * \param packet The packet with the GTP-U header.
+   * \param key The microflow key to fill.
+   * \return True if the packet can be cached, false otherwise.
+   */
+  static bool GetFlowKey (Ptr<const Packet> packet, FlowKey_t &key);
+
   /**
    * Trace source fired when a packet arrives this P-GW from
    * the S5 interface (leaving the EPC).
@@ -79,6 +127,13 @@ private:
    * the S5 interface (entering the EPC).
    */
   TracedCallback<Ptr<const Packet> > m_txS5Trace;
+
+  // Microflow cache.
+  FlowTeidMap_t       m_flowCache;        //!< Microflow cache entries.
+  uint32_t            m_flowCacheSize;    //!< Maximum number of entries.
+  uint32_t            m_flowCacheVersion; //!< TFT classifiers version.
+  uint64_t            m_flowCacheHits;    //!< Number of cache hits.
+  uint64_t            m_flowCacheMisses;  //!< Number of cache misses.
 };
 
 } // namespace ns3
@@ -62,9 +62,7 @@ SliceController::GetTypeId (void)
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    EnumValue (SliceId::UNKN),
                    MakeEnumAccessor (&SliceController::m_sliceId),
-                   MakeEnumChecker (SliceId::HTC, SliceIdStr (SliceId::HTC),
-                                    SliceId::MTC, SliceIdStr (SliceId::MTC),
-                                    SliceId::TMP, SliceIdStr (SliceId::TMP)))
+                   MakeSliceIdChecker ())
 
     // Infrastructure.
     .AddAttribute ("Aggregation",
@@ -187,6 +185,14 @@ SliceController::GetTypeId (void)
                      MakeTraceSourceAccessor (
                        &SliceController::m_pgwTftLoadBalTrace),
                      "ns3::SliceController::PgwTftStatsTracedCallback")
+    .AddTraceSource ("MsgTx", "OpenFlow messages sent to switches.",
+                     MakeTraceSourceAccessor (
+                       &SliceController::m_msgTxTrace),
+                     "ns3::SliceController::CtrlMsgTracedCallback")
+    .AddTraceSource ("MsgRx", "OpenFlow messages received from switches.",
+                     MakeTraceSourceAccessor (
+                       &SliceController::m_msgRxTrace),
+                     "ns3::SliceController::CtrlMsgTracedCallback")
   ;
   return tid;
 }
@@ -279,6 +285,22 @@ SliceController::DedicatedBearerRelease (
   return success;
 }
 
+void
+SliceController::FluidTrafficTx (uint32_t teid, Direction dir, uint64_t bytes)
+{
+  NS_LOG_FUNCTION (this << teid << dir << bytes);
+
+  Ptr<RoutingInfo> rInfo = RoutingInfo::GetPointer (teid);
+  NS_ASSERT_MSG (rInfo, "No routing information for teid " << teid);
+  if (!rInfo->IsActive ())
+    {
+      NS_LOG_WARN ("Ignoring fluid traffic for inactive bearer.");
+      return;
+    }
+
+  m_backhaulCtrl->BearerFluidTx (rInfo, dir, bytes);
+}
+
 SliceId
 SliceController::GetSliceId (void) const
 {
@@ -599,10 +621,11 @@ SliceController::HandleError (
 {
   NS_LOG_FUNCTION (this << swtch << xid);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
+  uint32_t bytes = sizeof (struct ofp_error_msg) + msg->data_length;
+
   // Print the message.
-  char *cStr = ofl_msg_to_string ((struct ofl_msg_header*)msg, 0);
-  std::string msgStr (cStr);
-  free (cStr);
+  std::string msgStr = OflMsgToString ((struct ofl_msg_header*)msg);
 
   // All handlers must free the message when everything is ok.
   ofl_msg_free ((struct ofl_msg_header*)msg, 0);
@@ -615,6 +638,8 @@ SliceController::HandleError (
             << " from switch id " << swtch->GetDpId ()
             << " with error message: " << msgStr
             << std::endl;
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "error", bytes, start);
   return 0;
 }
 
@@ -625,18 +650,13 @@ SliceController::HandleFlowRemoved (
 {
   NS_LOG_FUNCTION (this << swtch << xid << msg->stats->cookie);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
   uint32_t teid = CookieGetTeid (msg->stats->cookie);
   uint16_t prio = msg->stats->priority;
 
-  // Print the message.
-  char *cStr = ofl_msg_to_string ((struct ofl_msg_header*)msg, 0);
-  std::string msgStr (cStr);
-  free (cStr);
-
-  // All handlers must free the message when everything is ok.
-  ofl_msg_free_flow_removed (msg, true, 0);
-
-  NS_LOG_DEBUG ("Flow removed: " << msgStr);
+  // The message text is rendered only when it's actually printed.
+  NS_LOG_DEBUG ("Flow removed: " <<
+                OflMsgToString ((struct ofl_msg_header*)msg));
 
   // Check for existing routing information for this bearer.
   Ptr<RoutingInfo> rInfo = RoutingInfo::GetPointer (teid);
@@ -648,26 +668,34 @@ SliceController::HandleFlowRemoved (
     {
       NS_LOG_INFO ("Rule removed from switch dp " << swtch->GetDpId () <<
                    " for inactive bearer teid " << rInfo->GetTeidHex ());
-      return 0;
     }
 
   // 2) The application is running and the bearer is active, but the bearer
   // priority was increased and this removed flow rule is an old one.
-  if (rInfo->GetPriority () > prio)
+  else if (rInfo->GetPriority () > prio)
     {
       NS_LOG_INFO ("Rule removed from switch dp " << swtch->GetDpId () <<
                    " for bearer teid " << rInfo->GetTeidHex () <<
                    " with old priority " << prio);
-      return 0;
     }
 
   // 3) The application is running, the bearer is active, and the bearer
   // priority is the same of the removed rule. This is a critical situation!
   // For some reason, the flow rule was removed so we are going to abort the
   // program to avoid wrong results.
-  NS_ASSERT_MSG (rInfo->GetPriority () == prio, "Invalid flow priority.");
-  NS_ABORT_MSG ("Rule removed for active bearer. " <<
-                "OpenFlow flow removed message: " << msgStr);
+  else
+    {
+      NS_ASSERT_MSG (rInfo->GetPriority () == prio, "Invalid flow priority.");
+      NS_ABORT_MSG ("Rule removed for active bearer. " <<
+                    "OpenFlow flow removed message: " <<
+                    OflMsgToString ((struct ofl_msg_header*)msg));
+    }
+
+  // All handlers must free the message when everything is ok.
+  ofl_msg_free_flow_removed (msg, true, 0);
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "flow-removed",
+                       sizeof (struct ofp_flow_removed), start);
   return 0;
 }
 
@@ -678,6 +706,9 @@ SliceController::HandlePacketIn (
 {
   NS_LOG_FUNCTION (this << swtch << xid);
 
+  CtrlMsgTrace::WallTime_t start = m_msgRxTrace.Start ();
+  uint32_t bytes = sizeof (struct ofp_packet_in) + msg->data_length;
+
   // Print the message.
   char *cStr = ofl_structs_match_to_string (msg->match, 0);
   std::string msgStr (cStr);
@@ -694,6 +725,8 @@ SliceController::HandlePacketIn (
             << " from switch id " << swtch->GetDpId ()
             << " with packet-in message: " << msgStr
             << std::endl;
+
+  m_msgRxTrace.Notify (swtch->GetDpId (), "packet-in", bytes, start);
   return 0;
 }
 
@@ -713,6 +746,17 @@ SliceController::DpctlSchedule (Time delay, uint64_t dpId,
                        this, dpId, textCmd);
 }
 
+int
+SliceController::DpctlExecute (uint64_t dpId, const std::string textCmd)
+{
+  NS_LOG_FUNCTION (this << dpId << textCmd);
+
+  CtrlMsgTrace::WallTime_t start = m_msgTxTrace.Start ();
+  int error = OFSwitch13Controller::DpctlExecute (dpId, textCmd);
+  m_msgTxTrace.NotifyDpctl (dpId, textCmd, start);
+  return error;
+}
+
 bool
 SliceController::BearerInstall (Ptr<RoutingInfo> rInfo)
 {
@@ -908,6 +952,21 @@ SliceController::DoModifyBearerRequest (
       res.bearerContextsModified.push_back (bearerContext);
     }
 
+  // Update bearers with installed rules and the UE's eNB info.
+  UeHandover (ueInfo, dstEnbInfo);
+
+  // Fire trace source notifying the modified session.
+  m_sessionModifiedTrace (imsi, res.bearerContextsModified);
+
+  // Forward the response message to the MME.
+  m_s11SapMme->ModifyBearerResponse (res);
+}
+
+void
+SliceController::UeHandover (Ptr<UeInfo> ueInfo, Ptr<EnbInfo> dstEnbInfo)
+{
+  NS_LOG_FUNCTION (this << ueInfo << dstEnbInfo);
+
   // Iterate over routing infos and update bearers with installed rules.
   for (auto const &rit : ueInfo->GetRoutingInfoMap ())
     {
@@ -921,12 +980,6 @@ SliceController::DoModifyBearerRequest (
 
   // Finally, update the UE's eNB info (only after updating OpenFlow rules).
   ueInfo->SetEnbInfo (dstEnbInfo);
-
-  // Fire trace source notifying the modified session.
-  m_sessionModifiedTrace (imsi, res.bearerContextsModified);
-
-  // Forward the response message to the MME.
-  m_s11SapMme->ModifyBearerResponse (res);
 }
 
 uint16_t
@@ -41,6 +41,7 @@ namespace ns3 {
 class BackhaulController;
 class EnbInfo;
 class RoutingInfo;
+class UeInfo;
 class Uni5onMme;
 class SgwInfo;
 class PgwInfo;
@@ -58,6 +59,7 @@ typedef std::vector<Ptr<SliceController> > SliceControllerList_t;
 class SliceController : public OFSwitch13Controller
 {
   friend class MemberEpcS11SapSgw<SliceController>;
+  friend class ControllerBenchmark;
 
 public:
   SliceController ();           //!< Default constructor.
@@ -102,6 +104,16 @@ public:
   virtual bool DedicatedBearerRelease (EpsBearer bearer, uint64_t imsi,
                                        uint32_t teid);
 
+  /**
+   * Notify this controller of fluid traffic sent over an active EPS bearer.
+   * Fluid traffic is not carried by packets, so the backhaul controller
+   * accounts for the transmitted bytes along the bearer routing path.
+   * \param teid The teid for this bearer.
+   * \param dir The traffic direction.
+   * \param bytes The number of transmitted bytes.
+   */
+  void FluidTrafficTx (uint32_t teid, Direction dir, uint64_t bytes);
+
   /**
    * Get the slice ID for this controller.
    * \return The slice ID.
@@ -199,6 +211,16 @@ public:
   typedef void (*SessionModifiedTracedCallback)(
     uint64_t imsi, BearerModifiedList_t bearerList);
 
+  /**
+   * TracedCallback signature for OpenFlow messages exchanged with switches.
+   * \param dpId The OpenFlow datapath ID.
+   * \param type The message type.
+   * \param length The message length (see CtrlMsgTrace).
+   * \param wallNs The wall-clock time spent handling the message (ns).
+   */
+  typedef void (*CtrlMsgTracedCallback)(
+    uint64_t dpId, std::string type, uint32_t length, int64_t wallNs);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -214,6 +236,18 @@ protected:
    */
   void DpctlSchedule (Time delay, uint64_t dpId, const std::string textCmd);
 
+  /**
+   * Execute a dpctl command, firing the MsgTx trace source. This hides the
+   * non-virtual OFSwitch13Controller method, so only the commands issued by
+   * uni5on controllers through this method are accounted for. Messages sent
+   * by the OFSwitch13Controller itself (handshake, echo, barrier and commands
+   * queued by its own DpctlSchedule) are not.
+   * \param dpId The OpenFlow datapath ID.
+   * \param textCmd The dpctl command to be executed.
+   * \return 0 if everything's ok, otherwise an error number.
+   */
+  int DpctlExecute (uint64_t dpId, const std::string textCmd);
+
   // Inherited from OFSwitch13Controller.
   virtual ofl_err HandleError (
     struct ofl_msg_error *msg, Ptr<const RemoteSwitch> swtch,
@@ -253,6 +287,14 @@ private:
    */
   bool BearerUpdate (Ptr<RoutingInfo> rInfo, Ptr<EnbInfo> dstEnbInfo);
 
+  /**
+   * Update OpenFlow match rules for all bearers of this UE after the handover
+   * procedure, and then update the UE's eNB info.
+   * \param ueInfo The UE information.
+   * \param dstEnbInfo The destination eNB after the handover procedure.
+   */
+  void UeHandover (Ptr<UeInfo> ueInfo, Ptr<EnbInfo> dstEnbInfo);
+
   /**
    * \name Methods for the S11 SAP S-GW control plane.
    * \param msg The message sent here by the MME entity.
@@ -380,6 +422,12 @@ private:
   /** The P-GW TFT load balacing trace source, fired at PgwTftLoadBalancing. */
   TracedCallback<Ptr<const PgwInfo>, uint32_t, uint32_t> m_pgwTftLoadBalTrace;
 
+  /** The OpenFlow message TX trace source, fired at DpctlExecute. */
+  CtrlMsgTrace m_msgTxTrace;
+
+  /** The OpenFlow message RX trace source, fired at message handlers. */
+  CtrlMsgTrace m_msgRxTrace;
+
   // Slice identification.
   SliceId                 m_sliceId;        //!< Logical slice ID.
   std::string             m_sliceIdStr;     //!< Slice ID string.
@@ -62,9 +62,7 @@ SliceNetwork::GetTypeId (void)
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    EnumValue (SliceId::UNKN),
                    MakeEnumAccessor (&SliceNetwork::m_sliceId),
-                   MakeEnumChecker (SliceId::HTC, SliceIdStr (SliceId::HTC),
-                                    SliceId::MTC, SliceIdStr (SliceId::MTC),
-                                    SliceId::TMP, SliceIdStr (SliceId::TMP)))
+                   MakeSliceIdChecker ())
     .AddAttribute ("SliceCtrl", "The LTE logical slice controller pointer.",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    PointerValue (),
@@ -77,7 +75,8 @@ SliceNetwork::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&SliceNetwork::m_backhaul),
                    MakePointerChecker<BackhaulNetwork> ())
-    .AddAttribute ("RadioNet", "The LTE RAN network pointer.",
+    .AddAttribute ("RadioNet",
+                   "The LTE RAN network pointer (required with UEs).",
                    TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
                    PointerValue (),
                    MakePointerAccessor (&SliceNetwork::m_radio),
@@ -285,6 +284,14 @@ SliceNetwork::GetWebNode (void) const
   return m_webNode;
 }
 
+Ipv4Address
+SliceNetwork::AllocateUeAddress (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_ueAddrHelper.NewAddress ();
+}
+
 void
 SliceNetwork::DoDispose (void)
 {
@@ -311,7 +318,7 @@ SliceNetwork::NotifyConstructionCompleted (void)
   NS_ABORT_MSG_IF (m_sliceId == SliceId::UNKN, "Unknown slice ID.");
   NS_ABORT_MSG_IF (!m_controllerApp, "No slice controller application.");
   NS_ABORT_MSG_IF (!m_backhaul, "No backhaul network.");
-  NS_ABORT_MSG_IF (!m_radio, "No LTE RAN network.");
+  NS_ABORT_MSG_IF (!m_radio && m_nUes > 0, "No LTE RAN network.");
   NS_ABORT_MSG_IF (m_controllerApp->GetSliceId () != m_sliceId,
                    "Incompatible slice IDs for controller and network.");
 
@@ -343,7 +350,10 @@ SliceNetwork::NotifyConstructionCompleted (void)
   // Create and configure the logical LTE network.
   CreatePgw ();
   CreateSgw ();
-  CreateUes ();
+  if (m_nUes > 0)
+    {
+      CreateUes ();
+    }
 
   // Let's connect the OpenFlow switches to the controller. From this point
   // on it is not possible to change the OpenFlow network configuration.
@@ -85,6 +85,14 @@ public:
    */
   Ptr<Node> GetWebNode (void) const;
 
+  /**
+   * Allocate a new IP address on the UE network of this slice, for UEs that
+   * are not created by this slice network (like the synthetic UEs in the
+   * controller benchmark).
+   * \return The UE IP address.
+   */
+  Ipv4Address AllocateUeAddress (void);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose (void);
@@ -0,0 +1,279 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "timer-wheel.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TimerWheel");
+NS_OBJECT_ENSURE_REGISTERED (TimerWheel);
+
+TimerWheel::TimerWheel ()
+  : m_now (0),
+  m_nextId (1),
+  m_eventTick (0)
+{
+  NS_LOG_FUNCTION (this);
+
+  memset (m_count, 0, sizeof (m_count));
+}
+
+TimerWheel::~TimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+TimerWheel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimerWheel")
+    .SetParent<Object> ()
+    .AddConstructor<TimerWheel> ()
+    .AddAttribute ("Tick",
+                   "The timer wheel tick. Timers are rounded up to it.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&TimerWheel::m_tick),
+                   MakeTimeChecker (NanoSeconds (1)))
+  ;
+  return tid;
+}
+
+uint32_t
+TimerWheel::GetNPending (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_timers.size ();
+}
+
+bool
+TimerWheel::IsPending (TimerId id) const
+{
+  NS_LOG_FUNCTION (this << id);
+
+  return m_timers.find (id) != m_timers.end ();
+}
+
+void
+TimerWheel::Cancel (TimerId id)
+{
+  NS_LOG_FUNCTION (this << id);
+
+  auto it = m_timers.find (id);
+  if (it == m_timers.end ())
+    {
+      return;
+    }
+
+  // There's no need to update the simulator event, as it will find nothing
+  // to fire and move to the next non-empty tick.
+  Location &loc = it->second;
+  m_slots [loc.level][loc.slot].erase (loc.it);
+  m_count [loc.level]--;
+  m_timers.erase (it);
+}
+
+void
+TimerWheel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_event.Cancel ();
+  for (int l = 0; l < TW_LEVELS; l++)
+    {
+      for (int s = 0; s < TW_SLOTS; s++)
+        {
+          m_slots [l][s].clear ();
+        }
+      m_count [l] = 0;
+    }
+  m_timers.clear ();
+  Object::DoDispose ();
+}
+
+TimerWheel::TimerId
+TimerWheel::DoSchedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay << event);
+
+  NS_ASSERT_MSG (!delay.IsStrictlyNegative (), "Invalid negative delay.");
+  Advance ();
+
+  // Timers expire at least one tick after the current one, so timers
+  // scheduled while processing a tick will never be fired in the same tick.
+  Timer timer;
+  timer.id = m_nextId++;
+  timer.expire = std::max (ToTicks (Simulator::Now () + delay, true),
+                           m_now + 1);
+  timer.event = Ptr<EventImpl> (event, false);
+
+  TimerList_t temp;
+  temp.push_back (timer);
+  Location loc;
+  loc.it = temp.begin ();
+  Place (loc, temp);
+  m_timers [timer.id] = loc;
+
+  UpdateEvent (GetSlotStart (loc.level, loc.slot));
+  return timer.id;
+}
+
+void
+TimerWheel::Place (Location &loc, TimerList_t &from)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Find the lowest level where the timer expires within the current
+  // rotation of the level above it.
+  uint64_t expire = loc.it->expire;
+  int level = 0;
+  while (level < TW_LEVELS
+         && (expire >> (TW_SLOT_BITS * (level + 1)))
+         != (m_now >> (TW_SLOT_BITS * (level + 1))))
+    {
+      level++;
+    }
+  NS_ABORT_MSG_IF (level == TW_LEVELS, "Timer beyond the wheel horizon.");
+
+  loc.level = level;
+  loc.slot = (expire >> (TW_SLOT_BITS * level)) & (TW_SLOTS - 1);
+  TimerList_t &to = m_slots [loc.level][loc.slot];
+  to.splice (to.end (), from, loc.it);
+  m_count [loc.level]++;
+}
+
+void
+TimerWheel::Advance (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Without any pending event, no timer expires before the next one. So, we
+  // can move the current tick up to now without cascading any slot.
+  uint64_t nowTick = ToTicks (Simulator::Now (), false);
+  if (m_event.IsRunning ())
+    {
+      nowTick = std::min (nowTick, m_eventTick - 1);
+    }
+  m_now = std::max (m_now, nowTick);
+}
+
+uint64_t
+TimerWheel::GetNextTick (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  // Timers at lower levels always expire before the first tick of any
+  // non-empty slot at higher levels. All timers are kept in slots after the
+  // current one, so the first non-empty slot on the lowest non-empty level
+  // defines the next tick to process.
+  for (int l = 0; l < TW_LEVELS; l++)
+    {
+      if (m_count [l] == 0)
+        {
+          continue;
+        }
+
+      int curr = (m_now >> (TW_SLOT_BITS * l)) & (TW_SLOTS - 1);
+      for (int s = curr + 1; s < TW_SLOTS; s++)
+        {
+          if (!m_slots [l][s].empty ())
+            {
+              return GetSlotStart (l, s);
+            }
+        }
+      NS_ABORT_MSG ("Timers not found at level " << l);
+    }
+  return 0;
+}
+
+uint64_t
+TimerWheel::GetSlotStart (uint8_t level, uint16_t slot) const
+{
+  NS_LOG_FUNCTION (this << static_cast<uint16_t> (level) << slot);
+
+  int bits = TW_SLOT_BITS * level;
+  uint64_t rotation = (m_now >> (bits + TW_SLOT_BITS)) << TW_SLOT_BITS;
+  return (rotation + slot) << bits;
+}
+
+void
+TimerWheel::UpdateEvent (uint64_t tick)
+{
+  NS_LOG_FUNCTION (this << tick);
+
+  if (tick == 0 || (m_event.IsRunning () && m_eventTick <= tick))
+    {
+      return;
+    }
+
+  m_event.Cancel ();
+  m_eventTick = tick;
+  Time eventTime = TimeStep (m_tick.GetTimeStep () * tick);
+  m_event = Simulator::Schedule (eventTime - Simulator::Now (),
+                                 &TimerWheel::ProcessTick, this, tick);
+}
+
+void
+TimerWheel::ProcessTick (uint64_t tick)
+{
+  NS_LOG_FUNCTION (this << tick);
+
+  m_now = tick;
+
+  // Cascade timers from the current slots at higher levels down to the lower
+  // levels. Timers expiring at this tick will land at level 0.
+  for (int l = TW_LEVELS - 1; l > 0; l--)
+    {
+      int curr = (m_now >> (TW_SLOT_BITS * l)) & (TW_SLOTS - 1);
+      TimerList_t &list = m_slots [l][curr];
+      while (!list.empty ())
+        {
+          Location &loc = m_timers [list.front ().id];
+          m_count [l]--;
+          Place (loc, list);
+        }
+    }
+
+  // Fire the expired timers. Timers may be cancelled or scheduled by the
+  // fired events, so don't cache the list iterators.
+  TimerList_t &list = m_slots [0][m_now & (TW_SLOTS - 1)];
+  while (!list.empty ())
+    {
+      Timer timer = list.front ();
+      NS_ASSERT_MSG (timer.expire == m_now, "Invalid timer expire tick.");
+      list.pop_front ();
+      m_count [0]--;
+      m_timers.erase (timer.id);
+      timer.event->Invoke ();
+    }
+
+  UpdateEvent (GetNextTick ());
+}
+
+uint64_t
+TimerWheel::ToTicks (Time time, bool roundUp) const
+{
+  int64_t steps = time.GetTimeStep ();
+  int64_t tick = m_tick.GetTimeStep ();
+  return roundUp ? (steps + tick - 1) / tick : steps / tick;
+}
+
+} // namespace ns3
@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <list>
+#include <unordered_map>
+#include <ns3/core-module.h>
+
+// Number of levels and slots per level in the timer wheel.
+#define TW_LEVELS 4
+#define TW_SLOT_BITS 8
+#define TW_SLOTS (1 << TW_SLOT_BITS)
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onLogical
+ * Hierarchical timer wheel used to batch long-horizon events, like the
+ * application start attempts and bearer releases handled by the traffic
+ * managers. Timers are rounded up to the wheel tick, so all timers expiring
+ * within the same tick are fired by a single simulator event. The wheel keeps
+ * at most one pending simulator event, scheduled for the next non-empty tick,
+ * and timers can be cancelled in constant time.
+ *
+ * The wheel has TW_LEVELS levels of TW_SLOTS slots each. Level 0 slots are one
+ * tick wide, and each slot at level L spans a whole rotation of level L - 1.
+ * Timers far in the future are kept at higher levels and cascaded down to
+ * lower levels when their slot is reached.
+ */
+class TimerWheel : public Object
+{
+public:
+  /** The timer ID. Zero is never used as a valid timer ID. */
+  typedef uint64_t TimerId;
+
+  TimerWheel ();          //!< Default constructor.
+  virtual ~TimerWheel (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Get the number of pending timers.
+   * \return The number of pending timers.
+   */
+  uint32_t GetNPending (void) const;
+
+  /**
+   * Check whether the given timer is still pending.
+   * \param id The timer ID.
+   * \return True if the timer is pending, false otherwise.
+   */
+  bool IsPending (TimerId id) const;
+
+  /**
+   * Cancel the given timer. Cancelling an expired or already cancelled timer
+   * has no effect.
+   * \param id The timer ID.
+   */
+  void Cancel (TimerId id);
+
+  /**
+   * \name Schedule a member function to be invoked after the given delay.
+   * The delay is rounded up to the wheel tick.
+   * \param delay The relative expiration time.
+   * \param memPtr The member function pointer.
+   * \param obj The object pointer.
+   * \return The timer ID.
+   */
+  //\{
+  template <typename MEM, typename OBJ>
+  TimerId Schedule (Time const &delay, MEM memPtr, OBJ obj);
+
+  template <typename MEM, typename OBJ, typename T1>
+  TimerId Schedule (Time const &delay, MEM memPtr, OBJ obj, T1 a1);
+
+  template <typename MEM, typename OBJ, typename T1, typename T2, typename T3>
+  TimerId Schedule (Time const &delay, MEM memPtr, OBJ obj,
+                    T1 a1, T2 a2, T3 a3);
+  //\}
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+private:
+  /** A timer in the wheel. */
+  struct Timer
+  {
+    TimerId         id;       //!< Timer ID.
+    uint64_t        expire;   //!< Absolute expiration tick.
+    Ptr<EventImpl>  event;    //!< Event to invoke.
+  };
+
+  /** A list of timers in a single slot. */
+  typedef std::list<Timer> TimerList_t;
+
+  /** The location of a timer in the wheel. */
+  struct Location
+  {
+    uint8_t               level;  //!< Wheel level.
+    uint16_t              slot;   //!< Slot index.
+    TimerList_t::iterator it;     //!< Timer iterator in slot list.
+  };
+
+  /**
+   * Insert the event into the wheel.
+   * \param delay The relative expiration time.
+   * \param event The event to invoke.
+   * \return The timer ID.
+   */
+  TimerId DoSchedule (Time const &delay, EventImpl *event);
+
+  /**
+   * Place the timer into the proper level and slot, considering the current
+   * tick. The timer is moved from the source list when provided, keeping any
+   * iterator for it valid.
+   * \param loc The timer location to update.
+   * \param from The source list for this timer.
+   */
+  void Place (Location &loc, TimerList_t &from);
+
+  /**
+   * Update the current tick without firing any timer. This is used before
+   * inserting new timers after an idle period.
+   */
+  void Advance (void);
+
+  /**
+   * Get the next tick to process. This is the expiration tick of the earliest
+   * timer at level 0, or the first tick of the earliest non-empty slot at
+   * higher levels, when its timers must be cascaded down.
+   * \return The next tick to process, or zero when the wheel is empty.
+   */
+  uint64_t GetNextTick (void) const;
+
+  /**
+   * Get the first tick of the given slot, considering the current tick.
+   * \param level The wheel level.
+   * \param slot The slot index.
+   * \return The first tick of this slot.
+   */
+  uint64_t GetSlotStart (uint8_t level, uint16_t slot) const;
+
+  /**
+   * Reschedule the simulator event for the given tick, if it is earlier than
+   * the pending one.
+   * \param tick The tick to process.
+   */
+  void UpdateEvent (uint64_t tick);
+
+  /**
+   * Process the current tick, cascading timers from higher levels and firing
+   * the expired ones.
+   * \param tick The tick being processed.
+   */
+  void ProcessTick (uint64_t tick);
+
+  /**
+   * Convert a simulation time into wheel ticks.
+   * \param time The time.
+   * \param roundUp Round up instead of down.
+   * \return The number of ticks.
+   */
+  uint64_t ToTicks (Time time, bool roundUp) const;
+
+  Time                    m_tick;       //!< Wheel tick duration.
+  uint64_t                m_now;        //!< Current wheel tick.
+  TimerId                 m_nextId;     //!< Next timer ID.
+  EventId                 m_event;      //!< Pending simulator event.
+  uint64_t                m_eventTick;  //!< Tick of the pending event.
+
+  /** Timer lists for each level and slot. */
+  TimerList_t             m_slots [TW_LEVELS][TW_SLOTS];
+  /** Number of timers at each level. */
+  uint32_t                m_count [TW_LEVELS];
+  /** Timer locations by ID, used for constant-time cancellation. */
+  std::unordered_map<TimerId, Location> m_timers;
+};
+
+template <typename MEM, typename OBJ>
+TimerWheel::TimerId
+TimerWheel::Schedule (Time const &delay, MEM memPtr, OBJ obj)
+{
+  return DoSchedule (delay, MakeEvent (memPtr, obj));
+}
+
+template <typename MEM, typename OBJ, typename T1>
+TimerWheel::TimerId
+TimerWheel::Schedule (Time const &delay, MEM memPtr, OBJ obj, T1 a1)
+{
+  return DoSchedule (delay, MakeEvent (memPtr, obj, a1));
+}
+
+template <typename MEM, typename OBJ, typename T1, typename T2, typename T3>
+TimerWheel::TimerId
+TimerWheel::Schedule (Time const &delay, MEM memPtr, OBJ obj,
+                      T1 a1, T2 a2, T3 a3)
+{
+  return DoSchedule (delay, MakeEvent (memPtr, obj, a1, a2, a3));
+}
+
+} // namespace ns3
+#endif // TIMER_WHEEL_H
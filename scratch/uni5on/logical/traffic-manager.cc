@@ -77,6 +77,12 @@ TrafficManager::GetTypeId (void)
                    TimeValue (Time (0)),
                    MakeTimeAccessor (&TrafficManager::m_startTime),
                    MakeTimeChecker (Time (0)))
+    .AddAttribute ("TimerWheel",
+                   "The timer wheel shared by all traffic managers.",
+                   TypeId::ATTR_GET | TypeId::ATTR_CONSTRUCT,
+                   PointerValue (),
+                   MakePointerAccessor (&TrafficManager::m_timerWheel),
+                   MakePointerChecker<TimerWheel> ())
     .AddAttribute ("StopTime",
                    "The time to stop applications.",
                    TimeValue (Time (0)),
@@ -105,7 +111,7 @@ TrafficManager::AddUni5onClient (Ptr<Uni5onClient> app)
   // Schedule the first start attempt for this application.
   Time firstTry = std::max (Seconds (1), m_startTime);
   firstTry += Seconds (std::abs (m_interArrivalRng->GetValue ()));
-  Simulator::Schedule (firstTry, &TrafficManager::AppStartTry, this, app);
+  ScheduleAppStartTry (app, firstTry);
   NS_LOG_INFO ("First start attempt for app " << app->GetAppName () <<
                " will occur at " << firstTry.GetSeconds () << "s.");
 }
@@ -151,6 +157,18 @@ TrafficManager::SetImsi (uint64_t imsi)
   m_imsi = imsi;
 }
 
+void
+TrafficManager::ReseedStreams (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  ReseedStream (m_startProbRng);
+  for (auto const &it : m_timeByApp)
+    {
+      it.first->ReseedStreams ();
+    }
+}
+
 void
 TrafficManager::DoDispose ()
 {
@@ -158,7 +176,13 @@ TrafficManager::DoDispose ()
   m_interArrivalRng = 0;
   m_startProbRng = 0;
   m_ctrlApp = 0;
+  for (auto const &it : m_tryByApp)
+    {
+      m_timerWheel->Cancel (it.second);
+    }
+  m_timerWheel = 0;
   m_timeByApp.clear ();
+  m_tryByApp.clear ();
   Object::DoDispose ();
 }
 
@@ -167,6 +191,9 @@ TrafficManager::AppStartTry (Ptr<Uni5onClient> app)
 {
   NS_LOG_FUNCTION (this << app);
 
+  // This start attempt timer has fired, so it must not be cancelled anymore.
+  m_tryByApp.erase (app);
+
   NS_ASSERT_MSG (!app->IsActive (), "Can't start an active application.");
   NS_LOG_INFO ("Attempt to start app " << app->GetNameTeid ());
   bool authorized = true;
@@ -188,7 +215,7 @@ TrafficManager::AppStartTry (Ptr<Uni5onClient> app)
     {
       NS_LOG_INFO ("Application start try aborted by the start probability.");
       Time nextTry = GetNextAppStartTry (app) - Simulator::Now ();
-      Simulator::Schedule (nextTry, &TrafficManager::AppStartTry, this, app);
+      ScheduleAppStartTry (app, nextTry);
       return;
     }
 
@@ -209,12 +236,12 @@ TrafficManager::AppStartTry (Ptr<Uni5onClient> app)
     {
       NS_LOG_INFO ("Application start try blocked by network controller.");
       Time nextTry = GetNextAppStartTry (app) - Simulator::Now ();
-      Simulator::Schedule (nextTry, &TrafficManager::AppStartTry, this, app);
+      ScheduleAppStartTry (app, nextTry);
       return;
     }
 
   // Schedule the application start for +1 second.
-  Simulator::Schedule (Seconds (1), &Uni5onClient::Start, app);
+  m_timerWheel->Schedule (Seconds (1), &Uni5onClient::Start, app);
   NS_LOG_INFO ("App " << app->GetNameTeid () << " will start in +1sec with " <<
                "max duration set to " << app->GetMaxOnTime ().GetSeconds ());
 }
@@ -232,7 +259,7 @@ TrafficManager::NotifyAppStop (Ptr<Uni5onClient> app)
       RoutingInfo::GetPointer (teid)->SetActive (false);
 
       // Schedule the resource release procedure for +1 second.
-      Simulator::Schedule (
+      m_timerWheel->Schedule (
         Seconds (1), &SliceController::DedicatedBearerRelease,
         m_ctrlApp, app->GetEpsBearer (), m_imsi, teid);
     }
@@ -253,7 +280,7 @@ TrafficManager::NotifyAppStop (Ptr<Uni5onClient> app)
       NS_LOG_INFO ("Next start try for app " << app->GetNameTeid () <<
                    " delayed to +2secs.");
     }
-  Simulator::Schedule (nextTry, &TrafficManager::AppStartTry, this, app);
+  ScheduleAppStartTry (app, nextTry);
 }
 
 void
@@ -327,4 +354,14 @@ TrafficManager::GetNextAppStartTry (Ptr<Uni5onClient> app) const
   return it->second;
 }
 
+void
+TrafficManager::ScheduleAppStartTry (Ptr<Uni5onClient> app, Time delay)
+{
+  NS_LOG_FUNCTION (this << app << delay);
+
+  NS_ASSERT_MSG (m_timerWheel, "No timer wheel for this manager.");
+  m_tryByApp [app] = m_timerWheel->Schedule (
+      delay, &TrafficManager::AppStartTry, this, app);
+}
+
 } // namespace ns3
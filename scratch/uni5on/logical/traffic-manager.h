@@ -25,6 +25,7 @@
 #include <ns3/lte-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
+#include "timer-wheel.h"
 #include "../uni5on-common.h"
 
 namespace ns3 {
@@ -36,7 +37,9 @@ class Uni5onClient;
  * \ingroup uni5onLogical
  * Traffic manager which handles UNI5ON client applications start/stop events.
  * It interacts with the UNI5ON architecture to request and release bearers.
- * Each LteUeNetDevice has one TrafficManager object aggregated to it.
+ * Each LteUeNetDevice has one TrafficManager object aggregated to it. The
+ * application start attempts and the bearer release procedures are scheduled
+ * on a timer wheel shared by all traffic managers in the scenario.
  */
 class TrafficManager : public Object
 {
@@ -76,6 +79,13 @@ public:
    */
   void SetImsi (uint64_t imsi);
 
+  /**
+   * Reseed the random variable streams used by this manager and by its
+   * applications with the current RngSeedManager run number. The shared
+   * inter-arrival stream is reseeded by the traffic helper.
+   */
+  void ReseedStreams (void);
+
 protected:
   /** Destructor implementation. */
   virtual void DoDispose ();
@@ -115,6 +125,13 @@ private:
    */
   Time GetNextAppStartTry (Ptr<Uni5onClient> app) const;
 
+  /**
+   * Schedule the next attempt to start the application on the timer wheel.
+   * \param app The application pointer.
+   * \param delay The relative time for the next attempt.
+   */
+  void ScheduleAppStartTry (Ptr<Uni5onClient> app, Time delay);
+
   Ptr<RandomVariableStream> m_interArrivalRng;  //!< Inter-arrival random time.
   bool                      m_restartApps;      //!< Restart apps after stop.
   double                    m_startProb;        //!< Probability to start apps.
@@ -122,12 +139,17 @@ private:
   Time                      m_startTime;        //!< Time to start apps.
   Time                      m_stopTime;         //!< Time to stop apps.
   Ptr<SliceController>      m_ctrlApp;          //!< OpenFlow slice controller.
+  Ptr<TimerWheel>           m_timerWheel;       //!< Shared timer wheel.
   uint64_t                  m_imsi;             //!< UE IMSI identifier.
   uint32_t                  m_defaultTeid;      //!< Default UE tunnel TEID.
 
   /** Map saving application pointer / next start time. */
   typedef std::map<Ptr<Uni5onClient>, Time> AppTimeMap_t;
   AppTimeMap_t              m_timeByApp;        //!< Application map.
+
+  /** Map saving application pointer / pending start attempt timer. */
+  typedef std::map<Ptr<Uni5onClient>, TimerWheel::TimerId> AppTimerMap_t;
+  AppTimerMap_t             m_tryByApp;         //!< Start attempt timers.
 };
 
 } // namespace ns3
@@ -191,6 +191,14 @@ Uni5onMme::DoCreateSessionResponse (
   uint64_t imsi = msg.teid;
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
 
+  // Synthetic eNBs without radio, like those in the controller benchmark,
+  // have no S1-AP SAP, so there's nothing else to do.
+  EpcS1apSapEnb *s1apSapEnb = ueInfo->GetS1apSapEnb ();
+  if (!s1apSapEnb)
+    {
+      return;
+    }
+
   std::list<EpcS1apSapEnb::ErabToBeSetupItem> erabList;
   for (auto const &bit : msg.bearerContextsCreated)
     {
@@ -202,7 +210,7 @@ Uni5onMme::DoCreateSessionResponse (
       erabList.push_back (erab);
     }
 
-  ueInfo->GetS1apSapEnb ()->InitialContextSetupRequest (
+  s1apSapEnb->InitialContextSetupRequest (
     ueInfo->GetMmeUeS1Id (), ueInfo->GetEnbUeS1Id (), erabList);
 }
 
@@ -215,6 +223,14 @@ Uni5onMme::DoModifyBearerResponse (
   uint64_t imsi = msg.teid;
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
 
+  // Synthetic eNBs without radio, like those in the controller benchmark,
+  // have no S1-AP SAP, so there's nothing else to do.
+  EpcS1apSapEnb *s1apSapEnb = ueInfo->GetS1apSapEnb ();
+  if (!s1apSapEnb)
+    {
+      return;
+    }
+
   std::list<EpcS1apSapEnb::ErabSwitchedInUplinkItem> erabList;
   for (auto const &bit : msg.bearerContextsModified)
     {
@@ -225,7 +241,7 @@ Uni5onMme::DoModifyBearerResponse (
       erabList.push_back (erab);
     }
 
-  ueInfo->GetS1apSapEnb ()->PathSwitchRequestAcknowledge (
+  s1apSapEnb->PathSwitchRequestAcknowledge (
     ueInfo->GetEnbUeS1Id (), ueInfo->GetMmeUeS1Id (),
     ueInfo->GetEnbCellId (), erabList);
 }
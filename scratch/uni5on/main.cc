@@ -18,12 +18,22 @@
  * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
  */
 
+#include <cmath>
+#include <dirent.h>
+#include <fcntl.h>
 #include <iomanip>
 #include <iostream>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <ns3/config-store-module.h>
 #include <ns3/core-module.h>
 #include <ns3/internet-module.h>
 #include <ns3/ofswitch13-module.h>
+#include "helpers/async-output-writer.h"
+#include "helpers/controller-benchmark.h"
+#include "helpers/progress-reporter.h"
 #include "helpers/scenario-helper.h"
 
 using namespace ns3;
@@ -37,49 +47,25 @@ NS_LOG_COMPONENT_DEFINE ("Main");
 
 void ConfigureDefaults ();
 void ForceDefaults ();
-void EnableProgress (int);
 void EnableVerbose (bool);
 void EnableOfsLogs (bool);
-
-// Prefixes used by input and output filenames.
-static ns3::GlobalValue
-  g_inputPrefix ("InputPrefix", "Common prefix for output filenames.",
-                 ns3::StringValue (std::string ()),
-                 ns3::MakeStringChecker ());
-
-static ns3::GlobalValue
-  g_outputPrefix ("OutputPrefix", "Common prefix for input filenames.",
-                  ns3::StringValue (std::string ()),
-                  ns3::MakeStringChecker ());
-
-// Dump timeout for logging statistics.
-static ns3::GlobalValue
-  g_dumpTimeout ("DumpStatsTimeout", "Periodic statistics dump interval.",
-                 ns3::TimeValue (Seconds (1)),
-                 ns3::MakeTimeChecker ());
-
-// Simulation lenght.
-static ns3::GlobalValue
-  g_simTime ("SimTime", "Simulation stop time.",
-             ns3::TimeValue (Seconds (0)),
-             ns3::MakeTimeChecker ());
-
-// Flag for error messages at the stderr stream.
-static ns3::GlobalValue
-  g_seeLogs ("SeeCerr", "Tell user to check the stderr stream.",
-             ns3::BooleanValue (false),
-             ns3::MakeBooleanChecker ());
+void EnableProfiler (bool, std::string);
+bool ForkRuns (int, Ptr<ScenarioHelper>, int&);
 
 int
 main (int argc, char *argv[])
 {
   // Command line arguments.
+  int         bench    = 0;
+  int         forks    = 0;
   bool        lteRem   = false;
   bool        ofsLog   = false;
   int         pcapCfg  = 0;
   std::string prefix   = std::string ();
+  bool        profile  = false;
   int         progress = 1;
   bool        verbose  = false;
+  int         warmUp   = 0;
 
   // Configure some default attribute values. These values can be overridden by
   // users on the command line or in the configuration file.
@@ -87,12 +73,16 @@ main (int argc, char *argv[])
 
   // Parse command line arguments.
   CommandLine cmd;
-  cmd.AddValue ("LteRem",   "Print LTE radio environment map.", lteRem);
-  cmd.AddValue ("OfsLog",   "Enable ofsoftswitch13 logs.", ofsLog);
-  cmd.AddValue ("PcapCfg",  "Configure pcap output.", pcapCfg);
-  cmd.AddValue ("Prefix",   "Common prefix for filenames.", prefix);
-  cmd.AddValue ("Progress", "Simulation progress interval (sec).", progress);
-  cmd.AddValue ("Verbose",  "Enable verbose output.", verbose);
+  cmd.AddValue ("Benchmark", "Controller benchmark operations.", bench);
+  cmd.AddValue ("Forks",     "Number of runs sharing the warm-up.", forks);
+  cmd.AddValue ("LteRem",    "Print LTE radio environment map.", lteRem);
+  cmd.AddValue ("OfsLog",    "Enable ofsoftswitch13 logs.", ofsLog);
+  cmd.AddValue ("PcapCfg",   "Configure pcap output.", pcapCfg);
+  cmd.AddValue ("Prefix",    "Common prefix for filenames.", prefix);
+  cmd.AddValue ("Profile",   "Enable per-component profiler.", profile);
+  cmd.AddValue ("Progress",  "Simulation progress interval (sec).", progress);
+  cmd.AddValue ("Verbose",   "Enable verbose output.", verbose);
+  cmd.AddValue ("WarmUp",    "Warm-up interval shared by runs (sec).", warmUp);
   cmd.Parse (argc, argv);
 
   // Update input and output prefixes from command line prefix parameter.
@@ -129,15 +119,33 @@ main (int argc, char *argv[])
   EnableVerbose (verbose);
   EnableOfsLogs (ofsLog);
 
+  // The profiler must be enabled before any event gets scheduled, as it
+  // replaces the simulator implementation.
+  EnableProfiler (profile, outputPrefix.str ());
+
   // Create the helper object, which is responsible for creating and
-  // configuring the infrastructure and logical networks.
-  NS_LOG_INFO ("Creating simulation scenario...");
-  Ptr<ScenarioHelper> scenarioHelper = CreateObject<ScenarioHelper> ();
+  // configuring the infrastructure and logical networks. The controller
+  // benchmark builds its own synthetic network without the LTE radio, and
+  // stops the simulation when finished.
+  Ptr<ScenarioHelper> scenarioHelper;
+  Ptr<ControllerBenchmark> benchmark;
+  if (bench > 0)
+    {
+      NS_ABORT_MSG_IF (forks > 0, "Can't run the benchmark when forking.");
+      NS_LOG_INFO ("Creating controller benchmark...");
+      benchmark = CreateObjectWithAttributes<ControllerBenchmark> (
+          "Operations", UintegerValue (bench));
+    }
+  else
+    {
+      NS_LOG_INFO ("Creating simulation scenario...");
+      scenarioHelper = CreateObject<ScenarioHelper> ();
 
-  // Configure helper with command line parameters.
-  scenarioHelper->PrintLteRem (lteRem);
-  scenarioHelper->ConfigurePcap (outputPrefix.str (),
-                                 static_cast<uint8_t> (pcapCfg));
+      // Configure helper with command line parameters.
+      scenarioHelper->PrintLteRem (lteRem);
+      scenarioHelper->ConfigurePcap (outputPrefix.str (),
+                                     static_cast<uint8_t> (pcapCfg));
+    }
 
   // Populating routing and ARP tables. The 'perfect' ARP used here comes from
   // the patch at https://www.nsnam.org/bugzilla/show_bug.cgi?id=187. This
@@ -150,19 +158,62 @@ main (int argc, char *argv[])
 
   // Set stop time and run the simulation.
   std::cout << "Simulating..." << std::endl;
-  EnableProgress (progress);
+  Ptr<ProgressReporter> reporter;
+  if (progress > 0)
+    {
+      reporter = CreateObjectWithAttributes<ProgressReporter> (
+          "Interval", TimeValue (Seconds (progress)));
+    }
 
   TimeValue timeValue;
   GlobalValue::GetValueByName ("SimTime", timeValue);
   Time stopAt = timeValue.Get () + MilliSeconds (100);
 
+  // When forking is enabled, the scenario is built and simulated up to the
+  // end of the warm-up interval only once. Then, each child process continues
+  // the simulation independently, with its own run number for traffic.
+  if (forks > 0)
+    {
+      NS_ABORT_MSG_IF (profile, "Can't enable the profiler when forking.");
+      NS_ABORT_MSG_IF (Seconds (warmUp) >= stopAt, "Invalid warm-up time.");
+
+      Simulator::Stop (Seconds (warmUp));
+      Simulator::Run ();
+
+      int status = 0;
+      if (!ForkRuns (forks, scenarioHelper, status))
+        {
+          // This is the parent process. Skip any cleanup that could flush
+          // buffered data into output files now owned by the child processes.
+          std::cout.flush ();
+          _exit (status);
+        }
+      stopAt -= Simulator::Now ();
+    }
+
   Simulator::Stop (stopAt);
   Simulator::Run ();
 
   // Finish the simulation.
   Simulator::Destroy ();
-  scenarioHelper->Dispose ();
-  scenarioHelper = 0;
+  if (benchmark)
+    {
+      benchmark->Dispose ();
+      benchmark = 0;
+    }
+  if (reporter)
+    {
+      reporter->Dispose ();
+      reporter = 0;
+    }
+  if (scenarioHelper)
+    {
+      scenarioHelper->Dispose ();
+      scenarioHelper = 0;
+    }
+
+  // Write any pending output to files.
+  AsyncOutputWriter::Shutdown ();
 
   // Print the final status message.
   BooleanValue cerrValue;
@@ -340,14 +391,22 @@ void ForceDefaults ()
 
   //
   // Reducing the OpenFlow datapath timeout interval from 100ms to 50ms to
-  // get a more precise token refill operation at meter entries. This change
-  // requires reducing the EWMA alpha attribute at OpenFlow stats calculator
-  // to continue getting consistent average values for 1s interval.
-  //
+  // get a more precise token refill operation at meter entries. Every switch
+  // wakes up at this interval, so coarser values can be set with the
+  // DatapathTimeout global value when meter precision is not a concern. The
+  // EWMA alpha attribute at OpenFlow stats calculator is derived from the
+  // interval to keep the same averaging time constant as alpha 0.1 for 50ms:
+  // after n updates the old average weights (1 - alpha)^n, so the weight
+  // left after each second is 0.9^20 regardless of the interval.
+  //
+  TimeValue timeoutValue;
+  GlobalValue::GetValueByName ("DatapathTimeout", timeoutValue);
+  double intervals = timeoutValue.Get ().GetSeconds () / 0.05;
   Config::SetDefault (
-    "ns3::OFSwitch13Device::TimeoutInterval", TimeValue (MilliSeconds (50)));
+    "ns3::OFSwitch13Device::TimeoutInterval", timeoutValue);
   Config::SetDefault (
-    "ns3::OFSwitch13StatsCalculator::EwmaAlpha", DoubleValue (0.1));
+    "ns3::OFSwitch13StatsCalculator::EwmaAlpha",
+    DoubleValue (1.0 - std::pow (0.9, intervals)));
 
   //
   // Enable detailed OpenFlow datapath statistics.
@@ -356,14 +415,149 @@ void ForceDefaults ()
     "ns3::OFSwitch13StatsCalculator::FlowTableDetails", BooleanValue (true));
 }
 
+/**
+ * Fork the simulation into independent runs sharing the current state.
+ * Child process i (starting at 0) uses the current run number plus i for the
+ * traffic random variable streams and for the output prefix. Output files
+ * opened so far are duplicated for each new prefix, so the child processes
+ * get complete output files, including the statistics for the warm-up period.
+ * The first child process keeps the original files. The parent process waits
+ * for all children to finish.
+ * \param forks The number of child processes.
+ * \param scenarioHelper The scenario helper.
+ * \param status The exit status for the parent process.
+ * \return True for child processes, false for the parent process.
+ */
+bool
+ForkRuns (int forks, Ptr<ScenarioHelper> scenarioHelper, int &status)
+{
+  StringValue stringValue;
+  GlobalValue::GetValueByName ("InputPrefix", stringValue);
+  std::string inputPrefix = stringValue.Get ();
+  GlobalValue::GetValueByName ("OutputPrefix", stringValue);
+  std::string outputPrefix = stringValue.Get ();
+  uint64_t baseRun = RngSeedManager::GetRun ();
+
+  // Write all pending output and stop the output writer thread, so the files
+  // are complete before copying them and no thread is running on fork.
+  AsyncOutputWriter::Flush ();
+
+  // Get the canonical path for the output prefix, so we can match it against
+  // the targets for the file descriptors in /proc/self/fd.
+  std::string::size_type slash = outputPrefix.rfind ('/');
+  std::string dirName = (slash == std::string::npos)
+    ? "." : outputPrefix.substr (0, slash + 1);
+  std::string baseName = (slash == std::string::npos)
+    ? outputPrefix : outputPrefix.substr (slash + 1);
+  char pathBuf [PATH_MAX];
+  NS_ABORT_MSG_IF (!realpath (dirName.c_str (), pathBuf),
+                   "Invalid output directory " << dirName);
+  std::string canonicalPrefix = std::string (pathBuf) + "/" + baseName;
+
+  // Collect the output files opened under the current output prefix.
+  std::vector<std::pair<int, std::string> > outputFiles;
+  DIR *dir = opendir ("/proc/self/fd");
+  NS_ABORT_MSG_IF (!dir, "Can't list open file descriptors.");
+  while (struct dirent *entry = readdir (dir))
+    {
+      int fd = atoi (entry->d_name);
+      std::string link = std::string ("/proc/self/fd/") + entry->d_name;
+      ssize_t len = readlink (link.c_str (), pathBuf, sizeof (pathBuf) - 1);
+      if (len <= 0 || fd == dirfd (dir)
+          || (fcntl (fd, F_GETFL) & O_ACCMODE) == O_RDONLY)
+        {
+          continue;
+        }
+      std::string target (pathBuf, len);
+      if (target.compare (0, canonicalPrefix.size (), canonicalPrefix) == 0)
+        {
+          outputFiles.push_back (
+            std::make_pair (fd, target.substr (canonicalPrefix.size ())));
+        }
+    }
+  closedir (dir);
+
+  // Duplicate the output files for each new prefix before forking, so no
+  // child process is writing to them yet. Data still buffered in memory is
+  // inherited by the child processes and written to their own files later.
+  std::vector<std::string> prefixes;
+  for (int i = 0; i < forks; i++)
+    {
+      std::ostringstream prefix;
+      prefix << inputPrefix << baseRun + i << "-";
+      prefixes.push_back (prefix.str ());
+      for (size_t f = 0; i > 0 && f < outputFiles.size (); f++)
+        {
+          std::ifstream src (outputPrefix + outputFiles [f].second,
+                             std::ios::binary);
+          std::ofstream dst (prefixes [i] + outputFiles [f].second,
+                             std::ios::binary | std::ios::trunc);
+          dst << src.rdbuf ();
+        }
+    }
+
+  std::cout << "Forking " << forks << " runs at +"
+            << Simulator::Now ().GetSeconds () << "s..." << std::endl;
+  std::vector<pid_t> children;
+  for (int i = 0; i < forks; i++)
+    {
+      pid_t pid = fork ();
+      NS_ABORT_MSG_IF (pid < 0, "Can't fork the simulation process.");
+      if (pid > 0)
+        {
+          children.push_back (pid);
+          continue;
+        }
+
+      // This is the child process. Redirect the output file descriptors to
+      // the files for the new prefix, keeping the write offset at their end.
+      for (size_t f = 0; i > 0 && f < outputFiles.size (); f++)
+        {
+          std::string filename = prefixes [i] + outputFiles [f].second;
+          int fd = open (filename.c_str (), O_WRONLY);
+          NS_ABORT_MSG_IF (fd < 0, "Can't open output file " << filename);
+          lseek (fd, 0, SEEK_END);
+          dup2 (fd, outputFiles [f].first);
+          close (fd);
+        }
+
+      // Threads are not inherited by the child process, so start the output
+      // writer thread again. The parent doesn't need it, as it writes nothing
+      // else and exits as soon as its children finish.
+      AsyncOutputWriter::Restart ();
+
+      // Update the run number and output prefix, and reseed the traffic.
+      RngSeedManager::SetRun (baseRun + i);
+      Config::SetGlobal ("OutputPrefix", StringValue (prefixes [i]));
+      scenarioHelper->ReseedTraffic ();
+      return true;
+    }
+
+  // This is the parent process. Wait for all children to finish.
+  status = 0;
+  for (size_t i = 0; i < children.size (); i++)
+    {
+      int childStatus;
+      waitpid (children [i], &childStatus, 0);
+      if (!WIFEXITED (childStatus) || WEXITSTATUS (childStatus) != 0)
+        {
+          status = 1;
+        }
+    }
+  return false;
+}
+
 void
-EnableProgress (int interval)
+EnableProfiler (bool enable, std::string prefix)
 {
-  if (interval)
+  if (enable)
     {
-      int64_t now = Simulator::Now ().ToInteger (Time::S);
-      std::cout << "Current simulation time: +" << now << ".0s" << std::endl;
-      Simulator::Schedule (Seconds (interval), &EnableProgress, interval);
+      Config::SetDefault ("ns3::ProfilingSimulatorImpl::ReportFilename",
+                          StringValue (prefix + "profile.log"));
+      Config::SetDefault ("ns3::ProfilingSimulatorImpl::FoldedFilename",
+                          StringValue (prefix + "profile.folded"));
+      Config::SetGlobal ("SimulatorImplementationType",
+                         StringValue ("ns3::ProfilingSimulatorImpl"));
     }
 }
 
@@ -393,12 +587,18 @@ EnableVerbose (bool enable)
       LogComponentEnable ("Uni5onCommon",             logLevelWarnInfo);
 
       // Helper components.
+      LogComponentEnable ("ControllerBenchmark",      logLevelWarnInfo);
+      LogComponentEnable ("ProgressReporter",         logLevelWarnInfo);
       LogComponentEnable ("ScenarioHelper",           logLevelWarnInfo);
       LogComponentEnable ("TrafficHelper",            logLevelWarnInfo);
 
       // Infrastructure components.
+      LogComponentEnable ("AbstractEnbNetDevice",     logLevelWarnInfo);
+      LogComponentEnable ("AbstractUeNetDevice",      logLevelWarnInfo);
       LogComponentEnable ("BackhaulController",       logLevelWarnInfo);
       LogComponentEnable ("BackhaulNetwork",          logLevelWarnInfo);
+      LogComponentEnable ("MeshController",           logLevelWarnInfo);
+      LogComponentEnable ("MeshNetwork",              logLevelWarnInfo);
       LogComponentEnable ("RadioNetwork",             logLevelWarnInfo);
       LogComponentEnable ("RingController",           logLevelWarnInfo);
       LogComponentEnable ("RingNetwork",              logLevelWarnInfo);
@@ -410,12 +610,14 @@ EnableVerbose (bool enable)
       LogComponentEnable ("PgwTunnelApp",             logLevelWarnInfo);
       LogComponentEnable ("SliceController",          logLevelWarnInfo);
       LogComponentEnable ("SliceNetwork",             logLevelWarnInfo);
+      LogComponentEnable ("TimerWheel",               logLevelWarnInfo);
       LogComponentEnable ("Uni5onMme",                logLevelWarnInfo);
       LogComponentEnable ("TrafficManager",           logLevelWarnInfo);
 
       // Metadata components.
       LogComponentEnable ("EnbInfo",                  logLevelWarnInfo);
       LogComponentEnable ("LinkInfo",                 logLevelWarnInfo);
+      LogComponentEnable ("MeshInfo",                 logLevelWarnInfo);
       LogComponentEnable ("PgwInfo",                  logLevelWarnInfo);
       LogComponentEnable ("RingInfo",                 logLevelWarnInfo);
       LogComponentEnable ("RoutingInfo",              logLevelWarnInfo);
@@ -425,6 +627,8 @@ EnableVerbose (bool enable)
       // Applications.
       LogComponentEnable ("BufferedVideoClient",      logLevelWarnInfo);
       LogComponentEnable ("BufferedVideoServer",      logLevelWarnInfo);
+      LogComponentEnable ("FluidClient",              logLevelWarnInfo);
+      LogComponentEnable ("FluidServer",              logLevelWarnInfo);
       LogComponentEnable ("HttpClient",               logLevelWarnInfo);
       LogComponentEnable ("HttpServer",               logLevelWarnInfo);
       LogComponentEnable ("LiveVideoClient",          logLevelWarnInfo);
@@ -437,6 +641,7 @@ EnableVerbose (bool enable)
       // Statistic components.
       LogComponentEnable ("AdmissionStatsCalculator", logLevelWarnInfo);
       LogComponentEnable ("BackhaulStatsCalculator",  logLevelWarnInfo);
+      LogComponentEnable ("ControlStatsCalculator",   logLevelWarnInfo);
       LogComponentEnable ("FlowStatsCalculator",      logLevelWarnInfo);
       LogComponentEnable ("LteRrcStatsCalculator",    logLevelWarnInfo);
       LogComponentEnable ("PgwTftStatsCalculator",    logLevelWarnInfo);
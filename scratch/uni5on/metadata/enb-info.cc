@@ -97,7 +97,7 @@ EnbInfo::GetS1apSapEnb (void) const
 {
   NS_LOG_FUNCTION (this);
 
-  return m_application->GetS1apSapEnb ();
+  return m_application ? m_application->GetS1apSapEnb () : 0;
 }
 
 Ipv4Address
@@ -43,7 +43,8 @@ public:
    * \param s1uAddr The eNB S1-U IP address.
    * \param infraSwIdx The OpenFlow backhaul switch index.
    * \param infraSwS1uPortNo The port number for S1-U interface at the switch.
-   * \param enbApp The eNB application.
+   * \param enbApp The eNB application, or 0 for eNBs without radio (like the
+   *        synthetic eNBs in the controller benchmark).
    */
   EnbInfo (uint16_t cellId, Ipv4Address s1uAddr, uint16_t infraSwIdx,
            uint32_t infraSwS1uPortNo, Ptr<Uni5onEnbApplication> enbApp);
@@ -18,6 +18,7 @@
  * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
  */
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include "link-info.h"
@@ -80,6 +81,8 @@ LinkInfo::LinkInfo (Ptr<OFSwitch13Port> port1, Ptr<OFSwitch13Port> port2,
   // and the UpdateQuota method will adjust this value.
   m_slices [LinkDir::FWD][SliceId::UNKN].quota = 100;
   m_slices [LinkDir::BWD][SliceId::UNKN].quota = 100;
+  UpdateBitRateCache (LinkDir::FWD);
+  UpdateBitRateCache (LinkDir::BWD);
 
   RegisterLinkInfo (Ptr<LinkInfo> (this));
 }
@@ -200,7 +203,7 @@ LinkInfo::GetQuoBitRate (LinkDir dir, SliceId slice) const
 {
   NS_LOG_FUNCTION (this << dir << slice);
 
-  return GetLinkBitRate () * GetQuota (dir, slice) / 100;
+  return m_slices [dir][slice].quoBitRate;
 }
 
 int64_t
@@ -208,7 +211,7 @@ LinkInfo::GetMaxBitRate (LinkDir dir, SliceId slice) const
 {
   NS_LOG_FUNCTION (this << dir << slice);
 
-  return GetQuoBitRate (dir, slice) + GetExtBitRate (dir, slice);
+  return m_slices [dir][slice].maxBitRate;
 }
 
 int64_t
@@ -219,12 +222,20 @@ LinkInfo::GetResBitRate (LinkDir dir, SliceId slice) const
   return m_slices [dir][slice].reserved;
 }
 
+int64_t
+LinkInfo::GetFreBitRate (LinkDir dir, SliceId slice) const
+{
+  NS_LOG_FUNCTION (this << dir << slice);
+
+  return m_slices [dir][slice].freBitRate;
+}
+
 int64_t
 LinkInfo::GetUnrBitRate (LinkDir dir, SliceId slice) const
 {
   NS_LOG_FUNCTION (this << dir << slice);
 
-  return GetMaxBitRate (dir, slice) - GetResBitRate (dir, slice);
+  return m_slices [dir][slice].unrBitRate;
 }
 
 int64_t
@@ -234,6 +245,7 @@ LinkInfo::GetUseBitRate (EwmaTerm term, LinkDir dir, SliceId slice,
   NS_LOG_FUNCTION (this << term << dir << slice << type);
 
   NS_ASSERT_MSG (slice <= SliceId::ALL, "Invalid slice for this operation.");
+  EwmaUpdate (dir, slice);
   return m_slices [dir][slice].ewmaThp [type][term];
 }
 
@@ -285,9 +297,8 @@ LinkInfo::HasBitRate (LinkDir dir, SliceId slice, int64_t bitRate,
   // quota bit rate and the slice maximum bit rate * block threshold.
   NS_ASSERT_MSG (slice < SliceId::ALL, "Invalid slice for this operation.");
   int64_t blkBitRate = GetMaxBitRate (dir, slice) * blockThs;
-  int64_t quoBitRate = GetQuoBitRate (dir, slice);
-  int64_t resBitRate = GetResBitRate (dir, slice);
-  return (resBitRate + bitRate <= std::min (blkBitRate, quoBitRate));
+  return (bitRate <= GetFreBitRate (dir, slice)
+          && GetResBitRate (dir, slice) + bitRate <= blkBitRate);
 }
 
 std::ostream &
@@ -406,9 +417,17 @@ LinkInfo::NotifyConstructionCompleted (void)
 {
   NS_LOG_FUNCTION (this);
 
-  // Scheduling the first EWMA update.
-  m_ewmaLastTime = Simulator::Now ();
-  Simulator::Schedule (m_ewmaTimeout, &LinkInfo::EwmaUpdate, this);
+  // Aligning the first EWMA update to the global EwmaTimeout grid.
+  int64_t period = m_ewmaTimeout.GetTimeStep ();
+  NS_ABORT_MSG_IF (period <= 0, "Invalid EWMA timeout.");
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  for (int s = 0; s < N_SLICE_IDS_UNKN; s++)
+    {
+      for (int d = 0; d < N_LINK_DIRS; d++)
+        {
+          m_slices [d][s].ewmaLast = (now / period) * period;
+        }
+    }
 
   Object::NotifyConstructionCompleted ();
 }
@@ -425,16 +444,8 @@ LinkInfo::NotifyTxPacket (std::string context, Ptr<const Packet> packet)
   EpcGtpuTag gtpuTag;
   if (packet->PeekPacketTag (gtpuTag))
     {
-      SliceId slice = gtpuTag.GetSliceId ();
-      QosType type = gtpuTag.GetQosType ();
-      uint32_t size = packet->GetSize ();
-
-      // Update TX packets for the traffic slice and for fake shared slice,
-      // considering both the traffic type and the fake both type.
-      m_slices [dir][slice].txBytes [type] += size;
-      m_slices [dir][slice].txBytes [QosType::BOTH] += size;
-      m_slices [dir][SliceId::ALL].txBytes [type] += size;
-      m_slices [dir][SliceId::ALL].txBytes [QosType::BOTH] += size;
+      NotifyTxBytes (dir, gtpuTag.GetSliceId (), gtpuTag.GetQosType (),
+                     packet->GetSize ());
     }
   else
     {
@@ -442,6 +453,24 @@ LinkInfo::NotifyTxPacket (std::string context, Ptr<const Packet> packet)
     }
 }
 
+void
+LinkInfo::NotifyTxBytes (LinkDir dir, SliceId slice, QosType type,
+                         uint64_t bytes)
+{
+  NS_LOG_FUNCTION (this << dir << slice << type << bytes);
+
+  // Fold previous bytes into EWMA averages before accounting new ones.
+  EwmaUpdate (dir, slice);
+  EwmaUpdate (dir, SliceId::ALL);
+
+  // Update TX bytes for the traffic slice and for fake shared slice,
+  // considering both the traffic type and the fake both type.
+  m_slices [dir][slice].txBytes [type] += bytes;
+  m_slices [dir][slice].txBytes [QosType::BOTH] += bytes;
+  m_slices [dir][SliceId::ALL].txBytes [type] += bytes;
+  m_slices [dir][SliceId::ALL].txBytes [QosType::BOTH] += bytes;
+}
+
 bool
 LinkInfo::UpdateQuota (LinkDir dir, SliceId slice, int quota)
 {
@@ -463,6 +492,7 @@ LinkInfo::UpdateQuota (LinkDir dir, SliceId slice, int quota)
   m_slices [dir][slice].quota += quota;
   m_slices [dir][SliceId::ALL].quota += quota;
   m_slices [dir][SliceId::UNKN].quota -= quota;
+  UpdateBitRateCache (dir);
   NS_LOG_DEBUG ("Slice " << SliceIdStr (slice) <<
                 " with new quota " << GetQuota (dir, slice) <<
                 " in " << LinkDirStr (dir) << " direction.");
@@ -477,16 +507,21 @@ LinkInfo::UpdateResBitRate (
 
   // Check for valid slice reserved bit rate.
   NS_ASSERT_MSG (slice < SliceId::ALL, "Invalid slice for this operation.");
-  int64_t newSliReserved = GetResBitRate (dir, slice) + bitRate;
-  if (newSliReserved < 0 || newSliReserved > GetQuoBitRate (dir, slice))
+  SliceMetadata &slData = m_slices [dir][slice];
+  if (slData.reserved + bitRate < 0 || bitRate > slData.freBitRate)
     {
       NS_LOG_WARN ("Can't change the slice reserved bit rate.");
       return false;
     }
 
-  // Reserving the bit rate.
-  m_slices [dir][slice].reserved += bitRate;
-  m_slices [dir][SliceId::ALL].reserved += bitRate;
+  // Reserving the bit rate, keeping the cached free bit rates up to date.
+  SliceMetadata &allData = m_slices [dir][SliceId::ALL];
+  slData.reserved += bitRate;
+  slData.freBitRate -= bitRate;
+  slData.unrBitRate -= bitRate;
+  allData.reserved += bitRate;
+  allData.freBitRate -= bitRate;
+  allData.unrBitRate -= bitRate;
   NS_LOG_DEBUG ("Slice " << SliceIdStr (slice) <<
                 " with new reserved bit rate " << GetResBitRate (dir, slice) <<
                 " in " << LinkDirStr (dir) << " direction.");
@@ -511,6 +546,7 @@ LinkInfo::UpdateExtBitRate (LinkDir dir, SliceId slice, int64_t bitRate)
   // Update the slice extra bit rate.
   m_slices [dir][slice].extra += bitRate;
   m_slices [dir][SliceId::ALL].extra += bitRate;
+  UpdateBitRateCache (dir);
   NS_LOG_DEBUG ("Slice " << SliceIdStr (slice) <<
                 " with new extra bit rate " << GetExtBitRate (dir, slice) <<
                 " in " << LinkDirStr (dir) << " direction.");
@@ -539,31 +575,63 @@ LinkInfo::SetMetBitRate (LinkDir dir, SliceId slice, int64_t bitRate)
 }
 
 void
-LinkInfo::EwmaUpdate (void)
+LinkInfo::EwmaUpdate (LinkDir dir, SliceId slice) const
 {
-  double elapSecs = (Simulator::Now () - m_ewmaLastTime).GetSeconds ();
-  for (int s = 0; s < N_SLICE_IDS_ALL; s++)
+  const SliceMetadata &slData = m_slices [dir][slice];
+  int64_t period = m_ewmaTimeout.GetTimeStep ();
+  int64_t ticks = (Simulator::Now ().GetTimeStep () - slData.ewmaLast) / period;
+  if (ticks <= 0)
     {
-      for (int d = 0; d < N_LINK_DIRS; d++)
+      return;
+    }
+
+  // The first tick folds the bytes transmitted since the last update.
+  double elapSecs = m_ewmaTimeout.GetSeconds ();
+  for (int t = 0; t < N_QOS_TYPES_BOTH; t++)
+    {
+      // Updating both long-term and short-term EWMA throughput.
+      slData.ewmaThp [t][EwmaTerm::LTERM] =
+        (m_ewmaLtAlpha * 8 * slData.txBytes [t]) / elapSecs +
+        (1 - m_ewmaLtAlpha) * slData.ewmaThp [t][EwmaTerm::LTERM];
+      slData.ewmaThp [t][EwmaTerm::STERM] =
+        (m_ewmaStAlpha * 8 * slData.txBytes [t]) / elapSecs +
+        (1 - m_ewmaStAlpha) * slData.ewmaThp [t][EwmaTerm::STERM];
+      slData.txBytes [t] = 0;
+    }
+
+  // No bytes were transmitted in the remaining ticks, so the averages only
+  // decay. Stop as soon as all of them reach zero.
+  bool idle = false;
+  for (int64_t i = 1; i < ticks && !idle; i++)
+    {
+      idle = true;
+      for (int t = 0; t < N_QOS_TYPES_BOTH; t++)
         {
-          SliceMetadata &slData = m_slices [d][s];
-          for (int t = 0; t < N_QOS_TYPES_BOTH; t++)
-            {
-              // Updating both long-term and short-term EWMA throughput.
-              slData.ewmaThp [t][EwmaTerm::LTERM] =
-                (m_ewmaLtAlpha * 8 * slData.txBytes [t]) / elapSecs +
-                (1 - m_ewmaLtAlpha) * slData.ewmaThp [t][EwmaTerm::LTERM];
-              slData.ewmaThp [t][EwmaTerm::STERM] =
-                (m_ewmaStAlpha * 8 * slData.txBytes [t]) / elapSecs +
-                (1 - m_ewmaStAlpha) * slData.ewmaThp [t][EwmaTerm::STERM];
-              slData.txBytes [t] = 0;
-            }
+          slData.ewmaThp [t][EwmaTerm::LTERM] =
+            (1 - m_ewmaLtAlpha) * slData.ewmaThp [t][EwmaTerm::LTERM];
+          slData.ewmaThp [t][EwmaTerm::STERM] =
+            (1 - m_ewmaStAlpha) * slData.ewmaThp [t][EwmaTerm::STERM];
+          idle &= (slData.ewmaThp [t][EwmaTerm::LTERM] == 0
+                   && slData.ewmaThp [t][EwmaTerm::STERM] == 0);
         }
     }
+  slData.ewmaLast += ticks * period;
+}
 
-  // Scheduling the next EWMA update.
-  m_ewmaLastTime = Simulator::Now ();
-  Simulator::Schedule (m_ewmaTimeout, &LinkInfo::EwmaUpdate, this);
+void
+LinkInfo::UpdateBitRateCache (LinkDir dir)
+{
+  NS_LOG_FUNCTION (this << dir);
+
+  int64_t linkBitRate = GetLinkBitRate ();
+  for (int s = 0; s < N_SLICE_IDS_UNKN; s++)
+    {
+      SliceMetadata &slData = m_slices [dir][s];
+      slData.quoBitRate = linkBitRate * slData.quota / 100;
+      slData.maxBitRate = slData.quoBitRate + slData.extra;
+      slData.freBitRate = slData.quoBitRate - slData.reserved;
+      slData.unrBitRate = slData.maxBitRate - slData.reserved;
+    }
 }
 
 void
@@ -47,9 +47,9 @@ typedef std::set<Ptr<LinkInfo> > LinkInfoSet_t;
  * - The extra (over quota) bit rate, updated by the backhaul controller;
  * - The meter bit rate, updated by the backhaul controller;
  * - The reserved bit rate, updated by the backhaul controller;
- * - The transmitted bytes, updated by NotifyTxPacket method;
+ * - The transmitted bytes, updated by NotifyTxBytes method;
  * - The average throughput, for both short-term and long-term periods of
- *   evaluation, periodically updated by EwmaUpdate method;
+ *   evaluation, lazily updated by EwmaUpdate method on reads and writes;
  *
  * The figure below shows the relationship among link and slice bit rates:
  * \verbatim
@@ -72,7 +72,10 @@ typedef std::set<Ptr<LinkInfo> > LinkInfoSet_t;
 class LinkInfo : public Object
 {
   friend class BackhaulController;
+  friend class BackhaulPathsTestCase;
+  friend class MeshController;
   friend class RingController;
+  friend class LinkInfoEwmaTestCase;
 
 public:
   /** Link direction. */
@@ -196,6 +199,17 @@ public:
   int64_t GetResBitRate (
     LinkDir dir, SliceId slice = SliceId::ALL) const;
 
+  /**
+   * Get the free bit rate for this link on the given direction, optionally
+   * filtered by the network slice. This is the quota bit rate that is not
+   * reserved yet, kept up to date by quota and reservation updates.
+   * \param dir The link direction.
+   * \param slice The network slice.
+   * \return The free bit rate.
+   */
+  int64_t GetFreBitRate (
+    LinkDir dir, SliceId slice = SliceId::ALL) const;
+
   /**
    * Get the unreservedbit rate for this link on the given direction,
    * optionally filtered by the network slice.
@@ -337,6 +351,18 @@ private:
    */
   void NotifyTxPacket (std::string context, Ptr<const Packet> packet);
 
+  /**
+   * Notify this link of bytes transmitted in link channel on behalf of the
+   * given slice and traffic type. This is used both for packets and for fluid
+   * traffic injected by the backhaul controller without packets.
+   * \param dir The link direction.
+   * \param slice The network slice.
+   * \param type The traffic QoS type.
+   * \param bytes The number of transmitted bytes.
+   */
+  void NotifyTxBytes (LinkDir dir, SliceId slice, QosType type,
+                      uint64_t bytes);
+
   /**
    * Update the slice quota for this link on the given direction.
    * \param dir The link direction.
@@ -378,9 +404,24 @@ private:
     LinkDir dir, SliceId slice, int64_t bitRate);
 
   /**
-   * Update EWMA average statistics.
+   * Update EWMA average statistics for the given slice and direction. The
+   * averages are updated at the EwmaTimeout ticks elapsed since the last
+   * update, which are multiples of EwmaTimeout since the simulation start.
+   * This gives the same averages as a periodic update at each tick.
+   * \param dir The link direction.
+   * \param slice The network slice.
    */
-  void EwmaUpdate (void);
+  void EwmaUpdate (LinkDir dir, SliceId slice) const;
+
+  /**
+   * Update the cached quota, maximum, free and unreserved bit rates for all
+   * slices in the given link direction. This must be called whenever any
+   * slice quota or extra bit rate changes, keeping the admission control
+   * checks cheap. Reservations update the free and unreserved bit rates
+   * directly.
+   * \param dir The link direction.
+   */
+  void UpdateBitRateCache (LinkDir dir);
 
   /**
    * Register the link information in global map for further usage.
@@ -395,12 +436,19 @@ private:
     int64_t extra;                      //!< Extra (over quota) bit rate.
     int64_t meter;                      //!< OpenFlow meter bit rate.
     int64_t reserved;                   //!< Reserved bit rate.
+    int64_t quoBitRate;                 //!< Cached quota bit rate.
+    int64_t maxBitRate;                 //!< Cached maximum bit rate.
+    int64_t freBitRate;                 //!< Cached free bit rate.
+    int64_t unrBitRate;                 //!< Cached unreserved bit rate.
 
     /** EWMA throughput for both short-term and long-term averages. */
-    int64_t ewmaThp [N_QOS_TYPES_BOTH][N_EWMA_TERMS];
+    mutable int64_t ewmaThp [N_QOS_TYPES_BOTH][N_EWMA_TERMS];
 
     /** TX byte counters for each LTE QoS type. */
-    int64_t txBytes [N_QOS_TYPES_BOTH];
+    mutable int64_t txBytes [N_QOS_TYPES_BOTH];
+
+    /** Last EWMA update tick (in time steps). */
+    mutable int64_t ewmaLast;
   };
 
   Ptr<CsmaChannel>      m_channel;              //!< The CSMA link channel.
@@ -413,7 +461,6 @@ private:
   double                m_ewmaLtAlpha;          //!< EWMA long-term alpha.
   double                m_ewmaStAlpha;          //!< EWMA short-term alpha.
   Time                  m_ewmaTimeout;          //!< EWMA update timeout.
-  Time                  m_ewmaLastTime;         //!< Last EWMA update time.
 
   /** A pair of switch datapath IDs. */
   typedef std::pair<uint64_t, uint64_t> DpIdPair_t;
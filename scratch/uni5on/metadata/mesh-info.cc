@@ -0,0 +1,171 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <iomanip>
+#include <iostream>
+#include "mesh-info.h"
+#include "routing-info.h"
+
+using namespace std;
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MeshInfo");
+NS_OBJECT_ENSURE_REGISTERED (MeshInfo);
+
+MeshInfo::MeshInfo (Ptr<RoutingInfo> rInfo)
+  : m_rInfo (rInfo)
+{
+  NS_LOG_FUNCTION (this);
+
+  NS_ASSERT_MSG ((LteIface::S1 == 0 && LteIface::S5 == 1)
+                 || (LteIface::S5 == 0 && LteIface::S1 == 1),
+                 "Incompatible LteIface enum values.");
+
+  AggregateObject (rInfo);
+  m_downPath [LteIface::S1] = MeshInfo::UNDEF;
+  m_downPath [LteIface::S5] = MeshInfo::UNDEF;
+}
+
+MeshInfo::~MeshInfo ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+MeshInfo::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MeshInfo")
+    .SetParent<Object> ()
+  ;
+  return tid;
+}
+
+int
+MeshInfo::GetDlPath (LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << iface);
+
+  NS_ASSERT_MSG (iface == LteIface::S1 || iface == LteIface::S5,
+                 "Invalid LTE interface. Expected S1-U or S5 interface.");
+
+  return m_downPath [iface];
+}
+
+bool
+MeshInfo::IsLocalPath (LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << iface);
+
+  return (GetDlPath (iface) == MeshInfo::LOCAL);
+}
+
+bool
+MeshInfo::IsShortPath (LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << iface);
+
+  // The first path in the k-shortest list is the shortest one.
+  return (GetDlPath (iface) == 0 || IsLocalPath (iface));
+}
+
+bool
+MeshInfo::IsUndefPath (LteIface iface) const
+{
+  NS_LOG_FUNCTION (this << iface);
+
+  return (GetDlPath (iface) == MeshInfo::UNDEF);
+}
+
+Ptr<RoutingInfo>
+MeshInfo::GetRoutingInfo (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_rInfo;
+}
+
+std::string
+MeshInfo::MeshPathStr (int path)
+{
+  switch (path)
+    {
+    case MeshInfo::UNDEF:
+      return "undef";
+    case MeshInfo::LOCAL:
+      return "local";
+    default:
+      return "k" + std::to_string (path);
+    }
+}
+
+std::ostream &
+MeshInfo::PrintHeader (std::ostream &os)
+{
+  os << " " << setw (7) << "S1Shor"
+     << " " << setw (7) << "S1Path"
+     << " " << setw (7) << "S5Shor"
+     << " " << setw (7) << "S5Path";
+  return os;
+}
+
+void
+MeshInfo::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_rInfo = 0;
+  Object::DoDispose ();
+}
+
+void
+MeshInfo::SetDlPath (LteIface iface, int path)
+{
+  NS_LOG_FUNCTION (this << iface << path);
+
+  NS_ASSERT_MSG (path != MeshInfo::UNDEF, "Invalid mesh routing path.");
+  NS_ASSERT_MSG (iface == LteIface::S1 || iface == LteIface::S5,
+                 "Invalid LTE interface. Expected S1-U or S5 interface.");
+
+  m_downPath [iface] = path;
+}
+
+std::ostream & operator << (std::ostream &os, const MeshInfo &meshInfo)
+{
+  if (meshInfo.GetRoutingInfo ()->IsBlocked ())
+    {
+      os << " " << setw (7) << "-"
+         << " " << setw (7) << "-"
+         << " " << setw (7) << "-"
+         << " " << setw (7) << "-";
+    }
+  else
+    {
+      int s1Path = meshInfo.GetDlPath (LteIface::S1);
+      int s5Path = meshInfo.GetDlPath (LteIface::S5);
+      os << " " << setw (7) << meshInfo.IsShortPath (LteIface::S1)
+         << " " << setw (7) << MeshInfo::MeshPathStr (s1Path)
+         << " " << setw (7) << meshInfo.IsShortPath (LteIface::S5)
+         << " " << setw (7) << MeshInfo::MeshPathStr (s5Path);
+    }
+  return os;
+}
+
+} // namespace ns3
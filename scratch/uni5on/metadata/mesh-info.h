@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef MESH_INFO_H
+#define MESH_INFO_H
+
+#include <ns3/core-module.h>
+#include "../uni5on-common.h"
+
+namespace ns3 {
+
+class RoutingInfo;
+
+/**
+ * \ingroup uni5onMeta
+ * Metadata associated to the routing path for a single EPS bearer among the
+ * switches in the OpenFlow mesh backhaul network. The routing path is
+ * identified by its index in the list of k-shortest paths between the source
+ * and destination switches, as computed by the MeshController.
+ */
+class MeshInfo : public Object
+{
+  friend class MeshController;
+
+public:
+  /** Special values for the routing path index. */
+  enum MeshPath
+  {
+    UNDEF = -1,   //!< Undefined routing.
+    LOCAL = -2    //!< Local routing.
+  };
+
+  /**
+   * Complete constructor.
+   * \param rInfo RoutingInfo pointer.
+   */
+  MeshInfo (Ptr<RoutingInfo> rInfo);
+  virtual ~MeshInfo (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \name Private member accessors for bearer mesh routing information.
+   * The uplink path is always the same as the downlink path, but traversed
+   * in the inverted direction.
+   * \param iface The LTE logical interface.
+   * \return The requested information.
+   */
+  //\{
+  int           GetDlPath     (LteIface iface) const;
+  bool          IsLocalPath   (LteIface iface) const;
+  bool          IsShortPath   (LteIface iface) const;
+  bool          IsUndefPath   (LteIface iface) const;
+  //\}
+
+  /**
+   * Get the bearer routing information aggregated to this object.
+   * \return The routing information.
+   */
+  Ptr<RoutingInfo> GetRoutingInfo (void) const;
+
+  /**
+   * Get the string representing the routing path.
+   * \param path The routing path index.
+   * \return The routing path string.
+   */
+  static std::string MeshPathStr (int path);
+
+  /**
+   * Get the header for the print operator <<.
+   * \param os The output stream.
+   * \return The output stream.
+   * \internal Keep this method consistent with the << operator below.
+   */
+  static std::ostream & PrintHeader (std::ostream &os);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+private:
+  /**
+   * Set the downlink routing path index for the given interface.
+   * \param iface The LTE logical interface for this path.
+   * \param path The downlink path index.
+   */
+  void SetDlPath (LteIface iface, int path);
+
+  int              m_downPath [2];  //!< Downlink routing path index.
+  Ptr<RoutingInfo> m_rInfo;         //!< Routing metadata.
+};
+
+/**
+ * Print the mesh routing metadata on an output stream.
+ * \param os The output stream.
+ * \param meshInfo The MeshInfo object.
+ * \returns The output stream.
+ * \internal Keep this method consistent with the MeshInfo::PrintHeader ().
+ */
+std::ostream & operator << (std::ostream &os, const MeshInfo &meshInfo);
+
+} // namespace ns3
+#endif // MESH_INFO_H
@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <iostream>
 #include "pgw-info.h"
+#include "../logical/pgw-tunnel-app.h"
 #include "../logical/slice-controller.h"
 
 using namespace std;
@@ -334,6 +335,30 @@ PgwInfo::GetTftAvgCpuMax (void) const
   return DataRate (value / GetCurTfts ());
 }
 
+double
+PgwInfo::GetTftAvgFlowCacheHit (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  double value = 0.0;
+  for (uint16_t idx = 1; idx <= GetCurTfts (); idx++)
+    {
+      value += GetTunnelApp (idx)->GetFlowCacheHitRatio ();
+    }
+  return value / GetCurTfts ();
+}
+
+void
+PgwInfo::ResetTftFlowCacheStats (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  for (uint16_t idx = 1; idx <= GetMaxTfts (); idx++)
+    {
+      GetTunnelApp (idx)->ResetFlowCacheStats ();
+    }
+}
+
 double
 PgwInfo::GetTftAvgEwmaCpuUse (void) const
 {
@@ -463,6 +488,24 @@ PgwInfo::GetStats (uint16_t idx) const
   return stats;
 }
 
+Ptr<PgwTunnelApp>
+PgwInfo::GetTunnelApp (uint16_t idx) const
+{
+  NS_LOG_FUNCTION (this << idx);
+
+  Ptr<Node> node = m_devices.Get (idx)->GetNode ();
+  for (uint32_t i = 0; i < node->GetNApplications (); i++)
+    {
+      Ptr<PgwTunnelApp> app = DynamicCast<PgwTunnelApp> (
+          node->GetApplication (i));
+      if (app)
+        {
+          return app;
+        }
+    }
+  NS_ABORT_MSG ("No P-GW tunnel application on this switch.");
+}
+
 void
 PgwInfo::SaveSwitchInfo (Ptr<OFSwitch13Device> device, Ipv4Address s5Addr,
                          uint32_t s5PortNo, uint32_t infraSwS5PortNo,
@@ -30,6 +30,7 @@
 
 namespace ns3 {
 
+class PgwTunnelApp;
 class SliceController;
 
 /**
@@ -139,6 +140,7 @@ public:
   DataRate      GetTftAvgEwmaCpuCur     (void) const;
   double        GetTftAvgEwmaCpuUse     (void) const;
   DataRate      GetTftAvgCpuMax         (void) const;
+  double        GetTftAvgFlowCacheHit   (void) const;
   uint32_t      GetTftMaxFlowTableCur   (uint8_t tableId = 0) const;
   uint32_t      GetTftMaxFlowTableMax   (uint8_t tableId = 0) const;
   double        GetTftMaxFlowTableUse   (uint8_t tableId = 0) const;
@@ -147,6 +149,12 @@ public:
   DataRate      GetTftMaxCpuMax         (void) const;
   //\}
 
+  /**
+   * Reset the microflow cache counters of all P-GW TFT switches, so the
+   * cache hit ratio is computed over each statistics interval.
+   */
+  void ResetTftFlowCacheStats (void) const;
+
   /**
    * Get the header for the print operator <<.
    * \param os The output stream.
@@ -175,6 +183,13 @@ private:
    */
   Ptr<OFSwitch13StatsCalculator> GetStats (uint16_t idx) const;
 
+  /**
+   * Get the P-GW tunnel application installed on the switch node.
+   * \param idx The internal switch index.
+   * \return The P-GW tunnel application.
+   */
+  Ptr<PgwTunnelApp> GetTunnelApp (uint16_t idx) const;
+
   /**
    * Save the metadata associated to a single P-GW OpenFlow switch attached to
    * the OpenFlow backhaul network.
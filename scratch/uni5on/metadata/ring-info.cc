@@ -182,39 +182,16 @@ RingInfo::DoDispose ()
 }
 
 void
-RingInfo::SetShortDlPath (LteIface iface, RingPath path)
+RingInfo::SetDlPath (LteIface iface, RingPath path, bool isShort)
 {
-  NS_LOG_FUNCTION (this << iface << path);
+  NS_LOG_FUNCTION (this << iface << path << isShort);
 
   NS_ASSERT_MSG (path != RingInfo::UNDEF, "Invalid ring routing path.");
   NS_ASSERT_MSG (iface == LteIface::S1 || iface == LteIface::S5,
                  "Invalid LTE interface. Expected S1-U or S5 interface.");
 
   m_downPath [iface] = path;
-  m_shortPath [iface] = true;
-}
-
-void
-RingInfo::InvertPath (LteIface iface)
-{
-  NS_LOG_FUNCTION (this << iface);
-
-  if (!IsLocalPath (iface) && !IsUndefPath (iface))
-    {
-      m_downPath [iface] = RingInfo::InvertPath (m_downPath [iface]);
-      m_shortPath [iface] = !m_shortPath [iface];
-    }
-}
-
-void
-RingInfo::ResetPath (LteIface iface)
-{
-  NS_LOG_FUNCTION (this << iface);
-
-  if (!IsShortPath (iface))
-    {
-      InvertPath (iface);
-    }
+  m_shortPath [iface] = isShort;
 }
 
 std::ostream & operator << (std::ostream &os, const RingInfo &ringInfo)
@@ -116,24 +116,13 @@ protected:
 
 private:
   /**
-   * Set the downlink shortest routing path for the given interface.
+   * Set the downlink routing path for the given interface.
    * The uplink path will always be the same, but with inverted direction.
    * \param iface The LTE logical interface for this path.
    * \param path The downlink path.
+   * \param isShort True for the short downlink path.
    */
-  void SetShortDlPath (LteIface iface, RingPath path);
-
-  /**
-   * Invert the interface routing path.
-   * \param iface The LTE logical interface.
-   */
-  void InvertPath (LteIface iface);
-
-  /**
-   * Reset the interface routing path to the shortest one.
-   * \param iface The LTE logical interface.
-   */
-  void ResetPath (LteIface iface);
+  void SetDlPath (LteIface iface, RingPath path, bool isShort);
 
   RingPath         m_downPath [2];  //!< Downlink routing path.
   bool             m_shortPath [2]; //!< True for short downlink routing path.
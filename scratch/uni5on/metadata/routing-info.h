@@ -42,6 +42,9 @@ typedef std::vector<Ptr<RoutingInfo> > RoutingInfoList_t;
 class RoutingInfo : public Object
 {
   friend class BackhaulController;
+  friend class ControllerBenchmark;
+  friend class MeshController;
+  friend class ProgressReporter;
   friend class RingController;
   friend class SliceController;
   friend class TrafficManager;
@@ -37,6 +37,7 @@ NS_OBJECT_ENSURE_REGISTERED (UeInfo);
 // Initializing UeInfo static members.
 UeInfo::ImsiUeInfoMap_t UeInfo::m_ueInfoByImsi;
 UeInfo::Ipv4UeInfoMap_t UeInfo::m_ueInfoByAddr;
+uint32_t UeInfo::m_classifierVersion = 0;
 
 UeInfo::UeInfo (uint64_t imsi, Ipv4Address addr,
                 Ptr<SliceController> sliceCtrl)
@@ -272,6 +273,14 @@ UeInfo::GetPointer (Ipv4Address addr)
   return ueInfo;
 }
 
+uint32_t
+UeInfo::GetClassifierVersion (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  return UeInfo::m_classifierVersion;
+}
+
 std::ostream &
 UeInfo::PrintHeader (std::ostream &os)
 {
@@ -362,7 +371,7 @@ UeInfo::AddRoutingInfo (Ptr<RoutingInfo> rInfo)
 
   // Add TFT to the classifier.
   m_tftClassifier.Add (rInfo->GetTft (), rInfo->GetTeid ());
-
+  m_classifierVersion++;
 }
 
 uint32_t
@@ -56,6 +56,7 @@ class UeInfo : public Object
   friend class ScenarioHelper;
   friend class Uni5onMme;
   friend class BackhaulStatsCalculator;
+  friend class ControllerBenchmark;
   friend class TrafficStatsCalculator;
 
 public:
@@ -142,6 +143,14 @@ public:
    */
   static Ptr<UeInfo> GetPointer (Ipv4Address addr);
 
+  /**
+   * Get the version of the TFT classifiers, which is incremented every time
+   * a TFT is added to the classifier of any UE. This can be used to
+   * invalidate cached classification results.
+   * \return The TFT classifiers version.
+   */
+  static uint32_t GetClassifierVersion (void);
+
   /**
    * Get the header for the print operator <<.
    * \param os The output stream.
@@ -226,6 +235,8 @@ private:
   /** Map saving UE IPv4 / UE information. */
   typedef std::map<Ipv4Address, Ptr<UeInfo> > Ipv4UeInfoMap_t;
   static Ipv4UeInfoMap_t  m_ueInfoByAddr;   //!< Global UE info map by IPv4.
+
+  static uint32_t         m_classifierVersion; //!< TFT classifiers version.
 };
 
 /**
@@ -21,6 +21,8 @@
 #include <iomanip>
 #include <iostream>
 #include "admission-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
+#include "../metadata/mesh-info.h"
 #include "../metadata/ring-info.h"
 #include "../metadata/routing-info.h"
 #include "../metadata/ue-info.h"
@@ -85,7 +87,9 @@ AdmissionStatsCalculator::NotifyBearerRequest (Ptr<const RoutingInfo> rInfo)
 
   Ptr<const UeInfo> ueInfo = rInfo->GetUeInfo ();
   Ptr<const RingInfo> ringInfo = rInfo->GetObject<RingInfo> ();
-  NS_ASSERT_MSG (ringInfo, "No ring information for this routing info.");
+  Ptr<const MeshInfo> meshInfo = rInfo->GetObject<MeshInfo> ();
+  NS_ASSERT_MSG (ringInfo || meshInfo,
+                 "No backhaul information for this routing info.");
 
   // Update the slice stats.
   SliceMetadata &slData = m_slices [rInfo->GetSliceId ()];
@@ -125,9 +129,16 @@ AdmissionStatsCalculator::NotifyBearerRequest (Ptr<const RoutingInfo> rInfo)
     << *(rInfo->GetUeInfo ())
     << *(rInfo->GetUeInfo ()->GetEnbInfo ())
     << *(rInfo->GetUeInfo ()->GetSgwInfo ())
-    << *(rInfo->GetUeInfo ()->GetPgwInfo ())
-    << *ringInfo
-    << std::endl;
+    << *(rInfo->GetUeInfo ()->GetPgwInfo ());
+  if (ringInfo)
+    {
+      *m_brqWrapper->GetStream () << *ringInfo;
+    }
+  else
+    {
+      *m_brqWrapper->GetStream () << *meshInfo;
+    }
+  *m_brqWrapper->GetStream () << std::endl;
 }
 
 void
@@ -179,14 +190,14 @@ AdmissionStatsCalculator::NotifyConstructionCompleted (void)
   SetAttribute ("AdmStatsFilename", StringValue (prefix + m_admFilename));
   SetAttribute ("BrqStatsFilename", StringValue (prefix + m_brqFilename));
 
-  for (int s = 0; s < N_SLICE_IDS_ALL; s++)
+  for (SliceId slice : GetSliceIds (true))
     {
-      std::string sliceStr = SliceIdStr (static_cast<SliceId> (s));
-      SliceMetadata &slData = m_slices [s];
+      std::string sliceStr = SliceIdStr (slice);
+      SliceMetadata &slData = m_slices [slice];
 
       // Create the output file for this slice.
-      slData.admWrapper = Create<OutputStreamWrapper> (
-          m_admFilename + "-" + sliceStr + ".log", std::ios::out);
+      slData.admWrapper = AsyncOutputWriter::CreateStream (
+          m_admFilename + "-" + sliceStr + ".log");
 
       // Print the header in output file.
       *slData.admWrapper->GetStream ()
@@ -204,8 +215,8 @@ AdmissionStatsCalculator::NotifyConstructionCompleted (void)
     }
 
   // Create the output file for bearer requests.
-  m_brqWrapper = Create<OutputStreamWrapper> (
-      m_brqFilename + ".log", std::ios::out);
+  m_brqWrapper = AsyncOutputWriter::CreateStream (
+      m_brqFilename + ".log");
 
   // Print the header in output file.
   *m_brqWrapper->GetStream ()
@@ -216,6 +227,7 @@ AdmissionStatsCalculator::NotifyConstructionCompleted (void)
   EnbInfo::PrintHeader (*m_brqWrapper->GetStream ());
   SgwInfo::PrintHeader (*m_brqWrapper->GetStream ());
   PgwInfo::PrintHeader (*m_brqWrapper->GetStream ());
+  // The RingInfo and MeshInfo share the same columns.
   RingInfo::PrintHeader (*m_brqWrapper->GetStream ());
   *m_brqWrapper->GetStream () << std::endl;
 
@@ -234,9 +246,9 @@ AdmissionStatsCalculator::DumpStatistics (Time nextDump)
   NS_LOG_FUNCTION (this);
 
   // Iterate over all slices dumping statistics.
-  for (int s = 0; s < N_SLICE_IDS_ALL; s++)
+  for (SliceId slice : GetSliceIds (true))
     {
-      SliceMetadata &slData = m_slices [s];
+      SliceMetadata &slData = m_slices [slice];
       *slData.admWrapper->GetStream ()
         << " " << setw (8) << Simulator::Now ().GetSeconds ()
         << " " << setw (7) << slData.releases
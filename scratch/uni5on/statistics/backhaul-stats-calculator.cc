@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <iostream>
 #include "backhaul-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
 #include "../metadata/ue-info.h"
 #include "../metadata/routing-info.h"
 
@@ -39,28 +40,28 @@ BackhaulStatsCalculator::BackhaulStatsCalculator ()
   memset (m_slices, 0, sizeof (SliceMetadata) * N_SLICE_IDS_ALL);
 
   // Connect this stats calculator to required trace sources.
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onEnbApplication/S1uRx",
     MakeCallback (&BackhaulStatsCalculator::EpcOutputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onEnbApplication/S1uTx",
     MakeCallback (&BackhaulStatsCalculator::EpcInputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::PgwTunnelApp/S5Rx",
     MakeCallback (&BackhaulStatsCalculator::EpcOutputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::PgwTunnelApp/S5Tx",
     MakeCallback (&BackhaulStatsCalculator::EpcInputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/OverloadDrop",
     MakeCallback (&BackhaulStatsCalculator::OverloadDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/MeterDrop",
     MakeCallback (&BackhaulStatsCalculator::MeterDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/TableDrop",
     MakeCallback (&BackhaulStatsCalculator::TableDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/PortList/*/PortQueue/Drop",
     MakeCallback (&BackhaulStatsCalculator::QueueDropPacket, this));
 }
@@ -124,10 +125,10 @@ BackhaulStatsCalculator::NotifyConstructionCompleted (void)
   SetAttribute ("BwdStatsFilename", StringValue (prefix + m_bwdFilename));
   SetAttribute ("TffStatsFilename", StringValue (prefix + m_tffFilename));
 
-  for (int s = 0; s < N_SLICE_IDS_ALL; s++)
+  for (SliceId slice : GetSliceIds (true))
     {
-      std::string sliceStr = SliceIdStr (static_cast<SliceId> (s));
-      SliceMetadata &slData = m_slices [s];
+      std::string sliceStr = SliceIdStr (slice);
+      SliceMetadata &slData = m_slices [slice];
       for (int d = 0; d < N_DIRECTIONS; d++)
         {
           for (int t = 0; t < N_QOS_TYPES; t++)
@@ -139,10 +140,10 @@ BackhaulStatsCalculator::NotifyConstructionCompleted (void)
         }
 
       // Create the output files for this slice.
-      slData.bwdWrapper = Create<OutputStreamWrapper> (
-          m_bwdFilename + "-" + sliceStr + ".log", std::ios::out);
-      slData.tffWrapper = Create<OutputStreamWrapper> (
-          m_tffFilename + "-" + sliceStr + ".log", std::ios::out);
+      slData.bwdWrapper = AsyncOutputWriter::CreateStream (
+          m_bwdFilename + "-" + sliceStr + ".log");
+      slData.tffWrapper = AsyncOutputWriter::CreateStream (
+          m_tffFilename + "-" + sliceStr + ".log");
 
       // Print the headers in output files.
       *slData.bwdWrapper->GetStream ()
@@ -175,10 +176,9 @@ BackhaulStatsCalculator::DumpStatistics (Time nextDump)
   NS_LOG_FUNCTION (this);
 
   // Dump statistics for each network slice.
-  for (int s = 0; s < N_SLICE_IDS_ALL; s++)
+  for (SliceId slice : GetSliceIds (true))
     {
-      SliceId slice = static_cast<SliceId> (s);
-      SliceMetadata &slData = m_slices [s];
+      SliceMetadata &slData = m_slices [slice];
 
       // Dump slice bandwidth usage for each link.
       for (auto const &lInfo : LinkInfo::GetList ())
@@ -222,10 +222,10 @@ BackhaulStatsCalculator::DumpStatistics (Time nextDump)
 }
 
 void
-BackhaulStatsCalculator::OverloadDropPacket (std::string context,
+BackhaulStatsCalculator::OverloadDropPacket (uint32_t context,
                                              Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> sliStats;
@@ -269,9 +269,10 @@ BackhaulStatsCalculator::OverloadDropPacket (std::string context,
 
 void
 BackhaulStatsCalculator::MeterDropPacket (
-  std::string context, Ptr<const Packet> packet, uint32_t meterId)
+  uint32_t context, Ptr<const Packet> packet, uint32_t meterId)
 {
-  NS_LOG_FUNCTION (this << context << packet << meterId);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   packet << meterId);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> sliStats;
@@ -323,10 +324,10 @@ BackhaulStatsCalculator::MeterDropPacket (
 }
 
 void
-BackhaulStatsCalculator::QueueDropPacket (std::string context,
+BackhaulStatsCalculator::QueueDropPacket (uint32_t context,
                                           Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> sliStats;
@@ -370,9 +371,9 @@ BackhaulStatsCalculator::QueueDropPacket (std::string context,
 
 void
 BackhaulStatsCalculator::TableDropPacket (
-  std::string context, Ptr<const Packet> packet, uint8_t tableId)
+  uint32_t context, Ptr<const Packet> packet, uint8_t tableId)
 {
-  NS_LOG_FUNCTION (this << context << packet <<
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet <<
                    static_cast<uint16_t> (tableId));
 
   EpcGtpuTag gtpuTag;
@@ -416,10 +417,10 @@ BackhaulStatsCalculator::TableDropPacket (
 }
 
 void
-BackhaulStatsCalculator::EpcInputPacket (std::string context,
+BackhaulStatsCalculator::EpcInputPacket (uint32_t context,
                                          Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> sliStats;
@@ -439,10 +440,10 @@ BackhaulStatsCalculator::EpcInputPacket (std::string context,
 }
 
 void
-BackhaulStatsCalculator::EpcOutputPacket (std::string context,
+BackhaulStatsCalculator::EpcOutputPacket (uint32_t context,
                                           Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> sliStats;
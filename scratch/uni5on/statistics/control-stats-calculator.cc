@@ -0,0 +1,227 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include "control-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
+
+using namespace std;
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ControlStatsCalculator");
+NS_OBJECT_ENSURE_REGISTERED (ControlStatsCalculator);
+
+ControlStatsCalculator::ControlStatsCalculator ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // Connect this stats calculator to required trace sources.
+  Config::ConnectWithoutContext (
+    "/NodeList/*/ApplicationList/*/$ns3::BackhaulController/MsgTx",
+    MakeCallback (&ControlStatsCalculator::NotifyMsgTx, this));
+  Config::ConnectWithoutContext (
+    "/NodeList/*/ApplicationList/*/$ns3::BackhaulController/MsgRx",
+    MakeCallback (&ControlStatsCalculator::NotifyMsgRx, this));
+  Config::ConnectWithoutContext (
+    "/NodeList/*/ApplicationList/*/$ns3::SliceController/MsgTx",
+    MakeCallback (&ControlStatsCalculator::NotifyMsgTx, this));
+  Config::ConnectWithoutContext (
+    "/NodeList/*/ApplicationList/*/$ns3::SliceController/MsgRx",
+    MakeCallback (&ControlStatsCalculator::NotifyMsgRx, this));
+}
+
+ControlStatsCalculator::~ControlStatsCalculator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+ControlStatsCalculator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ControlStatsCalculator")
+    .SetParent<Object> ()
+    .AddConstructor<ControlStatsCalculator> ()
+    .AddAttribute ("CtrStatsFilename",
+                   "Filename for OpenFlow control messages statistics.",
+                   StringValue ("control-messages"),
+                   MakeStringAccessor (
+                     &ControlStatsCalculator::m_ctrFilename),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+void
+ControlStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_ctrWrapper = 0;
+  m_txMessages.clear ();
+  m_rxMessages.clear ();
+  Object::DoDispose ();
+}
+
+void
+ControlStatsCalculator::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  StringValue stringValue;
+  GlobalValue::GetValueByName ("OutputPrefix", stringValue);
+  std::string prefix = stringValue.Get ();
+  SetAttribute ("CtrStatsFilename", StringValue (prefix + m_ctrFilename));
+
+  // Create the output file for control messages.
+  m_ctrWrapper = AsyncOutputWriter::CreateStream (
+      m_ctrFilename + ".log");
+
+  // Print the header in output file.
+  *m_ctrWrapper->GetStream ()
+    << boolalpha << right << fixed << setprecision (3)
+    << " " << setw (8)  << "TimeSec"
+    << " " << setw (4)  << "Dir"
+    << " " << setw (6)  << "DpId"
+    << " " << setw (12) << "Type"
+    << " " << setw (8)  << "Count"
+    << " " << setw (10) << "Length"
+    << " " << setw (9)  << "AvgUs"
+    << " " << setw (9)  << "P50Us"
+    << " " << setw (9)  << "P99Us"
+    << " " << setw (9)  << "MaxUs"
+    << std::endl;
+
+  TimeValue timeValue;
+  GlobalValue::GetValueByName ("DumpStatsTimeout", timeValue);
+  Time firstDump = timeValue.Get ();
+  Simulator::Schedule (firstDump, &ControlStatsCalculator::DumpStatistics,
+                       this, firstDump);
+
+  Object::NotifyConstructionCompleted ();
+}
+
+void
+ControlStatsCalculator::NotifyMsgTx (uint64_t dpId, std::string type,
+                                     uint32_t length, int64_t wallNs)
+{
+  NS_LOG_FUNCTION (this << dpId << type << length << wallNs);
+
+  UpdateCounters (m_txMessages [std::make_pair (dpId, type)], length, wallNs);
+}
+
+void
+ControlStatsCalculator::NotifyMsgRx (uint64_t dpId, std::string type,
+                                     uint32_t length, int64_t wallNs)
+{
+  NS_LOG_FUNCTION (this << dpId << type << length << wallNs);
+
+  UpdateCounters (m_rxMessages [std::make_pair (dpId, type)], length, wallNs);
+}
+
+void
+ControlStatsCalculator::UpdateCounters (MessageMetadata &msgData,
+                                        uint32_t length, int64_t wallNs)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  // New map entries are value-initialized, so all counters start at zero.
+  msgData.count++;
+  msgData.length += length;
+  msgData.sumNs += wallNs;
+  msgData.maxNs = std::max (msgData.maxNs, wallNs);
+
+  // Bucket b holds handling times in the interval [2^b, 2^(b+1)) ns.
+  int bucket = 0;
+  while (bucket < N_TIME_BUCKETS - 1 && (wallNs >> (bucket + 1)) > 0)
+    {
+      bucket++;
+    }
+  msgData.buckets [bucket]++;
+}
+
+double
+ControlStatsCalculator::GetPercentileUs (const MessageMetadata &msgData,
+                                         double pct)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  uint64_t target = std::ceil (msgData.count * pct);
+  uint64_t accum = 0;
+  for (int b = 0; b < N_TIME_BUCKETS; b++)
+    {
+      accum += msgData.buckets [b];
+      if (accum >= target)
+        {
+          return static_cast<double> (UINT64_C (1) << (b + 1)) / 1000;
+        }
+    }
+  return static_cast<double> (msgData.maxNs) / 1000;
+}
+
+void
+ControlStatsCalculator::DumpStatistics (Time nextDump)
+{
+  NS_LOG_FUNCTION (this);
+
+  DumpMessages (m_txMessages, "tx");
+  DumpMessages (m_rxMessages, "rx");
+
+  Simulator::Schedule (nextDump, &ControlStatsCalculator::DumpStatistics,
+                       this, nextDump);
+}
+
+void
+ControlStatsCalculator::DumpMessages (MessageMap_t &messages,
+                                      std::string dirStr)
+{
+  NS_LOG_FUNCTION (this << dirStr);
+
+  for (auto &it : messages)
+    {
+      MessageMetadata &msgData = it.second;
+      if (msgData.count == 0)
+        {
+          continue;
+        }
+
+      double avgNs = static_cast<double> (msgData.sumNs) / msgData.count;
+      *m_ctrWrapper->GetStream ()
+        << " " << setw (8)  << Simulator::Now ().GetSeconds ()
+        << " " << setw (4)  << dirStr
+        << " " << setw (6)  << it.first.first
+        << " " << setw (12) << it.first.second
+        << " " << setw (8)  << msgData.count
+        << " " << setw (10) << msgData.length
+        << " " << setw (9)  << avgNs / 1000
+        << " " << setw (9)  << GetPercentileUs (msgData, 0.50)
+        << " " << setw (9)  << GetPercentileUs (msgData, 0.99)
+        << " " << setw (9)  << static_cast<double> (msgData.maxNs) / 1000
+        << std::endl;
+
+      // Reset the counters but keep the entry, as the same switch will
+      // likely exchange the same message types in the next interval.
+      memset (&msgData, 0, sizeof (MessageMetadata));
+    }
+}
+
+} // Namespace ns3
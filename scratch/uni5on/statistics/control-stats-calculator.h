@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef CONTROL_STATS_CALCULATOR_H
+#define CONTROL_STATS_CALCULATOR_H
+
+#include <map>
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include "../uni5on-common.h"
+
+// Number of log2 buckets in the message handling time histogram.
+#define N_TIME_BUCKETS 32
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onStats
+ * This class monitors the OpenFlow messages exchanged between the backhaul
+ * and slice controllers and the OpenFlow switches, and dump per-switch and
+ * per-message type counters, lengths and wall-clock handling time statistics.
+ * Only the dpctl commands issued by uni5on controllers and the error,
+ * flow-removed and packet-in messages are monitored. The length of sent
+ * messages is the dpctl command text length, not the OpenFlow message size.
+ */
+class ControlStatsCalculator : public Object
+{
+public:
+  ControlStatsCalculator ();          //!< Default constructor.
+  virtual ~ControlStatsCalculator (); //!< Dummy destructor, see DoDispose.
+
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+protected:
+  /** Destructor implementation. */
+  virtual void DoDispose ();
+
+  // Inherited from ObjectBase.
+  virtual void NotifyConstructionCompleted (void);
+
+private:
+  /** Metadata associated to a switch and message type. */
+  struct MessageMetadata
+  {
+    uint64_t count;                       //!< Number of messages.
+    uint64_t length;                      //!< Total message length.
+    int64_t  sumNs;                       //!< Total handling time.
+    int64_t  maxNs;                       //!< Maximum handling time.
+    uint32_t buckets [N_TIME_BUCKETS];    //!< Handling time histogram.
+  };
+
+  /** A pair of switch datapath ID and message type. */
+  typedef std::pair<uint64_t, std::string> MessageKey_t;
+
+  /** A map saving message key / message metadata. */
+  typedef std::map<MessageKey_t, MessageMetadata> MessageMap_t;
+
+  /**
+   * Notify a new OpenFlow message sent to a switch.
+   * \param dpId The OpenFlow datapath ID.
+   * \param type The message type.
+   * \param length The message length.
+   * \param wallNs The wall-clock time spent handling the message.
+   */
+  void NotifyMsgTx (uint64_t dpId, std::string type, uint32_t length,
+                    int64_t wallNs);
+
+  /**
+   * Notify a new OpenFlow message received from a switch.
+   * \param dpId The OpenFlow datapath ID.
+   * \param type The message type.
+   * \param length The message length.
+   * \param wallNs The wall-clock time spent handling the message.
+   */
+  void NotifyMsgRx (uint64_t dpId, std::string type, uint32_t length,
+                    int64_t wallNs);
+
+  /**
+   * Account for a new message in the given metadata.
+   * \param msgData The message metadata to update.
+   * \param length The message length.
+   * \param wallNs The wall-clock time spent handling the message.
+   */
+  static void UpdateCounters (MessageMetadata &msgData, uint32_t length,
+                              int64_t wallNs);
+
+  /**
+   * Get the approximated percentile of the handling time histogram.
+   * \param msgData The message metadata.
+   * \param pct The percentile in the interval [0, 1].
+   * \return The upper bound of the percentile bucket in microseconds.
+   */
+  static double GetPercentileUs (const MessageMetadata &msgData, double pct);
+
+  /**
+   * Dump statistics into file.
+   * \param nextDump The interval before next dump.
+   */
+  void DumpStatistics (Time nextDump);
+
+  /**
+   * Dump statistics for the given message map and reset its counters.
+   * \param messages The message map.
+   * \param dirStr The message direction string.
+   */
+  void DumpMessages (MessageMap_t &messages, std::string dirStr);
+
+  MessageMap_t             m_txMessages;    //!< Messages sent.
+  MessageMap_t             m_rxMessages;    //!< Messages received.
+  std::string              m_ctrFilename;   //!< CtrStats filename.
+  Ptr<OutputStreamWrapper> m_ctrWrapper;    //!< CtrStats file wrapper.
+};
+
+} // namespace ns3
+#endif /* CONTROL_STATS_CALCULATOR_H */
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <ns3/mobility-model.h>
 #include "lte-rrc-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
 #include "../uni5on-common.h"
 #include "../metadata/enb-info.h"
 #include "../metadata/ue-info.h"
@@ -40,69 +41,69 @@ LteRrcStatsCalculator::LteRrcStatsCalculator ()
   NS_LOG_FUNCTION (this);
 
   // Connect this stats calculator to required trace sources.
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::MobilityModel/CourseChange",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeMobilityCourseChange, this));
 
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyHandoverStart, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyHandoverEndOk, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyHandoverStart, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyHandoverEndOk, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndError",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyHandoverEndError, this));
 
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyEnbNewUeContext, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionEstablished",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyConnectionEstablished, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyConnectionReconfiguration, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/ConnectionEstablished",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyConnectionEstablished, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyConnectionReconfiguration, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/ConnectionTimeout",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeConnectionTimeout, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/InitialCellSelectionEndOk",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndOk, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/InitialCellSelectionEndError",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndError, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeRandomAccessSuccessful, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessError",
     MakeCallback (
       &LteRrcStatsCalculator::NotifyUeRandomAccessError, this));
@@ -164,8 +165,8 @@ LteRrcStatsCalculator::NotifyConstructionCompleted (void)
   SetAttribute ("MobStatsFilename", StringValue (prefix + m_mobFilename));
   SetAttribute ("RrcStatsFilename", StringValue (prefix + m_rrcFilename));
 
-  m_hvoWrapper = Create<OutputStreamWrapper> (
-      m_hvoFilename + ".log", std::ios::out);
+  m_hvoWrapper = AsyncOutputWriter::CreateStream (
+      m_hvoFilename + ".log");
   *m_hvoWrapper->GetStream ()
     << boolalpha << right << fixed << setprecision (3)
     << " " << setw (8)  << "TimeSec"
@@ -182,8 +183,8 @@ LteRrcStatsCalculator::NotifyConstructionCompleted (void)
   PgwInfo::PrintHeader (*m_hvoWrapper->GetStream ());
   *m_hvoWrapper->GetStream () << std::endl;
 
-  m_mobWrapper = Create<OutputStreamWrapper> (
-      m_mobFilename + ".log", std::ios::out);
+  m_mobWrapper = AsyncOutputWriter::CreateStream (
+      m_mobFilename + ".log");
   *m_mobWrapper->GetStream ()
     << boolalpha << right << fixed << setprecision (3)
     << " " << setw (8)  << "TimeSec"
@@ -197,8 +198,8 @@ LteRrcStatsCalculator::NotifyConstructionCompleted (void)
     << " " << setw (9)  << "VelZ"
     << std::endl;
 
-  m_rrcWrapper = Create<OutputStreamWrapper> (
-      m_rrcFilename + ".log", std::ios::out);
+  m_rrcWrapper = AsyncOutputWriter::CreateStream (
+      m_rrcFilename + ".log");
   *m_rrcWrapper->GetStream ()
     << boolalpha << right << fixed << setprecision (3)
     << " " << setw (8)  << "TimeSec"
@@ -216,9 +217,9 @@ LteRrcStatsCalculator::NotifyConstructionCompleted (void)
 
 void
 LteRrcStatsCalculator::NotifyUeMobilityCourseChange (
-  std::string context, Ptr<const MobilityModel> mobility)
+  uint32_t context, Ptr<const MobilityModel> mobility)
 {
-  NS_LOG_FUNCTION (this << context << mobility);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << mobility);
 
   Ptr<Node> node = mobility->GetObject<Node> ();
   Vector position = mobility->GetPosition ();
@@ -239,9 +240,10 @@ LteRrcStatsCalculator::NotifyUeMobilityCourseChange (
 
 void
 LteRrcStatsCalculator::NotifyHandoverEndError (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
   NS_ASSERT_MSG (ueInfo, "Invalid UE info.");
@@ -252,7 +254,7 @@ LteRrcStatsCalculator::NotifyHandoverEndError (
   NS_ASSERT_MSG (srcEnbInfo, "Invalid eNB info.");
 
   std::string node = "UE";
-  if (context.find ("LteEnbRrc") != std::string::npos)
+  if (Config::GetContextName (context).find ("LteEnbRrc") != std::string::npos)
     {
       node = "eNB";
     }
@@ -274,9 +276,10 @@ LteRrcStatsCalculator::NotifyHandoverEndError (
 
 void
 LteRrcStatsCalculator::NotifyHandoverEndOk (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
   NS_ASSERT_MSG (ueInfo, "Invalid UE info.");
@@ -287,7 +290,7 @@ LteRrcStatsCalculator::NotifyHandoverEndOk (
   NS_ASSERT_MSG (dstEnbInfo, "Invalid eNB info.");
 
   std::string node = "UE";
-  if (context.find ("LteEnbRrc") != std::string::npos)
+  if (Config::GetContextName (context).find ("LteEnbRrc") != std::string::npos)
     {
       node = "eNB";
       NS_ASSERT_MSG (ueInfo->GetEnbInfo ()->GetCellId () == cellId,
@@ -311,10 +314,11 @@ LteRrcStatsCalculator::NotifyHandoverEndOk (
 
 void
 LteRrcStatsCalculator::NotifyHandoverStart (
-  std::string context, uint64_t imsi, uint16_t srcCellId, uint16_t rnti,
+  uint32_t context, uint64_t imsi, uint16_t srcCellId, uint16_t rnti,
   uint16_t dstCellId)
 {
-  NS_LOG_FUNCTION (this << context << imsi << srcCellId << rnti << dstCellId);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << srcCellId << rnti << dstCellId);
 
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
   NS_ASSERT_MSG (ueInfo, "Invalid UE info.");
@@ -328,7 +332,7 @@ LteRrcStatsCalculator::NotifyHandoverStart (
   NS_ASSERT_MSG (srcEnbInfo && dstEnbInfo, "Invalid eNB info.");
 
   std::string node = "UE";
-  if (context.find ("LteEnbRrc") != std::string::npos)
+  if (Config::GetContextName (context).find ("LteEnbRrc") != std::string::npos)
     {
       node = "eNB";
     }
@@ -350,9 +354,9 @@ LteRrcStatsCalculator::NotifyHandoverStart (
 
 void
 LteRrcStatsCalculator::NotifyEnbNewUeContext (
-  std::string context, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << cellId << rnti);
 
   NS_ASSERT_MSG (cellId && rnti, "Invalid CellId or RNTI.");
   *m_rrcWrapper->GetStream ()
@@ -370,9 +374,10 @@ LteRrcStatsCalculator::NotifyEnbNewUeContext (
 
 void
 LteRrcStatsCalculator::NotifyConnectionEstablished (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
   NS_ASSERT_MSG (ueInfo, "Invalid UE info.");
@@ -383,7 +388,7 @@ LteRrcStatsCalculator::NotifyConnectionEstablished (
                  "Inconsistente eNB info.");
 
   std::string node = "UE";
-  if (context.find ("LteEnbRrc") != std::string::npos)
+  if (Config::GetContextName (context).find ("LteEnbRrc") != std::string::npos)
     {
       node = "eNB";
     }
@@ -402,9 +407,10 @@ LteRrcStatsCalculator::NotifyConnectionEstablished (
 
 void
 LteRrcStatsCalculator::NotifyConnectionReconfiguration (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   Ptr<UeInfo> ueInfo = UeInfo::GetPointer (imsi);
   NS_ASSERT_MSG (ueInfo, "Invalid UE info.");
@@ -415,7 +421,7 @@ LteRrcStatsCalculator::NotifyConnectionReconfiguration (
                  "Inconsistente eNB info.");
 
   std::string node = "UE";
-  if (context.find ("LteEnbRrc") != std::string::npos)
+  if (Config::GetContextName (context).find ("LteEnbRrc") != std::string::npos)
     {
       node = "eNB";
     }
@@ -434,9 +440,10 @@ LteRrcStatsCalculator::NotifyConnectionReconfiguration (
 
 void
 LteRrcStatsCalculator::NotifyUeConnectionTimeout (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   NS_ASSERT_MSG (imsi && cellId, "Invalid IMSI or CellId.");
   *m_rrcWrapper->GetStream ()
@@ -453,9 +460,9 @@ LteRrcStatsCalculator::NotifyUeConnectionTimeout (
 
 void
 LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndError (
-  std::string context, uint64_t imsi, uint16_t cellId)
+  uint32_t context, uint64_t imsi, uint16_t cellId)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << imsi << cellId);
 
   NS_ASSERT_MSG (imsi && cellId, "Invalid IMSI or CellId.");
   *m_rrcWrapper->GetStream ()
@@ -472,9 +479,9 @@ LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndError (
 
 void
 LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndOk (
-  std::string context, uint64_t imsi, uint16_t cellId)
+  uint32_t context, uint64_t imsi, uint16_t cellId)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << imsi << cellId);
 
   NS_ASSERT_MSG (imsi && cellId, "Invalid IMSI or CellId.");
   *m_rrcWrapper->GetStream ()
@@ -491,9 +498,10 @@ LteRrcStatsCalculator::NotifyUeInitialCellSelectionEndOk (
 
 void
 LteRrcStatsCalculator::NotifyUeRandomAccessError (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   NS_ASSERT_MSG (imsi && cellId, "Invalid IMSI or CellId.");
   *m_rrcWrapper->GetStream ()
@@ -510,9 +518,10 @@ LteRrcStatsCalculator::NotifyUeRandomAccessError (
 
 void
 LteRrcStatsCalculator::NotifyUeRandomAccessSuccessful (
-  std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+  uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   imsi << cellId << rnti);
 
   NS_ASSERT_MSG (imsi && cellId, "Invalid IMSI or CellId.");
   *m_rrcWrapper->GetStream ()
@@ -55,116 +55,116 @@ protected:
    * \param mobility The UE mobility model object.
    */
   void NotifyUeMobilityCourseChange (
-    std::string context, Ptr<const MobilityModel> mobility);
+    uint32_t context, Ptr<const MobilityModel> mobility);
 
   /**
    * Notify a failure of a handover procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyHandoverEndError (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a successful termination of a handover procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyHandoverEndOk (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a start of a handover procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param srcCellId The current serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    * \param dstCellId The target eNB cell ID.
    */
   void NotifyHandoverStart (
-    std::string context, uint64_t imsi, uint16_t srcCellId, uint16_t rnti,
+    uint32_t context, uint64_t imsi, uint16_t srcCellId, uint16_t rnti,
     uint16_t dstCellId);
 
   /**
    * Notify an eNB new UE context.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyEnbNewUeContext (
-    std::string context, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a successful RRC connection establishment.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyConnectionEstablished (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a RRC connection reconfiguration.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyConnectionReconfiguration (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a UE timeout RRC connection establishment because of T300.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyUeConnectionTimeout (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a UE failed initial cell selection procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    */
   void NotifyUeInitialCellSelectionEndError (
-    std::string context, uint64_t imsi, uint16_t cellId);
+    uint32_t context, uint64_t imsi, uint16_t cellId);
 
   /**
    * Notify a UE successful initial cell selection procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    */
   void NotifyUeInitialCellSelectionEndOk (
-    std::string context, uint64_t imsi, uint16_t cellId);
+    uint32_t context, uint64_t imsi, uint16_t cellId);
 
   /**
    * Notify a UE failed random access procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyUeRandomAccessError (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Notify a UE successful random access procedure.
-   * \param context Trace source context.
+   * \param context Interned trace source context identifier.
    * \param imsi The UE IMSI.
    * \param cellId The serving eNB cell ID.
    * \param rnti The Cell Radio Network Temporary Identifier.
    */
   void NotifyUeRandomAccessSuccessful (
-    std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+    uint32_t context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
 private:
   std::string               m_hvoFilename;    //!< HvoStats filename.
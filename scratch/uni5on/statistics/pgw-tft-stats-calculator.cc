@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <iostream>
 #include "pgw-tft-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
 #include "../logical/slice-controller.h"
 #include "../metadata/pgw-info.h"
 
@@ -83,14 +84,14 @@ PgwTftStatsCalculator::NotifyConstructionCompleted (void)
   std::string prefix = stringValue.Get ();
   SetAttribute ("LbmStatsFilename", StringValue (prefix + m_tftFilename));
 
-  for (int s = 0; s < N_SLICE_IDS; s++)
+  for (SliceId slice : GetSliceIds ())
     {
-      std::string sliceStr = SliceIdStr (static_cast<SliceId> (s));
-      SliceMetadata &slData = m_slices [s];
+      std::string sliceStr = SliceIdStr (slice);
+      SliceMetadata &slData = m_slices [slice];
 
       // Create the output file for this slice.
-      slData.tftWrapper = Create<OutputStreamWrapper> (
-          m_tftFilename + "-" + sliceStr + ".log", std::ios::out);
+      slData.tftWrapper = AsyncOutputWriter::CreateStream (
+          m_tftFilename + "-" + sliceStr + ".log");
 
       // Print the header in output file.
       *slData.tftWrapper->GetStream ()
@@ -116,6 +117,7 @@ PgwTftStatsCalculator::NotifyConstructionCompleted (void)
         << " " << setw (11) << "MaxCpuLoa"
         << " " << setw (9)  << "AvgCpuUse"
         << " " << setw (9)  << "MaxCpuUse"
+        << " " << setw (9)  << "AvgCacHit"
         << std::endl;
     }
 
@@ -152,7 +154,11 @@ PgwTftStatsCalculator::NotifyPgwTftStats (
     << " " << setw (11) << Bps2Kbps (pgwInfo->GetTftMaxEwmaCpuCur ())
     << " " << setw (9)  << pgwInfo->GetTftAvgEwmaCpuUse () * 100
     << " " << setw (9)  << pgwInfo->GetTftMaxEwmaCpuUse () * 100
+    << " " << setw (9)  << pgwInfo->GetTftAvgFlowCacheHit () * 100
     << std::endl;
+
+  // Reset the microflow cache counters for the next interval.
+  pgwInfo->ResetTftFlowCacheStats ();
 }
 
 } // Namespace ns3
@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <iostream>
 #include "traffic-stats-calculator.h"
+#include "../helpers/async-output-writer.h"
 #include "../applications/uni5on-client.h"
 #include "../metadata/ue-info.h"
 #include "../metadata/routing-info.h"
@@ -37,37 +38,37 @@ TrafficStatsCalculator::TrafficStatsCalculator ()
   NS_LOG_FUNCTION (this);
 
   // Connect this stats calculator to required trace sources.
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onEnbApplication/S1uRx",
     MakeCallback (&TrafficStatsCalculator::EpcOutputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onEnbApplication/S1uTx",
     MakeCallback (&TrafficStatsCalculator::EpcInputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::PgwTunnelApp/S5Rx",
     MakeCallback (&TrafficStatsCalculator::EpcOutputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::PgwTunnelApp/S5Tx",
     MakeCallback (&TrafficStatsCalculator::EpcInputPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/OverloadDrop",
     MakeCallback (&TrafficStatsCalculator::OverloadDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/MeterDrop",
     MakeCallback (&TrafficStatsCalculator::MeterDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/TableDrop",
     MakeCallback (&TrafficStatsCalculator::TableDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/$ns3::OFSwitch13Device/PortList/*/PortQueue/Drop",
     MakeCallback (&TrafficStatsCalculator::QueueDropPacket, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onClient/AppStart",
     MakeCallback (&TrafficStatsCalculator::ResetCounters, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onClient/AppStop",
     MakeCallback (&TrafficStatsCalculator::DumpStatistics, this));
-  Config::Connect (
+  Config::ConnectWithContextId (
     "/NodeList/*/ApplicationList/*/$ns3::Uni5onClient/AppError",
     MakeCallback (&TrafficStatsCalculator::DumpStatistics, this));
 }
@@ -126,10 +127,10 @@ TrafficStatsCalculator::NotifyConstructionCompleted (void)
   SetAttribute ("EpcStatsFilename", StringValue (prefix + m_epcFilename));
 
   // Create the output files.
-  m_appWrapper = Create<OutputStreamWrapper> (
-      m_appFilename + ".log", std::ios::out);
-  m_epcWrapper = Create<OutputStreamWrapper> (
-      m_epcFilename + ".log", std::ios::out);
+  m_appWrapper = AsyncOutputWriter::CreateStream (
+      m_appFilename + ".log");
+  m_epcWrapper = AsyncOutputWriter::CreateStream (
+      m_epcFilename + ".log");
 
   // Print the headers in output files.
   *m_appWrapper->GetStream ()
@@ -155,10 +156,11 @@ TrafficStatsCalculator::NotifyConstructionCompleted (void)
 }
 
 void
-TrafficStatsCalculator::DumpStatistics (std::string context,
+TrafficStatsCalculator::DumpStatistics (uint32_t context,
                                         Ptr<Uni5onClient> app)
 {
-  NS_LOG_FUNCTION (this << context << app->GetTeidHex ());
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   app->GetTeidHex ());
 
   uint32_t teid = app->GetTeid ();
   Ptr<const RoutingInfo> rInfo = RoutingInfo::GetPointer (teid);
@@ -200,20 +202,20 @@ TrafficStatsCalculator::DumpStatistics (std::string context,
 }
 
 void
-TrafficStatsCalculator::ResetCounters (std::string context,
+TrafficStatsCalculator::ResetCounters (uint32_t context,
                                        Ptr<Uni5onClient> app)
 {
-  NS_LOG_FUNCTION (this << context << app);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << app);
 
   GetFlowStats (app->GetTeid (), Direction::DLINK)->ResetCounters ();
   GetFlowStats (app->GetTeid (), Direction::ULINK)->ResetCounters ();
 }
 
 void
-TrafficStatsCalculator::OverloadDropPacket (std::string context,
+TrafficStatsCalculator::OverloadDropPacket (uint32_t context,
                                             Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> stats;
@@ -240,9 +242,10 @@ TrafficStatsCalculator::OverloadDropPacket (std::string context,
 
 void
 TrafficStatsCalculator::MeterDropPacket (
-  std::string context, Ptr<const Packet> packet, uint32_t meterId)
+  uint32_t context, Ptr<const Packet> packet, uint32_t meterId)
 {
-  NS_LOG_FUNCTION (this << context << packet << meterId);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) <<
+                   packet << meterId);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> stats;
@@ -277,10 +280,10 @@ TrafficStatsCalculator::MeterDropPacket (
 }
 
 void
-TrafficStatsCalculator::QueueDropPacket (std::string context,
+TrafficStatsCalculator::QueueDropPacket (uint32_t context,
                                          Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> stats;
@@ -307,9 +310,9 @@ TrafficStatsCalculator::QueueDropPacket (std::string context,
 
 void
 TrafficStatsCalculator::TableDropPacket (
-  std::string context, Ptr<const Packet> packet, uint8_t tableId)
+  uint32_t context, Ptr<const Packet> packet, uint8_t tableId)
 {
-  NS_LOG_FUNCTION (this << context << packet <<
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet <<
                    static_cast<uint16_t> (tableId));
 
   EpcGtpuTag gtpuTag;
@@ -336,10 +339,10 @@ TrafficStatsCalculator::TableDropPacket (
 }
 
 void
-TrafficStatsCalculator::EpcInputPacket (std::string context,
+TrafficStatsCalculator::EpcInputPacket (uint32_t context,
                                         Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> stats;
@@ -351,10 +354,10 @@ TrafficStatsCalculator::EpcInputPacket (std::string context,
 }
 
 void
-TrafficStatsCalculator::EpcOutputPacket (std::string context,
+TrafficStatsCalculator::EpcOutputPacket (uint32_t context,
                                          Ptr<const Packet> packet)
 {
-  NS_LOG_FUNCTION (this << context << packet);
+  NS_LOG_FUNCTION (this << Config::GetContextName (context) << packet);
 
   EpcGtpuTag gtpuTag;
   Ptr<FlowStatsCalculator> stats;
@@ -65,66 +65,66 @@ private:
   /**
    * Dump statistics into file.
    * Trace sink fired when application traffic stops.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param app The client application.
    */
-  void DumpStatistics (std::string context, Ptr<Uni5onClient> app);
+  void DumpStatistics (uint32_t context, Ptr<Uni5onClient> app);
 
   /**
    * Reset internal counters.
    * Trace sink fired when application traffic starts.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param app The client application.
    */
-  void ResetCounters (std::string context, Ptr<Uni5onClient> app);
+  void ResetCounters (uint32_t context, Ptr<Uni5onClient> app);
 
   /**
    * Trace sink fired when a packet is dropped while exceeding pipeline load
    * capacity.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The dropped packet.
    */
-  void OverloadDropPacket (std::string context, Ptr<const Packet> packet);
+  void OverloadDropPacket (uint32_t context, Ptr<const Packet> packet);
 
   /**
    * Trace sink fired when a packets is dropped by meter band.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The dropped packet.
    * \param meterId The meter ID that dropped the packet.
    */
-  void MeterDropPacket (std::string context, Ptr<const Packet> packet,
+  void MeterDropPacket (uint32_t context, Ptr<const Packet> packet,
                         uint32_t meterId);
 
   /**
    * Trace sink fired when a packet is dropped by OpenFlow port queues.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The dropped packet.
    */
-  void QueueDropPacket (std::string context, Ptr<const Packet> packet);
+  void QueueDropPacket (uint32_t context, Ptr<const Packet> packet);
 
 
   /**
    * Trace sink fired when an unmatched packets is dropped by a flow table.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The dropped packet.
    * \param tableId The flow table ID that dropped the packet.
    */
-  void TableDropPacket (std::string context, Ptr<const Packet> packet,
+  void TableDropPacket (uint32_t context, Ptr<const Packet> packet,
                         uint8_t tableId);
 
   /**
    * Trace sink fired when a packet enters the EPC.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The packet.
    */
-  void EpcInputPacket (std::string context, Ptr<const Packet> packet);
+  void EpcInputPacket (uint32_t context, Ptr<const Packet> packet);
 
   /**
    * Trace sink fired when a packet leaves the EPC.
-   * \param context Context information.
+   * \param context Interned context identifier.
    * \param packet The packet.
    */
-  void EpcOutputPacket (std::string context, Ptr<const Packet> packet);
+  void EpcOutputPacket (uint32_t context, Ptr<const Packet> packet);
 
   /**
    * Classify the downlink packet as in the P-GWu TFT logical port.
@@ -0,0 +1,508 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <ns3/core-module.h>
+#include <ns3/csma-module.h>
+#include <ns3/network-module.h>
+#include <ns3/ofswitch13-module.h>
+#include "../infrastructure/mesh-controller.h"
+#include "../infrastructure/ring-controller.h"
+#include "../metadata/link-info.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onInfra
+ * Base test case for the backhaul routing paths, building a backhaul topology
+ * of OpenFlow switches without installing any OpenFlow rule.
+ */
+class BackhaulPathsTestCase : public TestCase
+{
+public:
+  /**
+   * Complete constructor.
+   * \param name The test case name.
+   */
+  BackhaulPathsTestCase (std::string name);
+
+protected:
+  /** A list of links between switch index pairs. */
+  typedef std::vector<std::pair<uint16_t, uint16_t> > LinkList_t;
+
+  /** Shortcut for the controller routing path type. */
+  typedef BackhaulController::RoutingPath_t RoutingPath_t;
+
+  /** Shortcut for the controller switch list type. */
+  typedef BackhaulController::SwitchList_t SwitchList_t;
+
+  /**
+   * Build the backhaul topology and the controller routing path cache. The
+   * first switch of each link is the one on the link forward direction, so
+   * ring links must be listed in clockwise direction.
+   * \param ctrl The backhaul controller.
+   * \param nSwitches The number of switches.
+   * \param links The links between switches.
+   */
+  void BuildTopology (Ptr<BackhaulController> ctrl, uint16_t nSwitches,
+                      const LinkList_t &links);
+
+  /**
+   * Get the switch indexes along the given routing path.
+   * \param srcIdx The source switch index.
+   * \param path The routing path.
+   * \return The switch list.
+   */
+  static SwitchList_t GetSwitchList (uint16_t srcIdx,
+                                     const RoutingPath_t &path);
+
+  /**
+   * Get the ring routing direction of the given routing path.
+   * \param path The routing path.
+   * \return The ring routing direction.
+   */
+  static RingInfo::RingPath GetRingPath (const RoutingPath_t &path);
+
+  /**
+   * \name Controller accessors
+   * Forward the calls to the protected controller methods.
+   */
+  //\{
+  uint16_t GetNumPaths (uint16_t srcIdx, uint16_t dstIdx) const;
+  const RoutingPath_t& GetPath (uint16_t srcIdx, uint16_t dstIdx,
+                                uint16_t index) const;
+  const RoutingPath_t& GetInvPath (uint16_t srcIdx, uint16_t dstIdx,
+                                   uint16_t index) const;
+  bool BitRateRequest (const RoutingPath_t &path, int64_t bitRate) const;
+  bool BitRateReserve (const RoutingPath_t &path, int64_t bitRate) const;
+  SwitchList_t FindShortestPath (uint16_t srcIdx, uint16_t dstIdx) const;
+  std::vector<SwitchList_t> FindKShortestPaths (uint16_t srcIdx,
+                                                uint16_t dstIdx,
+                                                uint16_t k) const;
+  //\}
+
+  // Inherited from TestCase.
+  virtual void DoTeardown (void);
+
+  Ptr<BackhaulController> m_ctrl;   //!< The controller under test.
+};
+
+BackhaulPathsTestCase::BackhaulPathsTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+BackhaulPathsTestCase::BuildTopology (
+  Ptr<BackhaulController> ctrl, uint16_t nSwitches, const LinkList_t &links)
+{
+  m_ctrl = ctrl;
+
+  NodeContainer nodes;
+  nodes.Create (nSwitches);
+  Ptr<OFSwitch13InternalHelper> ofHelper =
+    CreateObject<OFSwitch13InternalHelper> ();
+  OFSwitch13DeviceContainer switches = ofHelper->InstallSwitch (nodes);
+
+  CsmaHelper csmaHelper;
+  csmaHelper.SetChannelAttribute ("FullDuplex", BooleanValue (true));
+  csmaHelper.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("1Gbps")));
+  for (auto const &link : links)
+    {
+      NodeContainer pair (nodes.Get (link.first), nodes.Get (link.second));
+      NetDeviceContainer devices = csmaHelper.Install (pair);
+      Ptr<OFSwitch13Port> port0 =
+        switches.Get (link.first)->AddSwitchPort (devices.Get (0));
+      Ptr<OFSwitch13Port> port1 =
+        switches.Get (link.second)->AddSwitchPort (devices.Get (1));
+      Ptr<CsmaChannel> channel =
+        DynamicCast<CsmaChannel> (devices.Get (0)->GetChannel ());
+      Ptr<LinkInfo> lInfo = CreateObject<LinkInfo> (port0, port1, channel);
+
+      // Give the whole link to the HTC slice.
+      lInfo->UpdateQuota (LinkInfo::FWD, SliceId::HTC, 100);
+      lInfo->UpdateQuota (LinkInfo::BWD, SliceId::HTC, 100);
+    }
+
+  // Only save the switch devices, skipping the OpenFlow rules.
+  m_ctrl->BackhaulController::NotifyTopologyBuilt (switches);
+  Ptr<MeshController> mesh = DynamicCast<MeshController> (m_ctrl);
+  if (mesh)
+    {
+      mesh->m_adjacency.assign (nSwitches, SwitchList_t ());
+      for (auto const &link : links)
+        {
+          mesh->m_adjacency [link.first].push_back (link.second);
+          mesh->m_adjacency [link.second].push_back (link.first);
+        }
+      for (auto &neighbors : mesh->m_adjacency)
+        {
+          std::sort (neighbors.begin (), neighbors.end ());
+        }
+    }
+  m_ctrl->CreatePathCache ();
+}
+
+BackhaulPathsTestCase::SwitchList_t
+BackhaulPathsTestCase::GetSwitchList (uint16_t srcIdx,
+                                      const RoutingPath_t &path)
+{
+  SwitchList_t swList (1, srcIdx);
+  for (auto const &hop : path)
+    {
+      swList.push_back (hop.dstIdx);
+    }
+  return swList;
+}
+
+RingInfo::RingPath
+BackhaulPathsTestCase::GetRingPath (const RoutingPath_t &path)
+{
+  RingInfo::RingPath ringPath = RingInfo::LOCAL;
+  if (!path.empty ())
+    {
+      ringPath = RingInfo::LinkDirToRingPath (path.front ().fwdDir);
+    }
+  return ringPath;
+}
+
+uint16_t
+BackhaulPathsTestCase::GetNumPaths (uint16_t srcIdx, uint16_t dstIdx) const
+{
+  return m_ctrl->GetNumPaths (srcIdx, dstIdx);
+}
+
+const BackhaulPathsTestCase::RoutingPath_t&
+BackhaulPathsTestCase::GetPath (uint16_t srcIdx, uint16_t dstIdx,
+                                uint16_t index) const
+{
+  return m_ctrl->GetPath (srcIdx, dstIdx, index);
+}
+
+const BackhaulPathsTestCase::RoutingPath_t&
+BackhaulPathsTestCase::GetInvPath (uint16_t srcIdx, uint16_t dstIdx,
+                                   uint16_t index) const
+{
+  return m_ctrl->GetInvPath (srcIdx, dstIdx, index);
+}
+
+bool
+BackhaulPathsTestCase::BitRateRequest (const RoutingPath_t &path,
+                                       int64_t bitRate) const
+{
+  return m_ctrl->BitRateRequest (path, bitRate, 0, SliceId::HTC, 1.0);
+}
+
+bool
+BackhaulPathsTestCase::BitRateReserve (const RoutingPath_t &path,
+                                       int64_t bitRate) const
+{
+  return m_ctrl->BitRateReserve (path, bitRate, 0, SliceId::HTC);
+}
+
+BackhaulPathsTestCase::SwitchList_t
+BackhaulPathsTestCase::FindShortestPath (uint16_t srcIdx,
+                                         uint16_t dstIdx) const
+{
+  Ptr<MeshController> mesh = DynamicCast<MeshController> (m_ctrl);
+  std::vector<bool> skipNodes (mesh->GetNSwitches (), false);
+  return mesh->FindShortestPath (srcIdx, dstIdx, skipNodes,
+                                 MeshController::EdgeSet_t ());
+}
+
+std::vector<BackhaulPathsTestCase::SwitchList_t>
+BackhaulPathsTestCase::FindKShortestPaths (uint16_t srcIdx, uint16_t dstIdx,
+                                           uint16_t k) const
+{
+  Ptr<MeshController> mesh = DynamicCast<MeshController> (m_ctrl);
+  return mesh->FindKShortestPaths (srcIdx, dstIdx, k);
+}
+
+void
+BackhaulPathsTestCase::DoTeardown (void)
+{
+  m_ctrl->Dispose ();
+  m_ctrl = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup uni5onInfra
+ * Check the ring routing direction of the cached paths for each ordered
+ * switch pair. The first path goes through the shortest ring direction,
+ * preferring the clockwise one when both have the same length. With the SPF
+ * strategy, the second path goes through the opposite ring direction.
+ */
+class RingPathsTestCase : public BackhaulPathsTestCase
+{
+public:
+  /**
+   * Complete constructor.
+   * \param nSwitches The number of switches in the ring.
+   */
+  RingPathsTestCase (uint16_t nSwitches);
+
+private:
+  virtual void DoRun (void);
+
+  uint16_t m_nSwitches;   //!< Number of switches in the ring.
+};
+
+RingPathsTestCase::RingPathsTestCase (uint16_t nSwitches)
+  : BackhaulPathsTestCase ("Ring paths with " + std::to_string (nSwitches) +
+                           " switches"),
+  m_nSwitches (nSwitches)
+{
+}
+
+void
+RingPathsTestCase::DoRun (void)
+{
+  LinkList_t links;
+  for (uint16_t idx = 0; idx < m_nSwitches; idx++)
+    {
+      links.push_back (std::make_pair (idx, (idx + 1) % m_nSwitches));
+    }
+  BuildTopology (CreateObjectWithAttributes<RingController> (
+                   "Routing", EnumValue (RingController::SPF)),
+                 m_nSwitches, links);
+
+  for (uint16_t src = 0; src < m_nSwitches; src++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (GetNumPaths (src, src), 1, "Local paths");
+      NS_TEST_EXPECT_MSG_EQ (GetPath (src, src, 0).empty (), true,
+                             "Local routing path");
+      for (uint16_t dst = 0; dst < m_nSwitches; dst++)
+        {
+          if (src == dst)
+            {
+              continue;
+            }
+          uint16_t clockHops = (dst + m_nSwitches - src) % m_nSwitches;
+          uint16_t countHops = m_nSwitches - clockHops;
+          bool clockFirst = (clockHops <= m_nSwitches / 2);
+          RingInfo::RingPath shortPath =
+            clockFirst ? RingInfo::CLOCK : RingInfo::COUNT;
+
+          NS_TEST_ASSERT_MSG_EQ (GetNumPaths (src, dst), 2, "SPF paths");
+          for (uint16_t index = 0; index < 2; index++)
+            {
+              const RoutingPath_t &path = GetPath (src, dst, index);
+              const RoutingPath_t &invPath = GetInvPath (src, dst, index);
+              bool isClock = (index == 0) == clockFirst;
+              RingInfo::RingPath ringPath = (index == 0) ?
+                shortPath : RingInfo::InvertPath (shortPath);
+
+              NS_TEST_EXPECT_MSG_EQ (
+                GetRingPath (path), ringPath,
+                "Ring direction from " << src << " to " << dst <<
+                " with index " << index);
+              NS_TEST_EXPECT_MSG_EQ (
+                path.size (), isClock ? clockHops : countHops,
+                "Path length from " << src << " to " << dst);
+              NS_TEST_EXPECT_MSG_EQ (
+                GetSwitchList (src, path).back (), dst, "Path destination");
+
+              // The inverted path follows the same links back to the source.
+              NS_TEST_ASSERT_MSG_EQ (invPath.size (), path.size (),
+                                     "Inverted path length");
+              NS_TEST_EXPECT_MSG_EQ (
+                GetRingPath (invPath), RingInfo::InvertPath (ringPath),
+                "Inverted ring direction");
+              for (size_t i = 0; i < path.size (); i++)
+                {
+                  const auto &hop = path [i];
+                  const auto &invHop = invPath [path.size () - 1 - i];
+                  NS_TEST_EXPECT_MSG_EQ (invHop.lInfo, hop.lInfo,
+                                         "Inverted path link");
+                  NS_TEST_EXPECT_MSG_EQ (invHop.srcIdx, hop.dstIdx,
+                                         "Inverted hop source");
+                  NS_TEST_EXPECT_MSG_EQ (invHop.fwdDir, hop.bwdDir,
+                                         "Inverted hop direction");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup uni5onInfra
+ * Check that the alternative ring path is available with the SPF strategy
+ * when the shortest path has no bit rate left.
+ */
+class RingSpfFallbackTestCase : public BackhaulPathsTestCase
+{
+public:
+  RingSpfFallbackTestCase ();  //!< Default constructor.
+
+private:
+  virtual void DoRun (void);
+};
+
+RingSpfFallbackTestCase::RingSpfFallbackTestCase ()
+  : BackhaulPathsTestCase ("Ring SPF fallback on a blocked path")
+{
+}
+
+void
+RingSpfFallbackTestCase::DoRun (void)
+{
+  LinkList_t links;
+  for (uint16_t idx = 0; idx < 4; idx++)
+    {
+      links.push_back (std::make_pair (idx, (idx + 1) % 4));
+    }
+  BuildTopology (CreateObjectWithAttributes<RingController> (
+                   "Routing", EnumValue (RingController::SPF)),
+                 4, links);
+
+  const RoutingPath_t &shortPath = GetPath (0, 1, 0);
+  const RoutingPath_t &longPath = GetPath (0, 1, 1);
+  NS_TEST_ASSERT_MSG_EQ (GetRingPath (shortPath), RingInfo::CLOCK,
+                         "Short path direction");
+  NS_TEST_ASSERT_MSG_EQ (GetRingPath (longPath), RingInfo::COUNT,
+                         "Long path direction");
+  NS_TEST_EXPECT_MSG_EQ (BitRateRequest (shortPath, 200000000), true,
+                         "Short path available");
+
+  // Block the short path, leaving the long path untouched.
+  NS_TEST_ASSERT_MSG_EQ (BitRateReserve (shortPath, 900000000), true,
+                         "Bit rate reserve");
+  NS_TEST_EXPECT_MSG_EQ (BitRateRequest (shortPath, 200000000), false,
+                         "Short path blocked");
+  NS_TEST_EXPECT_MSG_EQ (BitRateRequest (longPath, 200000000), true,
+                         "Long path available");
+
+  // The reverse direction uses the other link direction, so it is still
+  // available through the short path.
+  NS_TEST_EXPECT_MSG_EQ (BitRateRequest (GetPath (1, 0, 0), 200000000), true,
+                         "Reverse short path available");
+
+  // With the SPO strategy, there is no alternative path.
+  m_ctrl->Dispose ();
+  Ptr<RingController> spo = CreateObjectWithAttributes<RingController> (
+      "Routing", EnumValue (RingController::SPO));
+  BuildTopology (spo, 4, links);
+  NS_TEST_EXPECT_MSG_EQ (GetNumPaths (0, 1), 1, "SPO paths");
+}
+
+/**
+ * \ingroup uni5onInfra
+ * Check the order of the k-shortest paths on a small mesh, found by the Yen's
+ * algorithm. Candidate paths with the same number of hops are sorted by the
+ * switch indexes.
+ */
+class MeshPathsTestCase : public BackhaulPathsTestCase
+{
+public:
+  MeshPathsTestCase ();  //!< Default constructor.
+
+private:
+  virtual void DoRun (void);
+};
+
+MeshPathsTestCase::MeshPathsTestCase ()
+  : BackhaulPathsTestCase ("Mesh k-shortest paths order")
+{
+}
+
+void
+MeshPathsTestCase::DoRun (void)
+{
+  //     1
+  //   / | \
+  //  0  |  3 - 4
+  //   \ | /
+  //     2
+  LinkList_t links;
+  links.push_back (std::make_pair (0, 1));
+  links.push_back (std::make_pair (0, 2));
+  links.push_back (std::make_pair (1, 2));
+  links.push_back (std::make_pair (1, 3));
+  links.push_back (std::make_pair (2, 3));
+  links.push_back (std::make_pair (3, 4));
+  BuildTopology (CreateObjectWithAttributes<MeshController> (
+                   "NumPaths", UintegerValue (3),
+                   "Routing", EnumValue (MeshController::KSP)),
+                 5, links);
+
+  // Ties in the shortest path are broken by the lowest switch index.
+  SwitchList_t shortest = FindShortestPath (0, 4);
+  SwitchList_t expected = {0, 1, 3, 4};
+  NS_TEST_EXPECT_MSG_EQ ((shortest == expected), true, "Shortest path");
+
+  // There are only four loopless paths from switch 0 to 4.
+  std::vector<SwitchList_t> kPaths = FindKShortestPaths (0, 4, 5);
+  std::vector<SwitchList_t> expectedPaths = {
+    {0, 1, 3, 4}, {0, 2, 3, 4}, {0, 1, 2, 3, 4}, {0, 2, 1, 3, 4}
+  };
+  NS_TEST_ASSERT_MSG_EQ (kPaths.size (), expectedPaths.size (),
+                         "Number of k-shortest paths");
+  for (size_t i = 0; i < kPaths.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((kPaths [i] == expectedPaths [i]), true,
+                             "K-shortest path " << i);
+    }
+
+  // The path cache keeps the first NumPaths paths, in the same order.
+  NS_TEST_ASSERT_MSG_EQ (GetNumPaths (0, 4), 3, "Cached paths");
+  for (uint16_t i = 0; i < 3; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((GetSwitchList (0, GetPath (0, 4, i))
+                              == expectedPaths [i]), true,
+                             "Cached path " << i);
+      SwitchList_t inverted = expectedPaths [i];
+      std::reverse (inverted.begin (), inverted.end ());
+      NS_TEST_EXPECT_MSG_EQ ((GetSwitchList (4, GetInvPath (0, 4, i))
+                              == inverted), true,
+                             "Cached inverted path " << i);
+    }
+
+  // Paths in the opposite direction are found independently.
+  SwitchList_t reverse = {4, 3, 1, 0};
+  NS_TEST_EXPECT_MSG_EQ ((GetSwitchList (4, GetPath (4, 0, 0)) == reverse),
+                         true, "Reverse shortest path");
+}
+
+/**
+ * \ingroup uni5onInfra
+ * Backhaul controller test suite.
+ */
+class BackhaulControllerTestSuite : public TestSuite
+{
+public:
+  BackhaulControllerTestSuite ();  //!< Default constructor.
+};
+
+BackhaulControllerTestSuite::BackhaulControllerTestSuite ()
+  : TestSuite ("uni5on-backhaul-controller", UNIT)
+{
+  AddTestCase (new RingPathsTestCase (4), TestCase::QUICK);
+  AddTestCase (new RingPathsTestCase (5), TestCase::QUICK);
+  AddTestCase (new RingSpfFallbackTestCase, TestCase::QUICK);
+  AddTestCase (new MeshPathsTestCase, TestCase::QUICK);
+}
+
+/** BackhaulControllerTestSuite instance variable. */
+static BackhaulControllerTestSuite g_backhaulControllerTestSuite;
+
+} // namespace ns3
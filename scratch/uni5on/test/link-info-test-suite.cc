@@ -0,0 +1,227 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/csma-module.h>
+#include <ns3/network-module.h>
+#include <ns3/ofswitch13-module.h>
+#include "../metadata/link-info.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onInfra
+ * Compare the lazy LinkInfo EWMA throughput against a reference EWMA updated
+ * by a periodic event at each EwmaTimeout tick, as the LinkInfo did before.
+ */
+class LinkInfoEwmaTestCase : public TestCase
+{
+public:
+  /**
+   * Complete constructor.
+   * \param name The test case name.
+   * \param bursty True for random bursts over the whole test, false for
+   *        steady traffic followed by an idle period.
+   */
+  LinkInfoEwmaTestCase (std::string name, bool bursty);
+
+private:
+  /**
+   * Notify bytes transmitted over the link and to the reference EWMA.
+   * \param bytes The number of bytes.
+   */
+  void SendBytes (uint32_t bytes);
+
+  /** Update the reference EWMA and schedule the next update. */
+  void ReferenceUpdate (void);
+
+  /** Check the link EWMA throughput against the reference one. */
+  void CheckEwma (void);
+
+  // Inherited from TestCase.
+  virtual void DoRun (void);
+
+  bool          m_bursty;               //!< Bursty traffic pattern.
+  Ptr<LinkInfo> m_link;                 //!< The link under test.
+  Time          m_timeout;              //!< EWMA timeout.
+  double        m_alpha [2];            //!< EWMA alpha parameters.
+  int64_t       m_refThp [2];           //!< Reference EWMA throughput.
+  int64_t       m_refBytes;             //!< Reference TX bytes.
+  uint32_t      m_checks;               //!< Number of checks.
+};
+
+LinkInfoEwmaTestCase::LinkInfoEwmaTestCase (std::string name, bool bursty)
+  : TestCase (name),
+  m_bursty (bursty),
+  m_refBytes (0),
+  m_checks (0)
+{
+  m_refThp [LinkInfo::STERM] = 0;
+  m_refThp [LinkInfo::LTERM] = 0;
+}
+
+void
+LinkInfoEwmaTestCase::SendBytes (uint32_t bytes)
+{
+  m_link->NotifyTxBytes (LinkInfo::FWD, SliceId::HTC, QosType::NON, bytes);
+  m_refBytes += bytes;
+}
+
+void
+LinkInfoEwmaTestCase::ReferenceUpdate (void)
+{
+  double elapSecs = m_timeout.GetSeconds ();
+  for (int term = 0; term <= LinkInfo::LTERM; term++)
+    {
+      m_refThp [term] =
+        (m_alpha [term] * 8 * m_refBytes) / elapSecs +
+        (1 - m_alpha [term]) * m_refThp [term];
+    }
+  m_refBytes = 0;
+  Simulator::Schedule (m_timeout, &LinkInfoEwmaTestCase::ReferenceUpdate,
+                       this);
+}
+
+void
+LinkInfoEwmaTestCase::CheckEwma (void)
+{
+  m_checks++;
+  for (int t = 0; t <= LinkInfo::LTERM; t++)
+    {
+      LinkInfo::EwmaTerm term = static_cast<LinkInfo::EwmaTerm> (t);
+      NS_TEST_EXPECT_MSG_EQ_TOL (
+        m_link->GetUseBitRate (term, LinkInfo::FWD, SliceId::HTC),
+        m_refThp [term], 1, "Slice EWMA differs at " << Simulator::Now ());
+      NS_TEST_EXPECT_MSG_EQ_TOL (
+        m_link->GetUseBitRate (term, LinkInfo::FWD, SliceId::ALL),
+        m_refThp [term], 1, "Link EWMA differs at " << Simulator::Now ());
+    }
+}
+
+void
+LinkInfoEwmaTestCase::DoRun (void)
+{
+  // Create a full-duplex link between two OpenFlow switches.
+  NodeContainer nodes;
+  nodes.Create (2);
+  Ptr<OFSwitch13InternalHelper> ofHelper =
+    CreateObject<OFSwitch13InternalHelper> ();
+  OFSwitch13DeviceContainer switches = ofHelper->InstallSwitch (nodes);
+
+  CsmaHelper csmaHelper;
+  csmaHelper.SetChannelAttribute ("FullDuplex", BooleanValue (true));
+  csmaHelper.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("1Gbps")));
+  NetDeviceContainer devices = csmaHelper.Install (nodes);
+  Ptr<OFSwitch13Port> port0 = switches.Get (0)->AddSwitchPort (devices.Get (0));
+  Ptr<OFSwitch13Port> port1 = switches.Get (1)->AddSwitchPort (devices.Get (1));
+  Ptr<CsmaChannel> channel =
+    DynamicCast<CsmaChannel> (devices.Get (0)->GetChannel ());
+  m_link = CreateObject<LinkInfo> (port0, port1, channel);
+
+  TimeValue timeValue;
+  DoubleValue doubleValue;
+  m_link->GetAttribute ("EwmaTimeout", timeValue);
+  m_timeout = timeValue.Get ();
+  m_link->GetAttribute ("EwmaShortAlpha", doubleValue);
+  m_alpha [LinkInfo::STERM] = doubleValue.Get ();
+  m_link->GetAttribute ("EwmaLongAlpha", doubleValue);
+  m_alpha [LinkInfo::LTERM] = doubleValue.Get ();
+  Simulator::Schedule (m_timeout, &LinkInfoEwmaTestCase::ReferenceUpdate,
+                       this);
+
+  // Transmissions and reads never happen at EwmaTimeout ticks, to avoid
+  // ambiguous event order with the reference updates.
+  Time stop = Seconds (12);
+  if (m_bursty)
+    {
+      // Random bursts of packets and random reads over the whole test.
+      Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+      rng->SetStream (1);
+      for (uint32_t i = 0; i < 400; i++)
+        {
+          Time start = MicroSeconds (rng->GetInteger (0, 11999999));
+          uint32_t packets = rng->GetInteger (1, 200);
+          for (uint32_t p = 0; p < packets; p++)
+            {
+              Time when = start + MicroSeconds (12 * p + 1);
+              if (when.GetMicroSeconds () % 100000 != 0)
+                {
+                  Simulator::Schedule (when, &LinkInfoEwmaTestCase::SendBytes,
+                                       this, rng->GetInteger (64, 1500));
+                }
+            }
+        }
+      for (uint32_t i = 0; i < 500; i++)
+        {
+          Time when = MicroSeconds (rng->GetInteger (0, 11999999));
+          if (when.GetMicroSeconds () % 100000 != 0)
+            {
+              Simulator::Schedule (when, &LinkInfoEwmaTestCase::CheckEwma,
+                                   this);
+            }
+        }
+    }
+  else
+    {
+      // Steady traffic for 2 seconds, then an idle link, with sparse reads.
+      for (Time when = MicroSeconds (500); when < Seconds (2);
+           when += MilliSeconds (1))
+        {
+          Simulator::Schedule (when, &LinkInfoEwmaTestCase::SendBytes,
+                               this, 1500);
+        }
+      for (Time when = MilliSeconds (373); when < stop;
+           when += MilliSeconds (373))
+        {
+          Simulator::Schedule (when, &LinkInfoEwmaTestCase::CheckEwma, this);
+        }
+    }
+
+  Simulator::Stop (stop);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_GT (m_checks, 0, "No EWMA checks");
+  m_link = 0;
+}
+
+/**
+ * \ingroup uni5onInfra
+ * LinkInfo test suite.
+ */
+class LinkInfoTestSuite : public TestSuite
+{
+public:
+  LinkInfoTestSuite ();  //!< Default constructor.
+};
+
+LinkInfoTestSuite::LinkInfoTestSuite ()
+  : TestSuite ("uni5on-link-info", UNIT)
+{
+  AddTestCase (new LinkInfoEwmaTestCase (
+                 "EWMA throughput on an idle link", false), TestCase::QUICK);
+  AddTestCase (new LinkInfoEwmaTestCase (
+                 "EWMA throughput on a bursty link", true), TestCase::QUICK);
+}
+
+/** LinkInfoTestSuite instance variable. */
+static LinkInfoTestSuite g_linkInfoTestSuite;
+
+} // namespace ns3
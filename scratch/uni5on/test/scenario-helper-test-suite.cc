@@ -0,0 +1,175 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <sstream>
+#include <ns3/core-module.h>
+#include "../helpers/scenario-helper.h"
+#include "../helpers/traffic-helper.h"
+#include "../logical/slice-controller.h"
+#include "../logical/slice-network.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5on
+ * Scenario helper that only holds the slice factories, without building the
+ * UNI5ON architecture on construction.
+ */
+class ScenarioHelperFactoryTester : public ScenarioHelper
+{
+public:
+  using ScenarioHelper::GetSliceFactories;
+
+protected:
+  // Inherited from ObjectBase.
+  virtual void NotifyConstructionCompleted (void)
+  {
+    Object::NotifyConstructionCompleted ();
+  }
+};
+
+/**
+ * \ingroup uni5on
+ * Check the object factories used by named and generic logical slices.
+ */
+class ScenarioHelperSliceFactoryTestCase : public TestCase
+{
+public:
+  ScenarioHelperSliceFactoryTestCase ();  //!< Default constructor.
+
+private:
+  /**
+   * Check if the object factory sets the attribute to the given value.
+   * \param factory The object factory.
+   * \param attr The attribute name and serialized value (like Quota=20).
+   * \return True if the attribute is set to this value, false otherwise.
+   */
+  static bool HasAttribute (const ObjectFactory &factory, std::string attr);
+
+  // Inherited from TestCase.
+  virtual void DoRun (void);
+};
+
+ScenarioHelperSliceFactoryTestCase::ScenarioHelperSliceFactoryTestCase ()
+  : TestCase ("Slice factories for named and generic slices")
+{
+}
+
+bool
+ScenarioHelperSliceFactoryTestCase::HasAttribute (
+  const ObjectFactory &factory, std::string attr)
+{
+  std::ostringstream oss;
+  oss << factory;
+  std::string str = oss.str ();
+  std::string::size_type pos = str.find (attr);
+  if (pos == std::string::npos)
+    {
+      return false;
+    }
+  char prev = str [pos - 1];
+  char next = str [pos + attr.size ()];
+  return (prev == '[' || prev == '|') && (next == ']' || next == '|');
+}
+
+void
+ScenarioHelperSliceFactoryTestCase::DoRun (void)
+{
+  ObjectFactory htcCtrl (SliceController::GetTypeId ().GetName ());
+  htcCtrl.Set ("Quota", IntegerValue (30));
+  ObjectFactory mtcCtrl (SliceController::GetTypeId ().GetName ());
+  mtcCtrl.Set ("Quota", IntegerValue (20));
+  ObjectFactory network (SliceNetwork::GetTypeId ().GetName ());
+  ObjectFactory traffic (TrafficHelper::GetTypeId ().GetName ());
+  ObjectFactory slice3Traffic (TrafficHelper::GetTypeId ().GetName ());
+  slice3Traffic.Set ("Profile", EnumValue (SliceId::MTC));
+
+  Ptr<ScenarioHelperFactoryTester> helper =
+    CreateObject<ScenarioHelperFactoryTester> ();
+  helper->SetAttribute ("HtcController", ObjectFactoryValue (htcCtrl));
+  helper->SetAttribute ("HtcSlice", ObjectFactoryValue (network));
+  helper->SetAttribute ("HtcTraffic", ObjectFactoryValue (traffic));
+  helper->SetAttribute ("MtcController", ObjectFactoryValue (mtcCtrl));
+  helper->SetAttribute ("MtcSlice", ObjectFactoryValue (network));
+  helper->SetAttribute ("MtcTraffic", ObjectFactoryValue (traffic));
+  helper->SetAttribute ("Slice3Traffic", ObjectFactoryValue (slice3Traffic));
+
+  ObjectFactory ctrlFac, netFac, trafFac;
+
+  // Named slices use their own factories, untouched.
+  helper->GetSliceFactories (SliceId::HTC, ctrlFac, netFac, trafFac);
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (ctrlFac, "Quota=30"), true,
+                         "HTC controller quota changed");
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (trafFac, "Profile=htc"), false,
+                         "HTC traffic profile set");
+
+  // A named slice without factories is not replicated.
+  helper->GetSliceFactories (SliceId::TMP, ctrlFac, netFac, trafFac);
+  NS_TEST_EXPECT_MSG_EQ ((ctrlFac.GetTypeId () == TypeId ()), true,
+                         "TMP controller factory configured");
+
+  // A generic slice keeps the profile of its own traffic factory and
+  // replicates the HTC factories that are not configured.
+  helper->GetSliceFactories (static_cast<SliceId> (3),
+                             ctrlFac, netFac, trafFac);
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (trafFac, "Profile=mtc"), true,
+                         "Slice3 traffic profile overwritten");
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (ctrlFac, "Quota=0"), true,
+                         "Slice3 controller quota not dropped");
+  NS_TEST_EXPECT_MSG_EQ ((netFac.GetTypeId () == network.GetTypeId ()), true,
+                         "Slice3 network factory not replicated");
+
+  // A generic slice without factories replicates the MTC factories, with
+  // the MTC traffic profile and without the controller quota.
+  helper->GetSliceFactories (static_cast<SliceId> (4),
+                             ctrlFac, netFac, trafFac);
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (trafFac, "Profile=mtc"), true,
+                         "Slice4 traffic profile not set");
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (ctrlFac, "Quota=0"), true,
+                         "Slice4 controller quota not dropped");
+
+  // The replicated named slice factories remain untouched.
+  helper->GetSliceFactories (SliceId::MTC, ctrlFac, netFac, trafFac);
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (ctrlFac, "Quota=20"), true,
+                         "MTC controller quota changed");
+  NS_TEST_EXPECT_MSG_EQ (HasAttribute (trafFac, "Profile=mtc"), false,
+                         "MTC traffic profile set");
+}
+
+/**
+ * \ingroup uni5on
+ * ScenarioHelper test suite.
+ */
+class ScenarioHelperTestSuite : public TestSuite
+{
+public:
+  ScenarioHelperTestSuite ();  //!< Default constructor.
+};
+
+ScenarioHelperTestSuite::ScenarioHelperTestSuite ()
+  : TestSuite ("uni5on-scenario-helper", UNIT)
+{
+  AddTestCase (new ScenarioHelperSliceFactoryTestCase (), TestCase::QUICK);
+}
+
+/** ScenarioHelperTestSuite instance variable. */
+static ScenarioHelperTestSuite g_scenarioHelperTestSuite;
+
+} // namespace ns3
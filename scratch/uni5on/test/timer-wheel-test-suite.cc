@@ -0,0 +1,307 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <vector>
+#include <ns3/core-module.h>
+#include "../logical/timer-wheel.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup uni5onLogical
+ * Base test case for the timer wheel, recording the time each timer fires.
+ */
+class TimerWheelTestCase : public TestCase
+{
+public:
+  /**
+   * Complete constructor.
+   * \param name The test case name.
+   * \param tick The timer wheel tick.
+   */
+  TimerWheelTestCase (std::string name, Time tick);
+
+protected:
+  /**
+   * Schedule a timer that records its firing time.
+   * \param delay The relative expiration time.
+   * \return The timer ID.
+   */
+  TimerWheel::TimerId ScheduleTimer (Time delay);
+
+  /**
+   * Record the firing time of a timer.
+   * \param index The timer index.
+   */
+  void Fire (uint32_t index);
+
+  // Inherited from TestCase.
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+
+  Ptr<TimerWheel>   m_wheel;    //!< The timer wheel under test.
+  std::vector<Time> m_fired;    //!< Firing time by timer index.
+
+private:
+  Time              m_tick;     //!< Timer wheel tick.
+};
+
+TimerWheelTestCase::TimerWheelTestCase (std::string name, Time tick)
+  : TestCase (name),
+  m_tick (tick)
+{
+}
+
+TimerWheel::TimerId
+TimerWheelTestCase::ScheduleTimer (Time delay)
+{
+  // Timers that never fire keep the negative time.
+  uint32_t index = m_fired.size ();
+  m_fired.push_back (Seconds (-1));
+  return m_wheel->Schedule (delay, &TimerWheelTestCase::Fire, this, index);
+}
+
+void
+TimerWheelTestCase::Fire (uint32_t index)
+{
+  NS_TEST_EXPECT_MSG_LT (m_fired [index], Time (0), "Timer fired twice");
+  m_fired [index] = Simulator::Now ();
+}
+
+void
+TimerWheelTestCase::DoSetup (void)
+{
+  m_wheel = CreateObjectWithAttributes<TimerWheel> (
+      "Tick", TimeValue (m_tick));
+  m_fired.clear ();
+}
+
+void
+TimerWheelTestCase::DoTeardown (void)
+{
+  m_wheel->Dispose ();
+  m_wheel = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup uni5onLogical
+ * Check that timers are rounded up to the wheel tick.
+ */
+class TimerWheelRoundingTestCase : public TimerWheelTestCase
+{
+public:
+  TimerWheelRoundingTestCase ();  //!< Default constructor.
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Schedule a timer from a simulator event.
+   * \param delay The relative expiration time.
+   */
+  void ScheduleLater (Time delay);
+};
+
+TimerWheelRoundingTestCase::TimerWheelRoundingTestCase ()
+  : TimerWheelTestCase ("Rounding up to the wheel tick", MilliSeconds (10))
+{
+}
+
+void
+TimerWheelRoundingTestCase::ScheduleLater (Time delay)
+{
+  ScheduleTimer (delay);
+}
+
+void
+TimerWheelRoundingTestCase::DoRun (void)
+{
+  ScheduleTimer (MilliSeconds (0));
+  ScheduleTimer (MilliSeconds (1));
+  ScheduleTimer (MilliSeconds (10));
+  ScheduleTimer (MilliSeconds (11));
+  Simulator::Schedule (MilliSeconds (15),
+                       &TimerWheelRoundingTestCase::ScheduleLater, this,
+                       MilliSeconds (5));
+  Simulator::Schedule (MilliSeconds (15),
+                       &TimerWheelRoundingTestCase::ScheduleLater, this,
+                       MilliSeconds (6));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_fired [0], MilliSeconds (10), "Zero delay");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [1], MilliSeconds (10), "Within a tick");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [2], MilliSeconds (10), "Exact tick");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [3], MilliSeconds (20), "Over a tick");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [4], MilliSeconds (20), "Exact from 15ms");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [5], MilliSeconds (30), "Over from 15ms");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 0, "Pending timers");
+}
+
+/**
+ * \ingroup uni5onLogical
+ * Check that cancelled timers never fire, including those cancelled by
+ * other timers expiring in the same tick.
+ */
+class TimerWheelCancelTestCase : public TimerWheelTestCase
+{
+public:
+  TimerWheelCancelTestCase ();  //!< Default constructor.
+
+private:
+  virtual void DoRun (void);
+
+  /** Cancel the timer saved in m_victim from a timer wheel event. */
+  void CancelVictim (void);
+
+  TimerWheel::TimerId m_victim;   //!< Timer to be cancelled by another one.
+};
+
+TimerWheelCancelTestCase::TimerWheelCancelTestCase ()
+  : TimerWheelTestCase ("Timer cancellation", MilliSeconds (10))
+{
+}
+
+void
+TimerWheelCancelTestCase::CancelVictim (void)
+{
+  m_wheel->Cancel (m_victim);
+}
+
+void
+TimerWheelCancelTestCase::DoRun (void)
+{
+  TimerWheel::TimerId first = ScheduleTimer (MilliSeconds (20));
+  TimerWheel::TimerId second = ScheduleTimer (MilliSeconds (30));
+  TimerWheel::TimerId far = ScheduleTimer (Seconds (5));
+
+  // The canceller and the cancelled timers expire in the same tick. Timers
+  // in the same tick fire in scheduling order, so the canceller goes first.
+  m_wheel->Schedule (MilliSeconds (45),
+                     &TimerWheelCancelTestCase::CancelVictim, this);
+  m_victim = ScheduleTimer (MilliSeconds (50));
+
+  m_wheel->Cancel (first);
+  m_wheel->Cancel (far);
+  m_wheel->Cancel (far);
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->IsPending (first), false, "Still pending");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->IsPending (second), true, "Not pending");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 3, "Pending timers");
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_LT (m_fired [0], Time (0), "Cancelled timer fired");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [1], MilliSeconds (30), "Timer not fired");
+  NS_TEST_EXPECT_MSG_LT (m_fired [2], Time (0), "Cancelled timer fired");
+  NS_TEST_EXPECT_MSG_LT (m_fired [3], Time (0), "Cancelled timer fired");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (50),
+                         "Wheel event after the last timer");
+
+  // Cancelling an expired timer has no effect.
+  m_wheel->Cancel (second);
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->IsPending (second), false, "Still pending");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 0, "Pending timers");
+}
+
+/**
+ * \ingroup uni5onLogical
+ * Check timers crossing the rotation of the lower levels, which are kept at
+ * higher levels and cascaded down.
+ */
+class TimerWheelWrapTestCase : public TimerWheelTestCase
+{
+public:
+  TimerWheelWrapTestCase ();  //!< Default constructor.
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Schedule a timer from a simulator event.
+   * \param delay The relative expiration time.
+   */
+  void ScheduleLater (Time delay);
+};
+
+TimerWheelWrapTestCase::TimerWheelWrapTestCase ()
+  : TimerWheelTestCase ("Wrap-around and cascading", MilliSeconds (1))
+{
+}
+
+void
+TimerWheelWrapTestCase::ScheduleLater (Time delay)
+{
+  ScheduleTimer (delay);
+}
+
+void
+TimerWheelWrapTestCase::DoRun (void)
+{
+  // With 1ms ticks, level 0 spans 256ms and level 1 spans 65536ms.
+  int64_t delays [] = {255, 256, 257, 511, 512, 65535, 65536, 65537, 70000};
+  for (int64_t delay : delays)
+    {
+      ScheduleTimer (MilliSeconds (delay));
+    }
+
+  // Timers scheduled after the wheel moved near the end of a rotation.
+  Simulator::Schedule (MilliSeconds (200),
+                       &TimerWheelWrapTestCase::ScheduleLater, this,
+                       MilliSeconds (100));
+  Simulator::Schedule (MilliSeconds (65500),
+                       &TimerWheelWrapTestCase::ScheduleLater, this,
+                       MilliSeconds (40));
+  Simulator::Run ();
+
+  uint32_t n = sizeof (delays) / sizeof (delays [0]);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_fired [i], MilliSeconds (delays [i]),
+                             "Unexpected firing time for delay " <<
+                             delays [i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_fired [n], MilliSeconds (300),
+                         "Unexpected firing time across level 0");
+  NS_TEST_EXPECT_MSG_EQ (m_fired [n + 1], MilliSeconds (65540),
+                         "Unexpected firing time across level 1");
+  NS_TEST_EXPECT_MSG_EQ (m_wheel->GetNPending (), 0, "Pending timers");
+}
+
+/**
+ * \ingroup uni5onLogical
+ * TimerWheel test suite.
+ */
+class TimerWheelTestSuite : public TestSuite
+{
+public:
+  TimerWheelTestSuite ();  //!< Default constructor.
+};
+
+TimerWheelTestSuite::TimerWheelTestSuite ()
+  : TestSuite ("uni5on-timer-wheel", UNIT)
+{
+  AddTestCase (new TimerWheelRoundingTestCase (), TestCase::QUICK);
+  AddTestCase (new TimerWheelCancelTestCase (), TestCase::QUICK);
+  AddTestCase (new TimerWheelWrapTestCase (), TestCase::QUICK);
+}
+
+/** TimerWheelTestSuite instance variable. */
+static TimerWheelTestSuite g_timerWheelTestSuite;
+
+} // namespace ns3
@@ -18,12 +18,15 @@
  * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
  */
 
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <unistd.h>
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
+#include <ns3/ofswitch13-module.h>
 #include "uni5on-common.h"
 
 using namespace std;
@@ -32,6 +35,50 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Uni5onCommon");
 
+// Global values are defined here instead of in main.cc, as they are also
+// required by the uni5on-test program.
+
+// Prefixes used by input and output filenames.
+static GlobalValue
+  g_inputPrefix ("InputPrefix", "Common prefix for output filenames.",
+                 StringValue (std::string ()),
+                 MakeStringChecker ());
+
+static GlobalValue
+  g_outputPrefix ("OutputPrefix", "Common prefix for input filenames.",
+                  StringValue (std::string ()),
+                  MakeStringChecker ());
+
+// Dump timeout for logging statistics.
+static GlobalValue
+  g_dumpTimeout ("DumpStatsTimeout", "Periodic statistics dump interval.",
+                 TimeValue (Seconds (1)),
+                 MakeTimeChecker ());
+
+// Simulation lenght.
+static GlobalValue
+  g_simTime ("SimTime", "Simulation stop time.",
+             TimeValue (Seconds (0)),
+             MakeTimeChecker ());
+
+// Number of logical slices.
+static GlobalValue
+  g_numSlices ("NumSlices", "The number of LTE logical slices.",
+               UintegerValue (3),
+               MakeUintegerChecker<uint16_t> (1, N_SLICE_IDS));
+
+// OpenFlow datapath timeout interval.
+static GlobalValue
+  g_dpTimeout ("DatapathTimeout", "OpenFlow datapath timeout interval.",
+               TimeValue (MilliSeconds (50)),
+               MakeTimeChecker (MilliSeconds (1), Seconds (1)));
+
+// Flag for error messages at the stderr stream.
+static GlobalValue
+  g_seeLogs ("SeeCerr", "Tell user to check the stderr stream.",
+             BooleanValue (false),
+             MakeBooleanChecker ());
+
 std::string
 DirectionStr (Direction dir)
 {
@@ -116,11 +163,51 @@ SliceIdStr (SliceId slice)
     case SliceId::UNKN:
       return "unknown";
     default:
+      if (slice < N_SLICE_IDS)
+        {
+          return "slice" + std::to_string (static_cast<int> (slice));
+        }
       NS_LOG_ERROR ("Invalid logical slice ID.");
       return std::string ();
     }
 }
 
+int
+GetNSlices (void)
+{
+  UintegerValue uintegerValue;
+  GlobalValue::GetValueByName ("NumSlices", uintegerValue);
+  return static_cast<int> (uintegerValue.Get ());
+}
+
+std::vector<SliceId>
+GetSliceIds (bool all)
+{
+  std::vector<SliceId> slices;
+  for (int s = 0; s < GetNSlices (); s++)
+    {
+      slices.push_back (static_cast<SliceId> (s));
+    }
+  if (all)
+    {
+      slices.push_back (SliceId::ALL);
+    }
+  return slices;
+}
+
+Ptr<const AttributeChecker>
+MakeSliceIdChecker (void)
+{
+  Ptr<EnumChecker> checker = Create<EnumChecker> ();
+  checker->AddDefault (SliceId::HTC, SliceIdStr (SliceId::HTC));
+  for (int s = 1; s < N_SLICE_IDS; s++)
+    {
+      SliceId slice = static_cast<SliceId> (s);
+      checker->Add (slice, SliceIdStr (slice));
+    }
+  return checker;
+}
+
 std::string
 SliceModeStr (SliceMode mode)
 {
@@ -427,6 +514,44 @@ GetUint64Hex (uint64_t value)
   return std::string (valueStr);
 }
 
+std::string
+OflMsgToString (struct ofl_msg_header *msg)
+{
+  char *cStr = ofl_msg_to_string (msg, 0);
+  std::string msgStr (cStr);
+  free (cStr);
+  return msgStr;
+}
+
+CtrlMsgTrace::WallTime_t
+CtrlMsgTrace::Start (void) const
+{
+  return IsEmpty () ? WallTime_t () : std::chrono::steady_clock::now ();
+}
+
+void
+CtrlMsgTrace::Notify (uint64_t dpId, std::string type, uint32_t length,
+                      WallTime_t start) const
+{
+  if (!IsEmpty ())
+    {
+      std::chrono::nanoseconds wall =
+        std::chrono::steady_clock::now () - start;
+      (*this)(dpId, type, length, wall.count ());
+    }
+}
+
+void
+CtrlMsgTrace::NotifyDpctl (uint64_t dpId, const std::string &textCmd,
+                           WallTime_t start) const
+{
+  if (!IsEmpty ())
+    {
+      Notify (dpId, textCmd.substr (0, textCmd.find (' ')), textCmd.size (),
+              start);
+    }
+}
+
 void
 SetDeviceNames (Ptr<NetDevice> src, Ptr<NetDevice> dst, std::string desc)
 {
@@ -436,4 +561,27 @@ SetDeviceNames (Ptr<NetDevice> src, Ptr<NetDevice> dst, std::string desc)
               Names::FindName (src->GetNode ()), dst);
 }
 
+void
+ReseedStream (Ptr<RandomVariableStream> rng)
+{
+  if (rng)
+    {
+      rng->SetStream (rng->GetStream ());
+    }
+}
+
+int64_t
+GetResidentBytes (void)
+{
+  // The second field in statm is the resident set size in pages.
+  int64_t size = 0, resident = 0;
+  std::ifstream statm ("/proc/self/statm");
+  if (!(statm >> size >> resident))
+    {
+      NS_LOG_WARN ("Can't read the process resident set size.");
+      return 0;
+    }
+  return resident * sysconf (_SC_PAGESIZE);
+}
+
 } // namespace ns3
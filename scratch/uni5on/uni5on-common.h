@@ -21,12 +21,16 @@
 #ifndef UNI5ON_COMMON_H
 #define UNI5ON_COMMON_H
 
+#include <chrono>
 #include <string>
+#include <vector>
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
 #include <ns3/lte-module.h>
 
+struct ofl_msg_header;
+
 namespace ns3 {
 
 // TEID masks for OpenFlow matching.
@@ -150,9 +154,12 @@ typedef enum
 
 /**
  * \ingroup uni5on
- * Enumeration of available logical slices IDs.
+ * Enumeration of available logical slices IDs. Only the first slices have
+ * names. The IDs in the range [3, 14] are valid generic slices, used when the
+ * number of slices configured by the NumSlices global value is larger than
+ * the number of named slices.
  * \internal Slice IDs are restricted to the range [0, 14] by the current
- * TEID allocation strategy.
+ * TEID allocation strategy. The ALL value must fit in the meter ID too.
  */
 typedef enum
 {
@@ -160,11 +167,11 @@ typedef enum
   HTC  = 0,  //!< Slice for HTC UEs.
   MTC  = 1,  //!< Slice for MTC UEs.
   TMP  = 2,  //!< Slice for TMP UEs.
-  ALL  = 3,  //!< ALL previous slices.
-  UNKN = 4   //!< Unknown slice.
+  ALL  = 15, //!< ALL previous slices.
+  UNKN = 16  //!< Unknown slice.
 } SliceId;
 
-// Total number of valid SliceId items.
+// Total number of valid SliceId items (the maximum number of slices).
 #define N_SLICE_IDS (static_cast<int> (SliceId::ALL))
 #define N_SLICE_IDS_ALL (static_cast<int> (SliceId::ALL) + 1)
 #define N_SLICE_IDS_UNKN (static_cast<int> (SliceId::UNKN) + 1)
@@ -224,6 +231,30 @@ std::string QosTypeStr (QosType type);
  */
 std::string SliceIdStr (SliceId slice);
 
+/**
+ * \ingroup uni5on
+ * Get the number of logical slices in use, as configured by the NumSlices
+ * global value.
+ * \return The number of logical slices.
+ */
+int GetNSlices (void);
+
+/**
+ * \ingroup uni5on
+ * Get the list of logical slice IDs in use.
+ * \param all Include the ALL slice ID at the end of the list.
+ * \return The list of slice IDs.
+ */
+std::vector<SliceId> GetSliceIds (bool all = false);
+
+/**
+ * \ingroup uni5on
+ * Create the attribute checker for slice ID enum attributes, accepting all
+ * valid slice IDs.
+ * \return The attribute checker.
+ */
+Ptr<const AttributeChecker> MakeSliceIdChecker (void);
+
 /**
  * \ingroup uni5on
  * Get the inter-slicing operation mode name.
@@ -487,6 +518,61 @@ std::string GetUint32Hex (uint32_t value);
  */
 std::string GetUint64Hex (uint64_t value);
 
+/**
+ * \ingroup uni5on
+ * Render the OpenFlow message as a string. This is expensive, so only call it
+ * when the message text will actually be printed.
+ * \param msg The OpenFlow message.
+ * \return The message string.
+ */
+std::string OflMsgToString (struct ofl_msg_header *msg);
+
+/**
+ * \ingroup uni5on
+ * Trace source for OpenFlow messages exchanged between a controller and the
+ * switches, carrying the datapath ID, message type, message length and the
+ * wall-clock time spent handling the message (ns). The wall clock is only read
+ * when the trace has sinks connected. The length of received messages is the
+ * OpenFlow message size in bytes, without the OXM match. The length of sent
+ * messages is the dpctl command text length.
+ */
+class CtrlMsgTrace
+  : public TracedCallback<uint64_t, std::string, uint32_t, int64_t>
+{
+public:
+  /** Wall-clock time point. */
+  typedef std::chrono::steady_clock::time_point WallTime_t;
+
+  /**
+   * Get the wall-clock time when the handling of a message starts.
+   * \return The current wall-clock time, or the clock epoch when the trace
+   *         has no sinks.
+   */
+  WallTime_t Start (void) const;
+
+  /**
+   * Fire the trace for a message whose handling started at the given time.
+   * \param dpId The OpenFlow datapath ID.
+   * \param type The message type.
+   * \param length The message length.
+   * \param start The wall-clock time when the message handling started.
+   */
+  void Notify (uint64_t dpId, std::string type, uint32_t length,
+               WallTime_t start) const;
+
+  /**
+   * Fire the trace for a dpctl command whose execution started at the given
+   * time. The message type is the dpctl command name, like flow-mod or
+   * meter-mod, and the message length is the command text length, as the
+   * OpenFlow message is only built inside the OFSwitch13 controller.
+   * \param dpId The OpenFlow datapath ID.
+   * \param textCmd The dpctl command.
+   * \param start The wall-clock time when the command execution started.
+   */
+  void NotifyDpctl (uint64_t dpId, const std::string &textCmd,
+                    WallTime_t start) const;
+};
+
 /**
  * \ingroup uni5on
  * Set the devices names identifying the connection between the nodes.
@@ -496,5 +582,22 @@ std::string GetUint64Hex (uint64_t value);
  */
 void SetDeviceNames (Ptr<NetDevice> src, Ptr<NetDevice> dst, std::string desc);
 
+/**
+ * \ingroup uni5on
+ * Reseed the random variable stream with the current RngSeedManager seed and
+ * run numbers, keeping its distribution parameters. Streams with automatic
+ * assignment get a new stream index, so calling this for the same set of
+ * streams in the same order is deterministic.
+ * \param rng The random variable stream.
+ */
+void ReseedStream (Ptr<RandomVariableStream> rng);
+
+/**
+ * \ingroup uni5on
+ * Get the resident set size of this process.
+ * \return The resident set size in bytes, or zero when not available.
+ */
+int64_t GetResidentBytes (void);
+
 } // namespace ns3
 #endif // UNI5ON_COMMON_H
@@ -27,6 +27,8 @@
 #include "log.h"
 
 #include <sstream>
+#include <map>
+#include <vector>
 
 /**
  * \file
@@ -124,6 +126,18 @@ MatchContainer::ConnectWithoutContext (std::string name, const CallbackBase &cb)
     }
 }
 void 
+MatchContainer::ConnectWithContextId (std::string name, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << name << &cb);
+  NS_ASSERT (m_objects.size () == m_contexts.size ());
+  for (uint32_t i = 0; i < m_objects.size (); ++i)
+    {
+      Ptr<Object> object = m_objects[i];
+      uint32_t ctxId = Config::GetContextId (m_contexts[i] + name);
+      object->TraceConnectWithContextId (name, ctxId, cb);
+    }
+}
+void 
 MatchContainer::Disconnect (std::string name, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (this << name << &cb);
@@ -145,11 +159,27 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
       object->TraceDisconnectWithoutContext (name, cb);
     }
 }
+void 
+MatchContainer::DisconnectWithContextId (std::string name, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << name << &cb);
+  NS_ASSERT (m_objects.size () == m_contexts.size ());
+  for (uint32_t i = 0; i < m_objects.size (); ++i)
+    {
+      Ptr<Object> object = m_objects[i];
+      uint32_t ctxId = Config::GetContextId (m_contexts[i] + name);
+      object->TraceDisconnectWithContextId (name, ctxId, cb);
+    }
+}
 
 
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The path specification is parsed once at construction time into a list
+ * of index ranges, so testing each entry of large object containers (like
+ * the NodeList) is only a few integer comparisons.
  */
 class ArrayMatcher
 {
@@ -168,6 +198,13 @@ public:
    */
   bool Matches (std::size_t i) const;
 private:
+  /**
+   * Parse a single alternative of the Config path specification
+   * (without the '|' separator) into the list of index ranges.
+   *
+   * \param [in] token The Config path specification alternative.
+   */
+  void Parse (std::string token);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -178,75 +215,83 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Whether the Config path element matches any index. */
+  bool m_matchAll;
+  /** The [min, max] index ranges matching the Config path element. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_matchAll (false)
 {
   NS_LOG_FUNCTION (this << element);
-}
-bool
-ArrayMatcher::Matches (std::size_t i) const
-{
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+
+  std::string::size_type start = 0;
+  std::string::size_type tmp = m_element.find ("|");
+  while (tmp != std::string::npos)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      Parse (m_element.substr (start, tmp - start));
+      start = tmp + 1;
+      tmp = m_element.find ("|", start);
     }
-  std::string::size_type tmp;
-  tmp = m_element.find ("|");
-  if (tmp != std::string::npos)
+  Parse (m_element.substr (start));
+}
+
+void
+ArrayMatcher::Parse (std::string token)
+{
+  NS_LOG_FUNCTION (this << token);
+  if (token == "*")
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      m_matchAll = true;
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = token.find ("[");
+  std::string::size_type rightBracket = token.find ("]");
+  std::string::size_type dash = token.find ("-");
+  if (leftBracket == 0 && rightBracket == token.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = token.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = token.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
-      if (StringToUint32 (lowerBound, &min) && 
+      if (StringToUint32 (lowerBound, &min) &&
           StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
-        }
-      else
+          min <= max)
         {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (token, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_matchAll)
     {
       NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
       return true;
     }
+  std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it;
+  for (it = m_ranges.begin (); it != m_ranges.end (); it++)
+    {
+      if (i >= it->first && i <= it->second)
+        {
+          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
@@ -324,6 +369,38 @@ private:
    */
   virtual void DoOne (Ptr<Object> object, std::string path) = 0;
 
+  /**
+   * \ingroup config-impl
+   * Pointer or object container attribute matching a Config path item.
+   */
+  struct PathAttribute
+  {
+    std::string name;   //!< The attribute name.
+    bool isPointer;     //!< The attribute holds a pointer to an Object.
+    bool isContainer;   //!< The attribute holds an Object container.
+  };
+  /** Pointer and object container attributes matching a Config path item. */
+  typedef std::vector<struct PathAttribute> PathAttributeList_t;
+  /**
+   * Get the pointer and object container attributes for the given TypeId
+   * (including parent TypeIds) that match a Config path item.
+   *
+   * Looking up the attributes through the TypeId hierarchy is expensive, and
+   * wildcard paths like "/NodeList/<wildcard>/DeviceList/<wildcard>" do it
+   * again for every object on the path. The matching attributes are kept in
+   * an index by TypeId and path item shared by all resolvers, so they are
+   * looked up only once for each object type. Note that the index doesn't
+   * skip any object: a wildcard path still visits every object in the
+   * matched containers.
+   *
+   * \param [in] tid The object instance TypeId.
+   * \param [in] item The Config path item.
+   * \returns The list of matching attributes, owned by the index. Later
+   *          calls may rebuild it when attributes have been added.
+   */
+  static const PathAttributeList_t &GetPathAttributes (TypeId tid,
+                                                       std::string item);
+
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
   /** The Config path. */
@@ -483,62 +560,45 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   else 
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
       bool foundMatch = false;
-      
-      do
+      // The list is owned by the index, and the recursion may rebuild it if
+      // attributes are added meanwhile, so each entry is copied before use.
+      const PathAttributeList_t &attributes =
+        GetPathAttributes (root->GetInstanceTypeId (), item);
+
+      for (std::size_t i = 0; i < attributes.size (); i++)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          const struct PathAttribute attribute = attributes [i];
+          if (attribute.isPointer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<attribute.name<<" on path="<<GetResolvedPath ());
+              PointerValue pValue;
+              root->GetAttribute (attribute.name, pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer(info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              m_workStack.push_back (attribute.name);
+              DoResolve (pathLeft, object);
+              m_workStack.pop_back ();
+            }
+          if (attribute.isContainer)
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<attribute.name<<" on path="<<GetResolvedPath () << pathLeft);
+              foundMatch = true;
+              ObjectPtrContainerValue vector;
+              root->GetAttribute (attribute.name, vector);
+              m_workStack.push_back (attribute.name);
+              DoArrayResolve (pathLeft, vector);
+              m_workStack.pop_back ();
             }
+        }
 
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
-      
       if (!foundMatch)
         {
           NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
@@ -547,6 +607,59 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     }
 }
 
+const Resolver::PathAttributeList_t &
+Resolver::GetPathAttributes (TypeId tid, std::string item)
+{
+  NS_LOG_FUNCTION (tid << item);
+
+  /** Matching attributes and the attribute version they came from. */
+  typedef std::pair<uint32_t, PathAttributeList_t> IndexEntry_t;
+  static std::map<std::pair<uint16_t, std::string>, IndexEntry_t> index;
+
+  // Attributes can be added to existing TypeIds at any time, so the entry is
+  // only valid while the global attribute version is unchanged.
+  uint32_t version = TypeId::GetAttributeVersion ();
+  std::pair<uint16_t, std::string> key (tid.GetUid (), item);
+  auto it = index.find (key);
+  if (it != index.end () && it->second.first == version)
+    {
+      return it->second.second;
+    }
+
+  IndexEntry_t &entry = index [key];
+  entry.first = version;
+  entry.second.clear ();
+  TypeId currTid;
+  TypeId nextTid = tid;
+  do
+    {
+      currTid = nextTid;
+      for (uint32_t i = 0; i < currTid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = currTid.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          // attempt to cast to a pointer checker or to an object vector.
+          // Anything else we don't know what to do with, so we ignore it.
+          struct PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.isPointer =
+            dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0;
+          attribute.isContainer =
+            dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0;
+          if (attribute.isPointer || attribute.isContainer)
+            {
+              entry.second.push_back (attribute);
+            }
+        }
+      nextTid = currTid.GetParent ();
+    } while (nextTid != currTid);
+  return entry.second;
+}
+
 void 
 Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
 {
@@ -593,6 +706,14 @@ public:
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   /** \copydoc Config::Disconnect() */
   void Disconnect (std::string path, const CallbackBase &cb);
+  /** \copydoc Config::ConnectWithContextId() */
+  void ConnectWithContextId (std::string path, const CallbackBase &cb);
+  /** \copydoc Config::DisconnectWithContextId() */
+  void DisconnectWithContextId (std::string path, const CallbackBase &cb);
+  /** \copydoc Config::GetContextId() */
+  uint32_t GetContextId (std::string context);
+  /** \copydoc Config::GetContextName() */
+  const std::string & GetContextName (uint32_t contextId) const;
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
 
@@ -622,6 +743,11 @@ private:
   /** The list of Config path roots. */
   Roots m_roots;
 
+  /** The interned context strings, indexed by context identifier. */
+  std::vector<std::string> m_contextNames;
+  /** The context identifiers, indexed by context string. */
+  std::map<std::string, uint32_t> m_contextIds;
+
 };  // class ConfigImpl
 
 void 
@@ -685,6 +811,47 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
   container.Disconnect (leaf, cb);
 }
 
+void 
+ConfigImpl::ConnectWithContextId (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path << &cb);
+
+  std::string root, leaf;
+  ParsePath (path, &root, &leaf);
+  MatchContainer container = LookupMatches (root);
+  container.ConnectWithContextId (leaf, cb);
+}
+void 
+ConfigImpl::DisconnectWithContextId (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path << &cb);
+
+  std::string root, leaf;
+  ParsePath (path, &root, &leaf);
+  MatchContainer container = LookupMatches (root);
+  container.DisconnectWithContextId (leaf, cb);
+}
+uint32_t 
+ConfigImpl::GetContextId (std::string context)
+{
+  NS_LOG_FUNCTION (this << context);
+
+  std::pair<std::map<std::string, uint32_t>::iterator, bool> ret;
+  ret = m_contextIds.insert (std::make_pair (context, m_contextNames.size ()));
+  if (ret.second)
+    {
+      m_contextNames.push_back (context);
+    }
+  return ret.first->second;
+}
+const std::string & 
+ConfigImpl::GetContextName (uint32_t contextId) const
+{
+  NS_ASSERT_MSG (contextId < m_contextNames.size (),
+                 "Unknown context identifier " << contextId);
+  return m_contextNames[contextId];
+}
+
 MatchContainer 
 ConfigImpl::LookupMatches (std::string path)
 {
@@ -851,6 +1018,29 @@ Disconnect (std::string path, const CallbackBase &cb)
   NS_LOG_FUNCTION (path << &cb);
   ConfigImpl::Get ()->Disconnect (path, cb);
 }
+void 
+ConnectWithContextId (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path << &cb);
+  ConfigImpl::Get ()->ConnectWithContextId (path, cb);
+}
+void 
+DisconnectWithContextId (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (path << &cb);
+  ConfigImpl::Get ()->DisconnectWithContextId (path, cb);
+}
+uint32_t 
+GetContextId (std::string context)
+{
+  NS_LOG_FUNCTION (context);
+  return ConfigImpl::Get ()->GetContextId (context);
+}
+const std::string & 
+GetContextName (uint32_t contextId)
+{
+  return ConfigImpl::Get ()->GetContextName (contextId);
+}
 MatchContainer LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (path);
@@ -139,6 +139,44 @@ void Connect (std::string path, const CallbackBase &cb);
  * This function undoes the work of Config::ConnectWithContext.
  */
 void Disconnect (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to connect to the matching trace sources.
+ *
+ * This function will attempt to find all trace sources which
+ * match the input path and will then connect the input callback
+ * to them in such a way that the callback will receive an extra
+ * context identifier upon trace event notification. The identifier
+ * is the interned context string (see Config::GetContextName ()), so
+ * no string is copied when the trace source fires.
+ */
+void ConnectWithContextId (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] path A path to match trace sources.
+ * \param [in] cb The callback to disconnect to the matching trace sources.
+ *
+ * This function undoes the work of Config::ConnectWithContextId.
+ */
+void DisconnectWithContextId (std::string path, const CallbackBase &cb);
+/**
+ * \ingroup config
+ * \param [in] context The context string.
+ * \returns The interned context identifier.
+ *
+ * Get the unique identifier for this context string, interning it if this
+ * is the first time it is seen. Identifiers are dense and start at zero.
+ */
+uint32_t GetContextId (std::string context);
+/**
+ * \ingroup config
+ * \param [in] contextId The interned context identifier.
+ * \returns The context string.
+ *
+ * The returned reference remains valid for the whole simulation.
+ */
+const std::string & GetContextName (uint32_t contextId);
 
 /**
  * \ingroup config
@@ -222,6 +260,15 @@ public:
    * \sa ns3::Config::ConnectWithoutContext
    */
   void ConnectWithoutContext (std::string name, const CallbackBase &cb);
+  /**
+   * \param [in] name The name of the trace source to connect to
+   * \param [in] cb The sink to connect to the trace source
+   *
+   * Connect the specified sink to all the objects stored in this
+   * container.
+   * \sa ns3::Config::ConnectWithContextId
+   */
+  void ConnectWithContextId (std::string name, const CallbackBase &cb);
   /**
    * \param [in] name The name of the trace source to disconnect from
    * \param [in] cb The sink to disconnect from the trace source
@@ -240,6 +287,15 @@ public:
    * \sa ns3::Config::DisconnectWithoutContext
    */
   void DisconnectWithoutContext (std::string name, const CallbackBase &cb);
+  /**
+   * \param [in] name The name of the trace source to disconnect from
+   * \param [in] cb The sink to disconnect from the trace source
+   *
+   * Disconnect the specified sink from all the objects stored in this
+   * container.
+   * \sa ns3::Config::DisconnectWithContextId
+   */
+  void DisconnectWithContextId (std::string name, const CallbackBase &cb);
   
 private:
   /** The list of objects in this container. */
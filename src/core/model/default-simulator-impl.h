@@ -78,6 +78,18 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /**
+   * Get the number of events processed so far.
+   * \return The number of events invoked by Run.
+   */
+  uint64_t GetEventCount (void) const;
+  /**
+   * Get the number of events waiting in the event queue. Cancelled events
+   * are still counted until they are removed from the queue.
+   * \return The number of pending events.
+   */
+  uint32_t GetPendingEventCount (void) const;
+
 private:
   virtual void DoDispose (void);
 
@@ -129,6 +141,8 @@ private:
    *  not counting the Destroy events; this is used for validation
    */
   int m_unscheduledEvents;
+  /** The number of events processed so far. */
+  uint64_t m_eventCount;
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
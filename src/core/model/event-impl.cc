@@ -66,4 +66,11 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+const ObjectBase *
+EventImpl::PeekReceiver (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return 0;
+}
+
 } // namespace ns3
@@ -31,6 +31,8 @@
 
 namespace ns3 {
 
+class ObjectBase;
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -65,6 +67,12 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Get the object whose method is invoked by this event, when this
+   * object is an ns-3 ObjectBase.
+   * \return The receiver object, or 0 for other events.
+   */
+  virtual const ObjectBase * PeekReceiver (void) const;
 
 protected:
   /**
@@ -317,6 +317,8 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <type_traits>
+
 namespace ns3 {
 
 /**
@@ -355,6 +357,41 @@ struct EventMemberImplObjTraits<T *>
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Helper for the MakeEvent functions which take a class method.
+ *
+ * Get the event receiver when it is an ObjectBase.
+ *
+ * \tparam T \deduced The class type.
+ * \param [in] obj The event receiver.
+ * \return The receiver as an ObjectBase.
+ */
+template <typename T>
+typename std::enable_if<std::is_base_of<ObjectBase, T>::value,
+                        const ObjectBase *>::type
+EventMemberImplPeekReceiver (T &obj)
+{
+  return &obj;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Helper for the MakeEvent functions which take a class method.
+ *
+ * Other receivers are not ObjectBase.
+ *
+ * \tparam T \deduced The class type.
+ * \return A null pointer.
+ */
+template <typename T>
+typename std::enable_if<!std::is_base_of<ObjectBase, T>::value,
+                        const ObjectBase *>::type
+EventMemberImplPeekReceiver (T &)
+{
+  return 0;
+}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -375,6 +412,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -405,6 +447,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -436,6 +483,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -469,6 +521,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -504,6 +561,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -542,6 +604,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -582,6 +649,11 @@ private:
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual const ObjectBase * PeekReceiver (void) const
+    {
+      return EventMemberImplPeekReceiver (
+               EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
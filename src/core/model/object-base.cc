@@ -341,6 +341,32 @@ ObjectBase::TraceDisconnect (std::string name, std::string context, const Callba
   bool ok = accessor->Disconnect (this, context, cb);
   return ok;
 }
+bool 
+ObjectBase::TraceConnectWithContextId (std::string name, uint32_t contextId, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << name << contextId << &cb);
+  TypeId tid = GetInstanceTypeId ();
+  Ptr<const TraceSourceAccessor> accessor = tid.LookupTraceSourceByName (name);
+  if (accessor == 0)
+    {
+      return false;
+    }
+  bool ok = accessor->ConnectWithContextId (this, contextId, cb);
+  return ok;
+}
+bool 
+ObjectBase::TraceDisconnectWithContextId (std::string name, uint32_t contextId, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << name << contextId << &cb);
+  TypeId tid = GetInstanceTypeId ();
+  Ptr<const TraceSourceAccessor> accessor = tid.LookupTraceSourceByName (name);
+  if (accessor == 0)
+    {
+      return false;
+    }
+  bool ok = accessor->DisconnectWithContextId (this, contextId, cb);
+  return ok;
+}
 
 
 
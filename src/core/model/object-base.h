@@ -229,6 +229,31 @@ public:
    * \returns \c true.
    */
   bool TraceDisconnect (std::string name, std::string context, const CallbackBase &cb);
+  /**
+   * Connect a TraceSource to a Callback with an interned context identifier.
+   *
+   * The target trace source should be registered with TypeId::AddTraceSource.
+   *
+   * \param [in] name The name of the target trace source.
+   * \param [in] contextId The trace context identifier associated to the
+   *             callback.
+   * \param [in] cb The callback to connect to the trace source.
+   * \returns \c true.
+   */
+  bool TraceConnectWithContextId (std::string name, uint32_t contextId, const CallbackBase &cb);
+  /**
+   * Disconnect from a TraceSource a Callback previously connected
+   * with an interned context identifier.
+   *
+   * The target trace source should be registered with TypeId::AddTraceSource.
+   *
+   * \param [in] name The name of the target trace source.
+   * \param [in] contextId The trace context identifier associated to the
+   *             callback.
+   * \param [in] cb The callback to disconnect from the trace source.
+   * \returns \c true.
+   */
+  bool TraceDisconnectWithContextId (std::string name, uint32_t contextId, const CallbackBase &cb);
   /**
    * Disconnect from a TraceSource a Callback previously connected
    * without a context.
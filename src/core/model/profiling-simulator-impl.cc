@@ -0,0 +1,456 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "profiling-simulator-impl.h"
+#include "event-impl.h"
+#include "object-base.h"
+#include "type-id.h"
+#include "string.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ProfilingSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("ProfilingSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (ProfilingSimulatorImpl);
+
+namespace {
+
+/**
+ * \ingroup simulator
+ * Get the current wall-clock time in nanoseconds.
+ * \return The monotonic wall-clock time.
+ */
+inline int64_t
+WallNowNs (void)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (
+    std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+/**
+ * \ingroup simulator
+ * Event wrapper measuring the wall-clock time of the original event.
+ */
+class ProfiledEventImpl : public EventImpl
+{
+public:
+  /**
+   * Constructor.
+   * \param profiler The profiling simulator implementation.
+   * \param event The original event, whose reference is taken.
+   */
+  ProfiledEventImpl (ProfilingSimulatorImpl *profiler, EventImpl *event)
+    : m_profiler (profiler),
+      m_event (event, false)
+  {
+  }
+
+protected:
+  virtual void Notify (void)
+  {
+    // Get the receiver TypeId before the event, which may dispose it.
+    const ObjectBase *receiver = m_event->PeekReceiver ();
+    uint16_t tid = receiver ? receiver->GetInstanceTypeId ().GetUid () : 0;
+
+    int64_t start = WallNowNs ();
+    m_event->Invoke ();
+    m_profiler->NotifyEventDone (PeekPointer (m_event), tid,
+                                 WallNowNs () - start);
+  }
+
+private:
+  ProfilingSimulatorImpl *m_profiler;   //!< The profiler.
+  Ptr<EventImpl>          m_event;      //!< The original event.
+};
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ type name.
+ * \param mangled The mangled type name.
+ * \return The demangled type name, or the mangled one on errors.
+ */
+std::string
+DemangleTypeName (const char *mangled)
+{
+  std::string ret (mangled);
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  if (status == 0 && demangled)
+    {
+      ret = demangled;
+    }
+  std::free (demangled);
+#endif
+  return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Remove folded stack separators from a frame name.
+ * \param frame The frame name.
+ * \return The sanitized frame name.
+ */
+std::string
+FoldedFrame (std::string frame)
+{
+  std::replace (frame.begin (), frame.end (), ';', ',');
+  std::replace (frame.begin (), frame.end (), ' ', '_');
+  return frame;
+}
+
+/**
+ * \ingroup simulator
+ * Comparator for decreasing wall-clock time.
+ * \param a The first component statistics.
+ * \param b The second component statistics.
+ * \return True if a spent more wall-clock time than b.
+ */
+bool
+WallTimeComp (const ProfilingSimulatorImpl::ComponentStats &a,
+              const ProfilingSimulatorImpl::ComponentStats &b)
+{
+  return a.wallNs > b.wallNs;
+}
+
+} // unnamed namespace
+
+TypeId
+ProfilingSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ProfilingSimulatorImpl")
+    .SetParent<DefaultSimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<ProfilingSimulatorImpl> ()
+    .AddAttribute ("ReportFilename",
+                   "Filename for the sorted wall-clock profiling report.",
+                   StringValue ("simulator-profile.log"),
+                   MakeStringAccessor (
+                     &ProfilingSimulatorImpl::m_reportFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("FoldedFilename",
+                   "Filename for the flamegraph folded stack output.",
+                   StringValue ("simulator-profile.folded"),
+                   MakeStringAccessor (
+                     &ProfilingSimulatorImpl::m_foldedFilename),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl ()
+  : m_runWallNs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ProfilingSimulatorImpl::~ProfilingSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::vector<ProfilingSimulatorImpl::ComponentStats>
+ProfilingSimulatorImpl::GetStats (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  // Different event types (template instantiations with different object
+  // pointer types or duplicated type info across shared libraries) may map
+  // to the same component and signature. Merge them here.
+  std::map<std::string, ComponentStats> merged;
+  for (auto const &it : m_counters)
+    {
+      ComponentStats stats = ParseEventType (it.first.type, it.first.tid);
+      std::string key = stats.component + "\n" + stats.signature;
+      auto ret = merged.insert (std::make_pair (key, stats));
+      ret.first->second.events += it.second.events;
+      ret.first->second.wallNs += it.second.wallNs;
+    }
+
+  std::vector<ComponentStats> list;
+  for (auto const &it : merged)
+    {
+      list.push_back (it.second);
+    }
+  std::stable_sort (list.begin (), list.end (), WallTimeComp);
+  return list;
+}
+
+void
+ProfilingSimulatorImpl::NotifyEventDone (const EventImpl *event,
+                                         uint16_t tid, int64_t wallNs)
+{
+  EventKey key;
+  key.type = &typeid (*event);
+  key.tid = tid;
+  TypeCounters &counters = m_counters [key];
+  counters.events++;
+  counters.wallNs += wallNs;
+}
+
+void
+ProfilingSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+
+  DefaultSimulatorImpl::Destroy ();
+  WriteReport (m_reportFilename);
+  WriteFolded (m_foldedFilename);
+}
+
+EventId
+ProfilingSimulatorImpl::Schedule (const Time &delay, EventImpl *event)
+{
+  return DefaultSimulatorImpl::Schedule (delay, Wrap (event));
+}
+
+void
+ProfilingSimulatorImpl::ScheduleWithContext (uint32_t context,
+                                             const Time &delay,
+                                             EventImpl *event)
+{
+  DefaultSimulatorImpl::ScheduleWithContext (context, delay, Wrap (event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return DefaultSimulatorImpl::ScheduleNow (Wrap (event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  return DefaultSimulatorImpl::ScheduleDestroy (Wrap (event));
+}
+
+void
+ProfilingSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  int64_t start = WallNowNs ();
+  DefaultSimulatorImpl::Run ();
+  m_runWallNs += WallNowNs () - start;
+}
+
+EventImpl *
+ProfilingSimulatorImpl::Wrap (EventImpl *event)
+{
+  return new ProfiledEventImpl (this, event);
+}
+
+void
+ProfilingSimulatorImpl::WriteReport (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  if (filename.empty ())
+    {
+      return;
+    }
+
+  std::ofstream os (filename.c_str (), std::ios::out);
+  if (!os.is_open ())
+    {
+      NS_LOG_WARN ("Can't open the profiling report file " << filename);
+      return;
+    }
+
+  std::vector<ComponentStats> list = GetStats ();
+  int64_t  sumWallNs = 0;
+  uint64_t sumEvents = 0;
+  for (auto const &stats : list)
+    {
+      sumWallNs += stats.wallNs;
+      sumEvents += stats.events;
+    }
+
+  // The time not spent inside events was spent by the scheduler itself.
+  int64_t totalNs = std::max (m_runWallNs, sumWallNs);
+  int64_t schedNs = totalNs - sumWallNs;
+
+  os << std::fixed << std::setprecision (3)
+     << "Total run wall time: " << totalNs / 1e9 << " s" << std::endl
+     << "Total events:        " << sumEvents << std::endl
+     << "Scheduler overhead:  " << schedNs / 1e9 << " s" << std::endl
+     << std::endl;
+
+  os << " " << std::setw (11) << "WallSec"
+     << " " << std::setw (7)  << "Percent"
+     << " " << std::setw (12) << "Events"
+     << " " << std::setw (9)  << "AvgUsec"
+     << " " << std::setw (14) << "Group"
+     << " " << std::left      << "Component [Signature]"
+     << std::right << std::endl;
+
+  for (auto const &stats : list)
+    {
+      double percent = totalNs ? (100.0 * stats.wallNs / totalNs) : 0.0;
+      double avgUsec = stats.events ? (stats.wallNs / 1e3 / stats.events) : 0;
+      os << " " << std::setw (11) << stats.wallNs / 1e9
+         << " " << std::setw (7)  << percent
+         << " " << std::setw (12) << stats.events
+         << " " << std::setw (9)  << avgUsec
+         << " " << std::setw (14) << stats.group
+         << " " << stats.component << " [" << stats.signature << "]"
+         << std::endl;
+    }
+}
+
+void
+ProfilingSimulatorImpl::WriteFolded (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+
+  if (filename.empty ())
+    {
+      return;
+    }
+
+  std::ofstream os (filename.c_str (), std::ios::out);
+  if (!os.is_open ())
+    {
+      NS_LOG_WARN ("Can't open the profiling folded file " << filename);
+      return;
+    }
+
+  // One line per stack using microseconds as sample values.
+  int64_t sumWallNs = 0;
+  for (auto const &stats : GetStats ())
+    {
+      sumWallNs += stats.wallNs;
+      os << "Simulator::Run"
+         << ";" << FoldedFrame (stats.group)
+         << ";" << FoldedFrame (stats.component)
+         << ";" << FoldedFrame (stats.signature)
+         << " " << stats.wallNs / 1000
+         << std::endl;
+    }
+  if (m_runWallNs > sumWallNs)
+    {
+      os << "Simulator::Run;Scheduler " << (m_runWallNs - sumWallNs) / 1000
+         << std::endl;
+    }
+}
+
+ProfilingSimulatorImpl::ComponentStats
+ProfilingSimulatorImpl::ParseEventType (const std::type_info *info,
+                                        uint16_t uid)
+{
+  ComponentStats stats;
+  stats.events = 0;
+  stats.wallNs = 0;
+
+  // Events created by MakeEvent are local classes of the MakeEvent function
+  // template, so the demangled name looks like:
+  // ns3::MakeEvent<void (ns3::Class::*)(args), ns3::Class*>(...)::Impl
+  // ns3::MakeEvent<void (*)(args), ...>(...)::Impl
+  std::string name = DemangleTypeName (info->name ());
+  std::string signature = name;
+  std::size_t open = name.find ('<');
+  if (name.compare (0, 14, "ns3::MakeEvent") == 0 && open != std::string::npos)
+    {
+      // Keep only the first template argument (the function signature),
+      // considering nested template arguments and parentheses.
+      int depth = 0;
+      std::size_t end = open + 1;
+      for (; end < name.size (); end++)
+        {
+          char c = name [end];
+          if (c == '<' || c == '(')
+            {
+              depth++;
+            }
+          else if (c == '>' || c == ')')
+            {
+              if (depth == 0)
+                {
+                  break;
+                }
+              depth--;
+            }
+          else if (c == ',' && depth == 0)
+            {
+              break;
+            }
+        }
+      signature = name.substr (open + 1, end - open - 1);
+    }
+
+  // The owning class is the runtime class of the receiver object, when it
+  // is an ObjectBase. Otherwise, it is the class in the member function
+  // pointer type.
+  std::size_t member = signature.find ("::*)");
+  std::size_t paren = signature.rfind ('(', member);
+  if (uid != 0)
+    {
+      stats.component = TypeId::GetRegistered (uid - 1).GetName ();
+    }
+  else if (member != std::string::npos && paren != std::string::npos)
+    {
+      stats.component = signature.substr (paren + 1, member - paren - 1);
+    }
+  else if (signature.find ("(*)") != std::string::npos)
+    {
+      stats.component = "Function";
+    }
+  else
+    {
+      stats.component = name;
+    }
+  stats.signature = signature;
+
+  // Map the owning class to a registered TypeId to get its group.
+  TypeId tid;
+  if (TypeId::LookupByNameFailSafe (stats.component, &tid)
+      && !tid.GetGroupName ().empty ())
+    {
+      stats.group = tid.GetGroupName ();
+    }
+  else
+    {
+      stats.group = "-";
+    }
+  return stats;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#ifndef PROFILING_SIMULATOR_IMPL_H
+#define PROFILING_SIMULATOR_IMPL_H
+
+#include "default-simulator-impl.h"
+
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ProfilingSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * Single process simulator implementation that attributes the wall-clock
+ * time spent in each event to the component that owns the event callback.
+ *
+ * Each scheduled event is wrapped into a profiled event that measures the
+ * wall-clock time of the original Invoke () call. Events are grouped by
+ * their C++ implementation type, which encodes the member function
+ * signature for events created by MakeEvent, and by the component that owns
+ * them. When the event receiver is an ObjectBase, the component is the
+ * TypeId of the receiver object (from GetInstanceTypeId), so a timer of a
+ * subclass is not attributed to the base class declaring the method. For
+ * other events, the component is the class in the member function pointer
+ * type. When the component is a registered ns-3 TypeId, its group name
+ * (usually the module name) is used as the upper level of the hierarchy.
+ *
+ * When Simulator::Destroy () is invoked, this implementation writes a text
+ * report with components sorted by decreasing wall-clock time and a file in
+ * the folded stack format that can be directly processed by flamegraph.pl.
+ *
+ * To enable it, use:
+ * \code
+ * GlobalValue::Bind ("SimulatorImplementationType",
+ *                    StringValue ("ns3::ProfilingSimulatorImpl"));
+ * \endcode
+ */
+class ProfilingSimulatorImpl : public DefaultSimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  ProfilingSimulatorImpl ();
+  /** Destructor. */
+  ~ProfilingSimulatorImpl ();
+
+  /** Profiling statistics for a single component event type. */
+  struct ComponentStats
+  {
+    std::string group;      //!< The TypeId group name.
+    std::string component;  //!< The owning class name.
+    std::string signature;  //!< The event callback signature.
+    uint64_t    events;     //!< Number of invoked events.
+    int64_t     wallNs;     //!< Accumulated wall-clock time (ns).
+  };
+
+  /**
+   * Get the profiling statistics collected so far, merged by component and
+   * event signature and sorted by decreasing wall-clock time.
+   * \return The list of profiling statistics.
+   */
+  std::vector<ComponentStats> GetStats (void) const;
+
+  /**
+   * Record the wall-clock time spent by an event.
+   * \param event The original event implementation.
+   * \param tid The receiver TypeId uid, or 0 if unknown.
+   * \param wallNs The wall-clock time spent by the event (ns).
+   */
+  void NotifyEventDone (const EventImpl *event, uint16_t tid, int64_t wallNs);
+
+  // Inherited
+  virtual void Destroy ();
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay,
+                                    EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Run (void);
+
+private:
+  /**
+   * Wrap the event into a profiled event.
+   * \param event The original event.
+   * \return The profiled event.
+   */
+  EventImpl * Wrap (EventImpl *event);
+
+  /**
+   * Write the text report into the given filename.
+   * \param filename The output filename.
+   */
+  void WriteReport (std::string filename) const;
+
+  /**
+   * Write the folded stack into the given filename.
+   * \param filename The output filename.
+   */
+  void WriteFolded (std::string filename) const;
+
+  /**
+   * Build the component statistics from the event implementation type.
+   * \param info The event implementation type.
+   * \param uid The receiver TypeId uid, or 0 if unknown.
+   * \return The component statistics, with zeroed counters.
+   */
+  static ComponentStats ParseEventType (const std::type_info *info,
+                                        uint16_t uid);
+
+  /** Event implementation type and receiver TypeId uid. */
+  struct EventKey
+  {
+    const std::type_info *type; //!< Event implementation type.
+    uint16_t              tid;  //!< Receiver TypeId uid, or 0.
+
+    /**
+     * Compare two keys.
+     * \param other The other key.
+     * \return True if both keys are equal.
+     */
+    bool operator== (const EventKey &other) const
+    {
+      return type == other.type && tid == other.tid;
+    }
+  };
+
+  /** Hash function for event keys. */
+  struct EventKeyHash
+  {
+    /**
+     * Get the hash value.
+     * \param key The event key.
+     * \return The hash value.
+     */
+    std::size_t operator() (const EventKey &key) const
+    {
+      return std::hash<const std::type_info*> () (key.type) ^ key.tid;
+    }
+  };
+
+  /** Raw counters for an event implementation type. */
+  struct TypeCounters
+  {
+    uint64_t events;        //!< Number of invoked events.
+    int64_t  wallNs;        //!< Accumulated wall-clock time (ns).
+  };
+
+  /** Map saving event key / raw counters. */
+  typedef std::unordered_map<EventKey, TypeCounters, EventKeyHash>
+    TypeCountersMap_t;
+  TypeCountersMap_t         m_counters;       //!< Raw counters.
+
+  int64_t                   m_runWallNs;      //!< Wall-clock time in Run.
+  std::string               m_reportFilename; //!< Report filename.
+  std::string               m_foldedFilename; //!< Folded stack filename.
+};
+
+} // namespace ns3
+
+#endif /* PROFILING_SIMULATOR_IMPL_H */
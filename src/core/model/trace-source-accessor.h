@@ -95,6 +95,30 @@ public:
    *         the \c obj couldn't be cast to the correct type.
    */
   virtual bool Disconnect (ObjectBase *obj, std::string context, const CallbackBase &cb) const = 0;
+  /**
+   * Connect a Callback to a TraceSource with an interned context identifier.
+   *
+   * The context identifier will be provided as the first argument to the
+   * Callback function.
+   *
+   * \param [in] obj The object instance which contains the target trace source.
+   * \param [in] contextId The context identifier to bind to the user callback.
+   * \param [in] cb The callback to connect to the target trace source.
+   * \return \c true unless the connection could not be made, typically because
+   *         the \c obj couldn't be cast to the correct type.
+   */
+  virtual bool ConnectWithContextId (ObjectBase *obj, uint32_t contextId, const CallbackBase &cb) const = 0;
+  /**
+   * Disconnect a Callback from a TraceSource with an interned context
+   * identifier.
+   *
+   * \param [in] obj The object instance which contains the target trace source.
+   * \param [in] contextId The context identifier bound to the user callback.
+   * \param [in] cb The callback to disconnect from the target trace source.
+   * \return \c true unless the connection could not be made, typically because
+   *         the \c obj couldn't be cast to the correct type.
+   */
+  virtual bool DisconnectWithContextId (ObjectBase *obj, uint32_t contextId, const CallbackBase &cb) const = 0;
 };
 
 /**
@@ -188,6 +212,24 @@ DoMakeTraceSourceAccessor (SOURCE T::*a)
       (p->*m_source).Disconnect (cb, context);
       return true;
     }
+    virtual bool ConnectWithContextId (ObjectBase *obj, uint32_t contextId, const CallbackBase &cb) const {
+      T *p = dynamic_cast<T*> (obj);
+      if (p == 0)
+        {
+          return false;
+        }
+      (p->*m_source).ConnectWithContextId (cb, contextId);
+      return true;
+    }
+    virtual bool DisconnectWithContextId (ObjectBase *obj, uint32_t contextId, const CallbackBase &cb) const {
+      T *p = dynamic_cast<T*> (obj);
+      if (p == 0)
+        {
+          return false;
+        }
+      (p->*m_source).DisconnectWithContextId (cb, contextId);
+      return true;
+    }
     SOURCE T::*m_source;
   } *accessor = new Accessor ();
   accessor->m_source = a;
@@ -21,7 +21,7 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
 
 /**
@@ -80,6 +80,18 @@ public:
    * \param [in] path Context string to provide when invoking the Callback.
    */
   void Connect (const CallbackBase & callback, std::string path);
+  /**
+   * Append a Callback to the chain with an interned context identifier.
+   *
+   * The context identifier will be provided as the first argument
+   * to the Callback. This avoids copying the context string on every
+   * invocation. Use Config::GetContextName () to get the context string.
+   *
+   * \param [in] callback Callback to add to chain.
+   * \param [in] contextId Context identifier to provide when invoking the
+   *             Callback.
+   */
+  void ConnectWithContextId (const CallbackBase & callback, uint32_t contextId);
   /**
    * Remove from the chain a Callback which was connected without a context.
    *
@@ -93,6 +105,25 @@ public:
    * \param [in] path Context path which was used to connect the Callback.
    */
   void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * Remove from the chain a Callback which was connected with an interned
+   * context identifier.
+   *
+   * \param [in] callback Callback to remove from the chain.
+   * \param [in] contextId Context identifier which was used to connect the
+   *             Callback.
+   */
+  void DisconnectWithContextId (const CallbackBase & callback,
+                                uint32_t contextId);
+  /**
+   * Check for an empty chain of Callbacks.
+   *
+   * Trace sources that must build expensive arguments can use this check
+   * to skip that work when nobody is listening.
+   *
+   * \return \c true if there are no connected Callbacks.
+   */
+  bool IsEmpty (void) const;
   /**
    * \name Functors taking various numbers of arguments.
    *
@@ -222,21 +253,28 @@ public:
 
   
 private:
+  /** Callback type for the chain. */
+  typedef Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> CallbackType;
+  /**
+   * Container type for holding the Callbacks after the first one.
+   */
+  typedef std::vector<CallbackType> CallbackVector;
+
   /**
-   * Container type for holding the chain of Callbacks.
+   * Append a Callback to the end of the chain.
    *
-   * \tparam T1 \deduced Type of the first argument to the functor.
-   * \tparam T2 \deduced Type of the second argument to the functor.
-   * \tparam T3 \deduced Type of the third argument to the functor.
-   * \tparam T4 \deduced Type of the fourth argument to the functor.
-   * \tparam T5 \deduced Type of the fifth argument to the functor.
-   * \tparam T6 \deduced Type of the sixth argument to the functor.
-   * \tparam T7 \deduced Type of the seventh argument to the functor.
-   * \tparam T8 \deduced Type of the eighth argument to the functor.
+   * \param [in] cb Callback to add to chain.
+   */
+  void Append (const CallbackType &cb);
+
+  /**
+   * The first Callback in the chain, stored inline. Most trace sources have
+   * no more than one sink, so firing them never touches the heap. When null,
+   * the chain is empty.
    */
-  typedef std::list<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
-  /** The chain of Callbacks. */
-  CallbackList m_callbackList;
+  CallbackType m_first;
+  /** The remaining Callbacks in the chain, in connection order. */
+  CallbackVector m_others;
 };
 
 } // namespace ns3
@@ -253,8 +291,34 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::TracedCallback ()
-  : m_callbackList () 
+  : m_first (),
+    m_others ()
+{
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Append (const CallbackType &cb)
 {
+  if (m_first.IsNull ())
+    {
+      m_first = cb;
+    }
+  else
+    {
+      m_others.push_back (cb);
+    }
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+bool
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::IsEmpty (void) const
+{
+  return m_first.IsNull ();
 }
 template<typename T1, typename T2,
          typename T3, typename T4,
@@ -266,7 +330,7 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectWithoutContext (const CallbackBa
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> cb;
   if (!cb.Assign (callback))
     NS_FATAL_ERROR_NO_MSG();
-  m_callbackList.push_back (cb);
+  Append (cb);
 }
 template<typename T1, typename T2,
          typename T3, typename T4,
@@ -279,7 +343,20 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Connect (const CallbackBase & callback,
   if (!cb.Assign (callback))
     NS_FATAL_ERROR ("when connecting to " << path);
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  Append (realCb);
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectWithContextId (const CallbackBase & callback, uint32_t contextId)
+{
+  Callback<void,uint32_t,T1,T2,T3,T4,T5,T6,T7,T8> cb;
+  if (!cb.Assign (callback))
+    NS_FATAL_ERROR ("when connecting to context id " << contextId);
+  Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (contextId);
+  Append (realCb);
 }
 template<typename T1, typename T2, 
          typename T3, typename T4,
@@ -288,18 +365,36 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectWithoutContext (const CallbackBase & callback)
 {
-  for (typename CallbackList::iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); /* empty */)
+  if (IsEmpty ())
+    {
+      return;
+    }
+
+  for (typename CallbackVector::iterator i = m_others.begin ();
+       i != m_others.end (); /* empty */)
     {
       if ((*i).IsEqual (callback))
         {
-          i = m_callbackList.erase (i);
+          i = m_others.erase (i);
         }
       else
         {
           i++;
         }
     }
+  if (m_first.IsEqual (callback))
+    {
+      // Promote the next Callback to keep the chain order.
+      if (m_others.empty ())
+        {
+          m_first = CallbackType ();
+        }
+      else
+        {
+          m_first = m_others.front ();
+          m_others.erase (m_others.begin ());
+        }
+    }
 }
 template<typename T1, typename T2, 
          typename T3, typename T4,
@@ -319,12 +414,29 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 void 
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectWithContextId (const CallbackBase & callback, uint32_t contextId)
+{
+  Callback<void,uint32_t,T1,T2,T3,T4,T5,T6,T7,T8> cb;
+  if (!cb.Assign (callback))
+    NS_FATAL_ERROR ("when disconnecting from context id " << contextId);
+  Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (contextId);
+  DisconnectWithoutContext (realCb);
+}
+template<typename T1, typename T2, 
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (void) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
+    {
+      return;
+    }
+  m_first ();
+  for (std::size_t i = 0; i < m_others.size (); i++)
     {
-      (*i)();
+      m_others[i] ();
     }
 }
 template<typename T1, typename T2, 
@@ -334,10 +446,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
     {
-      (*i)(a1);
+      return;
+    }
+  m_first (a1);
+  for (std::size_t i = 0; i < m_others.size (); i++)
+    {
+      m_others[i] (a1);
     }
 }
 template<typename T1, typename T2, 
@@ -347,10 +463,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
     {
-      (*i)(a1, a2);
+      return;
+    }
+  m_first (a1, a2);
+  for (std::size_t i = 0; i < m_others.size (); i++)
+    {
+      m_others[i] (a1, a2);
     }
 }
 template<typename T1, typename T2, 
@@ -360,10 +480,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
+    {
+      return;
+    }
+  m_first (a1, a2, a3);
+  for (std::size_t i = 0; i < m_others.size (); i++)
     {
-      (*i)(a1, a2, a3);
+      m_others[i] (a1, a2, a3);
     }
 }
 template<typename T1, typename T2, 
@@ -373,10 +497,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
+    {
+      return;
+    }
+  m_first (a1, a2, a3, a4);
+  for (std::size_t i = 0; i < m_others.size (); i++)
     {
-      (*i)(a1, a2, a3, a4);
+      m_others[i] (a1, a2, a3, a4);
     }
 }
 template<typename T1, typename T2, 
@@ -386,10 +514,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
     {
-      (*i)(a1, a2, a3, a4, a5);
+      return;
+    }
+  m_first (a1, a2, a3, a4, a5);
+  for (std::size_t i = 0; i < m_others.size (); i++)
+    {
+      m_others[i] (a1, a2, a3, a4, a5);
     }
 }
 template<typename T1, typename T2, 
@@ -399,10 +531,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
     {
-      (*i)(a1, a2, a3, a4, a5, a6);
+      return;
+    }
+  m_first (a1, a2, a3, a4, a5, a6);
+  for (std::size_t i = 0; i < m_others.size (); i++)
+    {
+      m_others[i] (a1, a2, a3, a4, a5, a6);
     }
 }
 template<typename T1, typename T2, 
@@ -412,10 +548,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
+    {
+      return;
+    }
+  m_first (a1, a2, a3, a4, a5, a6, a7);
+  for (std::size_t i = 0; i < m_others.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7);
+      m_others[i] (a1, a2, a3, a4, a5, a6, a7);
     }
 }
 template<typename T1, typename T2, 
@@ -425,10 +565,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (IsEmpty ())
+    {
+      return;
+    }
+  m_first (a1, a2, a3, a4, a5, a6, a7, a8);
+  for (std::size_t i = 0; i < m_others.size (); i++)
     {
-      (*i)(a1, a2, a3, a4, a5, a6, a7, a8);
+      m_others[i] (a1, a2, a3, a4, a5, a6, a7, a8);
     }
 }
 
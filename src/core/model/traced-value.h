@@ -181,6 +181,18 @@ public:
   void Connect (const CallbackBase &cb, std::string path) {
     m_cb.Connect (cb, path);
   }
+  /**
+   * Connect a Callback with an interned context identifier.
+   *
+   * The context identifier will be provided as the first argument to the
+   * Callback function.
+   *
+   * \param [in] cb The Callback to connect to the target trace source.
+   * \param [in] contextId The context identifier to bind to the user callback.
+   */
+  void ConnectWithContextId (const CallbackBase &cb, uint32_t contextId) {
+    m_cb.ConnectWithContextId (cb, contextId);
+  }
   /**
    * Disconnect a Callback which was connected without context.
    *
@@ -198,6 +210,15 @@ public:
   void Disconnect (const CallbackBase &cb, std::string path) {
     m_cb.Disconnect (cb, path);
   }
+  /**
+   * Disconnect a Callback which was connected with a context identifier.
+   *
+   * \param [in] cb The Callback to disconnect.
+   * \param [in] contextId The context identifier bound to the user callback.
+   */
+  void DisconnectWithContextId (const CallbackBase &cb, uint32_t contextId) {
+    m_cb.DisconnectWithContextId (cb, contextId);
+  }
   /**
    * Set the value of the underlying variable.
    *
@@ -78,6 +78,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -182,6 +184,12 @@ public:
    * \returns The type id.
    */
   uint16_t GetRegistered (uint16_t i) const;
+  /**
+   * Get the version of the attribute information of all type ids.
+   * \returns The version, incremented every time an attribute is added
+   *          or a parent is set.
+   */
+  uint32_t GetAttributeVersion (void) const;
   /**
    * Record a new attribute in a type id.
    * \param [in] uid The id.
@@ -343,6 +351,9 @@ private:
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /** The attribute information version. */
+  uint32_t m_attributeVersion;
+
 
   /** IidManager constants. */
   enum {
@@ -357,6 +368,12 @@ private:
 };
 
 
+IidManager::IidManager ()
+  : m_attributeVersion (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 //static
 TypeId::hash_t
 IidManager::Hasher (const std::string name)
@@ -467,6 +484,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_attributeVersion++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -607,6 +625,12 @@ IidManager::GetRegistered (uint16_t i) const
   NS_LOG_FUNCTION (IID << i);
   return i + 1;
 }
+uint32_t
+IidManager::GetAttributeVersion (void) const
+{
+  NS_LOG_FUNCTION (IID);
+  return m_attributeVersion;
+}
 
 bool
 IidManager::HasAttribute (uint16_t uid,
@@ -676,6 +700,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  m_attributeVersion++;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void 
@@ -872,6 +897,12 @@ TypeId::GetRegistered (uint16_t i)
   NS_LOG_FUNCTION (i);
   return TypeId (IidManager::Get ()->GetRegistered (i));
 }
+uint32_t
+TypeId::GetAttributeVersion (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return IidManager::Get ()->GetAttributeVersion ();
+}
 
 bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
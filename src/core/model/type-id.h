@@ -164,6 +164,16 @@ public:
    * \returns The TypeId instance whose index is \c i.
    */
   static TypeId GetRegistered (uint16_t i);
+  /**
+   * Get the version of the attribute information of all TypeIds.
+   *
+   * The version changes every time an attribute is added to any TypeId,
+   * or a TypeId parent is set, so it can be used to invalidate cached
+   * attribute information.
+   *
+   * \returns The attribute information version.
+   */
+  static uint32_t GetAttributeVersion (void);
 
   /**
    * Constructor.
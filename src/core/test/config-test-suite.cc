@@ -275,6 +275,60 @@ DerivedConfigObject::GetTypeId (void)
 }
 
 
+/**
+ * \ingroup config-tests
+ * Test object whose TypeId is only registered, and extended with a new
+ * attribute, after the Config resolver has already been used.
+ */
+class LateConfigTestObject : public ConfigTestObject
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /** Add the NodeC attribute to the already registered TypeId. */
+  static void AddNodeCAttribute (void);
+  /**
+   * Set node C function
+   * \param c test object c
+   */
+  void SetNodeC (Ptr<ConfigTestObject> c);
+private:
+  Ptr<ConfigTestObject> m_nodeC;  //!< NodeC attribute target.
+};
+
+TypeId
+LateConfigTestObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("LateConfigTestObject")
+    .SetParent<ConfigTestObject> ()
+    ;
+  return tid;
+}
+
+void
+LateConfigTestObject::AddNodeCAttribute (void)
+{
+  TypeId tid = GetTypeId ();
+  struct TypeId::AttributeInformation info;
+  if (!tid.LookupAttributeByName ("NodeC", &info))
+    {
+      tid.AddAttribute ("NodeC", "",
+                        PointerValue (),
+                        MakePointerAccessor (&LateConfigTestObject::m_nodeC),
+                        MakePointerChecker<ConfigTestObject> ());
+    }
+}
+
+void
+LateConfigTestObject::SetNodeC (Ptr<ConfigTestObject> c)
+{
+  m_nodeC = c;
+}
+
+
 /**
  * \ingroup config-tests
  * Test for the ability to register and use a root namespace.
@@ -775,6 +829,94 @@ ObjectVectorTraceConfigTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the ability to trace connect with interned context identifiers.
+ */
+class ContextIdTraceConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ContextIdTraceConfigTestCase ();
+  /** Destructor. */
+  virtual ~ContextIdTraceConfigTestCase () {}
+
+  /**
+   * Trace callback with context identifier.
+   * \param contextId The context identifier.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithId (uint32_t contextId, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_contextId = contextId;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t  m_newValue;  //!< Flag to detect tracing result.
+  uint32_t m_contextId; //!< The context identifier.
+};
+
+ContextIdTraceConfigTestCase::ContextIdTraceConfigTestCase ()
+  : TestCase ("Check ability to trace connect with interned context identifiers")
+{
+}
+
+void
+ContextIdTraceConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  b->AddNodeB (obj0);
+  b->AddNodeB (obj1);
+
+  Config::ConnectWithContextId (
+    "/NodeA/NodeB/NodesB/*/Source",
+    MakeCallback (&ContextIdTraceConfigTestCase::TraceWithId, this));
+
+  //
+  // Each trace source gets its own identifier, mapped back to its path.
+  //
+  m_newValue = 0;
+  obj0->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -2, "Trace 0 did not fire as expected");
+  uint32_t id0 = m_contextId;
+  NS_TEST_ASSERT_MSG_EQ (Config::GetContextName (id0), "/NodeA/NodeB/NodesB/0/Source", "Trace 0 did not provide expected context");
+
+  m_newValue = 0;
+  obj1->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -3, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_NE (m_contextId, id0, "Trace 1 provided the same context as trace 0");
+  NS_TEST_ASSERT_MSG_EQ (Config::GetContextName (m_contextId), "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
+
+  //
+  // Interning the same string again gives back the same identifier.
+  //
+  NS_TEST_ASSERT_MSG_EQ (Config::GetContextId ("/NodeA/NodeB/NodesB/0/Source"), id0, "Context identifier is not stable");
+
+  //
+  // Disconnecting removes the sink.
+  //
+  Config::DisconnectWithContextId (
+    "/NodeA/NodeB/NodesB/*/Source",
+    MakeCallback (&ContextIdTraceConfigTestCase::TraceWithId, this));
+  m_newValue = 0;
+  obj0->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 0 fired after disconnect");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * Test for the ability to search attributes of parent classes
@@ -830,6 +972,83 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test that paths are resolved correctly for TypeIds registered, and for
+ * attributes added, after the Resolver has indexed the path attributes.
+ */
+class LateRegistrationConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LateRegistrationConfigTestCase ();
+  /** Destructor. */
+  virtual ~LateRegistrationConfigTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+};
+
+LateRegistrationConfigTestCase::LateRegistrationConfigTestCase ()
+  : TestCase ("Check that paths resolve through TypeIds and attributes registered late")
+{
+}
+
+void
+LateRegistrationConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+
+  //
+  // Resolve paths through ConfigTestObject first, so that its attributes
+  // are indexed before LateConfigTestObject is registered.
+  //
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Config::Set ("/NodeA/A", IntegerValue (1));
+  Config::Set ("/NodeB/A", IntegerValue (1));
+  a->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 1, "Object Attribute \"A\" not set correctly");
+
+  //
+  // Register LateConfigTestObject now; its inherited attributes must be
+  // found, including the ones already indexed for the parent TypeId.
+  //
+  Ptr<LateConfigTestObject> b = CreateObject<LateConfigTestObject> ();
+  root->SetNodeB (b);
+  Ptr<ConfigTestObject> c = CreateObject<ConfigTestObject> ();
+  b->SetNodeA (c);
+  Config::Set ("/NodeB/NodeA/A", IntegerValue (2));
+  c->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 2, "Object Attribute \"A\" not settable through a late TypeId");
+
+  //
+  // Resolve "NodeC" before it exists, then add it to the TypeId; the
+  // resolver must not keep using the stale result.
+  //
+  Ptr<ConfigTestObject> d = CreateObject<ConfigTestObject> ();
+  b->SetNodeC (d);
+  Config::Set ("/NodeB/NodeC/A", IntegerValue (3));
+  Config::Set ("/NodeB/*/B", IntegerValue (3));
+  d->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" set through a nonexistent attribute");
+
+  LateConfigTestObject::AddNodeCAttribute ();
+  Config::Set ("/NodeB/NodeC/A", IntegerValue (4));
+  Config::Set ("/NodeB/*/B", IntegerValue (4));
+  d->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 4, "Object Attribute \"A\" not settable through a late attribute");
+  d->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 4, "Object Attribute \"B\" not settable through a late attribute");
+  c->GetAttribute ("B", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 4, "Object Attribute \"B\" not set correctly");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -848,6 +1067,8 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new ContextIdTraceConfigTestCase);
+  AddTestCase (new LateRegistrationConfigTestCase);
 }
 
 /**
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include "ns3/profiling-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/object.h"
+#include "ns3/test.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * ProfilingSimulatorImpl test suite.
+ */
+
+namespace ns3 {
+
+  namespace tests {
+
+
+/**
+ * \ingroup core-tests
+ * Test object with a registered TypeId owning profiled events.
+ */
+class ProfiledObject : public Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::tests::ProfiledObject")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+    ;
+    return tid;
+  }
+  /** Event handler. */
+  void Handle (void)
+  {
+    m_count++;
+  }
+  /** Number of times Handle was invoked. */
+  uint32_t m_count = 0;
+};
+
+/**
+ * \ingroup core-tests
+ * Test object inheriting the event handler from ProfiledObject.
+ */
+class ProfiledSubObject : public ProfiledObject
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::tests::ProfiledSubObject")
+      .SetParent<ProfiledObject> ()
+      .SetGroupName ("Core")
+    ;
+    return tid;
+  }
+};
+
+/**
+ * \ingroup core-tests
+ * Check that events are counted and attributed to the owning class.
+ */
+class ProfilingSimulatorImplTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ProfilingSimulatorImplTestCase ();
+  virtual void DoRun (void);
+};
+
+ProfilingSimulatorImplTestCase::ProfilingSimulatorImplTestCase ()
+  : TestCase ("Check the per-component event attribution")
+{
+}
+
+void
+ProfilingSimulatorImplTestCase::DoRun (void)
+{
+  // No output files for this test.
+  Config::SetDefault ("ns3::ProfilingSimulatorImpl::ReportFilename",
+                      StringValue (""));
+  Config::SetDefault ("ns3::ProfilingSimulatorImpl::FoldedFilename",
+                      StringValue (""));
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::ProfilingSimulatorImpl"));
+
+  ProfiledObject::GetTypeId ();
+  Ptr<ProfiledObject> obj = CreateObject<ProfiledObject> ();
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &ProfiledObject::Handle, obj);
+    }
+  EventId cancelled = Simulator::Schedule (
+      MicroSeconds (20), &ProfiledObject::Handle, obj);
+  cancelled.Cancel ();
+  Simulator::ScheduleNow (&ProfiledObject::Handle, obj);
+  Simulator::Run ();
+
+  Ptr<ProfilingSimulatorImpl> impl =
+    DynamicCast<ProfilingSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Unexpected simulator implementation");
+
+  std::vector<ProfilingSimulatorImpl::ComponentStats> stats = impl->GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), 1, "Unexpected number of entries");
+  NS_TEST_EXPECT_MSG_EQ (stats.front ().events, 11, "Unexpected event count");
+  NS_TEST_EXPECT_MSG_EQ (obj->m_count, 11, "Unexpected invoked events");
+  NS_TEST_EXPECT_MSG_EQ (stats.front ().component,
+                         "ns3::tests::ProfiledObject", "Unexpected component");
+  NS_TEST_EXPECT_MSG_EQ (stats.front ().group, "Core", "Unexpected group");
+
+  impl = 0;
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::Reset ();
+}
+
+
+/**
+ * \ingroup core-tests
+ * Check that events are attributed to the runtime class of the receiver.
+ */
+class ProfilingSimulatorImplReceiverTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ProfilingSimulatorImplReceiverTestCase ();
+  virtual void DoRun (void);
+};
+
+ProfilingSimulatorImplReceiverTestCase::ProfilingSimulatorImplReceiverTestCase ()
+  : TestCase ("Check the attribution to the receiver object TypeId")
+{
+}
+
+void
+ProfilingSimulatorImplReceiverTestCase::DoRun (void)
+{
+  // No output files for this test.
+  Config::SetDefault ("ns3::ProfilingSimulatorImpl::ReportFilename",
+                      StringValue (""));
+  Config::SetDefault ("ns3::ProfilingSimulatorImpl::FoldedFilename",
+                      StringValue (""));
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::ProfilingSimulatorImpl"));
+
+  // The handler is declared by ProfiledObject, but the receivers have
+  // different runtime types.
+  Ptr<ProfiledObject> obj = CreateObject<ProfiledObject> ();
+  Ptr<ProfiledObject> sub = CreateObject<ProfiledSubObject> ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &ProfiledObject::Handle, obj);
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Simulator::Schedule (MicroSeconds (i), &ProfiledObject::Handle, sub);
+    }
+  Simulator::Run ();
+
+  Ptr<ProfilingSimulatorImpl> impl =
+    DynamicCast<ProfilingSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Unexpected simulator implementation");
+
+  std::vector<ProfilingSimulatorImpl::ComponentStats> stats = impl->GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), 2, "Unexpected number of entries");
+  for (auto const &entry : stats)
+    {
+      if (entry.component == "ns3::tests::ProfiledSubObject")
+        {
+          NS_TEST_EXPECT_MSG_EQ (entry.events, 5, "Unexpected event count");
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_EQ (entry.component, "ns3::tests::ProfiledObject",
+                                 "Unexpected component");
+          NS_TEST_EXPECT_MSG_EQ (entry.events, 3, "Unexpected event count");
+        }
+    }
+
+  impl = 0;
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::Reset ();
+}
+
+
+/**
+ * \ingroup core-tests
+ * ProfilingSimulatorImpl test suite.
+ */
+class ProfilingSimulatorImplTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  ProfilingSimulatorImplTestSuite ()
+    : TestSuite ("profiling-simulator-impl")
+  {
+    AddTestCase (new ProfilingSimulatorImplTestCase ());
+    AddTestCase (new ProfilingSimulatorImplReceiverTestCase ());
+  }
+};
+
+/**
+ * \ingroup core-tests
+ * ProfilingSimulatorImplTestSuite instance variable.
+ */
+static ProfilingSimulatorImplTestSuite g_profilingSimulatorImplTestSuite;
+
+
+  }  // namespace tests
+
+}  // namespace ns3
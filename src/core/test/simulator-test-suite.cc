@@ -19,6 +19,7 @@
  */
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
@@ -461,6 +462,49 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorEventCountTestCase : public TestCase
+{
+public:
+  SimulatorEventCountTestCase ();
+  virtual void DoRun (void);
+  void Event (void);
+};
+
+SimulatorEventCountTestCase::SimulatorEventCountTestCase ()
+  : TestCase ("Check the processed and pending event counters")
+{
+}
+
+void
+SimulatorEventCountTestCase::Event (void)
+{
+}
+
+void
+SimulatorEventCountTestCase::DoRun (void)
+{
+  Simulator::Schedule (MicroSeconds (1), &SimulatorEventCountTestCase::Event, this);
+  Simulator::Schedule (MicroSeconds (2), &SimulatorEventCountTestCase::Event, this);
+  EventId cancelled = Simulator::Schedule (MicroSeconds (3), &SimulatorEventCountTestCase::Event, this);
+  EventId removed = Simulator::Schedule (MicroSeconds (4), &SimulatorEventCountTestCase::Event, this);
+  Simulator::Cancel (cancelled);
+  Simulator::Remove (removed);
+
+  Ptr<DefaultSimulatorImpl> impl =
+    DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Unexpected simulator implementation");
+
+  // Cancelled events are kept in the queue until their expiration time.
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPendingEventCount (), 3, "Unexpected pending events");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount (), 0, "Unexpected processed events");
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPendingEventCount (), 0, "Unexpected pending events");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetEventCount (), 3, "Unexpected processed events");
+
+  impl = 0;
+  Simulator::Destroy ();
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -477,5 +521,6 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventCountTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
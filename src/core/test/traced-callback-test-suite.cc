@@ -113,6 +113,92 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class ChainTracedCallbackTestCase : public TestCase
+{
+public:
+  ChainTracedCallbackTestCase ();
+  virtual ~ChainTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbOne (uint8_t a);
+  void CbTwo (uint8_t a);
+  void CbThree (uint8_t a);
+
+  std::string m_order;
+};
+
+ChainTracedCallbackTestCase::ChainTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback chain order and empty check")
+{
+}
+
+void
+ChainTracedCallbackTestCase::CbOne (uint8_t a)
+{
+  NS_UNUSED (a);
+  m_order += "1";
+}
+
+void
+ChainTracedCallbackTestCase::CbTwo (uint8_t a)
+{
+  NS_UNUSED (a);
+  m_order += "2";
+}
+
+void
+ChainTracedCallbackTestCase::CbThree (uint8_t a)
+{
+  NS_UNUSED (a);
+  m_order += "3";
+}
+
+void
+ChainTracedCallbackTestCase::DoRun (void)
+{
+  TracedCallback<uint8_t> trace;
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New trace is not empty");
+
+  //
+  // Callbacks must be invoked in connection order.
+  //
+  trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbOne, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "Connected trace is empty");
+  trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbTwo, this));
+  trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbThree, this));
+  m_order = "";
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_order, "123", "Unexpected invocation order");
+
+  //
+  // Removing the first callback must keep the order of the others.
+  //
+  trace.DisconnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbOne, this));
+  m_order = "";
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_order, "23", "Unexpected invocation order");
+
+  //
+  // The same callback connected twice is invoked twice and removed at once.
+  //
+  trace.ConnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbTwo, this));
+  m_order = "";
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_order, "232", "Unexpected invocation order");
+  trace.DisconnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbTwo, this));
+  m_order = "";
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_order, "3", "Unexpected invocation order");
+
+  trace.DisconnectWithoutContext (MakeCallback (&ChainTracedCallbackTestCase::CbThree, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "Disconnected trace is not empty");
+  m_order = "";
+  trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_order, "", "Unexpected invocation");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +209,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new ChainTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
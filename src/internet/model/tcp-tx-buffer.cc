@@ -117,6 +117,12 @@ TcpTxBuffer::~TcpTxBuffer (void)
       m_size -= item->m_packet->GetSize ();
       delete item;
     }
+
+  for (std::vector<TcpTxItem*>::iterator pit = m_itemPool.begin ();
+       pit != m_itemPool.end (); ++pit)
+    {
+      delete *pit;
+    }
 }
 
 SequenceNumber32
@@ -181,7 +187,7 @@ TcpTxBuffer::Add (Ptr<Packet> p)
     {
       if (p->GetSize () > 0)
         {
-          TcpTxItem *item = new TcpTxItem ();
+          TcpTxItem *item = NewItem ();
           item->m_packet = p->Copy ();
           m_appList.insert (m_appList.end (), item);
           m_size += p->GetSize ();
@@ -398,7 +404,7 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
-                                bool *listEdited) const
+                                bool *listEdited)
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -465,7 +471,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                            " searching for " << seq <<
                            " and now we recurse because packet ends at "
                                         << beginOfCurrentPacket + currentPacket->GetSize ());
-              TcpTxItem *firstPart = new TcpTxItem ();
+              TcpTxItem *firstPart = NewItem ();
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
@@ -518,7 +524,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   list.erase (it);
 
                   MergeItems (previous, currentItem);
-                  delete currentItem;
+                  ReleaseItem (currentItem);
                   if (listEdited)
                     {
                       *listEdited = true;
@@ -531,7 +537,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
             {
               // the end is inside the current packet, but it isn't exactly
               // the packet end. Just fragment, fix the list, and return.
-              TcpTxItem *firstPart = new TcpTxItem ();
+              TcpTxItem *firstPart = NewItem ();
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
@@ -566,7 +572,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
           MergeItems (currentItem, next);
           list.erase (it);
 
-          delete next;
+          ReleaseItem (next);
 
           if (listEdited)
             {
@@ -585,6 +591,32 @@ static bool AreEquals (const bool &first, const bool &second)
   return first ? second : !second;
 }
 
+TcpTxItem*
+TcpTxBuffer::NewItem (void)
+{
+  if (m_itemPool.empty ())
+    {
+      return new TcpTxItem ();
+    }
+  TcpTxItem *item = m_itemPool.back ();
+  m_itemPool.pop_back ();
+  return item;
+}
+
+void
+TcpTxBuffer::ReleaseItem (TcpTxItem *item)
+{
+  if (m_itemPool.size () >= MAX_POOLED_ITEMS)
+    {
+      delete item;
+      return;
+    }
+
+  // Reset the item, dropping the packet reference, before pooling it
+  *item = TcpTxItem ();
+  m_itemPool.push_back (item);
+}
+
 void
 TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
 {
@@ -697,7 +729,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq)
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
                        ". Remaining data " << m_size);
-          delete item;
+          ReleaseItem (item);
         }
       else if (offset > 0)
         { // Part of the packet is behind the seqnum. Fragment
@@ -560,7 +560,7 @@ private:
    */
   TcpTxItem* GetPacketFromList (PacketList &list, const SequenceNumber32 &startingSeq,
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
-                                bool *listEdited = nullptr) const;
+                                bool *listEdited = nullptr);
 
   /**
    * \brief Merge two TcpTxItem
@@ -586,6 +586,27 @@ private:
    */
   void SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const;
 
+  /**
+   * \brief Get a new (default) TcpTxItem
+   *
+   * Items are frequently created and destroyed while splitting and merging
+   * segments, so released items are kept in a pool and reused.
+   *
+   * \return a new item, to be released with ReleaseItem
+   */
+  TcpTxItem* NewItem (void);
+
+  /**
+   * \brief Release a TcpTxItem back to the item pool
+   *
+   * The pool keeps at most MAX_POOLED_ITEMS items, so that a burst of
+   * fragmentation does not pin memory for the whole connection lifetime.
+   * Items beyond that limit are deleted.
+   *
+   * \param item the item to release
+   */
+  void ReleaseItem (TcpTxItem *item);
+
   /**
    * \brief Check if the values of sacked, lost, retrans, are in sync
    * with the sent list.
@@ -616,6 +637,9 @@ private:
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
 
+  static const uint32_t MAX_POOLED_ITEMS = 64; //!< Item pool size limit
+  std::vector<TcpTxItem*> m_itemPool; //!< Released items for reuse
+
 };
 
 /**
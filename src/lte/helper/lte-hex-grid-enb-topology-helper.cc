@@ -103,71 +103,76 @@ LteHexGridEnbTopologyHelper::SetPositionAndInstallEnbDevice (NodeContainer c)
 {
   NS_LOG_FUNCTION (this);
   NetDeviceContainer enbDevs;
-  const double xydfactor = std::sqrt (0.75);
-  double yd = xydfactor*m_d;
   for (uint32_t n = 0; n < c.GetN (); ++n)
     {
-      uint32_t currentSite = n / 3; 
-      uint32_t biRowIndex = (currentSite / (m_gridWidth + m_gridWidth + 1));
-      uint32_t biRowRemainder = currentSite % (m_gridWidth + m_gridWidth + 1);
-      uint32_t rowIndex = biRowIndex*2;
-      uint32_t colIndex = biRowRemainder; 
-      if (biRowRemainder >= m_gridWidth)
-	{
-	  ++rowIndex;
-	  colIndex -= m_gridWidth;
-	}
-      NS_LOG_LOGIC ("node " << n << " site " << currentSite 
-		    << " rowIndex " << rowIndex 
-		    << " colIndex " << colIndex 
-		    << " biRowIndex " << biRowIndex
-		    << " biRowRemainder " << biRowRemainder);
-      double y = m_yMin + yd * rowIndex;
-      double x;
       double antennaOrientation;
-      if ((rowIndex % 2) == 0) 
-	{
-	  x = m_xMin + m_d * colIndex;
-	}
-      else // row is odd
-	{
-	  x = m_xMin -(0.5*m_d) + m_d * colIndex;
-	}
-      
-      switch (n%3)
-	{
-	case 0:
-	  antennaOrientation = 0;
-	  x += m_offset;
-	  m_lteHelper->SetFfrAlgorithmAttribute("FrCellTypeId", UintegerValue (1));
-	  break;
-	  
-	case 1:
-	  antennaOrientation = 120;
-	  x -= m_offset/2.0;
-	  y += m_offset*xydfactor;
-	  m_lteHelper->SetFfrAlgorithmAttribute("FrCellTypeId", UintegerValue (2));
-	  break;
-	  
-	case 2:
-	  antennaOrientation = -120;
-	  x -= m_offset/2.0;
-	  y -= m_offset*xydfactor;
-	  m_lteHelper->SetFfrAlgorithmAttribute("FrCellTypeId", UintegerValue (3));
-	  break;
-	
-          // no default, n%3 = 0, 1, 2
-	}
+      Vector pos = GetEnbPosition (n, antennaOrientation);
       Ptr<Node> node = c.Get (n);
       Ptr<MobilityModel> mm = node->GetObject<MobilityModel> ();
-      Vector pos (x, y, m_siteHeight);
       NS_LOG_LOGIC ("node " << n << " at " << pos << " antennaOrientation " << antennaOrientation);
-      mm->SetPosition (Vector (x, y, m_siteHeight));
+      mm->SetPosition (pos);
+      m_lteHelper->SetFfrAlgorithmAttribute ("FrCellTypeId", UintegerValue (n % 3 + 1));
       m_lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (antennaOrientation));
       enbDevs.Add (m_lteHelper->InstallEnbDevice (node));
     }
   return enbDevs;
 }
 
+Vector
+LteHexGridEnbTopologyHelper::GetEnbPosition (uint32_t n, double &antennaOrientation) const
+{
+  NS_LOG_FUNCTION (this << n);
+  const double xydfactor = std::sqrt (0.75);
+  double yd = xydfactor*m_d;
+  uint32_t currentSite = n / 3; 
+  uint32_t biRowIndex = (currentSite / (m_gridWidth + m_gridWidth + 1));
+  uint32_t biRowRemainder = currentSite % (m_gridWidth + m_gridWidth + 1);
+  uint32_t rowIndex = biRowIndex*2;
+  uint32_t colIndex = biRowRemainder; 
+  if (biRowRemainder >= m_gridWidth)
+    {
+      ++rowIndex;
+      colIndex -= m_gridWidth;
+    }
+  NS_LOG_LOGIC ("node " << n << " site " << currentSite 
+                << " rowIndex " << rowIndex 
+                << " colIndex " << colIndex 
+                << " biRowIndex " << biRowIndex
+                << " biRowRemainder " << biRowRemainder);
+  double y = m_yMin + yd * rowIndex;
+  double x;
+  if ((rowIndex % 2) == 0) 
+    {
+      x = m_xMin + m_d * colIndex;
+    }
+  else // row is odd
+    {
+      x = m_xMin -(0.5*m_d) + m_d * colIndex;
+    }
+
+  switch (n%3)
+    {
+    case 0:
+      antennaOrientation = 0;
+      x += m_offset;
+      break;
+
+    case 1:
+      antennaOrientation = 120;
+      x -= m_offset/2.0;
+      y += m_offset*xydfactor;
+      break;
+
+    case 2:
+      antennaOrientation = -120;
+      x -= m_offset/2.0;
+      y -= m_offset*xydfactor;
+      break;
+
+      // no default, n%3 = 0, 1, 2
+    }
+  return Vector (x, y, m_siteHeight);
+}
+
 } // namespace ns3
  
@@ -71,6 +71,18 @@ public:
    */
   NetDeviceContainer SetPositionAndInstallEnbDevice (NodeContainer c);
 
+  /**
+   * Get the position on the hex grid and the antenna boresight of the
+   * eNB with the given index, as used by SetPositionAndInstallEnbDevice.
+   * This allows other eNB device models to share the same layout.
+   *
+   * \param n the index of the eNB node in the container
+   * \param antennaOrientation the antenna orientation [degrees] (output)
+   *
+   * \return the eNB position
+   */
+  Vector GetEnbPosition (uint32_t n, double &antennaOrientation) const;
+
 private:
   /**
    * Pointer to LteHelper object
@@ -277,7 +277,10 @@ EpcEnbApplication::RecvFromLteSocket (Ptr<Socket> socket)
       std::map<uint8_t, uint32_t>::iterator bidIt = rntiIt->second.find (bid);
       NS_ASSERT (bidIt != rntiIt->second.end ());
       uint32_t teid = bidIt->second;
-      m_rxLteSocketPktTrace (packet->Copy ());
+      if (!m_rxLteSocketPktTrace.IsEmpty ())
+        {
+          m_rxLteSocketPktTrace (packet->Copy ());
+        }
       SendToS1uSocket (packet, teid);
     }
 }
@@ -294,7 +297,10 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
   NS_ASSERT (it != m_teidRbidMap.end ());
 
-  m_rxS1uSocketPktTrace (packet->Copy ());
+  if (!m_rxS1uSocketPktTrace.IsEmpty ())
+    {
+      m_rxS1uSocketPktTrace (packet->Copy ());
+    }
   SendToLteSocket (packet, it->second.m_rnti, it->second.m_bid);
 }
 
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <map>
+#include <deque>
 
 namespace ns3 {
 
@@ -112,7 +113,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque  < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
 
     /// RetxPdu structure
     struct RetxPdu
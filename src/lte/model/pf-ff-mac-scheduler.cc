@@ -920,95 +920,122 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
+  // Single layer achievable rate (TB size / TTI) on one RBG for each CQI
+  // value, computed once per TTI instead of for each RBG and UE.
+  uint8_t mcsPerCqi [16];
+  double ratePerCqi [16];
+  for (int cqi = 0; cqi < 16; cqi++)
+    {
+      mcsPerCqi [cqi] = m_amc->GetMcsFromCqi (cqi);
+      ratePerCqi [cqi] = ((m_amc->GetDlTbSizeFromMcs (mcsPerCqi [cqi], rbgSize) / 8) / 0.001);
+    }
+  double rateNoInfo = ((m_amc->GetDlTbSizeFromMcs (0, rbgSize) / 8) / 0.001); // no info on this subband -> worst MCS
+
+  // Build the dense table of UEs that can be scheduled in this TTI, so the
+  // RBG allocation below does not look up the RNTI maps for each RBG.
+  m_dlCandidates.clear ();
+  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+    {
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
+      bool harqAvailable = HarqProcessAvailability ((*it).first);
+      if ((itRnti != rntiAllocated.end ())||(!harqAvailable))
+        {
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (itRnti != rntiAllocated.end ())
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
+            }
+          if (!harqAvailable)
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
+            }
+          continue;
+        }
+      std::map <uint16_t,uint8_t>::iterator itTxMode;
+      itTxMode = m_uesTxMode.find ((*it).first);
+      if (itTxMode == m_uesTxMode.end ())
+        {
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
+        }
+      if (LcActivePerFlow ((*it).first) == 0)
+        {
+          // this UE has no data to transmit
+          continue;
+        }
+      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
+      itCqi = m_a30CqiRxed.find ((*it).first);
+
+      pfsDlCandidate_t candidate;
+      candidate.rnti = (*it).first;
+      candidate.nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      candidate.sbMeas = (itCqi == m_a30CqiRxed.end ()) ? 0 : &((*itCqi).second);
+      candidate.lastAveragedThroughput = (*it).second.lastAveragedThroughput;
+      m_dlCandidates.push_back (candidate);
+    }
+
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
       if (rbgMap.at (i) == false)
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
+          std::vector <pfsDlCandidate_t>::const_iterator itCand;
+          std::vector <pfsDlCandidate_t>::const_iterator itMax = m_dlCandidates.end ();
           double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (itCand = m_dlCandidates.begin (); itCand != m_dlCandidates.end (); itCand++)
             {
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*itCand).rnti)) == false)
                 continue;
 
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
+              double achievableRate = 0.0;
+              uint8_t mcs = 0;
+              if ((*itCand).sbMeas == 0)
                 {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                  continue;
-                }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
+                  // start with lowest value
+                  mcs = mcsPerCqi [1];
+                  achievableRate = ratePerCqi [1] * (*itCand).nLayer;
                 }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
+              else
                 {
-                  for (uint8_t k = 0; k < nLayer; k++)
+                  const std::vector <uint8_t> &sbCqi = (*itCand).sbMeas->m_higherLayerSelected.at (i).m_sbCqi;
+                  uint8_t cqi1 = sbCqi.at (0);
+                  uint8_t cqi2 = 0;
+                  if (sbCqi.size () > 1)
                     {
-                      sbCqi.push_back (1);  // start with lowest value
+                      cqi2 = sbCqi.at (1);
                     }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
-              uint8_t cqi1 = sbCqi.at (0);
-              uint8_t cqi2 = 0;
-              if (sbCqi.size () > 1)
-                {
-                  cqi2 = sbCqi.at (1);
-                }
-
-              if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  if ((cqi1 == 0)&&(cqi2 == 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                    {
+                      continue;
+                    }
+                  for (uint8_t k = 0; k < (*itCand).nLayer; k++)
                     {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
+                      if (sbCqi.size () > k)
                         {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
+                          NS_ASSERT_MSG (sbCqi.at (k) <= 15, "CQI must be in [0..15] = " << (uint16_t)sbCqi.at (k));
+                          mcs = mcsPerCqi [sbCqi.at (k)];
+                          achievableRate += ratePerCqi [sbCqi.at (k)];
                         }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
+                      else
                         {
-                          rcqiMax = rcqi;
-                          itMax = it;
+                          // no info on this subband -> worst MCS
+                          mcs = 0;
+                          achievableRate += rateNoInfo;
                         }
                     }
-                }   // end if cqi
-            } // end for m_rlcBufferReq
+                }
+
+              double rcqi = achievableRate / (*itCand).lastAveragedThroughput;
+              NS_LOG_INFO (this << " RNTI " << (*itCand).rnti << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*itCand).lastAveragedThroughput << " RCQI " << rcqi);
+
+              if (rcqi > rcqiMax)
+                {
+                  rcqiMax = rcqi;
+                  itMax = itCand;
+                }
+            } // end for m_dlCandidates
 
-          if (itMax == m_flowStatsDl.end ())
+          if (itMax == m_dlCandidates.end ())
             {
               // no UE available for this RB
               NS_LOG_INFO (this << " any UE found");
@@ -1017,19 +1044,19 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             {
               rbgMap.at (i) = true;
               std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
+              itMap = allocationMap.find ((*itMax).rnti);
               if (itMap == allocationMap.end ())
                 {
                   // insert new element
                   std::vector <uint16_t> tempMap;
                   tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
+                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).rnti, tempMap));
                 }
               else
                 {
                   (*itMap).second.push_back (i);
                 }
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              NS_LOG_INFO (this << " UE assigned " << (*itMax).rnti);
             }
         } // end for RBG free
     } // end for RBGs
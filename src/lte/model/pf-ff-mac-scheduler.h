@@ -62,6 +62,16 @@ struct pfsFlowPerf_t
 };
 
 
+/// pfsDlCandidate_t structure
+struct pfsDlCandidate_t
+{
+  uint16_t rnti; ///< RNTI of the UE
+  int nLayer; ///< number of layers of the UE transmission mode
+  const SbMeasResult_s *sbMeas; ///< A30 CQI of the UE (null if not available)
+  double lastAveragedThroughput; ///< last averaged throughput
+};
+
+
 /**
  * \ingroup ff-api
  * \brief Implements the SCHED SAP and CSCHED SAP for a Proportional Fair scheduler
@@ -319,6 +329,11 @@ private:
   */
   std::map <uint16_t, pfsFlowPerf_t> m_flowStatsDl;
 
+  /**
+  * Dense table of the UEs that can be scheduled in the current TTI
+  */
+  std::vector <pfsDlCandidate_t> m_dlCandidates;
+
   /**
   * Map of UE statistics (per RNTI basis)
   */
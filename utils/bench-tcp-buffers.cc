@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the TcpTxBuffer and TcpRxBuffer
+// throughput. Data moves through the TcpTxBuffer as a TCP sender would move
+// it: application writes, segment transmissions, delayed cumulative ACKs and,
+// optionally, SACK-based loss recovery every 'loss' windows. Data moves
+// through the TcpRxBuffer as a TCP receiver would move it: a window of
+// segments, where the first one is lost and retransmitted after the others
+// every 'loss' windows, followed by an application read.
+// Sample usage:  ./waf --run 'bench-tcp-buffers --megabytes=256'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "ns3/tcp-rx-buffer.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-option-sack.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace ns3;
+
+/// Benchmark parameters
+struct BenchConfig
+{
+  uint64_t bytes;   //!< Total number of bytes to acknowledge
+  uint32_t mss;     //!< Segment size
+  uint32_t write;   //!< Application write size
+  uint32_t window;  //!< Sender window, in segments
+  uint32_t buffer;  //!< Maximum buffer size, in bytes
+  uint32_t loss;    //!< Lose one segment every 'loss' windows (0: no loss)
+};
+
+/**
+ * Move data through a TcpTxBuffer.
+ * \param cfg The benchmark parameters.
+ * \return The number of transmitted bytes, including retransmissions.
+ */
+static uint64_t
+benchTxBuffer (const BenchConfig &cfg)
+{
+  TcpTxBuffer txBuf;
+  txBuf.SetMaxBufferSize (cfg.buffer);
+  txBuf.SetSegmentSize (cfg.mss);
+  txBuf.SetDupAckThresh (3);
+  txBuf.SetHeadSequence (SequenceNumber32 (1));
+
+  Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+  uint64_t acked = 0;
+  uint64_t txBytes = 0;
+  uint32_t round = 0;
+  while (acked < cfg.bytes)
+    {
+      // Fill the buffer with application writes.
+      while (txBuf.Available () >= cfg.write)
+        {
+          txBuf.Add (Create<Packet> (cfg.write));
+        }
+
+      // Send a full window of new segments.
+      SequenceNumber32 head = txBuf.HeadSequence ();
+      SequenceNumber32 next = head;
+      for (uint32_t i = 0; i < cfg.window; i++)
+        {
+          uint32_t size = std::min (cfg.mss, txBuf.SizeFromSequence (next));
+          if (size == 0)
+            {
+              break;
+            }
+          txBuf.CopyFromSequence (size, next);
+          txBytes += size;
+          next += size;
+        }
+
+      uint32_t sent = next - head;
+      if (cfg.loss && (++round % cfg.loss) == 0 && sent > cfg.mss)
+        {
+          // The first segment is lost: the receiver SACKs the remaining ones
+          // and the sender retransmits the head before the cumulative ACK.
+          sack->ClearSackList ();
+          sack->AddSackBlock (TcpOptionSack::SackBlock (head + cfg.mss, next));
+          txBuf.Update (sack->GetSackList ());
+          SequenceNumber32 seq;
+          if (txBuf.NextSeg (&seq, true))
+            {
+              uint32_t size = std::min (cfg.mss, txBuf.SizeFromSequence (seq));
+              txBuf.CopyFromSequence (size, seq);
+              txBytes += size;
+            }
+          txBuf.DiscardUpTo (next);
+        }
+      else
+        {
+          // Delayed cumulative ACKs, one for every two segments.
+          SequenceNumber32 ack = head;
+          while (ack < next)
+            {
+              ack = std::min (ack + 2 * cfg.mss, next);
+              txBuf.DiscardUpTo (ack);
+            }
+        }
+      acked += sent;
+    }
+  return txBytes;
+}
+
+/**
+ * Move data through a TcpRxBuffer.
+ * \param cfg The benchmark parameters.
+ * \return The number of received bytes, including retransmissions.
+ */
+static uint64_t
+benchRxBuffer (const BenchConfig &cfg)
+{
+  TcpRxBuffer rxBuf (1);
+  rxBuf.SetMaxBufferSize (cfg.window * cfg.mss);
+
+  TcpHeader tcph;
+  SequenceNumber32 head (1);
+  uint64_t read = 0;
+  uint64_t rxBytes = 0;
+  uint32_t round = 0;
+  while (read < cfg.bytes)
+    {
+      // Receive a full window of segments, with the first one arriving after
+      // the others when it is lost.
+      bool lost = cfg.loss && (++round % cfg.loss) == 0;
+      for (uint32_t i = lost ? 1 : 0; i < cfg.window; i++)
+        {
+          tcph.SetSequenceNumber (head + i * cfg.mss);
+          rxBuf.Add (Create<Packet> (cfg.mss), tcph);
+          rxBytes += cfg.mss;
+        }
+      if (lost)
+        {
+          tcph.SetSequenceNumber (head);
+          rxBuf.Add (Create<Packet> (cfg.mss), tcph);
+          rxBytes += cfg.mss;
+        }
+
+      // The application reads everything in sequence.
+      Ptr<Packet> p;
+      while ((p = rxBuf.Extract (cfg.write)) != nullptr)
+        {
+          read += p->GetSize ();
+        }
+      head = rxBuf.NextRxSequence ();
+    }
+  return rxBytes;
+}
+
+static void
+runBench (void (*bench) (uint64_t &, const BenchConfig &),
+          const BenchConfig &cfg, const char *name)
+{
+  SystemWallClockMs time;
+  uint64_t txBytes = 0;
+  time.Start ();
+  (*bench) (txBytes, cfg);
+  uint64_t deltaMs = time.End ();
+  double mbps = deltaMs ? (txBytes / 1e6) / (deltaMs / 1e3) : 0;
+  std::cout << name << "=" << deltaMs << " ms, "
+            << txBytes / 1000000 << " MB, " << mbps << " MB/s" << std::endl;
+}
+
+static void
+benchBulk (uint64_t &txBytes, const BenchConfig &cfg)
+{
+  BenchConfig bulk = cfg;
+  bulk.loss = 0;
+  txBytes = benchTxBuffer (bulk);
+}
+
+static void
+benchSack (uint64_t &txBytes, const BenchConfig &cfg)
+{
+  txBytes = benchTxBuffer (cfg);
+}
+
+static void
+benchRx (uint64_t &rxBytes, const BenchConfig &cfg)
+{
+  rxBytes = benchRxBuffer (cfg);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t megabytes = 128;
+  BenchConfig cfg;
+  cfg.mss = 1448;
+  cfg.write = 1000;
+  cfg.window = 64;
+  cfg.buffer = 131072;
+  cfg.loss = 4;
+
+  CommandLine cmd;
+  cmd.AddValue ("megabytes", "number of megabytes to acknowledge", megabytes);
+  cmd.AddValue ("mss", "segment size", cfg.mss);
+  cmd.AddValue ("write", "application write size", cfg.write);
+  cmd.AddValue ("window", "sender window, in segments", cfg.window);
+  cmd.AddValue ("buffer", "maximum buffer size, in bytes", cfg.buffer);
+  cmd.AddValue ("loss", "lose one segment every 'loss' windows", cfg.loss);
+  cmd.Parse (argc, argv);
+  cfg.bytes = static_cast<uint64_t> (megabytes) * 1000000;
+
+  runBench (&benchBulk, cfg, "bulk");
+  runBench (&benchSack, cfg, "sack");
+  runBench (&benchRx, cfg, "rx");
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 University of Campinas (Unicamp)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Luciano Jerez Chaves <luciano@lrc.ic.unicamp.br>
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/// Number of times each sink was invoked, to keep the compiler honest.
+static uint64_t g_count = 0;
+
+/**
+ * Trace sink used by all benchmarks.
+ * \param value The traced value.
+ * \param size The traced size.
+ */
+static void
+Sink (uint32_t value, uint32_t size)
+{
+  g_count += value + size;
+}
+
+/**
+ * Fire a TracedCallback with the given number of sinks.
+ * \param sinks The number of connected sinks.
+ * \param n The number of times to fire the trace.
+ */
+static void
+benchFire (uint32_t sinks, uint32_t n)
+{
+  TracedCallback<uint32_t, uint32_t> trace;
+  for (uint32_t i = 0; i < sinks; i++)
+    {
+      trace.ConnectWithoutContext (MakeCallback (&Sink));
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      trace (i, sinks);
+    }
+}
+
+/**
+ * Connect and disconnect a sink to a TracedCallback.
+ * \param n The number of connect/disconnect cycles.
+ */
+static void
+benchConnect (uint32_t n)
+{
+  TracedCallback<uint32_t, uint32_t> trace;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      trace.ConnectWithoutContext (MakeCallback (&Sink));
+      trace.DisconnectWithoutContext (MakeCallback (&Sink));
+    }
+}
+
+static uint64_t
+runBenchOneIteration (uint32_t sinks, uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  if (sinks == std::numeric_limits<uint32_t>::max ())
+    {
+      benchConnect (n);
+    }
+  else
+    {
+      benchFire (sinks, n);
+    }
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (uint32_t sinks, uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (sinks, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ops = n;
+  ops *= 1000;
+  ops /= std::max (minDelay, static_cast<uint64_t> (1));
+  std::cout << ops << " ops/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark TracedCallback class");
+  cmd.AddValue ("n", "number of iterations", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-traced-callback with n=" << n << std::endl;
+
+  runBench (0, n, minIterations, "Fire trace without sinks");
+  runBench (1, n, minIterations, "Fire trace with one sink");
+  runBench (2, n, minIterations, "Fire trace with two sinks");
+  runBench (4, n, minIterations, "Fire trace with four sinks");
+  runBench (std::numeric_limits<uint32_t>::max (), n / 10, minIterations,
+            "Connect and disconnect one sink");
+
+  std::cout << "(checksum " << g_count << ")" << std::endl;
+  return 0;
+}